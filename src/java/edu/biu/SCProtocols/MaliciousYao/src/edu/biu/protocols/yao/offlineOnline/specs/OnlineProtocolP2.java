@@ -28,6 +28,7 @@ import edu.biu.protocols.yao.primitives.CutAndChooseSelection;
 import edu.biu.protocols.yao.primitives.EvaluateAllSelectionBuilder;
 import edu.biu.protocols.yao.primitives.Expector;
 import edu.biu.protocols.yao.primitives.KProbeResistantMatrix;
+import edu.biu.protocols.yao.primitives.KeyVectorOps;
 import edu.biu.scapi.circuits.circuit.BooleanCircuit;
 import edu.biu.scapi.circuits.circuit.Wire;
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastGarbledBooleanCircuit;
@@ -93,24 +94,6 @@ public class OnlineProtocolP2 implements Protocol {
 	 * Most of the times the native environment has better performance than the java environment.
 	 */
 	
-	/**
-	 * Gets the keys and mask and xor each key with the mask.
-	 * The result is placed in the keys array.
-	 * @param keys The keys to xor with the mask. This content is changed during the method and the output is places here.
-	 * @param mask The mask to use in order to xor each key.
-	 * @param size The number of keys.
-	 */
-	private native void xorKeysWithMask(byte[] keys, byte[] mask, int size);		
-	
-	/**
-	 * Gets two arrays of keys and xor them. 
-	 * @param keys1 The first keys array to xor. 
-	 * @param keys2 The second keys array to xor. 
-	 * @param output The result of xoring the keys array.
-	 * @param size The number of keys.
-	 */
-	private native void xorKeys(byte[] keys1, byte[] keys2, byte[] output, int size); 
-	
 	/**
 	 * Checks that the given random values and committed values are indeed lead to the commitments values.
 	 * @param comm The commitments values.
@@ -391,11 +374,9 @@ public class OnlineProtocolP2 implements Protocol {
 			
 			//Get the extended keys generated in the offline phase.
 			byte[] inputKeysY1Extended = circuitBundle.getY1ExtendedInputKeys();
-			byte[] cloneY1Extended = new byte[inputKeysY1Extended.length];
-			System.arraycopy(inputKeysY1Extended, 0, cloneY1Extended, 0, inputKeysY1Extended.length);
 			
-			// Call the native method that xor the commitment mask with Y1 extended keys received in offline phase.
-			xorKeysWithMask(cloneY1Extended, commitmentMask, inputKeysY1Extended.length/keyLength);
+			// Xor the commitment mask with Y1 extended keys received in offline phase (without changing the offline keys).
+			byte[] cloneY1Extended = KeyVectorOps.maskKeys(inputKeysY1Extended, commitmentMask, new byte[inputKeysY1Extended.length]);
 			
 			//Restore the original y1 keys using the given probe resistant matrix and the result of xoring the commitment mask with Y1 extended keys.
 			byte[] y1Keys = matrix.restoreKeys(cloneY1Extended);
@@ -422,11 +403,10 @@ public class OnlineProtocolP2 implements Protocol {
 			}
 		
 			//Xor the keys with the commitment mask to get the y2 keys.
-			xorKeysWithMask(values, commitmentMask, inputLabelsY2.length);
+			KeyVectorOps.maskKeys(values, commitmentMask, values);
 			
 			//Xor y1 keys and y2 keys to get y keys.
-			byte[] yKeys = new byte[inputLabelsY2.length*keyLength];
-			xorKeys(values, y1Keys, yKeys, inputLabelsY2.length);
+			byte[] yKeys = KeyVectorOps.xorKeys(values, y1Keys, values);
 		
 			//Set y keys to the circuit.
 			circuitBundle.setYInputKeys(yKeys);
@@ -532,7 +512,7 @@ public class OnlineProtocolP2 implements Protocol {
 			byte[] committedDifference = circuitBundle.getPlacementMaskDifference();
 			
 			//If both values are not equal, this is a cheating. Throw a cheating exception.
-			if (!Arrays.equals(committedDifference, actualDifference)) {
+			if (!KeyVectorOps.equalKeys(committedDifference, actualDifference)) {
 				throw new CheatAttemptException("committed delta between signals differ from actual signals!");
 			}
 		}
@@ -582,7 +562,7 @@ public class OnlineProtocolP2 implements Protocol {
 			}
 			
 			//Xor the keys with the commitment mask to get the x keys.
-			xorKeysWithMask(values, commitmentMask, inputLabelsP1.length);
+			KeyVectorOps.maskKeys(values, commitmentMask, values);
 			
 			//Set x keys to the circuit.
 			circuitBundle.setXInputKeys(values);
@@ -164,75 +164,26 @@ public class CutAndChooseProver {
 		int numOfThreads = primitives.getNumOfThreads();
 //		System.out.println("building garbled circuit bundle for " + numCircuits + " circuits...");
 		
-		//If the number of threads is more than zero, create the threads and assign to each one the appropriate circuits.
+		//If the number of threads is more than zero, build the circuits in parallel.
+		//Each building thread takes the next circuit that was not built yet, and each sending thread sends a fixed range of 
+		//circuits over its channel, since the verifier expects each channel to carry a fixed range of circuits, in order.
+		//A bundle builder may build its next circuit before the previous one was sent. This is fine since each bundle gets its 
+		//own copy of the garbled tables from the (native) garbled circuit.
 		if (numOfThreads > 0){
-			
-			ConstructThread[] threads = new ConstructThread[numOfThreads];
-			//Calculate the number of circuit in each thread and the remaining.
-			int numCircuitsPerThread = numCircuits / numOfThreads;
-			int remain = numCircuits % numOfThreads;
-			//Create the threads and assign to each one the appropriate circuits.
-			//The last thread gets also the remaining circuits.
-			for (int j = 0; j < numOfThreads; j++) {
-				if ((j != numOfThreads-1) || (remain == 0)){
-					threads[j] = new ConstructThread(j, j*numCircuitsPerThread, (j+1)*numCircuitsPerThread);
-				} else{
-					threads[j] = new ConstructThread(j, j*numCircuitsPerThread, (j+1)*numCircuitsPerThread + remain);
+			ParallelBuildAndSend.run(numCircuits, numOfThreads, new ParallelBuildAndSend.Builder() {
+				public void build(int item, int thread) {
+					buildCircuit(item, thread);
 				}
-				//Start all threads.
-				threads[j].start();
-			}
-			//Wait until all threads finish their job.
-			for (int j = 0; j < numOfThreads; j++) {
-				try {
-					threads[j].join();
-				} catch (InterruptedException e) {
-					throw new IllegalStateException();
+			}, new ParallelBuildAndSend.Sender() {
+				public void send(int item, int thread) throws IOException {
+					sendCircuit(item, thread);
 				}
-			}
+			});
 		//In case no thread should be created, build all the circuits directly.
 		} else {
 			for (int j = 0; j < numCircuits; j++) {
 				buildCircuit(j, 0);
-			}
-		}
-	}
-	
-	/**
-	 * Inner thread class that construct the circuits in a separate thread.
-	 * 
-	 * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Asaf Cohen)
-	 *
-	 */
-	private class ConstructThread extends Thread{
-		
-		private int from;	// The first circuit in the circuit list that should be created.
-		private int to;		// The last circuit in the circuit list that should be created.
-		private int i;		// The index of the thread.
-		
-		/**
-		 * Constructor that sets the parameters.
-		 * @param i The index of the thread.
-		 * @param from The first circuit in the circuit list that should be created.
-		 * @param to The last circuit in the circuit list that should be created.
-		 */
-		ConstructThread(int i, int from, int to){
-			this.i = i;
-			this.from = from;
-			this.to = to;
-		}
-		
-		/**
-		 * Builds the circuits from the start point to the end point in the circuit list.
-		 */
-		public void run(){
-			for (int j = from; j < to; j++) {
-				try {
-					buildCircuit(j, i);
-				} catch (IOException e) {
-					// TODO Auto-generated catch block
-					e.printStackTrace();
-				}	
+				sendCircuit(j, 0);
 			}
 		}
 	}
@@ -241,15 +192,23 @@ public class CutAndChooseProver {
 	 * Garble the circuit in the given index j using the bundle builder of the given index i.
 	 * @param j The index in the circuit list where the circuit that should be garbled is placed. 
 	 * @param i The index in the bundleBuilders list where the bundle builder that should be used is placed.
-	 * @throws IOException 
 	 */
-	private void buildCircuit(int j, int i) throws IOException {
+	private void buildCircuit(int j, int i) {
 		// Build a garbled circuit bundle with a randomly picked seed of size 160 bits.
 //		if (j % 50 == 0) {
 //			System.out.println("building garbled circuit bundle for circuit j = " + j);
 //		}
 		
 		circuitBundles[j] = bundleBuilders[i].build(20);
+	}
+	
+	/**
+	 * Sends the garbled tables and translation table of the circuit in the given index j.
+	 * @param j The index in the circuit list of the circuit to send.
+	 * @param i The index of the channel to send the circuit on.
+	 * @throws IOException 
+	 */
+	private void sendCircuit(int j, int i) throws IOException {
 		channels[i].send(circuitBundles[j].getGarbledTables());
 		channels[i].send(circuitBundles[j].getTranslationTable());
 	}
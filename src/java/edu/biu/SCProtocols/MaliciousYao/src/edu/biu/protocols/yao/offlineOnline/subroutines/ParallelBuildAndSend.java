@@ -0,0 +1,201 @@
+package edu.biu.protocols.yao.offlineOnline.subroutines;
+
+import java.io.IOException;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * Builds a list of items in parallel and sends them, in order, over several channels. <p>
+ *
+ * The items are not assigned to the building threads in advance. Each building thread takes the next item that was not built yet,
+ * so a slow item does not hold back the items after it. <p>
+ * The sending is done by separate threads, because the receiver expects each channel to carry a fixed range of items, in order.
+ * Each sending thread sends the items of its range as soon as they are built. <p>
+ * If an item cannot be built, the sending thread of its range stops, and the failure is thrown once all the threads are done.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class ParallelBuildAndSend {
+
+	/**
+	 * Builds a single item.
+	 */
+	public interface Builder {
+		/**
+		 * @param item The index of the item to build.
+		 * @param thread The index of the building thread.
+		 */
+		void build(int item, int thread);
+	}
+
+	/**
+	 * Sends a single item that was built.
+	 */
+	public interface Sender {
+		/**
+		 * @param item The index of the item to send.
+		 * @param thread The index of the sending thread, which is also the index of its channel.
+		 */
+		void send(int item, int thread) throws IOException;
+	}
+
+	private final int numItems;
+	private final Builder builder;
+	private final Sender sender;
+	private final AtomicInteger nextItem;		//The next item that should be built by the building threads.
+	private final CountDownLatch[] built;		//Opened when the item in the same index is built, or could not be built.
+	private final boolean[] succeeded;			//True for each item that was built. Written before its latch is opened.
+
+	private ParallelBuildAndSend(int numItems, Builder builder, Sender sender) {
+		this.numItems = numItems;
+		this.builder = builder;
+		this.sender = sender;
+		nextItem = new AtomicInteger(0);
+		built = new CountDownLatch[numItems];
+		for (int j = 0; j < numItems; j++) {
+			built[j] = new CountDownLatch(1);
+		}
+		succeeded = new boolean[numItems];
+	}
+
+	/**
+	 * Builds and sends all the items using the given number of building threads and the same number of sending threads.
+	 * The items are split between the sending threads in equal ranges, and the last thread gets also the remaining items.
+	 * A RuntimeException or an Error thrown by the sender is thrown to the caller as is.
+	 * @param numItems The number of items.
+	 * @param numThreads The number of threads of each kind. Should be positive.
+	 * @param builder Builds each item.
+	 * @param sender Sends each item after it was built.
+	 * @throws IOException In case one of the items could not be sent.
+	 * @throws IllegalStateException In case one of the items could not be built.
+	 */
+	public static void run(int numItems, int numThreads, Builder builder, Sender sender) throws IOException {
+		new ParallelBuildAndSend(numItems, builder, sender).run(numThreads);
+	}
+
+	private void run(int numThreads) throws IOException {
+		BuildThread[] builders = new BuildThread[numThreads];
+		SendThread[] senders = new SendThread[numThreads];
+		//Calculate the number of items in each channel and the remaining.
+		int numItemsPerThread = numItems / numThreads;
+		int remain = numItems % numThreads;
+		//Create the threads. The last channel gets also the remaining items.
+		for (int j = 0; j < numThreads; j++) {
+			builders[j] = new BuildThread(j);
+			if ((j != numThreads-1) || (remain == 0)){
+				senders[j] = new SendThread(j, j*numItemsPerThread, (j+1)*numItemsPerThread);
+			} else{
+				senders[j] = new SendThread(j, j*numItemsPerThread, (j+1)*numItemsPerThread + remain);
+			}
+			//Start all threads.
+			builders[j].start();
+			senders[j].start();
+		}
+		//Wait until all threads finish their job.
+		for (int j = 0; j < numThreads; j++) {
+			try {
+				builders[j].join();
+				senders[j].join();
+			} catch (InterruptedException e) {
+				throw new IllegalStateException();
+			}
+		}
+		//Propagate a failure of one of the threads.
+		for (int j = 0; j < numThreads; j++) {
+			if (builders[j].failure instanceof Error) {
+				throw (Error) builders[j].failure;
+			}
+			if (builders[j].failure != null) {
+				throw new IllegalStateException(builders[j].failure);
+			}
+			if (senders[j].failure instanceof IOException) {
+				throw (IOException) senders[j].failure;
+			}
+			if (senders[j].failure instanceof RuntimeException) {
+				throw (RuntimeException) senders[j].failure;
+			}
+			if (senders[j].failure != null) {
+				throw (Error) senders[j].failure;
+			}
+		}
+	}
+
+	/**
+	 * Inner thread class that builds items until there are no items left to build.
+	 */
+	private class BuildThread extends Thread{
+
+		private int i;					// The index of the thread.
+		private Throwable failure;		// The exception that stopped the thread, if any.
+
+		BuildThread(int i){
+			this.i = i;
+		}
+
+		/**
+		 * Takes the next item that was not built yet and builds it, until all the items are taken.
+		 */
+		public void run(){
+			int j;
+			while ((j = nextItem.getAndIncrement()) < numItems) {
+				try {
+					builder.build(j, i);
+					succeeded[j] = true;
+				} catch (RuntimeException e) {
+					failure = e;
+				} catch (Error e) {
+					failure = e;
+					//Stop building after an error. The items that were not taken yet are released as not built, so that no
+					//sender waits for them.
+					int k;
+					while ((k = nextItem.getAndIncrement()) < numItems) {
+						built[k].countDown();
+					}
+					return;
+				} finally {
+					//Release the sender that waits for this item, also when the build failed (the sender then stops).
+					built[j].countDown();
+				}
+			}
+		}
+	}
+
+	/**
+	 * Inner thread class that sends the items of a fixed range over one channel, in order.
+	 */
+	private class SendThread extends Thread{
+
+		private int from;				// The first item that should be sent.
+		private int to;					// The item after the last item that should be sent.
+		private int i;					// The index of the thread, which is also the index of its channel.
+		private Throwable failure;		// The exception that stopped the thread, if any.
+
+		SendThread(int i, int from, int to){
+			this.i = i;
+			this.from = from;
+			this.to = to;
+		}
+
+		/**
+		 * Waits for each item in the range to be built and sends it.
+		 */
+		public void run(){
+			try {
+				for (int j = from; j < to; j++) {
+					built[j].await();
+					if (!succeeded[j]) {
+						//The item could not be built, the building thread reports the reason.
+						return;
+					}
+					sender.send(j, i);
+				}
+			} catch (InterruptedException e) {
+				failure = new IOException(e);
+			} catch (Throwable e) {
+				//Any failure is recorded, so that it is thrown to the caller instead of ending the thread silently.
+				failure = e;
+			}
+		}
+	}
+}
@@ -16,6 +16,7 @@ import edu.biu.protocols.yao.common.CircuitUtils;
 import edu.biu.protocols.yao.common.Preconditions;
 import edu.biu.scapi.circuits.circuit.BooleanCircuit;
 import edu.biu.scapi.circuits.circuit.Wire;
+import edu.biu.scapi.circuits.fastGarbledCircuit.GarbledLabelsUtil;
 import edu.biu.scapi.comm.ProtocolInput;
 
 /**
@@ -66,6 +67,17 @@ public class CircuitInput implements ProtocolInput, Serializable {
 		return new CircuitInput(inputArray, wireLabels);
 	}
 	
+	/**
+	 * Alternative constructor. <P>
+	 * It creates new CircuitInput object from packed input bits (eight bits in each byte) and wire indices [0, ..., numBits].
+	 * @param packedBits The packed input bits, as returned from {@link #asPackedBits()}.
+	 * @param numBits The number of input bits.
+	 * @return the created CircuitInput object.
+	 */
+	public static CircuitInput fromPackedBits(byte[] packedBits, int numBits) {
+		return fromByteArray(GarbledLabelsUtil.unpackBits(packedBits, numBits));
+	}
+	
 	/**
 	 * Alternative constructor. <P>
 	 * It creates new CircuitInput object and read the input from the given file.
@@ -186,6 +198,23 @@ public class CircuitInput implements ProtocolInput, Serializable {
 		return input;
 	}
 	
+	/**
+	 * Returns the inputs packed, eight bits in each byte. Bit i is bit (i % 8) of byte (i / 8).
+	 */
+	public byte[] asPackedBits() {
+		return GarbledLabelsUtil.packBits(input);
+	}
+	
+	/**
+	 * Returns the label of each input wire that matches its input bit.
+	 * @param allLabels Two labels for each wire, the label of 0 followed by the label of 1.
+	 * @param firstWire The index (in allLabels) of the wire of the first input bit.
+	 * @return the selected labels, one after the other.
+	 */
+	public byte[] selectLabels(byte[] allLabels, int firstWire) {
+		return GarbledLabelsUtil.selectLabels(allLabels, firstWire, input);
+	}
+	
 	/**
 	 * Returns the xor of the inputs in the two given CircuitInputs objects.
 	 * @param x1 The first input to xor with the other.
@@ -0,0 +1,89 @@
+package edu.biu.protocols.yao.primitives;
+
+/**
+ * Native operations on vectors of keys. <P>
+ * 
+ * A key vector is a byte array that holds keys of the same length one after the other, for example all the input keys of 
+ * a bundle. Each operation goes over the whole vector in a single native call that works directly on the java arrays, 
+ * without copying them. The output array may be one of the input arrays, in which case the operation is done in place. <P>
+ * 
+ * The select and equal operations take the same time regardless of the selection bits and the content of the keys.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public final class KeyVectorOps {
+	
+	private static native void xor(byte[] a, byte[] b, byte[] output, int size);
+	private static native void mask(byte[] keys, byte[] mask, byte[] output, int numKeys, int keySize);
+	private static native void select(byte[] keys0, byte[] keys1, byte[] bits, byte[] output, int numKeys, int keySize);
+	private static native boolean equal(byte[] a, byte[] b, int size);
+	
+	private KeyVectorOps() {}
+	
+	/**
+	 * Puts a XOR b in output.
+	 * @param a The first vector.
+	 * @param b The second vector. Should be at least as long as a.
+	 * @param output The result. Should be at least as long as a. May be a or b.
+	 * @return The output array.
+	 */
+	public static byte[] xorKeys(byte[] a, byte[] b, byte[] output) {
+		if (b.length < a.length || output.length < a.length) {
+			throw new IllegalArgumentException("the vectors should have the same length");
+		}
+		xor(a, b, output, a.length);
+		return output;
+	}
+	
+	/**
+	 * Xors each key in the given vector with the mask. The length of each key is the length of the mask.
+	 * @param keys The keys to mask.
+	 * @param mask The mask to xor each key with.
+	 * @param output The masked keys. Should be at least as long as keys. May be keys.
+	 * @return The output array.
+	 */
+	public static byte[] maskKeys(byte[] keys, byte[] mask, byte[] output) {
+		if (mask.length == 0 || keys.length % mask.length != 0 || output.length < keys.length) {
+			throw new IllegalArgumentException("the keys vector should contain whole keys of the mask size");
+		}
+		mask(keys, mask, output, keys.length / mask.length, mask.length);
+		return output;
+	}
+	
+	/**
+	 * Selects for each index i the key i of keys1 if bits[i] is not zero and the key i of keys0 otherwise.
+	 * @param keys0 The keys to choose when the bit is zero.
+	 * @param keys1 The keys to choose when the bit is one. Should have the same length as keys0.
+	 * @param bits One byte for each key.
+	 * @param output The selected keys. Should be at least as long as keys0. May be keys0 or keys1.
+	 * @return The output array.
+	 */
+	public static byte[] selectKeys(byte[] keys0, byte[] keys1, byte[] bits, byte[] output) {
+		if (bits.length == 0) {
+			return output;
+		}
+		int keySize = keys0.length / bits.length;
+		if (keys1.length != keys0.length || keys0.length != keySize * bits.length || output.length < keys0.length) {
+			throw new IllegalArgumentException("the keys vectors should contain one key for each selection bit");
+		}
+		select(keys0, keys1, bits, output, bits.length, keySize);
+		return output;
+	}
+	
+	/**
+	 * Checks in constant time if the given vectors are equal.
+	 * @return true if a and b have the same length and content; false, otherwise.
+	 */
+	public static boolean equalKeys(byte[] a, byte[] b) {
+		if (a.length != b.length) {
+			return false;
+		}
+		return equal(a, b, a.length);
+	}
+	
+	static {	 
+		 //load the MaliciousYaoUtil jni dll that performs the native functions.
+		 System.loadLibrary("MaliciousYaoUtil");
+	}
+}
@@ -0,0 +1,118 @@
+package edu.biu.SCProtocols.NativeMaliciousYao;
+
+import edu.biu.scapi.comm.Protocol;
+import edu.biu.scapi.comm.ProtocolInput;
+import edu.biu.scapi.comm.ProtocolOutput;
+import edu.biu.SCProtocols.NativeSemiHonestYao.YaoProtocolOutput;
+
+/**
+ * This is a wrapper to a long running native malicious yao party, that serves many executions. <p>
+ * 
+ * Unlike {@link MaliciousYaoOfflineParty} and {@link MaliciousYaoOnlineParty}, that prepare a fixed number of buckets 
+ * in advance, the service keeps a pool of buckets that is refilled by running the offline protocol in batches of n1 
+ * buckets. Each call to {@link #run()} takes the next bucket from the pool and runs the online protocol on it. <p>
+ * 
+ * When the config file contains "service_offline_parties_file" (in the same section as "parties_file"), the offline 
+ * batches run in the background on a separate communication, and a new batch is started when the number of buckets in 
+ * the pool drops to "service_low_watermark" (n1/4 by default). Otherwise, a batch is generated when an execution finds 
+ * the pool empty. <p>
+ * 
+ * Both parties should be created with the same parameters and run the same number of executions.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class MaliciousYaoServiceParty implements Protocol {
+
+	//Indices of the values returned by getMetrics.
+	public static final int POOL_DEPTH = 0;				//Number of buckets that are ready to be used.
+	public static final int OFFLINE_BATCHES = 1;		//Number of offline batches that were generated.
+	public static final int EXECUTIONS = 2;				//Number of online executions that were served.
+	public static final int CIRCUITS_GARBLED = 3;		//Number of circuits garbled by all the offline batches.
+	public static final int LAST_LATENCY_MICROS = 4;	//Time of the last execution, including the wait for a bucket.
+	public static final int TOTAL_LATENCY_MICROS = 5;	//Sum of the times of all the executions.
+	public static final int MAX_LATENCY_MICROS = 6;		//Maximal time of a single execution.
+	public static final int OFFLINE_MICROS = 7;			//Sum of the times of all the offline batches.
+	
+	private long nativeService;	//A pointer to the native implementation
+	private YaoProtocolOutput output;
+	
+	//JNI functions that call the native implementation
+	private native long createService(int id, String configFileName);
+	private native byte[] execute(long nativeService);
+	private native long[] getMetrics(long nativeService);
+	private native void deleteService(long nativeService);
+	
+	@Override
+	public void start(ProtocolInput protocolInput) {
+		if (!(protocolInput instanceof MaliciousYaoProtocolInput)){
+			throw new IllegalArgumentException("The givan input should be an instance of MaliciousYaoProtocolInput");
+		}
+		
+		MaliciousYaoProtocolInput input = (MaliciousYaoProtocolInput) protocolInput;
+		nativeService = createService(input.getID(), input.getConfigFileName());
+	}
+
+	/**
+	 * Runs one execution of the online protocol on the next bucket of the pool.
+	 * @throws IllegalStateException In case the execution, or an offline batch that was run before it, failed.
+	 */
+	@Override
+	public void run() {
+		output = new YaoProtocolOutput(execute(nativeService));
+	}
+
+	@Override
+	public ProtocolOutput getOutput() {
+		return output;
+	}
+	
+	/**
+	 * Returns the current metrics of the service, indexed by the constants of this class.
+	 */
+	public long[] getMetrics() {
+		return getMetrics(nativeService);
+	}
+	
+	/**
+	 * Returns the average number of garbled circuits per execution so far.
+	 */
+	public double getCircuitsPerExecution() {
+		long[] metrics = getMetrics();
+		return (metrics[EXECUTIONS] == 0) ? 0 : (double) metrics[CIRCUITS_GARBLED] / metrics[EXECUTIONS];
+	}
+
+	//loads the dll
+	static {
+		System.loadLibrary("LibscapiJavaInterface");
+	}
+	
+	/**
+	 * deletes the related service object
+	 */
+	protected void finalize() throws Throwable {
+
+		// delete the dynamic allocation of the service.
+		deleteService(nativeService);
+
+		super.finalize();
+	}
+	
+	public static void main(String[] args) {
+		int id = new Integer(args[0]); 
+		String configFile = args[1];
+		int executions = new Integer(args[2]);
+		
+		MaliciousYaoServiceParty party = new MaliciousYaoServiceParty();
+		party.start(new MaliciousYaoProtocolInput(id, configFile));
+		for (int i = 0; i < executions; i++) {
+			party.run();
+		}
+		
+		long[] metrics = party.getMetrics();
+		System.out.println(metrics[EXECUTIONS] + " executions, " + metrics[OFFLINE_BATCHES] + " offline batches, " + 
+				metrics[POOL_DEPTH] + " buckets left in the pool.");
+		System.out.println("average latency " + (metrics[TOTAL_LATENCY_MICROS] / Math.max(1, metrics[EXECUTIONS])) + 
+				" micros, max latency " + metrics[MAX_LATENCY_MICROS] + " micros, " + party.getCircuitsPerExecution() + " circuits per execution.");
+	}
+}
@@ -5,6 +5,7 @@ import java.util.Date;
 
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
 import edu.biu.scapi.circuits.fastGarbledCircuit.FastGarbledBooleanCircuit;
+import edu.biu.scapi.circuits.fastGarbledCircuit.GarbledLabelsUtil;
 import edu.biu.scapi.comm.Channel;
 import edu.biu.scapi.exceptions.CheatAttemptException;
 import edu.biu.scapi.exceptions.InvalidDlogGroupException;
@@ -103,12 +104,8 @@ public class PartyOne {
 			e.printStackTrace();
 		}
   		
-  		byte[] p1Inputs = new byte[numberOfp1Inputs*SIZE_OF_BLOCK];
- 	    
   		//Create an array with the keys corresponding the given input.
-  		for (int i = 0; i < numberOfp1Inputs; i++) {
-  			System.arraycopy(allInputs, (2*i + ungarbledInput[i])*SIZE_OF_BLOCK, p1Inputs, i*SIZE_OF_BLOCK, SIZE_OF_BLOCK);
-  		}
+  		byte[] p1Inputs = GarbledLabelsUtil.selectLabels(allInputs, 0, GarbledLabelsUtil.packBits(ungarbledInput), numberOfp1Inputs);
  	   
   		//Send the keys to p2.
 		try {
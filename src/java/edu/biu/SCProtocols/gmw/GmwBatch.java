@@ -0,0 +1,195 @@
+package edu.biu.SCProtocols.gmw;
+
+import java.io.BufferedReader;
+import java.io.BufferedWriter;
+import java.io.FileReader;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.StreamTokenizer;
+
+/**
+ * This class prepares a batch execution of the GMW protocol, that evaluates the same circuit on many inputs at once. <p>
+ * 
+ * The circuit is replaced by a circuit that contains batchSize independent copies of it, and the inputs of all the executions 
+ * are put one after the other in a single input file. The gates of all the copies are interleaved, so each layer of the 
+ * batch circuit contains the same layer of all the copies. Since the native protocol opens all the AND gates of a layer 
+ * together, the batch takes the same number of communication rounds as a single execution, and the openings of all the 
+ * executions are sent in the same messages. <p>
+ * 
+ * Usage: each party calls {@link #createBatchCircuit} and {@link #createBatchInputs} (with its own input files), runs 
+ * {@link GmwParty} with the created files, and splits the output with {@link #splitOutput}.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class GmwBatch {
+	
+	/**
+	 * Writes a circuit that contains batchSize copies of the given circuit.
+	 * Wire w of copy k is wire w + k*numWires in the batch circuit, where numWires is the number of wires of the circuit. 
+	 * The inputs and outputs of each party are the inputs and outputs of all the copies, copy after copy.
+	 * @param circuitFileName The circuit to copy, in the format of the native GMW circuits.
+	 * @param batchSize The number of executions in the batch.
+	 * @param batchCircuitFileName The file to write the batch circuit to.
+	 * @throws IOException In case of a problem in reading or writing the files.
+	 */
+	public static void createBatchCircuit(String circuitFileName, int batchSize, String batchCircuitFileName) throws IOException {
+		if (batchSize < 1) {
+			throw new IllegalArgumentException("batch size should be at least 1");
+		}
+		
+		BufferedReader in = new BufferedReader(new FileReader(circuitFileName));
+		StreamTokenizer tokens = new StreamTokenizer(in);
+		tokens.resetSyntax();
+		tokens.wordChars('!', '~');
+		tokens.whitespaceChars(0, ' ');
+		
+		try {
+			int numGates = nextInt(tokens);
+			int numParties = nextInt(tokens);
+			int maxWire = -1;
+			
+			//Read the input wires and then the output wires of each party.
+			int[] inputParties = new int[numParties];
+			int[][] inputWires = new int[numParties][];
+			int[] outputParties = new int[numParties];
+			int[][] outputWires = new int[numParties][];
+			for (int p = 0; p < numParties; p++) {
+				inputParties[p] = nextInt(tokens);
+				inputWires[p] = nextInts(tokens, nextInt(tokens));
+				maxWire = Math.max(maxWire, max(inputWires[p]));
+			}
+			for (int p = 0; p < numParties; p++) {
+				outputParties[p] = nextInt(tokens);
+				outputWires[p] = nextInts(tokens, nextInt(tokens));
+				maxWire = Math.max(maxWire, max(outputWires[p]));
+			}
+			
+			//Read the gates: number of inputs, number of outputs, input wires, output wires and truth table.
+			int[][] gateWires = new int[numGates][];
+			int[] gateInputs = new int[numGates];
+			String[] truthTables = new String[numGates];
+			for (int g = 0; g < numGates; g++) {
+				gateInputs[g] = nextInt(tokens);
+				int numOutputs = nextInt(tokens);
+				gateWires[g] = nextInts(tokens, gateInputs[g] + numOutputs);
+				truthTables[g] = nextWord(tokens);
+				maxWire = Math.max(maxWire, max(gateWires[g]));
+			}
+			int numWires = maxWire + 1;
+			
+			BufferedWriter out = new BufferedWriter(new FileWriter(batchCircuitFileName));
+			try {
+				out.write((numGates * batchSize) + " " + numParties + "\n");
+				writeWires(out, inputParties, inputWires, batchSize, numWires);
+				writeWires(out, outputParties, outputWires, batchSize, numWires);
+				
+				//Write each gate for all the copies, so that the copies of a gate are in the same layer.
+				StringBuilder line = new StringBuilder();
+				for (int g = 0; g < numGates; g++) {
+					for (int k = 0; k < batchSize; k++) {
+						line.setLength(0);
+						line.append(gateInputs[g]).append(' ').append(gateWires[g].length - gateInputs[g]);
+						for (int w : gateWires[g]) {
+							line.append(' ').append(w + k * numWires);
+						}
+						line.append(' ').append(truthTables[g]).append('\n');
+						out.write(line.toString());
+					}
+				}
+			} finally {
+				out.close();
+			}
+		} finally {
+			in.close();
+		}
+	}
+	
+	/**
+	 * Writes the inputs of all the executions of a party, one after the other, to a single input file.
+	 * @param inputFileNames The input file of each execution, in the order of the executions.
+	 * @param batchInputFileName The file to write the inputs to.
+	 * @throws IOException In case of a problem in reading or writing the files.
+	 */
+	public static void createBatchInputs(String[] inputFileNames, String batchInputFileName) throws IOException {
+		BufferedWriter out = new BufferedWriter(new FileWriter(batchInputFileName));
+		try {
+			for (String inputFileName : inputFileNames) {
+				BufferedReader in = new BufferedReader(new FileReader(inputFileName));
+				try {
+					String line;
+					while ((line = in.readLine()) != null) {
+						if (!line.trim().isEmpty()) {
+							out.write(line.trim() + "\n");
+						}
+					}
+				} finally {
+					in.close();
+				}
+			}
+		} finally {
+			out.close();
+		}
+	}
+	
+	/**
+	 * Splits the output of a batch execution to the outputs of the executions.
+	 * @param output The output of the batch circuit.
+	 * @param batchSize The number of executions in the batch.
+	 * @return The output of each execution.
+	 */
+	public static byte[][] splitOutput(byte[] output, int batchSize) {
+		if (output.length % batchSize != 0) {
+			throw new IllegalArgumentException("the output does not belong to a batch of the given size");
+		}
+		int size = output.length / batchSize;
+		byte[][] outputs = new byte[batchSize][size];
+		for (int k = 0; k < batchSize; k++) {
+			System.arraycopy(output, k * size, outputs[k], 0, size);
+		}
+		return outputs;
+	}
+	
+	private static void writeWires(BufferedWriter out, int[] parties, int[][] wires, int batchSize, int numWires) throws IOException {
+		for (int p = 0; p < parties.length; p++) {
+			out.write(parties[p] + " " + (wires[p].length * batchSize) + "\n");
+			for (int k = 0; k < batchSize; k++) {
+				for (int w : wires[p]) {
+					out.write((w + k * numWires) + "\n");
+				}
+			}
+			out.write("\n");
+		}
+	}
+	
+	private static String nextWord(StreamTokenizer tokens) throws IOException {
+		if (tokens.nextToken() != StreamTokenizer.TT_WORD) {
+			throw new IOException("unexpected end of the circuit file");
+		}
+		return tokens.sval;
+	}
+	
+	private static int nextInt(StreamTokenizer tokens) throws IOException {
+		try {
+			return Integer.parseInt(nextWord(tokens));
+		} catch (NumberFormatException e) {
+			throw new IOException("bad number in the circuit file: " + tokens.sval);
+		}
+	}
+	
+	private static int[] nextInts(StreamTokenizer tokens, int n) throws IOException {
+		int[] values = new int[n];
+		for (int i = 0; i < n; i++) {
+			values[i] = nextInt(tokens);
+		}
+		return values;
+	}
+	
+	private static int max(int[] values) {
+		int max = -1;
+		for (int value : values) {
+			max = Math.max(max, value);
+		}
+		return max;
+	}
+}
@@ -9,6 +9,12 @@ import edu.biu.scapi.comm.ProtocolOutput;
  * A general explanation of the GMW protocol can be found at <a href ="http://crypto.biu.ac.il/sites/default/files/Winter%20School%2015%20-%20GMW%20and%20OT%20extension.pdf">http://crypto.biu.ac.il/sites/default/files/Winter%20School%2015%20-%20GMW%20and%20OT%20extension.pdf</a>.
  * This implementation is more efficient since we use Beaver's multiplication triples instead of 1 out of 4 OT. <P>
  * 
+ * The triples are generated in the offline phase, which does not depend on the inputs. The offline phase can be run 
+ * in advance by calling {@link #runOffline()}, and after {@link #setPreprocessAhead(int)}, the offline phase of the next 
+ * execution runs in the background after each of the given executions but the last. In both cases {@link #run()} only runs 
+ * the online phase.
+ * Both parties should use the same calls, since the offline phase is interactive. <P>
+ * 
  * The native implementation can be found at <a href ="https://github.com/cryptobiu/libscapi/tree/dev/protocols/GMW">https://github.com/cryptobiu/libscapi/tree/dev/protocols/GMW</a>.<p>
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
@@ -23,6 +29,9 @@ public class GmwParty implements Protocol{
 	private native long createGMWParty(int id, String circuitFileName, String partiesFileName, 
 			String inputsFileName, int numOfThreads);
 	private native byte[] runProtocol(long nativeParty);
+	private native void runOffline(long nativeParty);
+	private native void setPreprocessAhead(long nativeParty, int executions);
+	private native boolean isOfflineReady(long nativeParty);
 	private native void deleteGMW(long nativeParty);
 	
 	@Override
@@ -37,9 +46,37 @@ public class GmwParty implements Protocol{
 									 input.getInputsFileName(), input.getNumOfThreads());
 	}
 
+	/**
+	 * Runs the offline phase of the next execution, which generates the multiplication triples.
+	 * Does nothing if the triples of the next execution were already generated.
+	 */
+	public void runOffline() {
+		runOffline(nativeParty);
+	}
+	
+	/**
+	 * Runs the offline phase of the next execution in the background after each of the next executions, except the last one, 
+	 * so that no offline phase is left running after the last execution.
+	 * A failure of a background offline phase is thrown by the next call to {@link #run()} or {@link #runOffline()}.
+	 * @param executions The number of the next executions. 0 stops the background offline phases.
+	 */
+	public void setPreprocessAhead(int executions) {
+		if (executions < 0) {
+			throw new IllegalArgumentException("the number of executions should not be negative");
+		}
+		setPreprocessAhead(nativeParty, executions);
+	}
+	
+	/**
+	 * Returns true if the multiplication triples of the next execution are ready, so that {@link #run()} runs only the online phase.
+	 */
+	public boolean isOfflineReady() {
+		return isOfflineReady(nativeParty);
+	}
+	
 	@Override
 	public void run() {
-		//Executes the native protocol
+		//Executes the native protocol (the offline phase is skipped if it was already done)
 		byte[] nativeOutput = runProtocol(nativeParty);
 		output = new GmwProtocolOutput(nativeOutput);
 	}
@@ -112,6 +112,13 @@ public class AESFixedKeyMultiKeyEncryption implements MultiKeyEncryptionScheme {
 		this.isFreeXor = isFreeXor;
 	}
 	
+	/**
+	 * Returns true if the keys are processed in the free xor way (see setFreeXor).
+	 */
+	public boolean isFreeXor(){
+		return isFreeXor;
+	}
+	
 	@Override
 	public byte[] encrypt(byte[] plaintext) throws KeyNotSetException, TweakNotSetException, IllegalBlockSizeException {
 		return processRow(plaintext);
@@ -0,0 +1,162 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.circuits.fastGarbledCircuit;
+
+/**
+ * Conversions between the bits of a circuit's inputs and outputs and the garbled labels of its wires. <p>
+ * 
+ * The labels are kept as in {@link FastCircuitCreationValues}: two labels for each wire, the label of 0 followed by the label of 1.
+ * The garbler uses {@link #selectLabels(byte[], int, byte[], int)} to get the labels of its input, and the evaluator uses 
+ * {@link #bitsFromLabels(byte[], byte[])} to translate the garbled output. <p>
+ * 
+ * The bits can be given packed, eight bits in each byte, where bit i is bit (i % 8) of byte (i / 8). 
+ * For large inputs the conversions are done in the native library of the garbled circuits, in one call for all the wires. 
+ * If the library can not be loaded, the same conversions are done in java.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public final class GarbledLabelsUtil {
+	
+	private static final int LABEL_SIZE = 16;
+	
+	//Below this number of bits the java loop is faster than crossing the jni.
+	private static final int MIN_NATIVE_BITS = 256;
+	
+	private static final boolean isLoaded = ScGarbledCircuitLibrary.isLoaded();
+	
+	private GarbledLabelsUtil() {}
+	
+	/**
+	 * Returns true if the conversions are done in the native library.
+	 */
+	public static boolean isNativeAvailable() {
+		return isLoaded;
+	}
+	
+	/**
+	 * Packs the given bits, one bit in each byte, into an array of eight bits in each byte.
+	 * @param bits The bits to pack. Each byte should be 0 or 1.
+	 * @return the packed bits.
+	 */
+	public static byte[] packBits(byte[] bits) {
+		if (isLoaded && bits.length >= MIN_NATIVE_BITS) {
+			return nativePackBits(bits);
+		}
+		
+		byte[] packed = new byte[(bits.length + 7) / 8];
+		for (int i = 0; i < bits.length; i++) {
+			packed[i / 8] |= (bits[i] & 1) << (i % 8);
+		}
+		return packed;
+	}
+	
+	/**
+	 * Unpacks the given number of bits into an array of one bit in each byte.
+	 * @param packedBits The packed bits.
+	 * @param numBits The number of bits to unpack.
+	 * @return the unpacked bits.
+	 */
+	public static byte[] unpackBits(byte[] packedBits, int numBits) {
+		checkPackedSize(packedBits, numBits);
+		if (isLoaded && numBits >= MIN_NATIVE_BITS) {
+			return nativeUnpackBits(packedBits, numBits);
+		}
+		
+		byte[] bits = new byte[numBits];
+		for (int i = 0; i < numBits; i++) {
+			bits[i] = (byte) ((packedBits[i / 8] >> (i % 8)) & 1);
+		}
+		return bits;
+	}
+	
+	/**
+	 * Selects the label of each wire according to its bit.
+	 * @param allLabels Two labels for each wire, as returned from {@link FastCircuitCreationValues#getAllInputWireValues()}.
+	 * @param firstWire The index of the wire of the first bit. For example, the inputs of the second party start after the inputs 
+	 * 		  of the first party.
+	 * @param packedBits The packed bits of the wires.
+	 * @param numBits The number of wires to select.
+	 * @return the selected labels, one after the other.
+	 */
+	public static byte[] selectLabels(byte[] allLabels, int firstWire, byte[] packedBits, int numBits) {
+		checkPackedSize(packedBits, numBits);
+		if (firstWire < 0 || allLabels.length < (firstWire + numBits) * 2 * LABEL_SIZE) {
+			throw new IllegalArgumentException("there are not enough labels for the given wires");
+		}
+		if (isLoaded && numBits >= MIN_NATIVE_BITS) {
+			return nativeSelectLabels(allLabels, firstWire, packedBits, numBits);
+		}
+		
+		byte[] selected = new byte[numBits * LABEL_SIZE];
+		for (int i = 0; i < numBits; i++) {
+			int bit = (packedBits[i / 8] >> (i % 8)) & 1;
+			System.arraycopy(allLabels, (2 * (firstWire + i) + bit) * LABEL_SIZE, selected, i * LABEL_SIZE, LABEL_SIZE);
+		}
+		return selected;
+	}
+	
+	/**
+	 * Selects the label of each wire according to its bit, where the bits are given one in each byte.
+	 * @see #selectLabels(byte[], int, byte[], int)
+	 */
+	public static byte[] selectLabels(byte[] allLabels, int firstWire, byte[] bits) {
+		return selectLabels(allLabels, firstWire, packBits(bits), bits.length);
+	}
+	
+	/**
+	 * Translates the given output labels to their bits. <p>
+	 * The bit of each label is its signal bit (the lsb of its first byte) xored with the signal bit that the translation table holds,
+	 * which is the translation done by {@link ScNativeGarbledBooleanCircuit#translate(byte[])}.
+	 * @param outputLabels One label for each output wire.
+	 * @param translationTable The translation table of the circuit.
+	 * @return the output bits, one in each byte.
+	 */
+	public static byte[] bitsFromLabels(byte[] outputLabels, byte[] translationTable) {
+		if (outputLabels.length != translationTable.length * LABEL_SIZE) {
+			throw new IllegalArgumentException("the number of labels does not match the translation table");
+		}
+		if (isLoaded && translationTable.length >= MIN_NATIVE_BITS) {
+			return nativeBitsFromLabels(outputLabels, translationTable);
+		}
+		
+		byte[] bits = new byte[translationTable.length];
+		for (int i = 0; i < bits.length; i++) {
+			bits[i] = (byte) ((outputLabels[i * LABEL_SIZE] ^ translationTable[i]) & 1);
+		}
+		return bits;
+	}
+	
+	private static void checkPackedSize(byte[] packedBits, int numBits) {
+		if (numBits < 0 || packedBits.length < (numBits + 7) / 8) {
+			throw new IllegalArgumentException("the packed array does not contain the given number of bits");
+		}
+	}
+	
+	private static native byte[] nativePackBits(byte[] bits);
+	private static native byte[] nativeUnpackBits(byte[] packedBits, int numBits);
+	private static native byte[] nativeSelectLabels(byte[] allLabels, int firstWire, byte[] packedBits, int numBits);
+	private static native byte[] nativeBitsFromLabels(byte[] outputLabels, byte[] translationTable);
+}
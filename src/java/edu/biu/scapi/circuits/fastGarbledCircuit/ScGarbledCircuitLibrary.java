@@ -0,0 +1,61 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.circuits.fastGarbledCircuit;
+
+/**
+ * Loads the native library of the garbled circuits, ScGarbledCircuitJavaInterface, for the classes that have a java fallback. <p>
+ * 
+ * The library is loaded once, when this class is initialized. The classes that can work without it ({@link GarbledLabelsUtil} and 
+ * the native engine of the circuits in edu.biu.scapi.circuits.garbledCircuit) check {@link #isLoaded()} and use java code if it 
+ * returns false.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public final class ScGarbledCircuitLibrary {
+	
+	private static final boolean isLoaded;
+	
+	private ScGarbledCircuitLibrary() {}
+	
+	/**
+	 * Returns true if the native library was loaded.
+	 */
+	public static boolean isLoaded() {
+		return isLoaded;
+	}
+	
+	static {
+		boolean loaded;
+		try {
+			System.loadLibrary("ScGarbledCircuitJavaInterface");
+			loaded = true;
+		} catch (UnsatisfiedLinkError e) {
+			//The callers use their java implementation.
+			loaded = false;
+		}
+		isLoaded = loaded;
+	}
+}
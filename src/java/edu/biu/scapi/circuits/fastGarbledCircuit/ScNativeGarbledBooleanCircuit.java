@@ -53,7 +53,9 @@ public class ScNativeGarbledBooleanCircuit implements FastGarbledBooleanCircuit{
 		FREE_XOR_HALF_GATES,
 		FREE_XOR_ROW_REDUCTION,
 		FREE_XOR_STANDARD,
-		STANDARD
+		STANDARD,
+		//AND gates take 1.5 keys and 5 bits instead of the 2 keys of half gates (Rosulek and Roy, "Three Halves Make a Whole?")
+		FREE_XOR_THREE_HALVES
 	}
 	
 	
@@ -65,6 +67,8 @@ public class ScNativeGarbledBooleanCircuit implements FastGarbledBooleanCircuit{
 	private int[] numOfInputsForEachParty;
 	private byte[] garbledInputs;
 	private boolean isNonXorOutputsRequired;
+	private int numberOfGates;
+	private double computeManyThroughput; //The throughput of the last computeMany call, in gates x instances per second.
 	
 	private native long createGarbledcircuit(String fileName, int type, boolean isNonXorOutputsRequired);//Creates a garbled. It returns the pointer to that circuit saved in the dll memory 
 	private native int[] getOutputIndicesArray(long ptr);//Returns the output indices taken from the circuit file.
@@ -93,6 +97,8 @@ public class ScNativeGarbledBooleanCircuit implements FastGarbledBooleanCircuit{
 																			  //by the circuit. The input and the output keys are converted to the structures that are defined 
 																			  //in the SCAPI circuit
 	private native byte[] compute(long ptr, byte[] inputKeys);//Does the compute and returns the output keys that are the results.
+	private native byte[] computeMany(long ptr, byte[] inputKeySets, int numSets);//Computes the circuit on each of the given input sets and returns all output keys.
+	private native int getNumberOfGates(long ptr);
 	private native boolean verify(long ptr, byte[] bothInputKeys);//Does the compute and returns the output keys that are the results.
 	private native boolean internalVerify(long ptr, byte[] bothInputKeys, byte[] emptyBothOutputKeys);//does the verify without checking the translation table
 	private native byte[] translate(long ptr, byte[] ouyputKeys);
@@ -122,6 +128,7 @@ public class ScNativeGarbledBooleanCircuit implements FastGarbledBooleanCircuit{
 		inputsIndices = getInputIndicesArray(garbledCircuitPtr);//Returns the input indices taken from the circuit file..
 		
 		numOfInputsForEachParty = getNumOfInputsForEachParty(garbledCircuitPtr);
+		numberOfGates = getNumberOfGates(garbledCircuitPtr);
 		
 	}
 	
@@ -244,6 +251,40 @@ public class ScNativeGarbledBooleanCircuit implements FastGarbledBooleanCircuit{
 		
 	}
 	
+	/**
+	 * Computes the circuit on many sets of garbled inputs using the same garbled tables. <p>
+	 * All the sets are passed to the native code in a single call, that allocates the aligned memory once instead of crossing the jni
+	 * and allocating for each set. The three halves circuit computes each gate on four sets at a time, so the aes calls of the sets
+	 * are interleaved; the other types compute the sets one after the other. 
+	 * This is useful when the same garbled circuit is evaluated many times, for example in tests or with re-randomized inputs. <p>
+	 * The throughput of the call can be retrieved by {@link #getComputeManyThroughput()}.
+	 * @param garbledInputSets The garbled inputs of all the sets, one set after the other. Each set is given as in {@link #setInputs(byte[])}.
+	 * @return the garbled outputs of all the sets, one after the other, in the order of the input sets. 
+	 * Each output can be translated via the {@link #translate(byte[])} method.
+	 * @throws NotAllInputsSetException if the size of the given array is not a multiple of the size of one set of inputs.
+	 */
+	public byte[] computeMany(byte[] garbledInputSets) throws NotAllInputsSetException {
+		int setSize = inputsIndices.length * SCAPI_NATIVE_KEY_SIZE;
+		if (setSize == 0 || garbledInputSets.length % setSize != 0) {
+			throw new NotAllInputsSetException();
+		}
+		int numSets = garbledInputSets.length / setSize;
+		
+		long start = System.nanoTime();
+		byte[] result = computeMany(garbledCircuitPtr, garbledInputSets, numSets);
+		long time = System.nanoTime() - start;
+		
+		computeManyThroughput = (time == 0) ? 0 : ((double) numberOfGates * numSets) / (time / 1000000000.0);
+		return result;
+	}
+	
+	/**
+	 * Returns the throughput of the last call to {@link #computeMany(byte[])}, in gates x instances per second.
+	 */
+	public double getComputeManyThroughput() {
+		return computeManyThroughput;
+	}
+	
 	
 	
 	/**
@@ -50,6 +50,12 @@ interface CircuitTypeUtil {
 	 */
 	public GarbledGate[] createGates(Gate[] ungarbledGates, GarbledTablesHolder garbledTablesHolder);
 	
+	/**
+	 * Returns the native description of the gates that were created by {@link #createGates(Gate[], GarbledTablesHolder)}.
+	 * @return the native gates, or null if the gates are not supported by the native engine.
+	 */
+	public NativeGarbledGates getNativeGates();
+	
 	/**
 	 * This method generates both keys for each input wire. It then creates the garbled table according to these values.<p>
 	 * @param ungarbledCircuit The circuit that this {@code GarbledBooleanCircuit} is supposed to be a garbling of.
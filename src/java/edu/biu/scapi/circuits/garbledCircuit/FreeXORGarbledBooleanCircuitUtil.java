@@ -66,6 +66,9 @@ class FreeXORGarbledBooleanCircuitUtil implements CircuitTypeUtil {
 	private BitSet XORNOTTruthTable;	
 	private BitSet XORTruthTable;
 	
+	//Creates the garbled tables natively, if the gates of the circuit are supported by the native engine.
+	private NativeGarbledGates nativeGates;
+	
 	/**
 	 * Sets the given MultiKeyEncryptionScheme.
 	 * @param mes The concrete encryption object to use.
@@ -110,9 +113,15 @@ class FreeXORGarbledBooleanCircuitUtil implements CircuitTypeUtil {
 				gates[gate] = createStandardGate(ungarbledGates[gate], (BasicGarbledTablesHolder) garbledTablesHolder);
 			}
 		}
+		nativeGates = NativeGarbledGates.create(gates, ungarbledGates);
 		return gates;
 	}
 
+	@Override
+	public NativeGarbledGates getNativeGates(){
+		return nativeGates;
+	}
+
 	/**
 	 * We extract the creation of the standard garbled gate in order to be able to derive and create different standard gates.<p>
 	 * For example, in order to use the row reduction technique we derive this class and create RowReductionGate.
@@ -258,6 +267,12 @@ class FreeXORGarbledBooleanCircuitUtil implements CircuitTypeUtil {
 	 * @param allWireValues A map that contains both keys for each wire.
 	 */
 	protected void createGarbledTables(GarbledGate[] gates, BasicGarbledTablesHolder garbledTablesHolder, Gate[] ungarbledGates, Map<Integer, SecretKey[]> allWireValues) throws InvalidKeyException, IllegalBlockSizeException, PlaintextTooLongException {
+		
+		//The native engine creates the same tables as the gates, in one call.
+		if (nativeGates != null && nativeGates.describes(gates) && NativeGarbledGates.isEnabled()) {
+			nativeGates.createGarbledTables(garbledTablesHolder, allWireValues);
+			return;
+		}
 			
 		// Get the XOR and XORNOT truth table to be used to test against for equality.
 		BitSet XORTruthTable = getXORTruthTable();
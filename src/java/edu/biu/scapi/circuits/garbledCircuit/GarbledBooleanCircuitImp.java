@@ -52,6 +52,7 @@ public class GarbledBooleanCircuitImp extends GarbledBooleanCircuitAbs implement
 	private CircuitTypeUtil util; 		//Executes all functionalities that specific to the circuit type.
 	private PseudorandomGenerator prg;  //used in case of generating the keys using a seed.
 	private GarbledGate[] gates; 		// The garbled gates of this garbled circuit.
+	private NativeGarbledGates nativeGates; // Computes the gates natively. null if the gates are not supported by the native engine.
 	
   	/**
 	 * Default constructor. Sets the given boolean circuit and creates a Free XOR circuit using a AESFixedKeyMultiKeyEncryption.
@@ -123,6 +124,24 @@ public class GarbledBooleanCircuitImp extends GarbledBooleanCircuitAbs implement
 		
 		//Create the circuit's gates.
 		gates = util.createGates(bc.getGates(), garbledTablesHolder);
+		nativeGates = util.getNativeGates();
+	}
+	
+	/**
+	 * Enables or disables the native garbling engine of all the circuits in this package. <p>
+	 * The native engine is used for circuits that use AESFixedKeyMultiKeyEncryption and creates the same garbled tables and 
+	 * output keys as the java implementation. It is enabled by default when the native library is available, unless the 
+	 * system property "scapi.garbledCircuit.native" is set to false.
+	 */
+	public static void setNativeEngineEnabled(boolean enabled){
+		NativeGarbledGates.setEnabled(enabled);
+	}
+	
+	/**
+	 * Returns true if the native library of the garbling engine was loaded.
+	 */
+	public static boolean isNativeEngineAvailable(){
+		return NativeGarbledGates.isAvailable();
 	}
 	
 	@Override
@@ -162,21 +181,26 @@ public class GarbledBooleanCircuitImp extends GarbledBooleanCircuitAbs implement
 	  		}
   		}
   		
-  		/*
-  		 * We use the interface GarbledGate and thus this works for all implementing classes. The compute method of the 
-  		 * specific garbled gate being used will be called. This allows us to have circuits with different types of gates 
-  		 * {i.e a FreeXORGarbledBooleanCircuit contains both StandardGarbledGates and FreeXORGates) and this will work for all the gates.
-  		 */
-  		for (GarbledGate g : gates) {
-  			try {
-				g.compute(computedWires);
-			} catch (InvalidKeyException e) {
-				// Should not occur since the keys were generated through the encryption scheme that generates keys that match it.
-			} catch (IllegalBlockSizeException e) {
-				// Should not occur since the keys were generated through the encryption scheme that generates keys that match it.
-			} catch (CiphertextTooLongException e) {
-				// Should not occur since the keys were generated through the encryption scheme that generates keys that match it.
-			}
+  		if (nativeGates != null && nativeGates.isComputable() && NativeGarbledGates.isEnabled()){
+  			//The native engine computes all the gates in one call and puts their output values in computedWires.
+  			nativeGates.compute((BasicGarbledTablesHolder) garbledTablesHolder, computedWires);
+  		} else {
+	  		/*
+	  		 * We use the interface GarbledGate and thus this works for all implementing classes. The compute method of the 
+	  		 * specific garbled gate being used will be called. This allows us to have circuits with different types of gates 
+	  		 * {i.e a FreeXORGarbledBooleanCircuit contains both StandardGarbledGates and FreeXORGates) and this will work for all the gates.
+	  		 */
+	  		for (GarbledGate g : gates) {
+	  			try {
+					g.compute(computedWires);
+				} catch (InvalidKeyException e) {
+					// Should not occur since the keys were generated through the encryption scheme that generates keys that match it.
+				} catch (IllegalBlockSizeException e) {
+					// Should not occur since the keys were generated through the encryption scheme that generates keys that match it.
+				} catch (CiphertextTooLongException e) {
+					// Should not occur since the keys were generated through the encryption scheme that generates keys that match it.
+				}
+	  		}
   		}
   		
   		/*
@@ -0,0 +1,246 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.circuits.garbledCircuit;
+
+import java.util.BitSet;
+import java.util.Map;
+
+import javax.crypto.SecretKey;
+import javax.crypto.spec.SecretKeySpec;
+
+import edu.biu.scapi.circuits.circuit.Gate;
+import edu.biu.scapi.circuits.encryption.AESFixedKeyMultiKeyEncryption;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScGarbledCircuitLibrary;
+
+/**
+ * The native engine of the garbled circuits in this package. <p>
+ * 
+ * A circuit that uses {@link AESFixedKeyMultiKeyEncryption} spends most of its garbling and computing time in the encryption of the 
+ * garbled tables rows. Each row creates a few java objects and calls AES through jni. This class garbles or computes all the gates of 
+ * such a circuit in a single native call. The native engine creates exactly the same garbled tables and output keys as the java gates 
+ * ({@link StandardGarbledGate}, {@link StandardRowReductionGarbledGate}, {@link FreeXORGate} and {@link FreeXORNOTGate}), so circuits 
+ * garbled by one can be computed and verified by the other. <p>
+ * The keys are still sampled by the circuit utilities, so the translation tables and the garbling from a seed do not change. <p>
+ * 
+ * The engine is used automatically by {@link GarbledBooleanCircuitImp} when the native library is available and all the gates of the 
+ * circuit are supported. It can be disabled by setting the system property "scapi.garbledCircuit.native" to false, or by calling 
+ * {@link GarbledBooleanCircuitImp#setNativeEngineEnabled(boolean)}.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+final class NativeGarbledGates {
+	
+	//Each gate is described to the native code by GATE_DESC_SIZE ints: 
+	//kind, gate number, number of inputs, three input wires indices, output wire index and the truth table.
+	static final int GATE_DESC_SIZE = 8;
+	static final int FREE_XOR_GATE = 0;
+	static final int STANDARD_GATE = 1;
+	static final int ROW_REDUCTION_GATE = 2;
+	
+	//The tweak of AESFixedKeyMultiKeyEncryption contains the gate number and the signal bit of each input, four bytes each.
+	private static final int MAX_INPUTS = 3;
+	private static final int KEY_SIZE = 16;
+	
+	private static final boolean isLoaded = ScGarbledCircuitLibrary.isLoaded();
+	private static volatile boolean isEnabled = !"false".equals(System.getProperty("scapi.garbledCircuit.native"));
+	
+	private final GarbledGate[] gates;					//The gates that this object describes.
+	private final int[] gatesDesc;						//The native description of the gates.
+	private final int numWires;							//The number of wires of the circuit.
+	private final AESFixedKeyMultiKeyEncryption mes;	//The encryption scheme of the standard gates. null if there are no such gates.
+	private final boolean isComputable;					//False if there are row reduction gates, that are computed using a kdf.
+	
+	private NativeGarbledGates(GarbledGate[] gates, int[] gatesDesc, int numWires, AESFixedKeyMultiKeyEncryption mes, boolean isComputable) {
+		this.gates = gates;
+		this.gatesDesc = gatesDesc;
+		this.numWires = numWires;
+		this.mes = mes;
+		this.isComputable = isComputable;
+	}
+	
+	/**
+	 * Returns true if the native library was loaded.
+	 */
+	static boolean isAvailable() {
+		return isLoaded;
+	}
+	
+	/**
+	 * Returns true if the native engine should be used.
+	 */
+	static boolean isEnabled() {
+		return isLoaded && isEnabled;
+	}
+	
+	static void setEnabled(boolean enabled) {
+		isEnabled = enabled;
+	}
+	
+	/**
+	 * Creates the native description of the given gates.
+	 * @param gates The garbled gates of the circuit.
+	 * @param ungarbledGates The gates that the garbled gates are the garbling of, in the same order.
+	 * @return the created object, or null if the native library is not available or the circuit has a gate that the native engine does not support.
+	 */
+	static NativeGarbledGates create(GarbledGate[] gates, Gate[] ungarbledGates) {
+		if (!isLoaded) {
+			return null;
+		}
+		
+		int[] gatesDesc = new int[gates.length * GATE_DESC_SIZE];
+		int numWires = 0;
+		AESFixedKeyMultiKeyEncryption mes = null;
+		boolean isComputable = true;
+		
+		for (int i = 0; i < gates.length; i++) {
+			GarbledGate gate = gates[i];
+			int[] inputs = gate.getInputWireIndices();
+			int[] outputs = gate.getOutputWireIndices();
+			if (outputs.length != 1) {
+				return null;
+			}
+			int offset = i * GATE_DESC_SIZE;
+			
+			if (gate instanceof FreeXORGate) {
+				//Includes FreeXORNOTGate, that is computed the same way.
+				if (inputs.length != 2) {
+					return null;
+				}
+				gatesDesc[offset] = FREE_XOR_GATE;
+				
+			} else if (gate.getClass() == StandardGarbledGate.class || gate.getClass() == StandardRowReductionGarbledGate.class) {
+				StandardGarbledGate standardGate = (StandardGarbledGate) gate;
+				//All the standard gates should use the same AESFixedKeyMultiKeyEncryption object, since its free xor flag is read once for all gates.
+				if (standardGate.mes.getClass() != AESFixedKeyMultiKeyEncryption.class || (mes != null && standardGate.mes != mes) ||
+						inputs.length == 0 || inputs.length > MAX_INPUTS) {
+					return null;
+				}
+				mes = (AESFixedKeyMultiKeyEncryption) standardGate.mes;
+				
+				if (gate.getClass() == StandardRowReductionGarbledGate.class) {
+					gatesDesc[offset] = ROW_REDUCTION_GATE;
+					isComputable = false;
+				} else {
+					gatesDesc[offset] = STANDARD_GATE;
+				}
+				gatesDesc[offset + 1] = standardGate.gateNumber;
+				
+				BitSet truthTable = ungarbledGates[i].getTruthTable();
+				int rows = 1 << inputs.length;
+				for (int row = 0; row < rows; row++) {
+					if (truthTable.get(row)) {
+						gatesDesc[offset + 7] |= 1 << row;
+					}
+				}
+			} else {
+				return null;
+			}
+			
+			gatesDesc[offset + 2] = inputs.length;
+			for (int j = 0; j < inputs.length; j++) {
+				gatesDesc[offset + 3 + j] = inputs[j];
+				numWires = Math.max(numWires, inputs[j] + 1);
+			}
+			gatesDesc[offset + 6] = outputs[0];
+			numWires = Math.max(numWires, outputs[0] + 1);
+		}
+		
+		return new NativeGarbledGates(gates, gatesDesc, numWires, mes, isComputable);
+	}
+	
+	/**
+	 * Returns true if this object describes the given gates.
+	 */
+	boolean describes(GarbledGate[] gates) {
+		return this.gates == gates;
+	}
+	
+	/**
+	 * Returns true if the gates can be computed by the native engine.
+	 */
+	boolean isComputable() {
+		return isComputable;
+	}
+	
+	/**
+	 * Creates the garbled tables of the standard gates, the same as {@link StandardGarbledGate#createGarbledTable(Gate, Map)}.
+	 * @param garbledTablesHolder Holds the garbled tables.
+	 * @param allWireValues A map that contains both keys for each wire.
+	 */
+	void createGarbledTables(BasicGarbledTablesHolder garbledTablesHolder, Map<Integer, SecretKey[]> allWireValues) {
+		byte[] wireKeys = new byte[numWires * 2 * KEY_SIZE];
+		for (Map.Entry<Integer, SecretKey[]> entry : allWireValues.entrySet()) {
+			int wire = entry.getKey();
+			if (wire >= 0 && wire < numWires) {
+				System.arraycopy(entry.getValue()[0].getEncoded(), 0, wireKeys, wire * 2 * KEY_SIZE, KEY_SIZE);
+				System.arraycopy(entry.getValue()[1].getEncoded(), 0, wireKeys, wire * 2 * KEY_SIZE + KEY_SIZE, KEY_SIZE);
+			}
+		}
+		
+		//Allocate the tables in java, the native code fills them.
+		byte[][] garbledTables = garbledTablesHolder.toDoubleByteArray();
+		for (int offset = 0; offset < gatesDesc.length; offset += GATE_DESC_SIZE) {
+			if (gatesDesc[offset] != FREE_XOR_GATE) {
+				int numberOfRows = 1 << gatesDesc[offset + 2];
+				if (gatesDesc[offset] == ROW_REDUCTION_GATE) {
+					numberOfRows--;
+				}
+				garbledTables[gatesDesc[offset + 1]] = new byte[numberOfRows * KEY_SIZE];
+			}
+		}
+		
+		garbleTables(gatesDesc, wireKeys, garbledTables, isFreeXor());
+	}
+	
+	/**
+	 * Computes the gates, the same as calling {@link GarbledGate#compute(Map)} of each gate.
+	 * @param garbledTablesHolder Holds the garbled tables.
+	 * @param computedWires Contains the values of the input wires. The values of the output wires of all gates are added to it.
+	 */
+	void compute(BasicGarbledTablesHolder garbledTablesHolder, Map<Integer, GarbledWire> computedWires) {
+		byte[] wireValues = new byte[numWires * KEY_SIZE];
+		for (Map.Entry<Integer, GarbledWire> entry : computedWires.entrySet()) {
+			int wire = entry.getKey();
+			if (wire >= 0 && wire < numWires) {
+				System.arraycopy(entry.getValue().getValueAndSignalBit().getEncoded(), 0, wireValues, wire * KEY_SIZE, KEY_SIZE);
+			}
+		}
+		
+		computeGates(gatesDesc, wireValues, garbledTablesHolder.toDoubleByteArray(), isFreeXor());
+		
+		for (int offset = 0; offset < gatesDesc.length; offset += GATE_DESC_SIZE) {
+			int wire = gatesDesc[offset + 6];
+			computedWires.put(wire, new GarbledWire(new SecretKeySpec(wireValues, wire * KEY_SIZE, KEY_SIZE, "")));
+		}
+	}
+	
+	private boolean isFreeXor() {
+		return (mes != null) && mes.isFreeXor();
+	}
+	
+	private static native void garbleTables(int[] gatesDesc, byte[] wireKeys, byte[][] garbledTables, boolean isFreeXor);
+	private static native void computeGates(int[] gatesDesc, byte[] wireValues, byte[][] garbledTables, boolean isFreeXor);
+}
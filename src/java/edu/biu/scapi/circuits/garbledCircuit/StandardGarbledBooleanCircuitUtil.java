@@ -55,6 +55,9 @@ class StandardGarbledBooleanCircuitUtil implements CircuitTypeUtil{
 	
 	protected SecureRandom random;
 	
+	//Creates the garbled tables natively, if the gates of the circuit are supported by the native engine.
+	private NativeGarbledGates nativeGates;
+	
 	/**
 	 * Sets the given MultiKeyEncryptionScheme and random.
 	 * @param mes
@@ -84,9 +87,15 @@ class StandardGarbledBooleanCircuitUtil implements CircuitTypeUtil{
 		for (int gate = 0; gate < length; gate++) {
 			gates[gate] = createGate(ungarbledGates[gate], (BasicGarbledTablesHolder) garbledTablesHolder);
 		}
+		nativeGates = NativeGarbledGates.create(gates, ungarbledGates);
 		return gates;
 	}
 
+	@Override
+	public NativeGarbledGates getNativeGates(){
+		return nativeGates;
+	}
+
 	/**
 	 * Creates a StandardGarbledGate.
 	 * @param ungarbledGate to garble.
@@ -177,6 +186,12 @@ class StandardGarbledBooleanCircuitUtil implements CircuitTypeUtil{
 	 * @throws PlaintextTooLongException
 	 */
 	private void createGarbledTables(GarbledGate[] gates, BasicGarbledTablesHolder garbledTablesHolder, Gate[] ungarbledGates, Map<Integer, SecretKey[]> allWireValues) throws InvalidKeyException, IllegalBlockSizeException, PlaintextTooLongException {
+		//The native engine creates the same tables as the gates, in one call.
+		if (nativeGates != null && nativeGates.describes(gates) && NativeGarbledGates.isEnabled()) {
+			nativeGates.createGarbledTables(garbledTablesHolder, allWireValues);
+			return;
+		}
+		
 		int length = ungarbledGates.length;
 		//After we have all keys, create the garbledTables according to them.
 		for (int gate = 0; gate < length; gate++) {
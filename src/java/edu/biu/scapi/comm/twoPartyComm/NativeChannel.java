@@ -35,11 +35,83 @@ public class NativeChannel implements Channel{
 	
 	private boolean isClosed;
 	
+	private boolean isBatching;					// Indicates whether sent messages are held until flush.
+	
 	private native long initSendSocket(String address, int port);
 	private native void send(long sendSocketPtr, byte[] data);
 	private native byte[] receive(long receiveSocketPtr);
 	private native boolean closeSockets(long sendSocketPtr, long receiveSocketPtr);
 	private native void enableNagle(long sendSocketPtr, long receiveSocketPtr);
+	private native void setBatching(long sendSocketPtr, boolean batching, int threshold);
+	private native void flush(long sendSocketPtr);
+	private native void getSendCounters(long sendSocketPtr, long[] counters);
+	private native void resetSendCounters(long sendSocketPtr);
+	
+	/**
+	 * Holds the send counters of the channel.<p>
+	 * A round is a single write of pending messages to the socket. Without batching every message is a round of its own,
+	 * so comparing messages to rounds shows how well the messages were coalesced.
+	 */
+	public static class SendStatistics {
+		private long messages;
+		private long syscalls;
+		private long bytes;
+		private long rounds;
+		
+		SendStatistics(long[] counters){
+			messages = counters[0];
+			syscalls = counters[1];
+			bytes = counters[2];
+			rounds = counters[3];
+		}
+		
+		/**
+		 * Returns the number of messages that were sent.
+		 */
+		public long getMessages() {
+			return messages;
+		}
+		
+		/**
+		 * Returns the number of send system calls that were made on the socket.
+		 */
+		public long getSyscalls() {
+			return syscalls;
+		}
+		
+		/**
+		 * Returns the number of bytes written to the socket, including the size of each message.
+		 */
+		public long getBytes() {
+			return bytes;
+		}
+		
+		/**
+		 * Returns the number of rounds, meaning the number of times pending messages were written to the socket.
+		 */
+		public long getRounds() {
+			return rounds;
+		}
+		
+		/**
+		 * Returns the average number of messages in each round.
+		 */
+		public double getMessagesPerRound() {
+			return (rounds == 0) ? 0 : ((double) messages) / rounds;
+		}
+		
+		/**
+		 * Returns the average number of system calls in each round.
+		 */
+		public double getSyscallsPerRound() {
+			return (rounds == 0) ? 0 : ((double) syscalls) / rounds;
+		}
+		
+		@Override
+		public String toString() {
+			return "messages: " + messages + ", syscalls: " + syscalls + ", bytes: " + bytes + ", rounds: " + rounds;
+		}
+	}
 	
 	NativeChannel(SocketPartyData me, SocketPartyData other) {
 		this.me = me; 
@@ -64,6 +136,10 @@ public class NativeChannel implements Channel{
 
 	@Override
 	public Serializable receive() throws ClassNotFoundException, IOException {
+		//The other party may wait for the batched messages before it answers, so they should be sent before waiting.
+		if (isBatching){
+			flush(sendSocketPtr);
+		}
 		byte[] data =  receive(receiveSocketPtr);
 		ByteArrayInputStream iInput = new ByteArrayInputStream(data);
 		ObjectInputStream ois = new ObjectInputStream(iInput);
@@ -77,6 +153,63 @@ public class NativeChannel implements Channel{
 		
 	}
 
+	/**
+	 * Starts batching the sent messages.<p>
+	 * From this point, sent messages are held in native memory and written to the socket together when {@link #flush()} 
+	 * is called, when the pending messages reach the given threshold, or before the next receive. 
+	 * This way a protocol round that sends many small messages is sent in one segment.
+	 * @param threshold number of pending bytes that causes an automatic flush. Zero or negative value means the default threshold.
+	 */
+	public void startBatching(int threshold) {
+		setBatching(sendSocketPtr, true, threshold);
+		isBatching = true;
+	}
+	
+	/**
+	 * Starts batching the sent messages using the default threshold.
+	 */
+	public void startBatching() {
+		startBatching(0);
+	}
+	
+	/**
+	 * Sends all pending messages and stops batching. Each message will be sent immediately from now on.
+	 */
+	public void stopBatching() {
+		setBatching(sendSocketPtr, false, 0);
+		isBatching = false;
+	}
+	
+	/**
+	 * Returns true if the sent messages are currently batched.
+	 */
+	public boolean isBatching() {
+		return isBatching;
+	}
+	
+	/**
+	 * Sends all the pending messages in one write. Does nothing if there are no pending messages.
+	 */
+	public void flush() {
+		flush(sendSocketPtr);
+	}
+	
+	/**
+	 * Returns the send counters of this channel since it was created or since the last call to {@link #resetSendStatistics()}.
+	 */
+	public SendStatistics getSendStatistics() {
+		long[] counters = new long[4];
+		getSendCounters(sendSocketPtr, counters);
+		return new SendStatistics(counters);
+	}
+	
+	/**
+	 * Sets all send counters of this channel to zero.
+	 */
+	public void resetSendStatistics() {
+		resetSendCounters(sendSocketPtr);
+	}
+	
 	@Override
 	public boolean isClosed() {
 		
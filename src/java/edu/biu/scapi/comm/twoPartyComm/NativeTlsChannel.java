@@ -0,0 +1,252 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.comm.twoPartyComm;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.ObjectInputStream;
+import java.io.ObjectOutputStream;
+import java.io.Serializable;
+import java.util.logging.Level;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.generals.Logging;
+
+/**
+ * This class represents a channel whose TLS is done natively by OpenSSL instead of by javax.net.ssl.<p>
+ * Like the {@link NativeChannel}, it has two sockets. The send socket is connected by this channel as a TLS 1.3 client 
+ * and the receive socket is accepted by the {@link NativeTlsSocketListenerThread} as a TLS 1.3 server. Both parties 
+ * authenticate with their certificates, which should be signed by a trusted authority and issued to the name that the 
+ * other party is expected to have.<p>
+ * A sent message is copied once from its array to the native frame, and a received message is read in chunks directly 
+ * into the returned array. A received message that is longer than {@link #setMaxMessageSize(int)} fails the receive.<p>
+ * When kernel TLS is enabled in the {@link NativeTlsSocketCommunicationSetup}, OpenSSL hands the session keys to the kernel 
+ * (kTLS) after the handshake, so the records are encrypted and decrypted in the kernel. When the kernel, OpenSSL or the 
+ * negotiated cipher do not support it, the channel falls back to TLS in user space. 
+ * {@link #isKernelSend()} and {@link #isKernelReceive()} tell which directions are offloaded.<p>
+ * Messages are framed the same as in the NativeChannel, so the other party can be any TLS 1.3 peer that uses this framing.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class NativeTlsChannel implements Channel{
+
+	/**
+	 * A channel has a state. It can be either NOT_INIT,CONNECTING or READY.
+	 */
+	public static enum State {
+		
+		NOT_INIT,
+		CONNECTING,
+		READY
+	}
+	
+	private State state;						// The state of the channel.
+	
+	private SocketPartyData me;
+	private SocketPartyData other; 
+	private long context;						// Pointer to the native TLS context of the communication setup.
+	private String peerName;					// The name that the certificate of the other party should be issued to.
+	private int handshakeTimeout;				// The longest wait for each step of the handshake, in milliseconds.
+	
+	private long sendConnection;				// Pointer to the native TLS connection used to send messages.
+	private long receiveConnection;				// Pointer to the native TLS connection used to receive messages.
+	
+	private boolean isClosed;
+	private int maxMessageSize = DEFAULT_MAX_MESSAGE_SIZE;	// The longest message that is received.
+	
+	/**
+	 * The default maximal size of a received message, in bytes.
+	 */
+	public static final int DEFAULT_MAX_MESSAGE_SIZE = 1 << 30;
+	
+	private native long connect(long context, String address, int port, String peerName, int handshakeTimeout);
+	private native boolean send(long sendConnection, byte[] data);
+	private native byte[] receive(long receiveConnection, int maxSize);
+	private native boolean isKernelSend(long sendConnection);
+	private native boolean isKernelReceive(long receiveConnection);
+	private native void closeConnections(long sendConnection, long receiveConnection);
+	private native void deleteConnections(long sendConnection, long receiveConnection);
+	
+	NativeTlsChannel(SocketPartyData me, SocketPartyData other, long context, String peerName, int handshakeTimeout) {
+		this.me = me; 
+		this.other = other;
+		this.context = context;
+		this.peerName = peerName;
+		this.handshakeTimeout = handshakeTimeout;
+		
+		sendConnection = 0;
+		receiveConnection = 0;
+	}
+	
+	@Override
+	public void send(Serializable data) throws IOException {
+		ByteArrayOutputStream bOut = new ByteArrayOutputStream();  
+		ObjectOutputStream oOut  = new ObjectOutputStream(bOut);
+		oOut.writeObject(data);  
+		oOut.close();
+		
+		if (sendConnection == 0 || !send(sendConnection, bOut.toByteArray())){
+			throw new IOException("failed to send the message over the tls connection");
+		}
+	}
+
+	@Override
+	public Serializable receive() throws ClassNotFoundException, IOException {
+		byte[] data = (receiveConnection == 0) ? null : receive(receiveConnection, maxMessageSize);
+		if (data == null){
+			throw new IOException("failed to receive a message over the tls connection, or the message is longer than " + maxMessageSize + " bytes");
+		}
+		ObjectInputStream ois = new ObjectInputStream(new ByteArrayInputStream(data));
+		
+		return (Serializable) ois.readObject();
+	}
+
+	/**
+	 * Closes the connections. A thread that is blocked in send or receive fails with an IOException.<p>
+	 * The native connections are deleted only in finalize, since another thread may still be inside send or receive.
+	 */
+	@Override
+	public void close() {
+		if (!isClosed){
+			closeConnections(sendConnection, receiveConnection);
+			isClosed = true;
+		}
+	}
+	
+	/**
+	 * Sets the maximal size of a received message. The size of each message is sent by the other party, so this 
+	 * limits the memory that the other party can make this channel allocate.
+	 * @param maxMessageSize the maximal size in bytes. The default is {@link #DEFAULT_MAX_MESSAGE_SIZE}.
+	 */
+	public void setMaxMessageSize(int maxMessageSize) {
+		if (maxMessageSize < 0){
+			throw new IllegalArgumentException("the maximal message size should not be negative");
+		}
+		this.maxMessageSize = maxMessageSize;
+	}
+	
+	@Override
+	public boolean isClosed() {
+		return isClosed;
+	}
+	
+	/**
+	 * Returns true if the records of the sent messages are encrypted by the kernel.
+	 */
+	public boolean isKernelSend() {
+		return sendConnection != 0 && isKernelSend(sendConnection);
+	}
+	
+	/**
+	 * Returns true if the records of the received messages are decrypted by the kernel.
+	 */
+	public boolean isKernelReceive() {
+		return receiveConnection != 0 && isKernelReceive(receiveConnection);
+	}
+	
+	/**
+	 * Sets the state of the channel. 
+	 */
+	void setState(State state) {
+		this.state = state; 
+	}
+	
+	/**
+	 * Returns the state of the channel. 
+	 */
+	State getState() {
+		return state;
+	}
+	
+	/**
+	 * Returns if the send connection is established.
+	 */
+	boolean isSendConnected(){
+		return sendConnection != 0;
+	}
+	
+	/** 
+	 * Connects the send socket to the other party and runs the TLS handshake on it. If the other party is not up yet 
+	 * or the handshake fails, the send connection remains unset and the {@link NativeTlsSocketCommunicationSetup} tries 
+	 * again until it succeeds or a timeout has been reached.
+	 */
+	void connect() {
+		
+		//try to connect
+		Logging.getLogger().log(Level.INFO, "Trying to connect to " + other.getIpAddress().getHostAddress()+ " on port " + other.getPort());
+		
+		sendConnection = connect(context, other.getIpAddress().getHostAddress(), other.getPort(), peerName, handshakeTimeout);
+		
+		if(sendConnection != 0){
+			
+			Logging.getLogger().log(Level.INFO, "Socket connected, kernel tls: " + isKernelSend());
+				
+			//After the send connection is established, need to check if the receive connection is also established.
+			//If so, set the channel state to READY.
+			setReady();
+		}	
+	}
+	
+	/**
+	 * Sets the channel state to READY in case both send and receive connections are established.
+	 */
+	private synchronized void setReady() {
+		if(sendConnection != 0 && receiveConnection != 0){
+			
+			state = State.READY;
+			isClosed = false;
+			Logging.getLogger().log(Level.INFO, "state: ready " + toString());				
+		}
+	}
+	
+	/**
+	 * Sets the connection that was accepted by the listening thread as the receive connection of this channel.
+	 */
+	void setReceiveConnection(long receiveConnection) {
+		this.receiveConnection = receiveConnection;
+		//After the receive connection is established, need to check if the send connection is also established.
+		//If so, set the channel state to READY.
+		setReady();
+	}
+	
+	/**
+	 * Deletes the native connections.
+	 */
+	protected void finalize() throws Throwable {
+		
+		//Deletes from the dll the dynamic allocation of the connections.
+		deleteConnections(sendConnection, receiveConnection);
+		
+		super.finalize();
+	}
+	
+	static {	 
+		 //load the OpenSSL jni dll
+		 System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
@@ -0,0 +1,376 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.comm.twoPartyComm;
+
+import java.util.Collection;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.Map;
+import java.util.concurrent.TimeoutException;
+import java.util.logging.Level;
+
+import javax.net.ssl.SSLException;
+
+import org.apache.commons.exec.TimeoutObserver;
+import org.apache.commons.exec.Watchdog;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.exceptions.DuplicatePartyException;
+import edu.biu.scapi.generals.Logging;
+
+/**
+ * This class implements a communication between two parties using TLS 1.3 that is done natively by OpenSSL, 
+ * and creates {@link NativeTlsChannel}s.<p>
+ * 
+ * It is the native counterpart of the {@link SSLSocketCommunicationSetup}. Instead of a key store and a trust store, 
+ * the certificates and key are given in PEM files: the certificate (chain) of this party, its private key, and the 
+ * certificates of the authorities that the certificate of the other party should be signed by. In SCAPI the default 
+ * names are "scapiCert.pem", "scapiKey.pem" and "scapiCacerts.pem".<p>
+ * 
+ * Signing by a trusted authority is not enough: the certificate of the other party should also be issued to the name 
+ * that is expected for it. By default this is the ip address of the other party, which should be one of the ip 
+ * addresses of its certificate. A host or party name can be given instead, which should be one of the dns names of the 
+ * certificate (or its common name if it has none). A connection whose certificate doesn't match is dropped.<p>
+ * 
+ * By default the channels use TLS in user space. When kernel TLS is enabled, each channel hands its session keys to the 
+ * kernel (kTLS) after the handshake, if the kernel supports it, so the bulk of the messages is encrypted in the kernel 
+ * with AES-GCM. The kernel TLS path has not been tested on a kernel that supports it yet, so it should be considered 
+ * experimental.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class NativeTlsSocketCommunicationSetup implements TwoPartyCommunicationSetup, TimeoutObserver{
+	
+	protected boolean bTimedOut = false; 							//Indicated whether or not to end the communication.
+	protected Watchdog watchdog;									//Used to measure times.
+	protected NativeTlsSocketListenerThread listeningThread;		//Listen to calls from the other party.
+	protected int connectionsNumber;								//Holds the number of created connections. 
+	protected SocketPartyData me;									//The data of the current application.
+	protected SocketPartyData other;								//The data of the other application to communicate with.
+	
+	private long context;											//Pointer to the native TLS context that all the channels share.
+	private String peerName;										//The name that the certificate of the other party should be issued to.
+	private int handshakeTimeout = DEFAULT_HANDSHAKE_TIMEOUT;		//The longest wait for each step of a handshake, in milliseconds.
+	
+	/**
+	 * The default handshake timeout, in milliseconds.
+	 */
+	public static final int DEFAULT_HANDSHAKE_TIMEOUT = 5000;
+	private Map<String, Channel> connectionsMap;
+	
+	private native long createContext(String certFile, String keyFile, String caFile, boolean kernelTls);
+	private native void deleteContext(long context);
+	
+	/**
+	 * Constructor that gets the data of both parties and uses scapi's default PEM file names.
+	 * @param me The data of the current application.
+	 * @param party The data of the other application.
+	 * @throws DuplicatePartyException In case both parties are the same.
+	 * @throws SSLException In case one of the files cannot be loaded or the TLS context cannot be created.
+	 */
+	public NativeTlsSocketCommunicationSetup(PartyData me, PartyData party) throws DuplicatePartyException, SSLException {
+		//Call the other constructor with scapi's default file names.
+		this(me, party, "scapiCert.pem", "scapiKey.pem", "scapiCacerts.pem");
+	}
+	
+	/**
+	 * Constructor that gets the data of both parties and the PEM files of this party.
+	 * @param me The data of the current application.
+	 * @param party The data of the other application.
+	 * @param certFile Name of the file of the certificate (chain) of this party.
+	 * @param keyFile Name of the file of the private key of this party.
+	 * @param caFile Name of the file of the certificates that the certificate of the other party is verified with.
+	 * @throws DuplicatePartyException In case both parties are the same.
+	 * @throws SSLException In case one of the files cannot be loaded or the TLS context cannot be created.
+	 */
+	public NativeTlsSocketCommunicationSetup(PartyData me, PartyData party, String certFile, String keyFile, String caFile) throws DuplicatePartyException, SSLException {
+		this(me, party, certFile, keyFile, caFile, false);
+	}
+	
+	/**
+	 * Constructor that gets the data of both parties, the PEM files of this party and whether to use kernel TLS.
+	 * @param me The data of the current application.
+	 * @param party The data of the other application.
+	 * @param certFile Name of the file of the certificate (chain) of this party.
+	 * @param keyFile Name of the file of the private key of this party.
+	 * @param caFile Name of the file of the certificates that the certificate of the other party is verified with.
+	 * @param kernelTls true to offload the records to the kernel when it is supported (experimental); false to always use TLS in user space.
+	 * @throws DuplicatePartyException In case both parties are the same.
+	 * @throws SSLException In case one of the files cannot be loaded or the TLS context cannot be created.
+	 */
+	public NativeTlsSocketCommunicationSetup(PartyData me, PartyData party, String certFile, String keyFile, String caFile, boolean kernelTls) throws DuplicatePartyException, SSLException {
+		this(me, party, certFile, keyFile, caFile, kernelTls, null);
+	}
+	
+	/**
+	 * Constructor that gets the data of both parties, the PEM files of this party, whether to use kernel TLS and the 
+	 * name that the certificate of the other party should be issued to.
+	 * @param me The data of the current application.
+	 * @param party The data of the other application.
+	 * @param certFile Name of the file of the certificate (chain) of this party.
+	 * @param keyFile Name of the file of the private key of this party.
+	 * @param caFile Name of the file of the certificates that the certificate of the other party is verified with.
+	 * @param kernelTls true to offload the records to the kernel when it is supported (experimental); false to always use TLS in user space.
+	 * @param peerName The ip address, host name or party name of the other party in its certificate. If null, the ip address of the other party is used.
+	 * @throws DuplicatePartyException In case both parties are the same.
+	 * @throws SSLException In case one of the files cannot be loaded or the TLS context cannot be created.
+	 */
+	public NativeTlsSocketCommunicationSetup(PartyData me, PartyData party, String certFile, String keyFile, String caFile, boolean kernelTls, String peerName) throws DuplicatePartyException, SSLException {
+		//Both parties should be instances of SocketPArty.
+		if (!(me instanceof SocketPartyData) || !(party instanceof SocketPartyData)){
+			throw new IllegalArgumentException("both parties should be instances of SocketParty");
+		}
+		this.me = (SocketPartyData) me;
+		this.other = (SocketPartyData) party;
+		
+		//Compare the two given parties. If they are the same, throw exception.
+		int partyCompare = this.me.compareTo(other);
+		if(partyCompare == 0){
+			throw new DuplicatePartyException("Another party with the same ip address and port");
+		}
+		
+		this.peerName = (peerName != null) ? peerName : other.getIpAddress().getHostAddress();
+		
+		context = createContext(certFile, keyFile, caFile, kernelTls);
+		if (context == 0){
+			throw new SSLException("failed to create the tls context from " + certFile + ", " + keyFile + " and " + caFile);
+		}
+		connectionsNumber = 0;
+	}
+	
+	/**  
+	 * Initiates the creation of the actual TLS connections between the parties. If this function succeeds, the 
+	 * application may use the send and receive functions of the created channels to pass messages.
+	 * @throws TimeoutException in case a timeout has occurred before all channels have been connected.
+	 */
+	@Override
+	public Map<String, Channel> prepareForCommunication(String[] connectionsIds, long timeOut) throws TimeoutException {		
+		
+		//Start the watch dog with the given timeout.
+		watchdog = new Watchdog(timeOut);
+		//Add this instance as the observer in order to receive the event of time out.
+		watchdog.addTimeoutObserver(this);
+		watchdog.start();
+		
+		//Establish the connections.
+		establishConnections(connectionsIds);
+		
+		//Verify that all connections have been connected.
+		verifyConnectingStatus();
+		
+		//If we already know that all the connections were established we can stop the watchdog.
+		watchdog.stop();
+			
+		//In case of timeout, throw a TimeoutException
+		if (bTimedOut){
+			throw new TimeoutException("timeout has occurred");
+		}
+		
+		//Update the number of the created connections.
+		connectionsNumber += connectionsMap.size();
+		
+		return connectionsMap;
+	}
+
+	@Override
+	public Map<String, Channel> prepareForCommunication(int connectionsNum, long timeOut) throws TimeoutException {
+		//Prepare the connections Ids using the default implementation, meaning the connections are numbered 
+		//according to their index. i.e the first connection's name is "1", the second is "2" and so on.
+		String[] names = new String[connectionsNum];
+		for (int i=0; i<connectionsNum; i++){
+			names[i] = Integer.toString(connectionsNumber++);
+		}
+		
+		//Call the other prepareForCommunication function with the created ids.
+		return prepareForCommunication(names, timeOut);
+	}
+
+	/**
+	 * This function does the actual creation of the communication between the parties.<p>
+	 * A connected channel between two parties has two TLS connections. One is used by P1 to send messages and p2 receives them,
+	 * while the other used by P2 to send messages and P1 receives them.
+	 * 
+	 * The function does the following steps:
+	 * 1. Creates a channel for each connection.
+	 * 2. Start a listening thread that accepts calls from the other party.
+	 * 3. Calls each channel's connect function in order to connect each channel to the other party.
+	 * @param connectionsIds The names of the requested connections. 
+	 */
+	private void establishConnections(String[] connectionsIds) {
+		
+		NativeTlsChannel[] channels = createChannels(connectionsIds);
+		
+		if (!bTimedOut){
+			//Create a listening thread with the created channels.
+			//The listening thread receives calls from the other party and set the accepted connections as the receive connections of the channels.
+			listeningThread = new NativeTlsSocketListenerThread(channels, me, context, peerName, handshakeTimeout);
+			listeningThread.start();
+		}
+		
+		connect(channels);
+	}
+	
+	private NativeTlsChannel[] createChannels(String[] connectionsIds) {
+		//Initiate the channels map.
+		connectionsMap = new HashMap<String,Channel>();
+		
+		int size = connectionsIds.length;
+		//Create an array to hold the created channels.
+		NativeTlsChannel[] channels = new NativeTlsChannel[size];
+		
+		//Create the number of channels as requested, give them the names in connectionsIds and put them in the map.
+		for (int i=0; i<size; i++){
+			channels[i] = new NativeTlsChannel(me, other, context, peerName, handshakeTimeout);
+			channels[i].setState(NativeTlsChannel.State.NOT_INIT);
+			connectionsMap.put(connectionsIds[i], channels[i]);
+		}
+		
+		return channels;
+	}
+	
+	private void connect(NativeTlsChannel[] channels) {
+		//For each channel, call the connect function until the channel is actually connected.
+		for (int i=0; i<channels.length && !bTimedOut; i++){
+			
+			//while connection has not been stopped by owner and connection has failed.
+			while(!channels[i].isSendConnected() && !bTimedOut){
+				
+				//Set the state to connecting.
+				channels[i].setState(NativeTlsChannel.State.CONNECTING);
+				Logging.getLogger().log(Level.INFO, "state: connecting " + channels[i].toString());
+				
+				//Try to connect. The other party may not listen yet, so wait a while before the next try.
+				channels[i].connect();
+				if (!channels[i].isSendConnected()){
+					try {
+						Thread.sleep(500);
+					} catch (InterruptedException e) {
+						Logging.getLogger().log(Level.FINEST, e.toString());
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * Sets the longest time to wait for each step of the TLS handshake of a connection. A party that connects and doesn't 
+	 * complete the handshake is dropped after this time, and the listening thread checks this often whether it was stopped.
+	 * @param handshakeTimeout the timeout in milliseconds. The default is {@link #DEFAULT_HANDSHAKE_TIMEOUT}.
+	 */
+	public void setHandshakeTimeout(int handshakeTimeout) {
+		if (handshakeTimeout <= 0){
+			throw new IllegalArgumentException("the handshake timeout should be positive");
+		}
+		this.handshakeTimeout = handshakeTimeout;
+	}
+	
+	/**
+	 * Nagle's algorithm is always disabled on the native TLS sockets, so this function does nothing.
+	 */
+	@Override
+	public void enableNagle(){
+	}
+	
+	/**
+	 * This function is called by the infrastructure of the Watchdog if the previously set timeout has passed. (Do not call this function).
+	 */
+	public void timeoutOccured(Watchdog w) {
+
+		Logging.getLogger().log(Level.INFO, "Timeout occured");
+		
+		//Timeout has passed, set the flag.
+		bTimedOut = true;
+	
+		//Further stop the listening thread if it still runs. Similarly, it sets the flag of the listening thread to stopped.
+		if(listeningThread != null)
+			listeningThread.stopConnecting();
+		
+		stopConnecting();
+	}
+	
+	private void verifyConnectingStatus() {
+		//Wait until the thread has been stopped or all the channels are connected.
+		while(!bTimedOut && !areAllConnected()){
+			try {
+				Thread.sleep(500);
+			} catch (InterruptedException e) {
+
+				Logging.getLogger().log(Level.FINEST, e.toString());
+			}
+		}
+	}
+	
+	/** 
+	 * @return true if all the channels are in READY state, false otherwise.
+	 */
+	private boolean areAllConnected() {
+		Collection<Channel> c = connectionsMap.values();
+		Iterator<Channel> itr = c.iterator();
+		
+		//Go over the map and check if all the connections are in READY state.
+		while(itr.hasNext()){
+			if(((NativeTlsChannel)itr.next()).getState() != NativeTlsChannel.State.READY){
+				return false;
+			}
+		}
+		
+		return true;
+	}
+
+	/**
+	* Sets the flag bTimedOut to true and closes all the channels.
+	*/
+	public void stopConnecting(){
+	
+		//Set the flag to true.
+		bTimedOut = true;
+			
+		//Go over the map and close all connection.
+		Iterator<Channel> iterator = connectionsMap.values().iterator();
+		while(iterator.hasNext()){ 
+			iterator.next().close();
+		}
+		
+		//Remove all channels from the map.
+		connectionsMap.clear();
+	}
+	
+	/**
+	 * Releases the native TLS context. The connections of the created channels keep working until they are closed.
+	 */
+	public void close() {
+		if (context != 0){
+			deleteContext(context);
+			context = 0;
+		}
+	}
+	
+	static {	 
+		 //load the OpenSSL jni dll
+		 System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
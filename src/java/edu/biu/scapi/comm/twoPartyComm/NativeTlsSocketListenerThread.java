@@ -0,0 +1,130 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.comm.twoPartyComm;
+
+import java.util.logging.Level;
+
+import edu.biu.scapi.generals.Logging;
+
+/**
+ * This class listens to the connections of the other party and accepts them as the receive connections of the 
+ * {@link NativeTlsChannel}s. Each accepted socket runs the server side of the TLS handshake natively; 
+ * a connection whose handshake fails (for example, when the certificate of the other party is not trusted or is issued 
+ * to another name) or doesn't end within the handshake timeout is dropped.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class NativeTlsSocketListenerThread extends Thread {
+	
+	protected NativeTlsChannel[] channels;	//All connections between me and the other party. The receive connection of each channel should be set when accepted. 
+	private SocketPartyData me;
+	private long context;					//Pointer to the native TLS context of the communication setup.
+	private String peerName;				//The name that the certificate of the other party should be issued to.
+	private int handshakeTimeout;			//The longest wait for a connection and for each step of its handshake, in milliseconds.
+	private long serverSocket;
+	protected boolean bStopped = false;		//A flag that indicate if to keep on listening or stop.
+	
+	private native long initReceiveSocket(String address, int port);
+	private native long accept(long context, long serverSocket, String peerName, int timeout);
+	private native void close(long serverSocket);
+	
+	/**
+	* A constructor that opens the server socket.
+	* @param channels the channels that should be set with receive connection.
+	* @param me the data of the current application.
+	* @param context the native TLS context that the connections are accepted with.
+	* @param peerName the name that the certificate of the other party should be issued to.
+	* @param handshakeTimeout the longest wait for a connection and for each step of its handshake, in milliseconds.
+	*/
+	NativeTlsSocketListenerThread(NativeTlsChannel[] channels, SocketPartyData me, long context, String peerName, int handshakeTimeout) {
+	
+		this.channels = channels;
+		this.me = me;
+		this.context = context;
+		this.peerName = peerName;
+		this.handshakeTimeout = handshakeTimeout;
+		serverSocket = initReceiveSocket(me.getIpAddress().getHostAddress(), me.getPort());
+	}
+
+	/**
+	* Sets the flag bStopped to true. In the run function of this thread this flag is checked - 
+	* if the flag is true the run functions returns, otherwise continues.
+	*/
+	void stopConnecting(){
+	
+		//Set the flag to true.
+		bStopped = true;
+	}
+
+	/**
+	* This function is the main function of the NativeTlsSocketListenerThread. Mainly, we listen and accept valid connections 
+	* as long as the flag bStopped is false or until we have got as much connections as we should.
+	*/
+	public void run() {
+	
+		if (serverSocket == 0){
+			Logging.getLogger().log(Level.SEVERE, "Failed to listen on " + me.getIpAddress() + " port " + me.getPort());
+			return;
+		}
+		
+		//Set the state of all channels to connecting.
+		int size = channels.length;
+		for (int i=0; i<size; i++){
+		
+			channels[i].setState(NativeTlsChannel.State.CONNECTING);
+		}
+		
+		int i=0;
+		//Loop for listening to incoming connections and make sure that this thread should not stopped.
+		while (i < size && !bStopped) {
+		
+			Logging.getLogger().log(Level.INFO, "Trying to listen "+ me.getIpAddress());
+			
+			//Accept an incoming connection and run the handshake on it. The call returns after the handshake timeout if no 
+			//connection arrived or the handshake didn't end, so that bStopped is checked again.
+			long receiveConnection = accept(context, serverSocket, peerName, handshakeTimeout);
+		
+			if(receiveConnection != 0){
+				
+				channels[i].setReceiveConnection(receiveConnection);
+				
+				//Increment the index of incoming connections.
+				i++;
+			}
+		}
+	
+		Logging.getLogger().log(Level.INFO, "End of listening thread run");
+		
+		//After accepting all connections, close the thread.
+		close(serverSocket);
+	}
+	
+	static {	 
+		 //load the OpenSSL jni dll
+		 System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
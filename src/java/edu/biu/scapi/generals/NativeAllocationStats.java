@@ -0,0 +1,211 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.generals;
+
+import java.io.PrintStream;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Reports the native objects that the jni libraries handed to java as pointers (points, big numbers, garbled circuits, 
+ * OT extension objects, etc.) and were not deleted yet. <p>
+ * These objects are invisible to the java heap monitoring, so this class is the way to find native leaks.
+ * The accounting is done by each jni library and is enabled only if the environment variable SCAPI_NATIVE_ALLOC_TRACKING=1 
+ * is set before the library is loaded. When it is not set, the statistics are empty and the tracking costs almost nothing.
+ * Setting also SCAPI_NATIVE_ALLOC_DUMP=1 prints the live objects of each library when the process exits.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public final class NativeAllocationStats {
+	
+	/**
+	 * The jni libraries that account their native objects.
+	 */
+	public static enum Library {
+		OPENSSL,
+		SC_GARBLED_CIRCUIT,
+		OT_EXTENSION,
+		NTL
+	}
+	
+	/**
+	 * The statistics of a single native type.
+	 */
+	public static class TypeStats {
+		private Library library;
+		private String type;
+		private long liveCount;
+		private long liveBytes;
+		private long totalAllocations;
+		private long totalReleases;
+		
+		TypeStats(Library library, String type, long[] counters, int offset){
+			this.library = library;
+			this.type = type;
+			liveCount = counters[offset];
+			liveBytes = counters[offset + 1];
+			totalAllocations = counters[offset + 2];
+			totalReleases = counters[offset + 3];
+		}
+		
+		public Library getLibrary() {
+			return library;
+		}
+		
+		/**
+		 * Returns the name of the native type, for example EC_POINT.
+		 */
+		public String getType() {
+			return type;
+		}
+		
+		/**
+		 * Returns the number of objects of this type that were created and not deleted yet.
+		 */
+		public long getLiveCount() {
+			return liveCount;
+		}
+		
+		/**
+		 * Returns the approximate number of bytes held by the live objects of this type.
+		 */
+		public long getLiveBytes() {
+			return liveBytes;
+		}
+		
+		public long getTotalAllocations() {
+			return totalAllocations;
+		}
+		
+		public long getTotalReleases() {
+			return totalReleases;
+		}
+		
+		@Override
+		public String toString() {
+			return library + " " + type + ": " + liveCount + " live objects, " + liveBytes + " bytes (" 
+					+ totalAllocations + " allocated, " + totalReleases + " released)";
+		}
+	}
+	
+	//Number of counters the native code returns for each type.
+	private static final int NUM_COUNTERS = 4;
+	
+	//Each native getter returns the type names (String[]) and their counters (long[]) taken from a single snapshot.
+	private static native Object[] getOpenSSLStats();
+	private static native boolean isOpenSSLTrackingEnabled();
+	
+	private static native Object[] getScGarbledCircuitStats();
+	private static native boolean isScGarbledCircuitTrackingEnabled();
+	
+	private static native Object[] getOtExtensionStats();
+	private static native boolean isOtExtensionTrackingEnabled();
+	
+	private static native Object[] getNTLStats();
+	private static native boolean isNTLTrackingEnabled();
+	
+	private NativeAllocationStats(){}
+	
+	/**
+	 * Returns true if the given library is loaded and tracks its native objects.
+	 */
+	public static boolean isTrackingEnabled(Library library) {
+		try {
+			switch (library) {
+			case OPENSSL:				return isOpenSSLTrackingEnabled();
+			case SC_GARBLED_CIRCUIT:	return isScGarbledCircuitTrackingEnabled();
+			case OT_EXTENSION:			return isOtExtensionTrackingEnabled();
+			case NTL:					return isNTLTrackingEnabled();
+			default:					return false;
+			}
+		} catch (UnsatisfiedLinkError e) {
+			//The library was not loaded by this process.
+			return false;
+		}
+	}
+	
+	/**
+	 * Returns the statistics of the native types of the given library. 
+	 * If the library was not loaded or does not track its objects, returns an empty list.
+	 */
+	public static List<TypeStats> getStats(Library library) {
+		List<TypeStats> stats = new ArrayList<TypeStats>();
+		Object[] snapshot;
+		try {
+			switch (library) {
+			case OPENSSL:				snapshot = getOpenSSLStats();			break;
+			case SC_GARBLED_CIRCUIT:	snapshot = getScGarbledCircuitStats();	break;
+			case OT_EXTENSION:			snapshot = getOtExtensionStats();		break;
+			case NTL:					snapshot = getNTLStats();				break;
+			default:					return stats;
+			}
+		} catch (UnsatisfiedLinkError e) {
+			//The library was not loaded by this process.
+			return stats;
+		}
+		
+		String[] types = (String[]) snapshot[0];
+		long[] counters = (long[]) snapshot[1];
+		for (int i = 0; i < types.length; i++) {
+			stats.add(new TypeStats(library, types[i], counters, i * NUM_COUNTERS));
+		}
+		return stats;
+	}
+	
+	/**
+	 * Returns the statistics of all the loaded libraries.
+	 */
+	public static List<TypeStats> getStats() {
+		List<TypeStats> stats = new ArrayList<TypeStats>();
+		for (Library library : Library.values()) {
+			stats.addAll(getStats(library));
+		}
+		return stats;
+	}
+	
+	/**
+	 * Prints the types that have live native objects.
+	 */
+	public static void dump(PrintStream out) {
+		for (TypeStats typeStats : getStats()) {
+			if (typeStats.getLiveCount() != 0) {
+				out.println(typeStats);
+			}
+		}
+	}
+	
+	/**
+	 * Registers a shutdown hook that prints the live native objects when the JVM exits.
+	 */
+	public static void dumpOnShutdown() {
+		Runtime.getRuntime().addShutdownHook(new Thread() {
+			@Override
+			public void run() {
+				dump(System.err);
+			}
+		});
+	}
+}
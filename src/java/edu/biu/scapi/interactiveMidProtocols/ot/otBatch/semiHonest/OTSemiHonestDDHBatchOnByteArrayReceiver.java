@@ -96,15 +96,19 @@ public class OTSemiHonestDDHBatchOnByteArrayReceiver extends OTSemiHonestDDHBatc
 		OTSemiHonestDDHBatchOnByteArraySenderMsg msg = (OTSemiHonestDDHBatchOnByteArraySenderMsg)message;
 		int size = sigmaArr.size();
 		ArrayList<byte[]> xSigmaArr = new ArrayList<byte[]> ();
-		GroupElement u, kSigma;
 		byte[] vSigma, xSigma;
 
+		//Compute all the kSigma = u^alpha together.
+		GroupElement[] uArr = new GroupElement[size];
+		for (int i=0; i<size; i++){
+			uArr[i] = dlog.reconstructElement(true, msg.getTuples().get(i).getU());
+		}
+		GroupElement[] kSigmaArr = dlog.exponentiateMany(uArr, alphaArr.toArray(new BigInteger[size]));
+
 		for (int i=0; i<size; i++){
 			
 			OTSemiHonestDDHOnByteArraySenderMsg tuple = msg.getTuples().get(i);
-			//Compute kSigma:
-			u = dlog.reconstructElement(true, tuple.getU());
-			kSigma = dlog.exponentiate(u, alphaArr.get(i));
+			GroupElement kSigma = kSigmaArr[i];
 			byte[] kBytes = dlog.mapAnyGroupElementToByteArray(kSigma);
 			
 			//Get v0 or v1 according to sigma.
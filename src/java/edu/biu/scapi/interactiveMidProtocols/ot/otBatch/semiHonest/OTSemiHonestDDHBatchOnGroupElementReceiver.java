@@ -85,16 +85,21 @@ public class OTSemiHonestDDHBatchOnGroupElementReceiver extends OTSemiHonestDDHB
 		OTSemiHonestDDHBatchOnGroupElementSenderMsg msg = (OTSemiHonestDDHBatchOnGroupElementSenderMsg)message;
 		int size = sigmaArr.size();
 		ArrayList<GroupElement> xSigmaArr = new ArrayList<GroupElement>();
-		GroupElement u, kSigma, vSigma;
-		BigInteger beta;
+		GroupElement kSigma, vSigma;
+
+		//Compute all the (kSigma)^(-1) = u^(-alpha) together.
+		GroupElement[] uArr = new GroupElement[size];
+		BigInteger[] betaArr = new BigInteger[size];
+		for (int i=0; i<size; i++){
+			uArr[i] = dlog.reconstructElement(true, msg.getTuples().get(i).getU());	//Get u
+			betaArr[i] = dlog.getOrder().subtract(alphaArr.get(i));				//Get -alpha
+		}
+		GroupElement[] kSigmaArr = dlog.exponentiateMany(uArr, betaArr);
 
 		for (int i=0; i<size; i++){
 			
 			OTSemiHonestDDHOnGroupElementSenderMsg tuple = msg.getTuples().get(i);
-			//Compute (kSigma)^(-1) = u^(-alpha):
-			u = dlog.reconstructElement(true, tuple.getU());	//Get u
-			beta = dlog.getOrder().subtract(alphaArr.get(i));	//Get -alpha
-			kSigma = dlog.exponentiate(u, beta);
+			kSigma = kSigmaArr[i];
 			
 			
 			//Get v0 or v1 according to sigma.
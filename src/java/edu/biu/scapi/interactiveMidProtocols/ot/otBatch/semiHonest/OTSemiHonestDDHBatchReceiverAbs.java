@@ -29,6 +29,7 @@ import java.io.Serializable;
 import java.math.BigInteger;
 import java.security.SecureRandom;
 import java.util.ArrayList;
+import java.util.Arrays;
 
 import org.bouncycastle.util.BigIntegers;
 
@@ -198,10 +199,15 @@ abstract class OTSemiHonestDDHBatchReceiverAbs implements OTBatchReceiver{
 	private OTRGroupElementBatchMsg computeTuples(ArrayList<BigInteger> alphaArr, ArrayList<GroupElement> hArr, ArrayList<Byte> sigmaArr) {
 		int size = alphaArr.size();
 		GroupElement g = dlog.getGenerator();
+		
+		//Calculate all the g^alphaI together.
+		GroupElement[] gArr = new GroupElement[size];
+		Arrays.fill(gArr, g);
+		GroupElement[] gAlphaArr = dlog.exponentiateMany(gArr, alphaArr.toArray(new BigInteger[size]));
+		
 		ArrayList<OTRGroupElementPairMsg> tuples = new ArrayList<OTRGroupElementPairMsg>();
 		for (int i=0; i<size; i++){
-			//Calculate g^alphaI.
-			GroupElement gAlpha = dlog.exponentiate(g, alphaArr.get(i));
+			GroupElement gAlpha = gAlphaArr[i];
 					
 			GroupElement h0 = null;
 			GroupElement h1 = null;
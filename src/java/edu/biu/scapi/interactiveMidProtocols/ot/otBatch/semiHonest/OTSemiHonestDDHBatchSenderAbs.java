@@ -29,6 +29,7 @@ import java.io.Serializable;
 import java.math.BigInteger;
 import java.security.SecureRandom;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.logging.Level;
 
 import edu.biu.scapi.generals.Logging;
@@ -160,28 +161,32 @@ abstract class OTSemiHonestDDHBatchSenderAbs implements OTBatchSender{
 		BigInteger r = BigIntegers.createRandomInRange(BigInteger.ZERO, qMinusOne, random);
 		GroupElement g = dlog.getGenerator(); //Get the group generator.
 		
-		//Calculate u = g^r.
-		GroupElement u = dlog.exponentiate(g, r);
-		
 		ArrayList<OTRGroupElementPairMsg> tuples = message.getTuples();
 		int size = tuples.size();
 		ArrayList<GroupElement> k0Array = new ArrayList<GroupElement>();
 		ArrayList<GroupElement> k1Array = new ArrayList<GroupElement>();
-		GroupElement h0, h1;
 		OTRGroupElementPairMsg tuple;
 		
-		//For every i=1,...,m, COMPUTE:
+		//Calculate u = g^r and for every i=1,...,m:
 		//	ki0 = (hi0)^r
 		//	ki1 = (hi1)^r
+		//All the exponentiations use the same r, so they are computed together.
+		GroupElement[] bases = new GroupElement[2 * size + 1];
+		BigInteger[] exponents = new BigInteger[2 * size + 1];
+		Arrays.fill(exponents, r);
+		bases[0] = g;
 		for (int i=0; i<size; i++){
 			tuple = tuples.get(i);
-			//Recreate h0 from the data in the received message.
-			h0 = dlog.reconstructElement(true, tuple.getFirstGE());
-			h1 = dlog.reconstructElement(true, tuple.getSecondGE());
-			
-			//Calculate k0 = h0^r.
-			k0Array.add(i, dlog.exponentiate(h0, r));
-			k1Array.add(i, dlog.exponentiate(h1, r));
+			//Recreate h0 and h1 from the data in the received message.
+			bases[2 * i + 1] = dlog.reconstructElement(true, tuple.getFirstGE());
+			bases[2 * i + 2] = dlog.reconstructElement(true, tuple.getSecondGE());
+		}
+		GroupElement[] powers = dlog.exponentiateMany(bases, exponents);
+		
+		GroupElement u = powers[0];
+		for (int i=0; i<size; i++){
+			k0Array.add(i, powers[2 * i + 1]);
+			k1Array.add(i, powers[2 * i + 2]);
 		}
 		
 		OTSMsg messageToSend = computeMsg(input, u, k0Array, k1Array);
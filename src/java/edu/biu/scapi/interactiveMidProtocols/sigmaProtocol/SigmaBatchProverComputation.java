@@ -0,0 +1,56 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.interactiveMidProtocols.sigmaProtocol;
+
+import edu.biu.scapi.exceptions.CheatAttemptException;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProverInput;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProtocolMsg;
+
+/**
+ * This interface is implemented by sigma protocol provers that can compute the messages of many proofs together.<p>
+ * The messages of each proof are the same as the messages of a separate proof that uses the same random values.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public interface SigmaBatchProverComputation extends SigmaProverComputation {
+	
+	/**
+	 * Computes the first messages of a batch of proofs, one for each of the given inputs.<p>
+	 * The second messages of the batch should be computed by computeSecondMsgs. This replaces a single proof that was 
+	 * started by computeFirstMsg.
+	 * @param inputs the inputs of the proofs.
+	 * @return the computed messages, in the order of the inputs.
+	 */
+	public SigmaProtocolMsg[] computeFirstMsgs(SigmaProverInput[] inputs);
+	
+	/**
+	 * Computes the second messages of the batch that was started by computeFirstMsgs.
+	 * @param challenges the challenge of each proof, in the order of the inputs.
+	 * @return the computed messages.
+	 * @throws CheatAttemptException if the length of one of the challenges is not equal to the soundness parameter.
+	 */
+	public SigmaProtocolMsg[] computeSecondMsgs(byte[][] challenges) throws CheatAttemptException;
+}
@@ -31,9 +31,10 @@ import org.bouncycastle.util.BigIntegers;
 
 import edu.biu.scapi.exceptions.CheatAttemptException;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.DlogBasedSigma;
-import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.SigmaProverComputation;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.SigmaBatchProverComputation;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.SigmaSimulator;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaBIMsg;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaBatchResponses;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaGroupElementMsg;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProverInput;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProtocolMsg;
@@ -49,7 +50,7 @@ import edu.biu.scapi.primitives.dlog.GroupElement;
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
  */
-public class SigmaDlogProverComputation implements SigmaProverComputation, DlogBasedSigma{
+public class SigmaDlogProverComputation implements SigmaBatchProverComputation, DlogBasedSigma{
 
 	/*	
 	  This class computes the following calculations:
@@ -64,6 +65,7 @@ public class SigmaDlogProverComputation implements SigmaProverComputation, DlogB
 	private SigmaDlogProverInput input;	// Contains h and w.
 	private BigInteger r;				// The value chosen in the protocol.
 	private BigInteger qMinusOne;
+	private SigmaBatchResponses batch;			// The state of the current batch of proofs.
 	
 	/**
 	 * Constructor that gets the underlying DlogGroup, soundness parameter and SecureRandom.
@@ -84,6 +86,7 @@ public class SigmaDlogProverComputation implements SigmaProverComputation, DlogB
 		}
 		
 		this.random = random;
+		batch = new SigmaBatchResponses(dlog.getOrder(), t);
 		qMinusOne = dlog.getOrder().subtract(BigInteger.ONE);
 	}
 	
@@ -161,6 +164,46 @@ public class SigmaDlogProverComputation implements SigmaProverComputation, DlogB
 		
 	}
 	
+	/**
+	 * Computes the first messages of a batch of proofs, one for each of the given inputs.<p>
+	 * "SAMPLE a random r in Zq<p>
+	 *  COMPUTE a = g^r" for each proof.<p>
+	 * The second messages of the batch should be computed by computeSecondMsgs. This replaces a single proof that was 
+	 * started by computeFirstMsg.
+	 * @param inputs each one MUST be an instance of SigmaDlogProverInput.
+	 * @return the computed messages, in the order of the inputs.
+	 * @throws IllegalArgumentException if one of the inputs is not an instance of SigmaDlogProverInput.
+	 */
+	public SigmaProtocolMsg[] computeFirstMsgs(SigmaProverInput[] inputs) {
+		batch.start(inputs.length);
+		SigmaProtocolMsg[] msgs = new SigmaProtocolMsg[inputs.length];
+		for (int i = 0; i < inputs.length; i++){
+			msgs[i] = computeFirstMsg(inputs[i]);
+			batch.set(i, new BigInteger[]{ input.getW() }, new BigInteger[]{ r });
+		}
+		r = BigInteger.ZERO;
+		return msgs;
+	}
+	
+	/**
+	 * Computes the second messages of the batch that was started by computeFirstMsgs.<p>
+	 * "COMPUTE z = (r + ew) mod q" for each proof. All the responses are computed together over packed vectors.
+	 * @param challenges the challenge of each proof, in the order of the inputs.
+	 * @return the computed messages.
+	 * @throws CheatAttemptException if the length of one of the challenges is not equal to the soundness parameter.
+	 * @throws IllegalArgumentException if the number of challenges is not the number of proofs in the batch.
+	 */
+	public SigmaProtocolMsg[] computeSecondMsgs(byte[][] challenges) throws CheatAttemptException {
+		//Compute z = (r+ew) mod q of all the proofs.
+		BigInteger[][] z = batch.computeResponses(challenges);
+		
+		SigmaProtocolMsg[] msgs = new SigmaProtocolMsg[z.length];
+		for (int i = 0; i < z.length; i++){
+			msgs[i] = new SigmaBIMsg(z[i][0]);
+		}
+		return msgs;
+	}
+	
 	/**
 	 * Checks if the given challenge length is equal to the soundness parameter.
 	 * @return true if the challenge length is t; false, otherwise. 
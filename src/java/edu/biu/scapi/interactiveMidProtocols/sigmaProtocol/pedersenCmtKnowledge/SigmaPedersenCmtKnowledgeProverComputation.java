@@ -31,8 +31,9 @@ import org.bouncycastle.util.BigIntegers;
 
 import edu.biu.scapi.exceptions.CheatAttemptException;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.DlogBasedSigma;
-import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.SigmaProverComputation;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.SigmaBatchProverComputation;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.SigmaSimulator;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaBatchResponses;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaGroupElementMsg;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProverInput;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProtocolMsg;
@@ -48,7 +49,7 @@ import edu.biu.scapi.primitives.dlog.GroupElement;
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
  */
-public class SigmaPedersenCmtKnowledgeProverComputation implements SigmaProverComputation, DlogBasedSigma{
+public class SigmaPedersenCmtKnowledgeProverComputation implements SigmaBatchProverComputation, DlogBasedSigma{
 	
 	/*	
 	  This class computes the following calculations:
@@ -62,6 +63,7 @@ public class SigmaPedersenCmtKnowledgeProverComputation implements SigmaProverCo
 	private SecureRandom random;
 	private SigmaPedersenCmtKnowledgeProverInput input;	// Contains h, c, x, r.
 	private BigInteger alpha, beta;						//random values used in the protocol.
+	private SigmaBatchResponses batch;			// The state of the current batch of proofs.
 	
 	/**
 	 * Constructor that gets the underlying DlogGroup, soundness parameter and SecureRandom.
@@ -82,6 +84,7 @@ public class SigmaPedersenCmtKnowledgeProverComputation implements SigmaProverCo
 		}
 		
 		this.random = random;
+		batch = new SigmaBatchResponses(dlog.getOrder(), t);
 	}
 
 	/**
@@ -167,6 +170,48 @@ public class SigmaPedersenCmtKnowledgeProverComputation implements SigmaProverCo
 		
 	}
 	
+	/**
+	 * Computes the first messages of a batch of proofs, one for each of the given inputs.<p>
+	 * "SAMPLE random values alpha, beta <- Zq<p>
+	 *  COMPUTE a = (h^alpha)*(g^beta)" for each proof.<p>
+	 * The second messages of the batch should be computed by computeSecondMsgs. This replaces a single proof that was 
+	 * started by computeFirstMsg.
+	 * @param inputs each one MUST be an instance of SigmaPedersenCmtKnowledgeProverInput.
+	 * @return the computed messages, in the order of the inputs.
+	 * @throws IllegalArgumentException if one of the inputs is not an instance of SigmaPedersenCmtKnowledgeProverInput.
+	 */
+	public SigmaProtocolMsg[] computeFirstMsgs(SigmaProverInput[] inputs) {
+		batch.start(inputs.length);
+		SigmaProtocolMsg[] msgs = new SigmaProtocolMsg[inputs.length];
+		for (int i = 0; i < inputs.length; i++){
+			msgs[i] = computeFirstMsg(inputs[i]);
+			batch.set(i, new BigInteger[]{ input.getX(), input.getR() }, new BigInteger[]{ alpha, beta });
+		}
+		alpha = BigInteger.ZERO;
+		beta = BigInteger.ZERO;
+		return msgs;
+	}
+	
+	/**
+	 * Computes the second messages of the batch that was started by computeFirstMsgs.<p>
+	 * "COMPUTE u = alpha + ex mod q and v = beta + er mod q" for each proof. All the responses are computed together 
+	 * over packed vectors.
+	 * @param challenges the challenge of each proof, in the order of the inputs.
+	 * @return the computed messages.
+	 * @throws CheatAttemptException if the length of one of the challenges is not equal to the soundness parameter.
+	 * @throws IllegalArgumentException if the number of challenges is not the number of proofs in the batch.
+	 */
+	public SigmaProtocolMsg[] computeSecondMsgs(byte[][] challenges) throws CheatAttemptException {
+		//Compute u = alpha + ex mod q and v = beta + er mod q of all the proofs.
+		BigInteger[][] uv = batch.computeResponses(challenges);
+		
+		SigmaProtocolMsg[] msgs = new SigmaProtocolMsg[uv.length];
+		for (int i = 0; i < uv.length; i++){
+			msgs[i] = new SigmaPedersenCmtKnowledgeMsg(uv[i][0], uv[i][1]);
+		}
+		return msgs;
+	}
+	
 	/**
 	 * Checks if the given challenge length is equal to the soundness parameter.
 	 * @return true if the challenge length is t; false, otherwise. 
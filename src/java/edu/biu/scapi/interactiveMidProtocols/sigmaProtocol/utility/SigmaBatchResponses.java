@@ -0,0 +1,128 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility;
+
+import java.math.BigInteger;
+
+import edu.biu.scapi.exceptions.CheatAttemptException;
+import edu.biu.scapi.primitives.dlog.ScZqVectorOps;
+import edu.biu.scapi.primitives.dlog.ZqVectorOps;
+
+/**
+ * Holds the state of a batch of sigma proofs whose responses have the form z = r + e*w mod q, 
+ * and computes all the responses of the batch together. <p>
+ * 
+ * Each proof may have several responses, for example u = alpha + ex and v = beta + er in the Pedersen committed value proof. 
+ * The prover computes the first message of each proof and sets its witnesses and random values with {@link #set(int, BigInteger[], BigInteger[])}.
+ * Then {@link #computeResponses(byte[][])} computes the responses of all the proofs over packed vectors and deletes the random values.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class SigmaBatchResponses {
+	
+	private BigInteger q;
+	private int t;						// Soundness parameter in BITS.
+	private BigInteger[][] witnesses;	// The witnesses of each proof of the current batch, one for each response.
+	private BigInteger[][] randoms;		// The random values of each proof of the current batch, one for each response.
+	private ZqVectorOps zq;				// Arithmetic modulo q of the responses, created on first use.
+	
+	/**
+	 * @param q the order of the underlying Dlog group.
+	 * @param t the soundness parameter in BITS.
+	 */
+	public SigmaBatchResponses(BigInteger q, int t) {
+		this.q = q;
+		this.t = t;
+	}
+	
+	/**
+	 * Starts a new batch of proofs. The state of a previous batch is deleted.
+	 * @param numProofs the number of proofs in the batch.
+	 */
+	public void start(int numProofs) {
+		witnesses = new BigInteger[numProofs][];
+		randoms = new BigInteger[numProofs][];
+	}
+	
+	/**
+	 * Sets the values of one proof of the batch.
+	 * @param proof the index of the proof.
+	 * @param w the witnesses of the proof, one for each response.
+	 * @param r the random values of the proof, one for each response.
+	 */
+	public void set(int proof, BigInteger[] w, BigInteger[] r) {
+		witnesses[proof] = w;
+		randoms[proof] = r;
+	}
+	
+	/**
+	 * Computes "z = (r + ew) mod q" for each response of each proof of the batch.
+	 * @param challenges the challenge of each proof, in the order of the proofs.
+	 * @return the responses of each proof, in the order of its witnesses.
+	 * @throws CheatAttemptException if the length of one of the challenges is not equal to the soundness parameter.
+	 * @throws IllegalArgumentException if no batch was started or the number of challenges is not the number of proofs in the batch.
+	 */
+	public BigInteger[][] computeResponses(byte[][] challenges) throws CheatAttemptException {
+		if (randoms == null || challenges.length != randoms.length){
+			throw new IllegalArgumentException("there should be a challenge for each proof of the batch");
+		}
+		
+		int numProofs = challenges.length;
+		int numResponses = (numProofs == 0) ? 0 : randoms[0].length;
+		BigInteger[] e = new BigInteger[numProofs];
+		for (int i = 0; i < numProofs; i++){
+			//check the challenge validity.
+			if (challenges[i].length != t/8){
+				throw new CheatAttemptException("the length of the given challenge is differ from the soundness parameter");
+			}
+			e[i] = new BigInteger(1, challenges[i]);
+		}
+		
+		if (zq == null){
+			zq = ScZqVectorOps.create(q);
+		}
+		byte[] packedE = zq.pack(e);
+		BigInteger[][] responses = new BigInteger[numProofs][numResponses];
+		for (int j = 0; j < numResponses; j++){
+			BigInteger[] w = new BigInteger[numProofs];
+			BigInteger[] r = new BigInteger[numProofs];
+			for (int i = 0; i < numProofs; i++){
+				w[i] = witnesses[i][j];
+				r[i] = randoms[i][j];
+			}
+			BigInteger[] z = zq.unpack(zq.multiplyAdd(packedE, zq.pack(w), zq.pack(r), null));
+			for (int i = 0; i < numProofs; i++){
+				responses[i][j] = z[i];
+			}
+		}
+		
+		//Delete the random values.
+		witnesses = null;
+		randoms = null;
+		
+		return responses;
+	}
+}
@@ -326,11 +326,11 @@ public abstract class ElGamalAbs implements ElGamalEnc{
 		}
 		
 		//Calculates c1 = g^y and c2 = msg * h^y.
+		//Both exponentiations are computed together, so that groups that normalize points in batches do it once.
 		GroupElement generator = dlog.getGenerator();
-		GroupElement c1 = dlog.exponentiate(generator, r);
-		GroupElement hy = dlog.exponentiate(publicKey.getH(), r);
+		GroupElement[] powers = dlog.exponentiateMany(new GroupElement[]{generator, publicKey.getH()}, new BigInteger[]{r, r});
 		
-		return completeEncryption(c1, hy, plaintext);
+		return completeEncryption(powers[0], powers[1], plaintext);
 	}
 	
 	protected abstract AsymmetricCiphertext completeEncryption(GroupElement c1, GroupElement hy, Plaintext plaintext);
@@ -294,13 +294,16 @@ public class ScElGamalOnGroupElement extends ElGamalAbs implements AsymMultiplic
 			throw new IllegalArgumentException("the given random value must be in Zq");
 		}
 				
+		//Calculates g^w and h^w together.
+		GroupElement[] powers = dlog.exponentiateMany(new GroupElement[]{dlog.getGenerator(), publicKey.getH()}, new BigInteger[]{w, w});
+		
 		//Calculates u = g^w*u1*u2.
-		GroupElement gExpW = dlog.exponentiate(dlog.getGenerator(), w);
+		GroupElement gExpW = powers[0];
 		GroupElement gExpWmultU1 = dlog.multiplyGroupElements(gExpW, c1.getC1());
 		GroupElement u = dlog.multiplyGroupElements(gExpWmultU1, c2.getC1());
 		
 		//Calculates v = h^w*v1*v2.
-		GroupElement hExpW = dlog.exponentiate(publicKey.getH(), w);
+		GroupElement hExpW = powers[1];
 		GroupElement hExpWmultV1 = dlog.multiplyGroupElements(hExpW, c1.getC2());
 		GroupElement v = dlog.multiplyGroupElements(hExpWmultV1, c2.getC2());
 		
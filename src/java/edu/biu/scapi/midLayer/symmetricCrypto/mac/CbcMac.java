@@ -43,4 +43,26 @@ public interface CbcMac extends UniqueTagMac, PrfVaryingInputLength, UnlimitedTi
 	 * @param msgLength the length of the message in bytes.
 	 */
 	public void startMac(int msgLength);
+	
+	/**
+	 * Computes the mac of many messages of the same length and puts the tags in the given array, one after the other.
+	 * The tag of each message is equal to the result of mac on the same message.
+	 * @param msgs the messages, one after the other, starting at offset 0.
+	 * @param msgLen the length of each message in bytes.
+	 * @param numMsgs the number of messages.
+	 * @param tags array to put the tags in. Should have room for numMsgs tags after tagsOffset.
+	 * @param tagsOffset the offset within the tags array to put the first tag from.
+	 */
+	public void macMany(byte[] msgs, int msgLen, int numMsgs, byte[] tags, int tagsOffset);
+	
+	/**
+	 * Verifies the tags of many messages of the same length.
+	 * @param msgs the messages, one after the other, starting at offset 0.
+	 * @param msgLen the length of each message in bytes.
+	 * @param numMsgs the number of messages.
+	 * @param tags the tags to verify, one after the other.
+	 * @param tagsOffset the offset within the tags array of the first tag.
+	 * @return an array that holds in index i true if the i-th tag is the result of computing mac on the i-th message. false, otherwise.
+	 */
+	public boolean[] verifyMany(byte[] msgs, int msgLen, int numMsgs, byte[] tags, int tagsOffset);
 }
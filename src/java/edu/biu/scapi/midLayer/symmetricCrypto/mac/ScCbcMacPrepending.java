@@ -39,13 +39,17 @@ import javax.crypto.SecretKey;
 
 import edu.biu.scapi.exceptions.FactoriesException;
 import edu.biu.scapi.generals.Logging;
+import edu.biu.scapi.primitives.prf.CbcChainPrp;
 import edu.biu.scapi.primitives.prf.PrpFixed;
 import edu.biu.scapi.primitives.prf.PseudorandomFunction;
 import edu.biu.scapi.primitives.prf.bc.BcAES;
 import edu.biu.scapi.tools.Factories.PrfFactory;
 
 /**
- * Concrete class of CBC-Mac.
+ * Concrete class of CBC-Mac. <p>
+ * 
+ * If the underlying prp implements {@link CbcChainPrp}, the blocks of the message are chained by the native code in one call 
+ * instead of one call for each block, and macMany computes up to 8 independent chains side by side.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
@@ -198,31 +202,36 @@ public class ScCbcMacPrepending implements CbcMac {
 		if (!isKeySet()){
 			throw new IllegalStateException("no SecretKey was set");
 		}
-		try {
-			actualMsgLength = 0; // Resets the msg.
-			expectedMsgLength = msgLength; // Saves the msg length.
-
-			// Gets the bytes of the length.
-			byte[] len = BigInteger.valueOf(msgLength).toByteArray();
-
-			// Creates an array of size getMacSize, copies the length to it and
-			// pads the rest bytes with zeros.
-			byte[] prepending = new byte[getMacSize()];
-			System.arraycopy(len, 0, prepending, 0, len.length);
-			for (int i = len.length; i < getMacSize(); i++) {
-				prepending[i] = 0;
-			}
-			tag = new byte[getMacSize()];
-			// Computes the mac operation of the msg length - the pre-pended
-			// block of the mac computation.
-			prp.computeBlock(prepending, 0, tag, 0);
+		actualMsgLength = 0; // Resets the msg.
+		expectedMsgLength = msgLength; // Saves the msg length.
 
-			isMacStarted = true; // Sets the mac state to started.
+		tag = computePrepending(msgLength);
+		isMacStarted = true; // Sets the mac state to started.
+	}
+	
+	/**
+	 * Computes the mac operation of the msg length - the pre-pended block of the mac computation.
+	 * @param msgLength the length of the message in bytes.
+	 * @return the tag after the pre-pended block.
+	 */
+	private byte[] computePrepending(int msgLength){
+		// Gets the bytes of the length.
+		byte[] len = BigInteger.valueOf(msgLength).toByteArray();
+
+		// Creates an array of size getMacSize, copies the length to it and
+		// pads the rest bytes with zeros.
+		byte[] prepending = new byte[getMacSize()];
+		System.arraycopy(len, 0, prepending, 0, len.length);
+		
+		byte[] prependingTag = new byte[getMacSize()];
+		try {
+			prp.computeBlock(prepending, 0, prependingTag, 0);
 		} catch (IllegalBlockSizeException e) {
 			// Shouldn't occur since the tag is of size block size and the
 			// msgLength size is small.
 			Logging.getLogger().log(Level.WARNING, e.toString());
 		}
+		return prependingTag;
 	}
 
 	/**
@@ -264,18 +273,119 @@ public class ScCbcMacPrepending implements CbcMac {
 		byte[] macTag = mac(msg, offset, msgLength);
 
 		// Compares the real tag to the given tag.
-		// For code-security reasons, the comparison is fully performed. That is, even if we know
-		// already after the first few bits that the tag is not equal to the mac, we continue the
-		// checking until the end of the tag bits.
+		return tagsEqual(macTag, 0, tag, 0);
+	}
+	
+	/*
+	 * Compares the tag that starts at macOffset in macTags to the tag that starts at tagOffset in tags.
+	 * For code-security reasons, the comparison is fully performed. That is, even if we know
+	 * already after the first few bits that the tag is not equal to the mac, we continue the
+	 * checking until the end of the tag bits.
+	 */
+	private boolean tagsEqual(byte[] macTags, int macOffset, byte[] tags, int tagOffset){
 		boolean equal = true;
-		int length = macTag.length;
+		int length = getMacSize();
 		for (int i = 0; i < length; i++) {
-			if (macTag[i] != tag[i]) {
+			if (macTags[macOffset + i] != tags[tagOffset + i]) {
 				equal = false;
 			}
 		}
 		return equal;
 	}
+	
+	/**
+	 * Computes the mac of many messages of the same length and puts the tags in the given array, one after the other.
+	 * The tag of each message is equal to the result of mac on the same message. <p>
+	 * The pre-pended length block is the same for all the messages, so it is computed once. If the underlying prp implements 
+	 * CbcChainPrp, all the messages are chained in one native call.
+	 * @param msgs the messages, one after the other, starting at offset 0.
+	 * @param msgLen the length of each message in bytes.
+	 * @param numMsgs the number of messages.
+	 * @param tags array to put the tags in. Should have room for numMsgs tags after tagsOffset.
+	 * @param tagsOffset the offset within the tags array to put the first tag from.
+	 * @throws IllegalStateException if no secret key was set.
+	 */
+	public void macMany(byte[] msgs, int msgLen, int numMsgs, byte[] tags, int tagsOffset){
+		if (!isKeySet()){
+			throw new IllegalStateException("no SecretKey was set");
+		}
+		int macSize = getMacSize();
+		if ((msgLen < 0) || (numMsgs < 0) || ((long) msgLen * numMsgs > msgs.length) || 
+				(tagsOffset < 0) || ((long) macSize * numMsgs > tags.length - tagsOffset)){
+			throw new ArrayIndexOutOfBoundsException("wrong length for the given messages or tags buffer");
+		}
+		
+		byte[] prependingTag = computePrepending(msgLen);
+		
+		if (prp instanceof CbcChainPrp){
+			((CbcChainPrp) prp).computeCbcChains(prependingTag, msgs, 0, msgLen, numMsgs, tags, tagsOffset);
+		} else{
+			for (int i = 0; i < numMsgs; i++){
+				byte[] msgTag = prependingTag.clone();
+				chain(msgTag, msgs, i * msgLen, msgLen);
+				System.arraycopy(msgTag, 0, tags, tagsOffset + i * macSize, macSize);
+			}
+		}
+	}
+	
+	/**
+	 * Verifies the tags of many messages of the same length.
+	 * @param msgs the messages, one after the other, starting at offset 0.
+	 * @param msgLen the length of each message in bytes.
+	 * @param numMsgs the number of messages.
+	 * @param tags the tags to verify, one after the other.
+	 * @param tagsOffset the offset within the tags array of the first tag.
+	 * @return an array that holds in index i true if the i-th tag is the result of computing mac on the i-th message. false, otherwise.
+	 * @throws IllegalStateException if no secret key was set.
+	 */
+	public boolean[] verifyMany(byte[] msgs, int msgLen, int numMsgs, byte[] tags, int tagsOffset){
+		int macSize = getMacSize();
+		// The size of all the tags is computed in long, so that a large number of messages does not overflow it.
+		long tagsSize = (long) numMsgs * macSize;
+		if ((numMsgs < 0) || (tagsOffset < 0) || (tagsSize > tags.length - tagsOffset)){
+			throw new ArrayIndexOutOfBoundsException("wrong length for the given tags buffer");
+		}
+		// Calculates the macs on the msgs to get the real tags.
+		byte[] macTags = new byte[(int) tagsSize];
+		macMany(msgs, msgLen, numMsgs, macTags, 0);
+		
+		boolean[] results = new boolean[numMsgs];
+		for (int i = 0; i < numMsgs; i++){
+			results[i] = tagsEqual(macTags, i * macSize, tags, tagsOffset + i * macSize);
+		}
+		return results;
+	}
+	
+	/*
+	 * Chains the given blocks into the given chaining value. The last block is padded with zeros if the message is not aligned 
+	 * to the mac size. If the underlying prp implements CbcChainPrp, all the blocks are computed in one native call.
+	 */
+	private void chain(byte[] chainValue, byte[] msg, int offset, int msgLen){
+		if (prp instanceof CbcChainPrp){
+			// The chaining value is both the iv and the output.
+			((CbcChainPrp) prp).computeCbcChains(chainValue, msg, offset, msgLen, 1, chainValue, 0);
+			return;
+		}
+		
+		int macSize = getMacSize();
+		// Goes over the msg blocks.
+		for (int i = 0; i < msgLen; i += macSize) {
+			// Xores the tag with the current block in the message. A partial last block is xored as if it was padded with zeros.
+			// In order to avoid unnecessary allocation of memory, we put the xor-ed bytes into the chaining value.
+			int blockLen = Math.min(macSize, msgLen - i);
+			for (int j = 0; j < blockLen; j++) {
+				chainValue[j] = (byte) (chainValue[j] ^ msg[offset + i + j]);
+			}
+			try {
+				// Computes the tag of the current block. Puts the result into
+				// the chaining value to avoid unnecessary allocating and copying of arrays.
+				prp.computeBlock(chainValue, 0, chainValue, 0);
+			} catch (IllegalBlockSizeException e) {
+				// Shouldn't occur since the arguments are of size block size.
+				Logging.getLogger().log(Level.WARNING, e.toString());
+			}
+		}
+	}
 
 	/**
 	 * Adds the byte array to the existing message to mac.
@@ -299,29 +409,11 @@ public class ScCbcMacPrepending implements CbcMac {
 		if ((msgLen % getMacSize()) != 0) {
 			throw new IllegalArgumentException("message should be aligned to the mac size, " + getMacSize() + " bytes");
 		}
-		// Calculates the number of blocks of size mac size.
-		int rounds = msgLen / getMacSize();
-
-		// Goes over the msg blocks.
-		for (int i = 0; i < rounds; i++) {
-			// Xores the tag with the current block in the message.
-			// In order to avoid unnecessary allocation of memory, we put the xor-ed bytes into tag.
-			for (int j = 0; j < getMacSize(); j++) {
-				tag[j] = (byte) (tag[j] ^ msg[j + i * getMacSize()]);
-			}
-			try {
-				// Computes the tag of the current block. Puts the result into
-				// tag to avoid unnecessary allocating and copying of arrays.
-				prp.computeBlock(tag, 0, tag, 0);
-
-				// Increases the actual message size.
-				actualMsgLength += getMacSize();
-			} catch (IllegalBlockSizeException e) {
-				// Shouldn't occur since the arguments are of size block size.
-				e.printStackTrace();
-				Logging.getLogger().log(Level.WARNING, e.toString());
-			}
-		}
+		// Chains the msg blocks into the tag.
+		chain(tag, msg, offset, msgLen);
+		
+		// Increases the actual message size.
+		actualMsgLength += msgLen;
 	}
 
 	/**
@@ -341,46 +433,9 @@ public class ScCbcMacPrepending implements CbcMac {
 			throw new IllegalStateException("to start the mac call the startMac function");
 		}
 		
-		//Number of bytes left to be aligned to the block size.
-		int pad = 0;
-		
-		//Msg is not aligned to the underlying prp's block size.
-		if ((msgLen % getMacSize()) != 0){
-			pad = getMacSize() - (msgLen % getMacSize());
-		}
-		
-		//Creates a new array that padded to be aligned to the mac size.
-		byte[] paddedMsg = new byte[msgLen + pad];
-		//copy the msg to the beginning of the padded array.
-		System.arraycopy(msg, offset, paddedMsg, 0, msgLen);
+		//Chains the msg blocks into the tag. If msg is not aligned to the underlying prp's block size, the last block is padded with zeroes.
+		chain(tag, msg, offset, msgLen);
 		
-		//If msg is not aligned to the underlying prp's block size, pads with zeroes.
-		if (pad > 0){
-			for( int i=0; i<pad; i++){
-				paddedMsg[msgLen+i] = 0;
-			}
-		}
-		//Number of blocks in size macSize.
-		int rounds = (msgLen+pad) / getMacSize();
-	
-		//Goes over the msg blocks.
-		for( int i=0; i<rounds; i++){
-			
-			//Xores the tag with the current block in the message.
-			//In order to avoid unnecessary allocation of memory, we put the xor-ed bytes into tag.
-			for (int j=0; j<getMacSize(); j++){
-				tag[j] = (byte) (tag[j] ^ paddedMsg[j+i*getMacSize()]);
-			}
-			try {
-				//Computes the tag of the current block. Puts the result into tag to avoid unnecessary allocating and copying of arrays.
-				prp.computeBlock(tag, 0, tag, 0);
-				
-			} catch (IllegalBlockSizeException e) {
-				// Shouldn't occur since the arguments are of size block size
-				e.printStackTrace();
-				Logging.getLogger().log(Level.WARNING, e.toString());
-			} 
-		}
 		//Increases the actual message size.
 		actualMsgLength += msgLen;
 		//If the given message is not in the expected size - throws exception.
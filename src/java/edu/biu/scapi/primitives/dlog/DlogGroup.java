@@ -145,6 +145,16 @@ public interface DlogGroup {
 	 */
 	public GroupElement exponentiate(GroupElement base, BigInteger exponent) throws IllegalArgumentException;
 	
+	/**
+	 * Raises each base to the respective exponent. The result is the same as calling exponentiate for each base, 
+	 * but some groups compute the results together more quickly.
+	 * @param bases
+	 * @param exponents one for each base
+	 * @return an array that holds bases[i]^exponents[i] in the i-th place
+	 * @throws IllegalArgumentException if one of the bases doesn't match the group or the arrays lengths are different
+	 */
+	public GroupElement[] exponentiateMany(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException;
+	
 	/**
 	 * Multiplies two GroupElements
 	 * @param groupElement1
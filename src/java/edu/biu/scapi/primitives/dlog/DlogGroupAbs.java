@@ -143,6 +143,21 @@ public abstract class DlogGroupAbs implements primeOrderSubGroup{
 
 	}
 
+	/*
+	 * Raises each base to the respective exponent, one exponentiation at a time.
+	 * Groups that can compute the results together override it.
+	 */
+	public GroupElement[] exponentiateMany(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException {
+		if (bases.length != exponents.length){
+			throw new IllegalArgumentException("the number of bases and exponents should be equal");
+		}
+		GroupElement[] results = new GroupElement[bases.length];
+		for (int i = 0; i < bases.length; i++) {
+			results[i] = exponentiate(bases[i], exponents[i]);
+		}
+		return results;
+	}
+
 	/*
 	 * Computes the simultaneousMultiplyExponentiate using a naive algorithm
 	 */
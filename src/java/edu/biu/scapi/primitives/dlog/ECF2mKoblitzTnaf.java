@@ -0,0 +1,212 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.dlog;
+
+import java.math.BigInteger;
+
+/**
+ * The tau-adic representation of scalars on a Koblitz curve y^2 + xy = x^3 + ax^2 + 1 over GF(2^m), for example K-163, 
+ * K-233 and K-283.<p>
+ * 
+ * The Frobenius map tau(x, y) = (x^2, y^2) is an endomorphism of the curve that satisfies tau^2 - mu*tau + 2 = 0, where 
+ * mu = 1 if a = 1 and mu = -1 if a = 0. A scalar k is written as a width-w tau-adic NAF, sum of u_i*tau^i, so that k*P 
+ * can be computed with Frobenius maps, which cost three squarings, instead of doublings. Every non zero digit u is odd and 
+ * stands for alpha_u*P, where alpha_u = u mod tau^w. <p>
+ * 
+ * The scalar is first reduced modulo tau^m - 1, which acts as zero on every point of the curve, so the result is correct 
+ * also for points that are not in the main subgroup. The recoding follows Solinas, "Efficient Arithmetic on Koblitz 
+ * Curves", Designs, Codes and Cryptography 19, 2000. 
+ * Elements of Z[tau] are held as pairs {r0, r1} that stand for r0 + r1*tau.<p>
+ * 
+ * The number of digits and their signs depend on the scalar, and so does the time of the exponentiation that uses them. 
+ * The recoding is therefore used only for public scalars, see OpenSSLDlogECF2m.exponentiateWithPublicExponent.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class ECF2mKoblitzTnaf {
+
+	private int m;				//The degree of the field.
+	private int a;				//The coefficient a of the curve.
+	private int w;				//The width of the expansion.
+	private BigInteger mu;
+	private BigInteger[] eta;	//tau^m - 1.
+	private BigInteger tw;		//The image of tau in Z / 2^w.
+	private BigInteger[][] alphas;	//alpha_u of u = 1, 3, ..., 2^(w-1) - 1.
+	
+	/**
+	 * Constructor that computes the values that are used in the recoding.
+	 * @param m the degree of the field.
+	 * @param a the coefficient a of the curve, 0 or 1.
+	 * @param w the width of the expansion, at least 2 and at most 8.
+	 */
+	public ECF2mKoblitzTnaf(int m, int a, int w){
+		if (a != 0 && a != 1){
+			throw new IllegalArgumentException("a should be 0 or 1");
+		}
+		if (w < 2 || w > 8){
+			throw new IllegalArgumentException("w should be between 2 and 8");
+		}
+		this.m = m;
+		this.a = a;
+		this.w = w;
+		mu = (a == 1) ? BigInteger.ONE : BigInteger.ONE.negate();
+		
+		//The Lucas sequence U_0 = 0, U_1 = 1, U_(i+1) = mu*U_i - 2*U_(i-1), with tau^i = U_i*tau - 2*U_(i-1).
+		int length = Math.max(m, w) + 1;
+		BigInteger[] u = new BigInteger[length];
+		u[0] = BigInteger.ZERO;
+		u[1] = BigInteger.ONE;
+		for (int i = 1; i < length - 1; i++){
+			u[i + 1] = mu.multiply(u[i]).subtract(u[i - 1].shiftLeft(1));
+		}
+		
+		eta = new BigInteger[]{ u[m - 1].shiftLeft(1).negate().subtract(BigInteger.ONE), u[m] };
+		BigInteger twoW = BigInteger.ONE.shiftLeft(w);
+		tw = u[w - 1].shiftLeft(1).multiply(u[w].modInverse(twoW)).mod(twoW);
+		
+		BigInteger[] tauW = { u[w - 1].shiftLeft(1).negate(), u[w] };
+		alphas = new BigInteger[1 << (w - 2)][];
+		for (int i = 0; i < alphas.length; i++){
+			alphas[i] = reduce(new BigInteger[]{ BigInteger.valueOf(2 * i + 1), BigInteger.ZERO }, tauW);
+		}
+	}
+	
+	/**
+	 * @return the degree of the field.
+	 */
+	public int getM(){
+		return m;
+	}
+	
+	/**
+	 * @return the coefficient a of the curve.
+	 */
+	public int getA(){
+		return a;
+	}
+	
+	/**
+	 * @return the width of the expansion.
+	 */
+	public int getWidth(){
+		return w;
+	}
+	
+	/**
+	 * Returns the width-2 tau-adic NAF of every alpha_u, which is used to compute the points alpha_u*P.
+	 * @return an array that holds the digits of alpha_1, alpha_3, ..., alpha_(2^(w-1)-1), least significant digit first.
+	 */
+	public byte[][] getAlphaDigits(){
+		byte[][] digits = new byte[alphas.length][];
+		for (int i = 0; i < alphas.length; i++){
+			digits[i] = recode(alphas[i], 2);
+		}
+		return digits;
+	}
+	
+	/**
+	 * Computes the width-w tau-adic NAF of the given scalar.
+	 * @param k the scalar. May be negative.
+	 * @return the digits of the expansion, least significant digit first. The expansion has about m digits, and about 
+	 * one in w + 1 of them is non zero.
+	 */
+	public byte[] recode(BigInteger k){
+		return recode(reduce(new BigInteger[]{ k, BigInteger.ZERO }, eta), w);
+	}
+	
+	/**
+	 * Computes the width-width tau-adic NAF of the given element of Z[tau].
+	 */
+	private byte[] recode(BigInteger[] r, int width){
+		BigInteger r0 = r[0], r1 = r[1];
+		BigInteger twoW = BigInteger.ONE.shiftLeft(width);
+		BigInteger four = BigInteger.valueOf(4);
+		byte[] digits = new byte[m + 2 * width + 8];
+		int length = 0;
+		while (r0.signum() != 0 || r1.signum() != 0){
+			if (length == digits.length){
+				byte[] longer = new byte[2 * length];
+				System.arraycopy(digits, 0, longer, 0, length);
+				digits = longer;
+			}
+			
+			int digit = 0;
+			if (r0.testBit(0)){
+				if (width == 2){
+					//u = r0 - 2*r1 mods 4.
+					digit = 2 - r0.subtract(r1.shiftLeft(1)).mod(four).intValue();
+					r0 = r0.subtract(BigInteger.valueOf(digit));
+				} else{
+					//u = r0 + r1*tw mods 2^w, and r0 + r1*tau is replaced by r0 + r1*tau - u, where u stands for +-alpha_|u|.
+					digit = r0.add(r1.multiply(tw)).mod(twoW).intValue();
+					if (digit >= (1 << (width - 1))){
+						digit -= 1 << width;
+					}
+					BigInteger[] alpha = alphas[Math.abs(digit) / 2];
+					if (digit > 0){
+						r0 = r0.subtract(alpha[0]);
+						r1 = r1.subtract(alpha[1]);
+					} else{
+						r0 = r0.add(alpha[0]);
+						r1 = r1.add(alpha[1]);
+					}
+				}
+			}
+			digits[length++] = (byte) digit;
+			
+			//Divide by tau: (r0 + r1*tau) / tau = r1 + mu*r0/2 - (r0/2)*tau. r0 is even here.
+			BigInteger half = r0.shiftRight(1);
+			r0 = r1.add(mu.multiply(half));
+			r1 = half.negate();
+		}
+		
+		byte[] result = new byte[length];
+		System.arraycopy(digits, 0, result, 0, length);
+		return result;
+	}
+	
+	/**
+	 * Returns the remainder of k modulo d in Z[tau], which has a small norm.
+	 */
+	private BigInteger[] reduce(BigInteger[] k, BigInteger[] d){
+		//Divide k by d by multiplying with the conjugate of d and dividing by the norm, rounding each coordinate.
+		BigInteger norm = d[0].multiply(d[0]).add(mu.multiply(d[0]).multiply(d[1])).add(d[1].multiply(d[1]).shiftLeft(1));
+		BigInteger[] conjugate = { d[0].add(mu.multiply(d[1])), d[1].negate() };
+		BigInteger[] numerator = multiply(k, conjugate);
+		BigInteger[] quotient = { ECScalarArithmetic.roundedDivide(numerator[0], norm), ECScalarArithmetic.roundedDivide(numerator[1], norm) };
+		BigInteger[] product = multiply(quotient, d);
+		return new BigInteger[]{ k[0].subtract(product[0]), k[1].subtract(product[1]) };
+	}
+	
+	/**
+	 * @return the product x*y in Z[tau], using tau^2 = mu*tau - 2.
+	 */
+	private BigInteger[] multiply(BigInteger[] x, BigInteger[] y){
+		BigInteger high = x[1].multiply(y[1]);
+		return new BigInteger[]{ x[0].multiply(y[0]).subtract(high.shiftLeft(1)), 
+								 x[0].multiply(y[1]).add(x[1].multiply(y[0])).add(mu.multiply(high)) };
+	}
+}
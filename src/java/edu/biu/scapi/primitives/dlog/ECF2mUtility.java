@@ -179,6 +179,28 @@ public class ECF2mUtility {
 		return groupParams;
 	}
 	
+	/**
+	 * Returns the tau-adic recoding of the curve, if it is one of the Koblitz curves K-163, K-233 or K-283.<p>
+	 * The implementation that uses it should still check that the field polynomial is the standard one of the degree.
+	 * @param params elliptic curve over F2m parameters
+	 * @return the recoding with width 4, or null if the curve is not a supported Koblitz curve.
+	 */
+	public ECF2mKoblitzTnaf getKoblitzTnaf(GroupParams params){
+		if (!(params instanceof ECF2mKoblitz)){
+			return null;
+		}
+		ECF2mKoblitz koblitz = (ECF2mKoblitz) params;
+		int m = koblitz.getM();
+		if (m != 163 && m != 233 && m != 283){
+			return null;
+		}
+		BigInteger a = koblitz.getA();
+		if (!koblitz.getB().equals(BigInteger.ONE) || a.bitLength() > 1){
+			return null;
+		}
+		return new ECF2mKoblitzTnaf(m, a.intValue(), 4);
+	}
+	
 	/**
 	 * @return the type of the group - ECF2m
 	 */
@@ -0,0 +1,160 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.dlog;
+
+import java.math.BigInteger;
+
+/**
+ * The GLV endomorphism of an elliptic curve over Fp of the form y^2 = x^3 + b, for example secp256k1.<p>
+ * 
+ * If p = 1 mod 3 and the group order q = 1 mod 3, the map phi(x, y) = (beta*x, y), where beta is a non trivial cube root 
+ * of unity mod p, is an endomorphism of the curve that acts on the group as multiplication by lambda, a non trivial cube 
+ * root of unity mod q. Computing phi costs a single field multiplication. <p>
+ * 
+ * A scalar k is split into k1 + k2*lambda = k mod q, where k1 and k2 are about half the length of q, so that 
+ * k*P = k1*P + k2*phi(P) can be computed as a simultaneous multiplication with half the number of doublings.
+ * The decomposition follows Gallant, Lambert and Vanstone, "Faster Point Multiplication on Elliptic Curves with 
+ * Efficient Endomorphisms", Crypto 2001.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class ECFpGlvEndomorphism {
+
+	private static final BigInteger THREE = BigInteger.valueOf(3);
+	
+	private BigInteger q;		//The group order.
+	private BigInteger beta;	//Cube root of unity mod p.
+	private BigInteger lambda;	//Cube root of unity mod q, such that phi(P) = lambda*P.
+	
+	//Two short vectors (a1, b1), (a2, b2) of the lattice {(x, y) : x + y*lambda = 0 mod q}.
+	private BigInteger a1, b1, a2, b2;
+	
+	/**
+	 * Constructor that sets the endomorphism and computes the lattice basis used in the scalar decomposition.<p>
+	 * The constructor does not check that beta and lambda match each other on the curve, 
+	 * see {@link ECFpUtility#getGlvEndomorphismCandidates(ECFpGroupParams)}.
+	 * @param q the group order.
+	 * @param beta a non trivial cube root of unity mod p.
+	 * @param lambda the non trivial cube root of unity mod q that matches beta.
+	 */
+	public ECFpGlvEndomorphism(BigInteger q, BigInteger beta, BigInteger lambda){
+		this.q = q;
+		this.beta = beta;
+		this.lambda = lambda;
+		
+		//Run the extended euclidean algorithm on q and lambda. Each step gives s*q + t*lambda = r, so (r, -t) is in the lattice.
+		//Stop at the first remainder that is smaller than sqrt(q).
+		BigInteger sqrtQ = sqrt(q);
+		BigInteger rPrev = q, r = lambda;
+		BigInteger tPrev = BigInteger.ZERO, t = BigInteger.ONE;
+		while (r.compareTo(sqrtQ) >= 0){
+			BigInteger quotient = rPrev.divide(r);
+			BigInteger rNext = rPrev.subtract(quotient.multiply(r));
+			BigInteger tNext = tPrev.subtract(quotient.multiply(t));
+			rPrev = r;
+			r = rNext;
+			tPrev = t;
+			t = tNext;
+		}
+		a1 = r;
+		b1 = t.negate();
+		
+		//The second vector is the shorter of the vectors of the previous and the next steps.
+		BigInteger quotient = rPrev.divide(r);
+		BigInteger rNext = rPrev.subtract(quotient.multiply(r));
+		BigInteger tNext = tPrev.subtract(quotient.multiply(t));
+		if (rPrev.pow(2).add(tPrev.pow(2)).compareTo(rNext.pow(2).add(tNext.pow(2))) <= 0){
+			a2 = rPrev;
+			b2 = tPrev.negate();
+		} else{
+			a2 = rNext;
+			b2 = tNext.negate();
+		}
+	}
+	
+	/**
+	 * @return beta, the cube root of unity mod p such that phi(x, y) = (beta*x, y).
+	 */
+	public BigInteger getBeta(){
+		return beta;
+	}
+	
+	/**
+	 * @return lambda, the cube root of unity mod q such that phi(P) = lambda*P.
+	 */
+	public BigInteger getLambda(){
+		return lambda;
+	}
+	
+	/**
+	 * Splits the given scalar into two scalars of about half the length of the group order.
+	 * @param k the scalar to split. May be negative or bigger than the group order.
+	 * @return an array that holds k1 and k2 such that k1 + k2*lambda = k mod q. k1 and k2 may be negative.
+	 */
+	public BigInteger[] decompose(BigInteger k){
+		k = k.mod(q);
+		BigInteger c1 = ECScalarArithmetic.roundedDivide(b2.multiply(k), q);
+		BigInteger c2 = ECScalarArithmetic.roundedDivide(b1.negate().multiply(k), q);
+		BigInteger k1 = k.subtract(c1.multiply(a1)).subtract(c2.multiply(a2));
+		BigInteger k2 = c1.multiply(b1).add(c2.multiply(b2)).negate();
+		return new BigInteger[]{ k1, k2 };
+	}
+	
+	/**
+	 * Returns the non trivial cube roots of unity mod the given prime.
+	 * @param prime a prime number.
+	 * @return the two non trivial cube roots of unity, or null if prime != 1 mod 3 and there are none.
+	 */
+	public static BigInteger[] cubeRootsOfUnity(BigInteger prime){
+		if (!prime.mod(THREE).equals(BigInteger.ONE)){
+			return null;
+		}
+		
+		//g^((prime-1)/3) is a cube root of unity for every g. It is non trivial for two thirds of the g's.
+		BigInteger exponent = prime.subtract(BigInteger.ONE).divide(THREE);
+		for (BigInteger g = BigInteger.valueOf(2); ; g = g.add(BigInteger.ONE)){
+			BigInteger root = g.modPow(exponent, prime);
+			if (!root.equals(BigInteger.ONE)){
+				return new BigInteger[]{ root, root.multiply(root).mod(prime) };
+			}
+		}
+	}
+	
+	/**
+	 * @return floor(sqrt(n)), for a positive n.
+	 */
+	private static BigInteger sqrt(BigInteger n){
+		//Newton iteration, starting above the root.
+		BigInteger x = BigInteger.ONE.shiftLeft(n.bitLength() / 2 + 1);
+		while (true){
+			BigInteger y = x.add(n.divide(x)).shiftRight(1);
+			if (y.compareTo(x) >= 0){
+				return x;
+			}
+			x = y;
+		}
+	}
+}
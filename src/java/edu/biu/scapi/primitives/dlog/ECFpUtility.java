@@ -364,6 +364,28 @@ public class ECFpUtility {
 		return groupParams;
 	}
 	
+	/**
+	 * Returns the GLV endomorphisms that the curve may have.<p>
+	 * A curve of the form y^2 = x^3 + b with p = 1 mod 3 and q = 1 mod 3 has the endomorphism phi(x, y) = (beta*x, y), that 
+	 * acts on the group as multiplication by lambda. Which of the two cube roots of unity mod q matches beta can only be found 
+	 * by computing on the curve, so both candidates are returned and the caller keeps the one with phi(G) = lambda*G.
+	 * @param params elliptic curve over Fp parameters
+	 * @return the candidate endomorphisms, or an empty array if the curve has no such endomorphism.
+	 */
+	public ECFpGlvEndomorphism[] getGlvEndomorphismCandidates(ECFpGroupParams params){
+		if (params.getA().mod(params.getP()).signum() != 0){
+			return new ECFpGlvEndomorphism[0];
+		}
+		BigInteger[] betas = ECFpGlvEndomorphism.cubeRootsOfUnity(params.getP());
+		BigInteger[] lambdas = ECFpGlvEndomorphism.cubeRootsOfUnity(params.getQ());
+		if (betas == null || lambdas == null){
+			return new ECFpGlvEndomorphism[0];
+		}
+		
+		return new ECFpGlvEndomorphism[]{ new ECFpGlvEndomorphism(params.getQ(), betas[0], lambdas[0]), 
+										  new ECFpGlvEndomorphism(params.getQ(), betas[0], lambdas[1]) };
+	}
+	
 	/**
 	 * @return the type of the group - ECFp
 	 */
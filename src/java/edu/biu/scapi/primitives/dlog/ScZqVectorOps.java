@@ -0,0 +1,234 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+package edu.biu.scapi.primitives.dlog;
+
+import java.math.BigInteger;
+
+import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLZqVectorOps;
+
+/**
+ * Implementation of {@link ZqVectorOps} with BigInteger. <p>
+ * 
+ * It works with any modulus and needs no native library, so it is used where the native implementation 
+ * {@link OpenSSLZqVectorOps} cannot be loaded. See {@link #create(BigInteger)}.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class ScZqVectorOps implements ZqVectorOps {
+
+	protected BigInteger q;
+	protected int elementSize;	//The number of bytes of each element.
+	
+	protected static final int ADD = 0;
+	protected static final int SUBTRACT = 1;
+	protected static final int MULTIPLY = 2;
+	protected static final int MULTIPLY_ADD = 3;
+	
+	/**
+	 * Creates the arithmetic modulo the given q.
+	 * @param q the modulus.
+	 * @throws IllegalArgumentException if q is smaller than 2.
+	 */
+	public ScZqVectorOps(BigInteger q) {
+		if (q.compareTo(BigInteger.ONE) <= 0){
+			throw new IllegalArgumentException("the modulus should be bigger than 1");
+		}
+		this.q = q;
+		elementSize = (q.bitLength() + 7) / 8;
+	}
+	
+	/**
+	 * Creates the arithmetic modulo the given q, using the native OpenSSL implementation if its library can be loaded.
+	 * @param q the modulus.
+	 * @return the arithmetic modulo q.
+	 * @throws IllegalArgumentException if q is smaller than 2.
+	 */
+	public static ZqVectorOps create(BigInteger q) {
+		try {
+			return new OpenSSLZqVectorOps(q);
+		} catch (LinkageError e) {
+			//The OpenSSLJavaInterface library is not available.
+			return new ScZqVectorOps(q);
+		}
+	}
+	
+	@Override
+	public BigInteger getModulus() {
+		return q;
+	}
+	
+	@Override
+	public int getElementSize() {
+		return elementSize;
+	}
+	
+	@Override
+	public byte[] pack(BigInteger... values) {
+		byte[] packed = new byte[values.length * elementSize];
+		for (int i = 0; i < values.length; i++) {
+			set(packed, i, values[i]);
+		}
+		return packed;
+	}
+	
+	@Override
+	public void set(byte[] packed, int index, BigInteger value) {
+		byte[] bytes = value.mod(q).toByteArray();
+		//toByteArray may add a sign byte, which is always zero here.
+		int length = Math.min(bytes.length, elementSize);
+		int offset = (index + 1) * elementSize;
+		for (int i = index * elementSize; i < offset - length; i++) {
+			packed[i] = 0;
+		}
+		System.arraycopy(bytes, bytes.length - length, packed, offset - length, length);
+	}
+	
+	@Override
+	public BigInteger get(byte[] packed, int index) {
+		byte[] bytes = new byte[elementSize];
+		System.arraycopy(packed, index * elementSize, bytes, 0, elementSize);
+		return new BigInteger(1, bytes);
+	}
+	
+	@Override
+	public BigInteger[] unpack(byte[] packed) {
+		BigInteger[] values = new BigInteger[size(packed)];
+		for (int i = 0; i < values.length; i++) {
+			values[i] = get(packed, i);
+		}
+		return values;
+	}
+	
+	@Override
+	public byte[] add(byte[] a, byte[] b, byte[] result) {
+		return operate(ADD, a, b, null, result);
+	}
+	
+	@Override
+	public byte[] subtract(byte[] a, byte[] b, byte[] result) {
+		return operate(SUBTRACT, a, b, null, result);
+	}
+	
+	@Override
+	public byte[] multiply(byte[] a, byte[] b, byte[] result) {
+		return operate(MULTIPLY, a, b, null, result);
+	}
+	
+	@Override
+	public byte[] multiplyAdd(byte[] a, byte[] b, byte[] c, byte[] result) {
+		return operate(MULTIPLY_ADD, a, b, c, result);
+	}
+	
+	@Override
+	public byte[] invertMany(byte[] a, byte[] result) {
+		int num = size(a);
+		result = checkResult(result, num);
+		checkReduced(a);
+		
+		BigInteger[] values = unpack(a);
+		for (int i = 0; i < num; i++) {
+			set(result, i, values[i].modInverse(q));
+		}
+		return result;
+	}
+	
+	/**
+	 * Checks the operands and computes the given operation with BigInteger.
+	 */
+	protected byte[] operate(int operation, byte[] a, byte[] b, byte[] c, byte[] result) {
+		int num = size(a);
+		checkOperand(b, num);
+		if (operation == MULTIPLY_ADD){
+			checkOperand(c, num);
+		}
+		result = checkResult(result, num);
+		
+		checkReduced(a);
+		checkReduced(b);
+		BigInteger[] x = unpack(a);
+		BigInteger[] y = unpack(b);
+		BigInteger[] z = null;
+		if (operation == MULTIPLY_ADD){
+			checkReduced(c);
+			z = unpack(c);
+		}
+		for (int i = 0; i < num; i++) {
+			BigInteger yi = y[(y.length == 1) ? 0 : i];
+			BigInteger value;
+			switch (operation) {
+			case ADD:
+				value = x[i].add(yi);
+				break;
+			case SUBTRACT:
+				value = x[i].subtract(yi);
+				break;
+			case MULTIPLY:
+				value = x[i].multiply(yi);
+				break;
+			default:
+				value = x[i].multiply(yi).add(z[(z.length == 1) ? 0 : i]);
+			}
+			set(result, i, value);
+		}
+		return result;
+	}
+	
+	/**
+	 * @return the number of elements in the given vector.
+	 */
+	protected int size(byte[] packed) {
+		if (packed.length % elementSize != 0){
+			throw new IllegalArgumentException("the vector should hold whole elements of " + elementSize + " bytes");
+		}
+		return packed.length / elementSize;
+	}
+	
+	protected void checkOperand(byte[] operand, int num) {
+		if (operand.length != num * elementSize && operand.length != elementSize){
+			throw new IllegalArgumentException("the vectors should have the same number of elements, or a single element");
+		}
+	}
+	
+	protected byte[] checkResult(byte[] result, int num) {
+		if (result == null){
+			return new byte[num * elementSize];
+		}
+		if (result.length < num * elementSize){
+			throw new IllegalArgumentException("the result array is too short");
+		}
+		return result;
+	}
+	
+	private void checkReduced(byte[] packed) {
+		for (BigInteger value : unpack(packed)) {
+			if (value.compareTo(q) >= 0){
+				throw new IllegalArgumentException("the elements should be smaller than the modulus");
+			}
+		}
+	}
+}
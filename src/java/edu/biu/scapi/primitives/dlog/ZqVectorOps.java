@@ -0,0 +1,114 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+package edu.biu.scapi.primitives.dlog;
+
+import java.math.BigInteger;
+
+/**
+ * Arithmetic modulo q over vectors of elements, where q is usually the order of a Dlog group. <p>
+ * 
+ * The elements of a vector are packed in one byte array, each one in getElementSize() bytes, big endian. Each operation is 
+ * done on whole vectors, which is useful where many responses of the form z = r + e*w mod q are computed, as in batches of 
+ * sigma protocols. <p>
+ * 
+ * {@link ScZqVectorOps} implements the operations with BigInteger, and {@link edu.biu.scapi.primitives.dlog.openSSL.OpenSSLZqVectorOps}
+ * implements them natively.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public interface ZqVectorOps {
+	
+	/**
+	 * @return the modulus.
+	 */
+	public BigInteger getModulus();
+	
+	/**
+	 * @return the number of bytes of each element in the packed vectors.
+	 */
+	public int getElementSize();
+	
+	/**
+	 * Packs the given values into a vector. Each value is reduced modulo q, so negative values are allowed.
+	 * @param values the values to pack.
+	 * @return the packed vector.
+	 */
+	public byte[] pack(BigInteger... values);
+	
+	/**
+	 * Puts the given value, reduced modulo q, in the given index of the vector.
+	 */
+	public void set(byte[] packed, int index, BigInteger value);
+	
+	/**
+	 * @return the element in the given index of the vector.
+	 */
+	public BigInteger get(byte[] packed, int index);
+	
+	/**
+	 * @return the elements of the given vector.
+	 */
+	public BigInteger[] unpack(byte[] packed);
+	
+	/**
+	 * Computes a[i] + b[i] mod q for each index i.
+	 * @param a the first vector.
+	 * @param b the second vector. May hold a single element, which is then used for every index.
+	 * @param result the array to put the results in, or null to allocate a new one. May be a or b.
+	 * @return the result vector.
+	 * @throws IllegalArgumentException if the vectors sizes do not match or one of the elements is not smaller than q.
+	 */
+	public byte[] add(byte[] a, byte[] b, byte[] result);
+	
+	/**
+	 * Computes a[i] - b[i] mod q for each index i. The parameters are as in {@link #add(byte[], byte[], byte[])}.
+	 */
+	public byte[] subtract(byte[] a, byte[] b, byte[] result);
+	
+	/**
+	 * Computes a[i] * b[i] mod q for each index i. The parameters are as in {@link #add(byte[], byte[], byte[])}.
+	 */
+	public byte[] multiply(byte[] a, byte[] b, byte[] result);
+	
+	/**
+	 * Computes a[i] * b[i] + c[i] mod q for each index i, for example the responses z = e*w + r of sigma protocols.
+	 * b and c may each hold a single element, which is then used for every index. 
+	 * The other parameters are as in {@link #add(byte[], byte[], byte[])}.
+	 */
+	public byte[] multiplyAdd(byte[] a, byte[] b, byte[] c, byte[] result);
+	
+	/**
+	 * Computes the inverse modulo q of each element of the given vector.
+	 * @param a the elements to invert.
+	 * @param result the array to put the inverses in, or null to allocate a new one. May be a.
+	 * @return the inverses.
+	 * @throws ArithmeticException if one of the elements is not invertible modulo q.
+	 * @throws IllegalArgumentException if the result array is too short or one of the elements is not smaller than q.
+	 */
+	public byte[] invertMany(byte[] a, byte[] result);
+}
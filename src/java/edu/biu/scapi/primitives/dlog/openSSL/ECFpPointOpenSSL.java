@@ -109,6 +109,22 @@ public class ECFpPointOpenSSL implements ECFpPoint{
 		}
 	}
 	
+	/**
+	 * Constructor that gets a native point together with its affine coordinates, that were already computed. 
+	 * Used when many points are normalized at once, see {@link OpenSSLAdapterDlogEC#getAffineCoordinates(long[])}.
+	 * @param point native element that need to be set.
+	 * @param coordinates the x and y coordinates of the point, or null if the point is the infinity.
+	 */
+	ECFpPointOpenSSL(long point, BigInteger[] coordinates) {
+		this.point = point;
+		
+		//In case of infinity, there are no coordinates and we set them to null.
+		if (coordinates != null){
+			x = coordinates[0];
+			y = coordinates[1];
+		}
+	}
+	
 	/**
 	 * @return the pointer to the native point.
 	 */
@@ -30,6 +30,7 @@ import java.security.SecureRandom;
 
 import edu.biu.scapi.primitives.dlog.DlogGroupEC;
 import edu.biu.scapi.primitives.dlog.ECElement;
+import edu.biu.scapi.primitives.dlog.GroupElement;
 
 /**
  * An abstract class that implements some common functionalities for both elliptic curve types, Fp and F2m.
@@ -51,6 +52,8 @@ public abstract class OpenSSLAdapterDlogEC extends DlogGroupEC{
 	protected native boolean validate(long curve);									//Validates the curve.
 	protected native long exponentiateWithPreComputedValues(long curve, byte[] exponent);//Raise the given base to the given exponent, using pre computed values.
 	protected native void deleteDlog(long curve);									//Deletes the native curve.
+	protected native byte[][] normalizeMany(long curve, long[] points);			//Converts the given points to affine coordinates and returns them.
+	protected native void deletePoints(long[] points);								//Deletes the given native points.
 	
 	/**
 	 * Initialize this DlogGroup with the curve in the given file.
@@ -101,6 +104,158 @@ public abstract class OpenSSLAdapterDlogEC extends DlogGroupEC{
 		return curve;
 	}
 	
+	/**
+	 * Returns the native point of the given element.
+	 * @param element an element of this group.
+	 * @return the pointer to the native point.
+	 * @throws IllegalArgumentException if the given element doesn't match the DlogGroup.
+	 */
+	abstract long getNativePoint(GroupElement element) throws IllegalArgumentException;
+	
+	/**
+	 * Raises the given native point to the given non negative exponent.
+	 * @return the native result.
+	 */
+	abstract long exponentiatePoint(long point, BigInteger exponent);
+	
+	/**
+	 * Raises the given native point to the given non negative exponent, which is known to the other parties.<p>
+	 * The default is {@link #exponentiatePoint(long, BigInteger)}. A group may override it with a faster method whose 
+	 * running time depends on the exponent, so it should never be called with a secret exponent.
+	 * @return the native result.
+	 */
+	long exponentiatePublicPoint(long point, BigInteger exponent){
+		return exponentiatePoint(point, exponent);
+	}
+	
+	/**
+	 * Creates an element of this group from a native point and its affine coordinates, that were already computed.
+	 * @param point the native point.
+	 * @param coordinates the x and y coordinates of the point, or null if the point is the infinity.
+	 */
+	abstract ECElement createPoint(long point, BigInteger[] coordinates);
+	
+	/**
+	 * Raises each base to the respective exponent and returns all the results.<p>
+	 * The result is the same as calling {@link #exponentiate(GroupElement, BigInteger)} for each base, but the affine coordinates of all 
+	 * the results are computed together with a single field inversion, instead of an inversion for each result.
+	 * @param bases the bases to raise.
+	 * @param exponents the exponents, one for each base.
+	 * @return an array that holds base[i]^exponents[i] in the i-th place.
+	 * @throws IllegalArgumentException if one of the bases doesn't match the DlogGroup or the arrays lengths are different.
+	 */
+	@Override
+	public GroupElement[] exponentiateMany(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException {
+		return exponentiateMany(bases, exponents, false);
+	}
+	
+	/**
+	 * Raises each base to the respective exponent and returns all the results, like {@link #exponentiateMany(GroupElement[], BigInteger[])}.<p>
+	 * The exponents must be public values, such as the challenges of a batch verification. The exponentiation may take 
+	 * a time that depends on them, which is faster on some curves but leaks the exponents through timing.
+	 * @param bases the bases to raise.
+	 * @param exponents the public exponents, one for each base.
+	 * @return an array that holds base[i]^exponents[i] in the i-th place.
+	 * @throws IllegalArgumentException if one of the bases doesn't match the DlogGroup or the arrays lengths are different.
+	 */
+	public GroupElement[] exponentiateManyWithPublicExponents(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException {
+		return exponentiateMany(bases, exponents, true);
+	}
+	
+	/**
+	 * Raises the base to the given public exponent. The exponentiation may take a time that depends on the exponent, 
+	 * so it should never be called with a secret exponent.
+	 * @param base the base to raise.
+	 * @param exponent the public exponent.
+	 * @return the result of base^exponent.
+	 * @throws IllegalArgumentException if the base doesn't match the DlogGroup.
+	 */
+	public GroupElement exponentiateWithPublicExponent(GroupElement base, BigInteger exponent) throws IllegalArgumentException {
+		return exponentiateMany(new GroupElement[]{ base }, new BigInteger[]{ exponent }, true)[0];
+	}
+	
+	private GroupElement[] exponentiateMany(GroupElement[] bases, BigInteger[] exponents, boolean publicExponents) throws IllegalArgumentException {
+		if (bases.length != exponents.length){
+			throw new IllegalArgumentException("the number of bases and exponents should be equal");
+		}
+		
+		//Check all the bases before any native point is created.
+		int len = bases.length;
+		long[] basePoints = new long[len];
+		int numPoints = 0;
+		for (int i = 0; i < len; i++) {
+			basePoints[i] = getNativePoint(bases[i]);
+			if (!((ECElement) bases[i]).isInfinity()) {
+				numPoints++;
+			}
+		}
+		
+		GroupElement[] results = new GroupElement[len];
+		long[] points = new long[numPoints];
+		int created = 0;
+		try {
+			for (int i = 0; i < len; i++) {
+				//The infinity point raised to any exponent is the infinity.
+				if (((ECElement) bases[i]).isInfinity()) {
+					results[i] = bases[i];
+					continue;
+				}
+				
+				//If the exponent is negative, convert it to be the exponent modulus q.
+				BigInteger exponent = exponents[i];
+				if (exponent.compareTo(BigInteger.ZERO) < 0){
+					exponent = exponent.mod(getOrder());
+				}
+				
+				// Call the native exponentiate function. The coordinates of the result are taken later, for all the results at once.
+				points[created++] = publicExponents ? exponentiatePublicPoint(basePoints[i], exponent) : exponentiatePoint(basePoints[i], exponent);
+			}
+			
+			BigInteger[][] coordinates = getAffineCoordinates(points);
+			
+			// Build the elements from the results. From here on, the elements own the native points.
+			int index = 0;
+			for (int i = 0; i < len; i++) {
+				if (results[i] == null){
+					results[i] = createPoint(points[index], coordinates[index]);
+					index++;
+				}
+			}
+			created = 0;
+		} finally {
+			//If something failed before the elements were built, no element will delete the native results.
+			if (created > 0){
+				long[] toDelete = new long[created];
+				System.arraycopy(points, 0, toDelete, 0, created);
+				deletePoints(toDelete);
+			}
+		}
+		return results;
+	}
+	
+	/**
+	 * Converts the given native points to affine coordinates together and returns their coordinates.<p>
+	 * Getting the coordinates of a single point costs a field inversion. Here all the points are normalized using 
+	 * one inversion and a few multiplications for each point, so creating many elements at once is much cheaper.
+	 * @param points pointers to the native points.
+	 * @return for each point an array that holds its x and y coordinates, or null if the point is the infinity.
+	 */
+	BigInteger[][] getAffineCoordinates(long[] points){
+		byte[][] coordinates = normalizeMany(curve, points);
+		if (coordinates == null){
+			throw new IllegalStateException("failed to normalize the points");
+		}
+		
+		BigInteger[][] result = new BigInteger[points.length][];
+		for (int i = 0; i < points.length; i++){
+			//In case of infinity, there are no coordinates.
+			if (coordinates[2 * i] != null){
+				result[i] = new BigInteger[]{ new BigInteger(1, coordinates[2 * i]), new BigInteger(1, coordinates[2 * i + 1]) };
+			}
+		}
+		return result;
+	}
+	
 	@Override
 	@Deprecated
 	public ECElement generateElement(BigInteger x, BigInteger y) throws IllegalArgumentException {
@@ -32,6 +32,7 @@ import java.util.Properties;
 
 import edu.biu.scapi.primitives.dlog.DlogECF2m;
 import edu.biu.scapi.primitives.dlog.ECElement;
+import edu.biu.scapi.primitives.dlog.ECF2mKoblitzTnaf;
 import edu.biu.scapi.primitives.dlog.ECF2mUtility;
 import edu.biu.scapi.primitives.dlog.GroupElement;
 import edu.biu.scapi.primitives.dlog.groupParams.ECF2mGroupParams;
@@ -51,11 +52,18 @@ import edu.biu.scapi.securityLevel.DDH;
 public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m, DDH{
 	
 	private ECF2mUtility util; //Utility class that computes some common ECF2m functionalities.
+	private ECF2mKoblitzTnaf koblitzTnaf; //The tau-adic recoding of a Koblitz curve, or null if the curve is not a Koblitz curve.
+	private boolean hasTnaf; //Whether the native tau-adic arithmetic was set.
 	
 	//Creates the native curve.
 	private native long createCurve(byte[] p, byte[] a, byte[] b);
 	//Initializes the native curve with the generator and order.
 	private native int initCurve(long curve, long generator, byte[] q, byte[] cofactor);
+	//Sets the tau-adic arithmetic of a Koblitz curve. Returns false if the native curve or the processor is not supported.
+	//If portable is true, the field arithmetic doesn't use the carry-less multiplication instruction.
+	private native boolean initKoblitz(long curve, int m, int a, byte[][] alphaDigits, boolean portable);
+	//Raises the point to the exponent given as a width-w tau-adic NAF. Returns 0 if the tau-adic arithmetic was not set.
+	private native long exponentiateTnaf(long curve, long point, byte[] digits);
 	
 	/**
 	 * Default constructor. Initializes this object with K-163 NIST curve.
@@ -143,6 +151,74 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 		
 		//Initialize the native curve with the generator, order and cofactor.
 		initCurve(curve, ((ECF2mPointOpenSSL) generator).getPoint(), params.getQ().toByteArray(), ((ECF2mGroupParams) params).getCofactor().toByteArray());
+		
+		//Use the Frobenius map instead of doublings for public exponents on the Koblitz curves K-163, K-233 and K-283.
+		koblitzTnaf = util.getKoblitzTnaf(groupParams);
+		setPortableTnaf(false);
+	}
+	
+	/**
+	 * @return true if the exponentiations with public exponents use the tau-adic NAF of the exponent, which is the case on 
+	 * the Koblitz curves K-163, K-233 and K-283 when the processor has a carry-less multiplication instruction.
+	 */
+	public boolean hasTnaf(){
+		return hasTnaf;
+	}
+	
+	/**
+	 * Sets the field arithmetic of the tau-adic exponentiation. By default it uses the carry-less multiplication instruction, 
+	 * and the tau-adic exponentiation is not used if the processor lacks it.<p>
+	 * The results are the same in both cases. This is meant for testing the portable arithmetic, and should not be called 
+	 * while other threads use this group.
+	 * @param portable whether to use the portable field arithmetic.
+	 * @return true if the tau-adic exponentiation is used from now on.
+	 */
+	public boolean setPortableTnaf(boolean portable){
+		hasTnaf = koblitzTnaf != null && initKoblitz(curve, koblitzTnaf.getM(), koblitzTnaf.getA(), koblitzTnaf.getAlphaDigits(), portable);
+		return hasTnaf;
+	}
+	
+	@Override
+	long getNativePoint(GroupElement element) throws IllegalArgumentException {
+		//If the GroupElement doesn't match the DlogGroup, throw exception.
+		if (!(element instanceof ECF2mPointOpenSSL)){
+			throw new IllegalArgumentException("the given base doesn't match the DlogGroup");
+		}
+		return ((ECF2mPointOpenSSL) element).getPoint();
+	}
+	
+	@Override
+	ECElement createPoint(long point, BigInteger[] coordinates) {
+		return new ECF2mPointOpenSSL(point, coordinates);
+	}
+	
+	/**
+	 * Raises the given native point to the exponent, using the constant time ladder of OpenSSL.
+	 * @param point the native point. Should not be the infinity point.
+	 * @param exponent a non negative exponent.
+	 * @return the native result.
+	 */
+	@Override
+	long exponentiatePoint(long point, BigInteger exponent){
+		return exponentiate(curve, point, exponent.toByteArray());
+	}
+	
+	/**
+	 * Raises the given native point to the public exponent. Uses the tau-adic NAF of the exponent on Koblitz curves, 
+	 * whose running time depends on the exponent.
+	 * @param point the native point. Should not be the infinity point.
+	 * @param exponent a non negative public exponent.
+	 * @return the native result.
+	 */
+	@Override
+	long exponentiatePublicPoint(long point, BigInteger exponent){
+		if (hasTnaf){
+			long result = exponentiateTnaf(curve, point, koblitzTnaf.recode(exponent));
+			if (result != 0){
+				return result;
+			}
+		}
+		return exponentiatePoint(point, exponent);
 	}
 
 	@Override
@@ -198,7 +274,7 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 				
 		long point = ((ECF2mPointOpenSSL) base).getPoint();
 		// Call the native exponentiate function.
-		long result = exponentiate(curve, point, exponent.toByteArray());
+		long result = exponentiatePoint(point, exponent);
 		// Build a ECF2mPointOpenSSL element from the result.
 		return new ECF2mPointOpenSSL(curve, result);
 	}
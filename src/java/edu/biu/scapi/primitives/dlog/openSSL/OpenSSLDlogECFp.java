@@ -32,6 +32,7 @@ import java.util.Properties;
 
 import edu.biu.scapi.primitives.dlog.DlogECFp;
 import edu.biu.scapi.primitives.dlog.ECElement;
+import edu.biu.scapi.primitives.dlog.ECFpGlvEndomorphism;
 import edu.biu.scapi.primitives.dlog.ECFpUtility;
 import edu.biu.scapi.primitives.dlog.GroupElement;
 import edu.biu.scapi.primitives.dlog.groupParams.ECFpGroupParams;
@@ -46,6 +47,8 @@ import edu.biu.scapi.securityLevel.DDH;
 public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, DDH{
 	
 	private ECFpUtility util; //Utility class that computes some common ECFp functionalities.
+	private ECFpGlvEndomorphism glv; //The GLV endomorphism of the curve, or null if the curve has none.
+	private boolean glvEnabled = true;
 	
 	//Creates the native curve.
 	private native long createCurve(byte[] p, byte[] a, byte[] b);
@@ -53,6 +56,10 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 	private native int initCurve(long curve, long generator, byte[] q);
 	//Encodes the given byte array into a point. If the given byte array can not be encoded to a point, returns 0.
 	private native long encodeByteArrayToPoint(long curve, byte[] binaryString, int k);
+	//Sets the GLV endomorphism (x, y) -> (beta*x, y) of the native curve.
+	private native boolean initEndomorphism(long curve, byte[] beta);
+	//Raises each base to the respective exponent and multiplies the results, where each exponent is given as k1, k2 with k = k1 + k2*lambda.
+	private native long simultaneousMultiplyGlv(long curve, long[] nativePoints, byte[][] exponents, boolean[] negative);
 	
 	/**
 	 * Default constructor. Initializes this object with P-192 NIST curve.
@@ -122,6 +129,93 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 		
 		//Initialize the curve with the generator and order.
 		initCurve(curve, ((ECFpPointOpenSSL) generator).getPoint(), fpParams.getQ().toByteArray());
+		
+		//Use the GLV endomorphism if the curve has one, for example secp256k1.
+		initEndomorphism(fpParams);
+	}
+	
+	/**
+	 * Sets the GLV endomorphism of the curve, if it has one.<p>
+	 * The candidates are checked on the generator, and a candidate is used only if phi(G) = lambda*G.
+	 * @param fpParams the curve parameters.
+	 */
+	private void initEndomorphism(ECFpGroupParams fpParams){
+		for (ECFpGlvEndomorphism candidate : util.getGlvEndomorphismCandidates(fpParams)){
+			//glv is not set yet, so this is the generic exponentiation.
+			ECFpPointOpenSSL lambdaG = (ECFpPointOpenSSL) exponentiate(generator, candidate.getLambda());
+			BigInteger phiX = candidate.getBeta().multiply(fpParams.getXg()).mod(fpParams.getP());
+			if (lambdaG.getX().equals(phiX) && lambdaG.getY().equals(fpParams.getYg())){
+				if (initEndomorphism(curve, candidate.getBeta().toByteArray())){
+					glv = candidate;
+				}
+				return;
+			}
+		}
+	}
+	
+	/**
+	 * @return true if the curve has a GLV endomorphism that is used to speed up the exponentiations.
+	 */
+	public boolean hasEndomorphism(){
+		return glv != null;
+	}
+	
+	/**
+	 * Enables or disables the use of the GLV endomorphism, which is enabled by default when the curve has one.<p>
+	 * The results are the same in both cases. Disabling it is useful to compare to the generic exponentiation.
+	 * @param enabled whether to use the endomorphism.
+	 */
+	public void setEndomorphismEnabled(boolean enabled){
+		glvEnabled = enabled;
+	}
+	
+	@Override
+	long getNativePoint(GroupElement element) throws IllegalArgumentException {
+		//If the GroupElement doesn't match the DlogGroup, throw exception.
+		if (!(element instanceof ECFpPointOpenSSL)){
+			throw new IllegalArgumentException("the given base doesn't match the DlogGroup");
+		}
+		return ((ECFpPointOpenSSL) element).getPoint();
+	}
+	
+	@Override
+	ECElement createPoint(long point, BigInteger[] coordinates) {
+		return new ECFpPointOpenSSL(point, coordinates);
+	}
+	
+	/**
+	 * Raises the given native point to the exponent. Uses the GLV endomorphism if the curve has one.
+	 * @param point the native point. Should not be the infinity point.
+	 * @param exponent a non negative exponent.
+	 * @return the native result.
+	 */
+	@Override
+	long exponentiatePoint(long point, BigInteger exponent){
+		if (glv != null && glvEnabled){
+			return multiplyGlv(new long[]{ point }, new BigInteger[]{ exponent });
+		}
+		return exponentiate(curve, point, exponent.toByteArray());
+	}
+	
+	/**
+	 * Raises each native point to the respective exponent and multiplies the results, using the GLV endomorphism.<p>
+	 * Each exponent is split into two exponents of half length, so all the exponentiations share half the number of doublings.
+	 * @param nativePoints the native points. None of them may be the infinity point.
+	 * @param exponents the exponents.
+	 * @return the native result.
+	 */
+	private long multiplyGlv(long[] nativePoints, BigInteger[] exponents){
+		int len = nativePoints.length;
+		byte[][] halves = new byte[2 * len][];
+		boolean[] negative = new boolean[2 * len];
+		for (int i = 0; i < len; i++) {
+			BigInteger[] split = glv.decompose(exponents[i]);
+			for (int j = 0; j < 2; j++) {
+				halves[2 * i + j] = split[j].abs().toByteArray();
+				negative[2 * i + j] = split[j].signum() < 0;
+			}
+		}
+		return simultaneousMultiplyGlv(curve, nativePoints, halves, negative);
 	}
 
 	@Override
@@ -178,7 +272,7 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 				
 		long point = ((ECFpPointOpenSSL) base).getPoint();
 		// Call the native exponentiate function.
-		long result = exponentiate(curve, point, exponent.toByteArray());
+		long result = exponentiatePoint(point, exponent);
 		// Build a ECFpPointOpenSSL element from the result.
 		return new ECFpPointOpenSSL(curve, result);
 	}
@@ -251,6 +345,10 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 	@Override
 	public GroupElement simultaneousMultipleExponentiations(GroupElement[] groupElements, BigInteger[] exponentiations) {
 		
+		if (glv != null && glvEnabled){
+			return simultaneousMultipleExponentiationsGlv(groupElements, exponentiations);
+		}
+		
 		int len = groupElements.length;
 
 		//Create arrays to hold the native points and the exponents' bytes.
@@ -270,6 +368,40 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 		// Build a ECFpPointOpenSSL element from the result value.
 		return new ECFpPointOpenSSL(curve, result);
 	}
+	
+	/**
+	 * Computes the product of several exponentiations with distinct bases, using the GLV endomorphism.
+	 */
+	private GroupElement simultaneousMultipleExponentiationsGlv(GroupElement[] groupElements, BigInteger[] exponentiations) {
+		int len = groupElements.length;
+		
+		//The infinity point does not change the product, and it has no image under the endomorphism, so it is skipped.
+		long[] nativePoints = new long[len];
+		BigInteger[] exponents = new BigInteger[len];
+		int numPoints = 0;
+		for (int i = 0; i < len; i++) {
+			// if the GroupElements don't match the DlogGroup, throw exception.
+			if (!(groupElements[i] instanceof ECFpPointOpenSSL)) {
+				throw new IllegalArgumentException("groupElement doesn't match the DlogGroup");
+			}
+			if (!((ECFpPointOpenSSL) groupElements[i]).isInfinity()) {
+				nativePoints[numPoints] = ((ECFpPointOpenSSL) groupElements[i]).getPoint();
+				exponents[numPoints] = exponentiations[i];
+				numPoints++;
+			}
+		}
+		if (numPoints == 0){
+			return getInfinity();
+		}
+		
+		long[] points = new long[numPoints];
+		BigInteger[] pointsExponents = new BigInteger[numPoints];
+		System.arraycopy(nativePoints, 0, points, 0, numPoints);
+		System.arraycopy(exponents, 0, pointsExponents, 0, numPoints);
+		
+		// Build a ECFpPointOpenSSL element from the result value.
+		return new ECFpPointOpenSSL(curve, multiplyGlv(points, pointsExponents));
+	}
 
 	@Override
 	public GroupElement encodeByteArrayToGroupElement(byte[] binaryString) {
@@ -0,0 +1,151 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.dlog.openSSL;
+
+import java.math.BigInteger;
+
+import edu.biu.scapi.primitives.dlog.ScZqVectorOps;
+
+/**
+ * Native implementation of {@link edu.biu.scapi.primitives.dlog.ZqVectorOps}. <p>
+ * 
+ * Each operation is done on whole vectors in a single native call, so there are no BigInteger objects and no separate 
+ * modular reductions for each element. <p>
+ * 
+ * The native arithmetic works with odd moduli of up to 576 bits, which covers the orders of the elliptic curves up to 
+ * P-521. Other moduli, such as the orders of large Zp groups, are handled by the BigInteger implementation of 
+ * {@link ScZqVectorOps}.
+ * Since the underlying library is written in a native language we use the JNI architecture.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OpenSSLZqVectorOps extends ScZqVectorOps {
+
+	private long context;		//Pointer to the native arithmetic, or 0 if the modulus is not supported by the native code.
+	
+	//Native functions. These functions are implemented in a c++ dll using JNI that we load.
+	
+	//Creates the arithmetic modulo q. Returns 0 if q is even or longer than 576 bits.
+	private native long createContext(byte[] q);
+	//Each of the operations returns false if one of the elements is not smaller than q. b and c may hold a single element.
+	private native boolean add(long context, byte[] a, byte[] b, byte[] result, int num);
+	private native boolean subtract(long context, byte[] a, byte[] b, byte[] result, int num);
+	private native boolean multiply(long context, byte[] a, byte[] b, byte[] result, int num);
+	private native boolean multiplyAdd(long context, byte[] a, byte[] b, byte[] c, byte[] result, int num);
+	//Returns false also if one of the elements is not invertible.
+	private native boolean invertMany(long context, byte[] a, byte[] result, int num);
+	//Deletes the native arithmetic.
+	private native void deleteContext(long context);
+	
+	/**
+	 * Creates the arithmetic modulo the given q.
+	 * @param q the modulus.
+	 * @throws IllegalArgumentException if q is smaller than 2.
+	 */
+	public OpenSSLZqVectorOps(BigInteger q) {
+		super(q);
+		context = createContext(q.toByteArray());
+	}
+	
+	/**
+	 * @return true if the operations are done by the native code; false if they are done with BigInteger.
+	 */
+	public boolean isNative() {
+		return context != 0;
+	}
+	
+	/**
+	 * Computes the inverse modulo q of each element of the given vector. All the inverses cost a single modular inversion 
+	 * and three multiplications for each element.
+	 */
+	@Override
+	public byte[] invertMany(byte[] a, byte[] result) {
+		if (context == 0){
+			return super.invertMany(a, result);
+		}
+		
+		int num = size(a);
+		result = checkResult(result, num);
+		if (!invertMany(context, a, result, num)){
+			throw new ArithmeticException("one of the elements is not invertible");
+		}
+		return result;
+	}
+	
+	@Override
+	protected byte[] operate(int operation, byte[] a, byte[] b, byte[] c, byte[] result) {
+		//The modulus is not supported by the native code.
+		if (context == 0){
+			return super.operate(operation, a, b, c, result);
+		}
+		
+		int num = size(a);
+		checkOperand(b, num);
+		if (operation == MULTIPLY_ADD){
+			checkOperand(c, num);
+		}
+		result = checkResult(result, num);
+		
+		//The native code also checks that the elements are reduced.
+		boolean valid;
+		switch (operation) {
+		case ADD:
+			valid = add(context, a, b, result, num);
+			break;
+		case SUBTRACT:
+			valid = subtract(context, a, b, result, num);
+			break;
+		case MULTIPLY:
+			valid = multiply(context, a, b, result, num);
+			break;
+		default:
+			valid = multiplyAdd(context, a, b, c, result, num);
+		}
+		if (!valid){
+			throw new IllegalArgumentException("the elements should be smaller than the modulus");
+		}
+		return result;
+	}
+	
+	/**
+	 * Deletes the native arithmetic.
+	 */
+	protected void finalize() throws Throwable {
+		
+		//Deletes from the dll the dynamic allocation of the arithmetic.
+		if (context != 0){
+			deleteContext(context);
+		}
+		
+		super.finalize();
+	}
+	
+	static {
+		
+		//loads the OpenSSL dll.
+		System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
@@ -0,0 +1,57 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+package edu.biu.scapi.primitives.prf;
+
+/** 
+ * Interface for PRPs that can compute CBC chains of many messages in one call to their native implementation. <p>
+ * 
+ * The chain of a message m_1,...,m_n (each of the block size) that starts from iv is c_0 = iv, c_i = prp(c_(i-1) xor m_i), 
+ * and its result is c_n. The last block of a message that is not aligned to the block size is padded with zeros.
+ * This is the computation of {@link edu.biu.scapi.midLayer.symmetricCrypto.mac.ScCbcMacPrepending} after the prepended 
+ * length block, so ScCbcMacPrepending uses this interface when the underlying prp implements it. 
+ * Independent chains can be computed side by side by the native code, which hides the latency of the serial chain.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public interface CbcChainPrp extends PrpFixed {
+	
+	/**
+	 * Computes the CBC chains of numMsgs messages of msgLen bytes each and writes the result of each chain to outBytes, 
+	 * one block after the other. 
+	 * @param iv the initial chaining value of every message, of the block size. The array is not changed, unless it is also the output array.
+	 * @param inBytes the messages, one after the other.
+	 * @param inOff the offset of the first message in inBytes.
+	 * @param msgLen the length of each message in bytes.
+	 * @param numMsgs the number of messages.
+	 * @param outBytes the output array. Should have room for numMsgs blocks after outOff.
+	 * @param outOff the offset in outBytes to put the result from.
+	 * @throws IllegalStateException if no key was set.
+	 * @throws IllegalArgumentException if the given iv is not of the block size.
+	 * @throws ArrayIndexOutOfBoundsException if the given offsets or lengths are invalid.
+	 */
+	public void computeCbcChains(byte[] iv, byte[] inBytes, int inOff, int msgLen, int numMsgs, byte[] outBytes, int outOff);
+}
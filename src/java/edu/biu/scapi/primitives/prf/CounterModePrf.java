@@ -0,0 +1,53 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+package edu.biu.scapi.primitives.prf;
+
+/** 
+ * Interface for PRFs that can compute themselves on consecutive counter blocks in one call to their native implementation. <p>
+ * 
+ * The counter is a big endian number of the size of the block, that is increased by one after each block and wraps around to zero.
+ * The output is the concatenation of the results of computing the prf on ctr, ctr+1, ..., truncated to the requested length. 
+ * This is the same stream that {@link edu.biu.scapi.primitives.prg.ScPrgFromPrf} creates by calling computeBlock on each counter, 
+ * so ScPrgFromPrf uses this interface when the underlying prf implements it.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public interface CounterModePrf extends PrfFixed {
+	
+	/**
+	 * Computes the prf on the counter blocks ctr, ctr+1, ... and writes the first outLen bytes of the results to outBytes.
+	 * The last block is truncated if outLen is not a multiple of the block size.
+	 * @param ctr the first counter block. The array is not changed.
+	 * @param outBytes output bytes. The resulted bytes of compute.
+	 * @param outOff output offset in the outBytes array to put the result from.
+	 * @param outLen the number of bytes to compute.
+	 * @throws IllegalStateException if no key was set.
+	 * @throws IllegalArgumentException if the given counter is not of the block size.
+	 * @throws ArrayIndexOutOfBoundsException if the given offset or length is invalid.
+	 */
+	public void computeCounterBlocks(byte[] ctr, byte[] outBytes, int outOff, int outLen);
+}
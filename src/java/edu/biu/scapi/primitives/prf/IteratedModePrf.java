@@ -0,0 +1,70 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+package edu.biu.scapi.primitives.prf;
+
+/** 
+ * Interface for PRFs with varying input length that can compute the constructions built on top of them in one call to their 
+ * native implementation: {@link IteratedPrfVarying} with this prf as the underlying prf, and {@link LubyRackoffPrpFromPrfVarying} 
+ * with such an IteratedPrfVarying as the round function. <p>
+ * 
+ * The results are identical to the java compositions, which make a separate call to this prf for each round of each block. 
+ * IteratedPrfVarying and LubyRackoffPrpFromPrfVarying use this interface when their underlying prf implements it.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public interface IteratedModePrf extends PrfVaryingInputLength {
+	
+	/**
+	 * Computes IteratedPrfVarying over this prf on numBlocks inputs of inLen bytes each, and writes outLen bytes of output 
+	 * of each input to outBytes, one after the other.
+	 * @param inBytes the inputs, one after the other.
+	 * @param inOff the offset of the first input in inBytes.
+	 * @param inLen the length of each input.
+	 * @param outBytes the output array.
+	 * @param outOff the offset in outBytes to put the first output from.
+	 * @param outLen the length of each output.
+	 * @param numBlocks the number of inputs.
+	 * @throws IllegalStateException if no key was set.
+	 * @throws ArrayIndexOutOfBoundsException if the given offsets or lengths are invalid.
+	 */
+	public void computeIteratedBlocks(byte[] inBytes, int inOff, int inLen, byte[] outBytes, int outOff, int outLen, int numBlocks);
+	
+	/**
+	 * Computes or inverts LubyRackoffPrpFromPrfVarying, whose round function is IteratedPrfVarying over this prf, on numBlocks 
+	 * blocks of len bytes each.
+	 * @param inBytes the blocks, one after the other.
+	 * @param inOff the offset of the first block in inBytes.
+	 * @param outBytes the output array.
+	 * @param outOff the offset in outBytes to put the first result from.
+	 * @param len the length of each block. Should be even.
+	 * @param numBlocks the number of blocks.
+	 * @param invert true to invert the permutation, false to compute it.
+	 * @throws IllegalStateException if no key was set.
+	 * @throws ArrayIndexOutOfBoundsException if the given offsets or lengths are invalid.
+	 */
+	public void computeLubyRackoffBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int len, int numBlocks, boolean invert);
+}
@@ -39,6 +39,7 @@ import edu.biu.scapi.tools.Factories.PrfFactory;
 /** 
  * This class is one implementation of pseudorandom function with varying IO, based on any prf with varying input length. <p>
  * The implementation is based on several calls to the underlying Prf and concatenation of the results.
+ * If the underlying prf implements {@link IteratedModePrf}, all the calls are made by its native code in one call.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Meital Levy)
  */
@@ -121,6 +122,12 @@ public class IteratedPrfVarying extends PrfVaryingFromPrfVaryingInput {
 		if ((outOff > outBytes.length) || (outOff+outLen > outBytes.length)){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
+		
+		if (prfVaryingInputLength instanceof IteratedModePrf){
+			((IteratedModePrf) prfVaryingInputLength).computeIteratedBlocks(inBytes, inOff, inLen, outBytes, outOff, outLen, 1);
+			return;
+		}
+		
 		int prfLength = prfVaryingInputLength.getBlockSize();            //the output size of the prfVaryingInputLength
 		int rounds = (int) Math.ceil((float)outLen / (float)prfLength);  //the smallest integer for which rounds * prfLength > outlen
 		byte[] intermediateOutBytes = new byte[prfLength];               //round result
@@ -158,6 +165,38 @@ public class IteratedPrfVarying extends PrfVaryingFromPrfVaryingInput {
 			}
 		}
 	}
+	
+	/**
+	 * Computes the iterated permutation on many inputs of the same length. <p>
+	 * The result of each input is equal to the result of computeBlock on it. If the underlying prf implements IteratedModePrf, 
+	 * all the inputs are computed in one native call.
+	 * @param inBytes - the inputs, one after the other.
+	 * @param inOff - the offset of the first input in the inBytes array.
+	 * @param inLen - the length of each input in bytes.
+	 * @param outBytes - output bytes. The results, one after the other.
+	 * @param outOff - output offset in the outBytes array to put the first result from.
+	 * @param outLen - the length of each output in bytes.
+	 * @param numBlocks - the number of inputs.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, int inLen, byte[] outBytes, int outOff, int outLen, int numBlocks) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (prfVaryingInputLength instanceof IteratedModePrf){
+			((IteratedModePrf) prfVaryingInputLength).computeIteratedBlocks(inBytes, inOff, inLen, outBytes, outOff, outLen, numBlocks);
+			return;
+		}
+		for (int i = 0; i < numBlocks; i++){
+			computeBlock(inBytes, inOff + i * inLen, inLen, outBytes, outOff + i * outLen, outLen);
+		}
+	}
+	
+	/**
+	 * Returns the underlying prf if it can compute the constructions over it natively, null otherwise.
+	 */
+	IteratedModePrf getIteratedModePrf(){
+		return (prfVaryingInputLength instanceof IteratedModePrf) ? (IteratedModePrf) prfVaryingInputLength : null;
+	}
 
 	
 }
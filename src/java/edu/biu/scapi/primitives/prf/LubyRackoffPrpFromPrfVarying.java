@@ -36,7 +36,10 @@ import edu.biu.scapi.tools.Factories.PrfFactory;
  * The class LubyRackoffPrpFromPrfVarying is one implementation that has a varying input and output length. 
  * LubyRackoffPrpFromPrfVarying is a pseudorandom permutation with varying input/output lengths, based on any PRF with a variable input/output length 
  * (as long as input length = output length). We take the interpretation that there is essentially a different random permutation
- * for every input/output length.
+ * for every input/output length. <p>
+ * 
+ * If the underlying PRF is an IteratedPrfVarying over a prf that implements {@link IteratedModePrf}, all the rounds are computed 
+ * by the native code of that prf in one call.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Meital Levy)
  * 
@@ -117,6 +120,12 @@ public final class LubyRackoffPrpFromPrfVarying extends PrpFromPrfVarying {
 			throw new IllegalBlockSizeException("Length of input must be even");
 		}
 		
+		IteratedModePrf nativePrf = getIteratedModePrf();
+		if (nativePrf != null){
+			nativePrf.computeLubyRackoffBlocks(inBytes, inOff, outBytes, outOff, inLen, 1, false);
+			return;
+		}
+		
 		int sideSize = inLen/2;//L in the pseudo code
 		byte[] tmpReference;
 		byte[] leftCurrent = new byte[sideSize];
@@ -209,6 +218,12 @@ public final class LubyRackoffPrpFromPrfVarying extends PrpFromPrfVarying {
 			throw new IllegalBlockSizeException("Length of input must be even");
 		}
 		
+		IteratedModePrf nativePrf = getIteratedModePrf();
+		if (nativePrf != null){
+			nativePrf.computeLubyRackoffBlocks(inBytes, inOff, outBytes, outOff, len, 1, true);
+			return;
+		}
+		
 		int sideSize = len/2;//L in the pseudo code
 		byte[] tmpReference;
 		byte[] leftCurrent = new byte[sideSize];
@@ -263,6 +278,72 @@ public final class LubyRackoffPrpFromPrfVarying extends PrpFromPrfVarying {
 		
 	}
 
+	/**
+	 * Computes the LubyRackoff permutation on many blocks of the same length. <p>
+	 * The result of each block is equal to the result of computeBlock on it. If the underlying prf can compute the rounds 
+	 * natively, all the blocks are computed in one native call.
+	 * @param inBytes the blocks, one after the other.
+	 * @param inOff the offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. The results, one after the other.
+	 * @param outOff output offset in the outBytes array to put the first result from.
+	 * @param len the length of each block. Should be even.
+	 * @param numBlocks the number of blocks.
+	 * @throws IllegalBlockSizeException if the length is odd.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int len, int numBlocks) throws IllegalBlockSizeException{
+		computeOrInvertBlocks(inBytes, inOff, outBytes, outOff, len, numBlocks, false);
+	}
+	
+	/**
+	 * Inverts the LubyRackoff permutation on many blocks of the same length. <p>
+	 * The result of each block is equal to the result of invertBlock on it. If the underlying prf can compute the rounds 
+	 * natively, all the blocks are inverted in one native call.
+	 * @param inBytes the blocks, one after the other.
+	 * @param inOff the offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. The results, one after the other.
+	 * @param outOff output offset in the outBytes array to put the first result from.
+	 * @param len the length of each block. Should be even.
+	 * @param numBlocks the number of blocks.
+	 * @throws IllegalBlockSizeException if the length is odd.
+	 */
+	public void invertBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int len, int numBlocks) throws IllegalBlockSizeException{
+		computeOrInvertBlocks(inBytes, inOff, outBytes, outOff, len, numBlocks, true);
+	}
+	
+	private void computeOrInvertBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int len, int numBlocks, boolean invert) throws IllegalBlockSizeException{
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		//checks that the input is of even length.
+		if(!(len % 2==0) ){//odd throw exception
+			throw new IllegalBlockSizeException("Length of input must be even");
+		}
+		
+		IteratedModePrf nativePrf = getIteratedModePrf();
+		if (nativePrf != null){
+			nativePrf.computeLubyRackoffBlocks(inBytes, inOff, outBytes, outOff, len, numBlocks, invert);
+			return;
+		}
+		for (int i = 0; i < numBlocks; i++){
+			if (invert){
+				invertBlock(inBytes, inOff + i * len, outBytes, outOff + i * len, len);
+			} else{
+				computeBlock(inBytes, inOff + i * len, len, outBytes, outOff + i * len);
+			}
+		}
+	}
+	
+	/*
+	 * Returns the prf that can compute all the rounds natively, or null if the underlying prf is not an IteratedPrfVarying 
+	 * over such a prf.
+	 */
+	private IteratedModePrf getIteratedModePrf(){
+		if (prfVaryingIOLength instanceof IteratedPrfVarying){
+			return ((IteratedPrfVarying) prfVaryingIOLength).getIteratedModePrf();
+		}
+		return null;
+	}
+	
 	/**
 	 * @return LubyRackoff algorithm name
 	 */
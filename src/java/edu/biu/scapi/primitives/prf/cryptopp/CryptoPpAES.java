@@ -37,6 +37,8 @@ import javax.crypto.KeyGenerator;
 import javax.crypto.SecretKey;
 
 import edu.biu.scapi.primitives.prf.AES;
+import edu.biu.scapi.primitives.prf.CbcChainPrp;
+import edu.biu.scapi.primitives.prf.CounterModePrf;
 
 /**
  * Concrete class of prf family for AES. This class wraps the implementation of Crypto++.
@@ -44,7 +46,7 @@ import edu.biu.scapi.primitives.prf.AES;
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
  */
-public class CryptoPpAES implements AES{
+public class CryptoPpAES implements AES, CounterModePrf, CbcChainPrp{
 
 	private boolean isKeySet;
 	private long aesCompute;		//native object used for compute blocks
@@ -60,6 +62,8 @@ public class CryptoPpAES implements AES{
 	private native String getName(long aes);
 	private native int getBlockSize(long aes);
 	private native void deleteAES(long aesCompute, long aesInvert);
+	private native void computeCounterBlocks(long aesCompute, byte[] ctr, byte[] out, int outOffset, int outLen);
+	private native void computeCbcChains(long aesCompute, byte[] iv, byte[] in, int inOffset, int msgLen, int numMsgs, byte[] out, int outOffset);
 	
 	/**
 	 * Default constructor. Uses default implementation of SecureRandom.
@@ -226,6 +230,49 @@ public class CryptoPpAES implements AES{
 		optimizedCompute(aesCompute, inBytes, outBytes, true);
 	}
 
+	/**
+	 * Computes the AES permutation on the counter blocks ctr, ctr+1, ... in one call to the native code.
+	 * @see CounterModePrf#computeCounterBlocks(byte[], byte[], int, int)
+	 */
+	@Override
+	public void computeCounterBlocks(byte[] ctr, byte[] outBytes, int outOff, int outLen) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (ctr.length != getBlockSize()){
+			throw new IllegalArgumentException("the counter should be of the block size");
+		}
+		if ((outOff < 0) || (outLen < 0) || (outOff + outLen > outBytes.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		//Call the native code to compute all the blocks.
+		computeCounterBlocks(aesCompute, ctr, outBytes, outOff, outLen);
+	}
+	
+	/**
+	 * Computes the CBC chains of many messages in one call to the native code.
+	 * @see CbcChainPrp#computeCbcChains(byte[], byte[], int, int, int, byte[], int)
+	 */
+	@Override
+	public void computeCbcChains(byte[] iv, byte[] inBytes, int inOff, int msgLen, int numMsgs, byte[] outBytes, int outOff) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (iv.length != getBlockSize()){
+			throw new IllegalArgumentException("the iv should be of the block size");
+		}
+		if ((inOff < 0) || (msgLen < 0) || (numMsgs < 0) || ((long) msgLen * numMsgs > inBytes.length - inOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOff < 0) || ((long) getBlockSize() * numMsgs > outBytes.length - outOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		//Call the native code to compute all the chains.
+		computeCbcChains(aesCompute, iv, inBytes, inOff, msgLen, numMsgs, outBytes, outOff);
+	}
+
 	/** 
 	 * This function is provided in the interface especially for the sub-family PrfVaryingIOLength, which may have variable input/output lengths.
 	 * Since both Input and output variables are fixed this function should not normally be called. 
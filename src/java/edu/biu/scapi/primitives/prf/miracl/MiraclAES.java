@@ -35,8 +35,10 @@ import javax.crypto.KeyGenerator;
 import javax.crypto.SecretKey;
 
 import edu.biu.scapi.primitives.prf.AES;
+import edu.biu.scapi.primitives.prf.CbcChainPrp;
+import edu.biu.scapi.primitives.prf.CounterModePrf;
 
-public class MiraclAES implements AES{
+public class MiraclAES implements AES, CounterModePrf, CbcChainPrp{
 
 	private boolean isKeySet;
 	private long aes;				//native object used for compute AES permutation
@@ -48,6 +50,8 @@ public class MiraclAES implements AES{
 	private native void optimizedCompute(long aes, byte[] in, byte[] out);
 	private native void optimizedInvert(long aes, byte[] in, byte[] out);
 	private native void deleteAES(long aes);
+	private native void computeCounterBlocks(long aes, byte[] ctr, byte[] out, int outOffset, int outLen);
+	private native void computeCbcChains(long aes, byte[] iv, byte[] in, int inOffset, int msgLen, int numMsgs, byte[] out, int outOffset);
 	
 	/**
 	 * Default constructor. Uses default implementation of SecureRandom.
@@ -200,6 +204,49 @@ public class MiraclAES implements AES{
 		optimizedCompute(aes, inBytes, outBytes);
 	}
 
+	/**
+	 * Computes the AES permutation on the counter blocks ctr, ctr+1, ... in one call to the native code.
+	 * @see CounterModePrf#computeCounterBlocks(byte[], byte[], int, int)
+	 */
+	@Override
+	public void computeCounterBlocks(byte[] ctr, byte[] outBytes, int outOff, int outLen) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (ctr.length != getBlockSize()){
+			throw new IllegalArgumentException("the counter should be of the block size");
+		}
+		if ((outOff < 0) || (outLen < 0) || (outOff + outLen > outBytes.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		//Call the native code to compute all the blocks.
+		computeCounterBlocks(aes, ctr, outBytes, outOff, outLen);
+	}
+	
+	/**
+	 * Computes the CBC chains of many messages in one call to the native code.
+	 * @see CbcChainPrp#computeCbcChains(byte[], byte[], int, int, int, byte[], int)
+	 */
+	@Override
+	public void computeCbcChains(byte[] iv, byte[] inBytes, int inOff, int msgLen, int numMsgs, byte[] outBytes, int outOff) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (iv.length != getBlockSize()){
+			throw new IllegalArgumentException("the iv should be of the block size");
+		}
+		if ((inOff < 0) || (msgLen < 0) || (numMsgs < 0) || ((long) msgLen * numMsgs > inBytes.length - inOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOff < 0) || ((long) getBlockSize() * numMsgs > outBytes.length - outOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		//Call the native code to compute all the chains.
+		computeCbcChains(aes, iv, inBytes, inOff, msgLen, numMsgs, outBytes, outOff);
+	}
+
 	/** 
 	 * This function is provided in the interface especially for the sub-family PrfVaryingIOLength, which may have variable input/output lengths.
 	 * Since both Input and output variables are fixed this function should not normally be called. 
@@ -31,6 +31,8 @@ import java.security.SecureRandom;
 import javax.crypto.SecretKey;
 
 import edu.biu.scapi.primitives.prf.AES;
+import edu.biu.scapi.primitives.prf.CbcChainPrp;
+import edu.biu.scapi.primitives.prf.CounterModePrf;
 
 /**
  * Concrete class of PRF family for AES. This class wraps the implementation of OpenSSL library.
@@ -38,11 +40,13 @@ import edu.biu.scapi.primitives.prf.AES;
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
  */
-public class OpenSSLAES extends OpenSSLPRP implements AES{
+public class OpenSSLAES extends OpenSSLPRP implements AES, CounterModePrf, CbcChainPrp{
 	//Native functions that implements AES using OpenSSL functions.
 	private native long createAESCompute();	//Creates AES object that compute the AES function on a block.
 	private native long createAESInvert();	//Creates AES object that invert the AES function on a block.
 	private native void setKey(long computeP, long invertP, byte[] key); //Sets a key to the native AES objects.
+	private native void computeCounterBlocks(long computeP, byte[] ctr, byte[] outBytes, int outOffset, int outLen); //Computes AES on consecutive counter blocks.
+	private native void computeCbcChains(long computeP, byte[] iv, byte[] inBytes, int inOffset, int msgLen, int numMsgs, byte[] outBytes, int outOffset); //Computes the CBC chains of many messages.
 	
 	/**
 	 * Default constructor that creates the AES objects. Uses default implementation of SecureRandom.
@@ -102,6 +106,49 @@ public class OpenSSLAES extends OpenSSLPRP implements AES{
 		return 16;
 	}
 	
+	/**
+	 * Computes the AES permutation on the counter blocks ctr, ctr+1, ... in one call to the native code.
+	 * @see CounterModePrf#computeCounterBlocks(byte[], byte[], int, int)
+	 */
+	@Override
+	public void computeCounterBlocks(byte[] ctr, byte[] outBytes, int outOff, int outLen) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (ctr.length != getBlockSize()){
+			throw new IllegalArgumentException("the counter should be of the block size");
+		}
+		if ((outOff < 0) || (outLen < 0) || (outOff + outLen > outBytes.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		//Call the native code to compute all the blocks.
+		computeCounterBlocks(computeP, ctr, outBytes, outOff, outLen);
+	}
+	
+	/**
+	 * Computes the CBC chains of many messages in one call to the native code.
+	 * @see CbcChainPrp#computeCbcChains(byte[], byte[], int, int, int, byte[], int)
+	 */
+	@Override
+	public void computeCbcChains(byte[] iv, byte[] inBytes, int inOff, int msgLen, int numMsgs, byte[] outBytes, int outOff) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (iv.length != getBlockSize()){
+			throw new IllegalArgumentException("the iv should be of the block size");
+		}
+		if ((inOff < 0) || (msgLen < 0) || (numMsgs < 0) || ((long) msgLen * numMsgs > inBytes.length - inOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOff < 0) || ((long) getBlockSize() * numMsgs > outBytes.length - outOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		//Call the native code to compute all the chains.
+		computeCbcChains(computeP, iv, inBytes, inOff, msgLen, numMsgs, outBytes, outOff);
+	}
+	
 	/**
 	 * Deletes the native AES objects.
 	 */
@@ -37,6 +37,7 @@ import javax.crypto.spec.SecretKeySpec;
 import edu.biu.scapi.exceptions.FactoriesException;
 import edu.biu.scapi.primitives.hash.CryptographicHash;
 import edu.biu.scapi.primitives.prf.Hmac;
+import edu.biu.scapi.primitives.prf.IteratedModePrf;
 
 /**
  * Concrete class of PRF family for Hmac. This class wraps the implementation of OpenSSL library.
@@ -44,7 +45,7 @@ import edu.biu.scapi.primitives.prf.Hmac;
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
  */
-public class OpenSSLHMAC implements Hmac {
+public class OpenSSLHMAC implements Hmac, IteratedModePrf {
 	
 	private long hmac;					//Pointer to the native hmac.
 	private boolean isKeySet;			//until setKey is called set to false.
@@ -58,6 +59,10 @@ public class OpenSSLHMAC implements Hmac {
 	private native void updateNative(long hmac, byte[] in, int inOffset, int inLen);//Updates the Hmac eith the given in array.
 	private native void updateFinal(long hmac, byte[] out, int outOffset);//Finalize the Hmac operation and puts the result in the given out array.
 	private native void deleteNative(long hmac);		//Deletes the native object.
+	//Computes IteratedPrfVarying over the native Hmac on many inputs.
+	private native void computeIteratedBlocks(long hmac, byte[] in, int inOffset, int inLen, byte[] out, int outOffset, int outLen, int numBlocks);
+	//Computes or inverts LubyRackoffPrpFromPrfVarying over IteratedPrfVarying over the native Hmac on many blocks.
+	private native void computeLubyRackoffBlocks(long hmac, byte[] in, int inOffset, byte[] out, int outOffset, int len, int numBlocks, boolean invert);
 	
 	/**
 	 * Default constructor that uses SHA1.
@@ -246,6 +251,44 @@ public class OpenSSLHMAC implements Hmac {
 		updateFinal(hmac, outBytes, outOffset);
 	}
 	
+	/**
+	 * Computes IteratedPrfVarying over this hmac on many inputs in one call to the native code.
+	 * @see IteratedModePrf#computeIteratedBlocks(byte[], int, int, byte[], int, int, int)
+	 */
+	@Override
+	public void computeIteratedBlocks(byte[] inBytes, int inOff, int inLen, byte[] outBytes, int outOff, int outLen, int numBlocks) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if ((inOff < 0) || (inLen < 0) || (numBlocks < 0) || ((long) inLen * numBlocks > inBytes.length - inOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOff < 0) || (outLen < 0) || ((long) outLen * numBlocks > outBytes.length - outOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		computeIteratedBlocks(hmac, inBytes, inOff, inLen, outBytes, outOff, outLen, numBlocks);
+	}
+	
+	/**
+	 * Computes or inverts LubyRackoffPrpFromPrfVarying over IteratedPrfVarying over this hmac on many blocks in one call to the native code.
+	 * @see IteratedModePrf#computeLubyRackoffBlocks(byte[], int, byte[], int, int, int, boolean)
+	 */
+	@Override
+	public void computeLubyRackoffBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int len, int numBlocks, boolean invert) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if ((inOff < 0) || (len < 0) || (numBlocks < 0) || ((long) len * numBlocks > inBytes.length - inOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOff < 0) || ((long) len * numBlocks > outBytes.length - outOff)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		computeLubyRackoffBlocks(hmac, inBytes, inOff, outBytes, outOff, len, numBlocks, invert);
+	}
+	
 	/**
 	 * Generates a secret key to initialize this prf object.
 	 * @param keyParams algorithmParameterSpec contains the required secret key size in bits 
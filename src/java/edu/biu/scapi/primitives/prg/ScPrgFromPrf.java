@@ -29,19 +29,25 @@ package edu.biu.scapi.primitives.prg;
 import java.security.InvalidKeyException;
 import java.security.spec.AlgorithmParameterSpec;
 import java.security.spec.InvalidParameterSpecException;
+import java.util.Arrays;
 
 import javax.crypto.IllegalBlockSizeException;
 import javax.crypto.SecretKey;
 
 import edu.biu.scapi.exceptions.FactoriesException;
 import edu.biu.scapi.exceptions.NoMaxException;
+import edu.biu.scapi.primitives.prf.CounterModePrf;
 import edu.biu.scapi.primitives.prf.PseudorandomFunction;
 import edu.biu.scapi.primitives.prf.bc.BcAES;
 import edu.biu.scapi.tools.Factories.PrfFactory;
 
 /**
  * This is a simple way of generating a pseudorandom stream from a pseudorandom function. The seed for the pseudorandom generator is the key to the pseudorandom function. 
- * Then, the algorithm initializes a counter to 1 and applies the pseudorandom function to the counter, increments it, and repeats.
+ * Then, the algorithm initializes a counter to 1 and applies the pseudorandom function to the counter, increments it, and repeats. <p>
+ * If the underlying prf implements {@link CounterModePrf} (the native AES implementations), all the blocks of a call are computed in one 
+ * native call. The output is the same as computing each block separately. <p>
+ * The position in the stream can be saved and restored using {@link #getCounter()} and {@link #setCounter(byte[])}, or set directly 
+ * using {@link #setCounterOffset(long)}.
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
  */
@@ -146,6 +152,14 @@ public class ScPrgFromPrf implements PseudorandomGenerator{
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 
+		//If the prf can compute consecutive counters natively, compute all the blocks in one call.
+		//Each call uses a new counter for each started block, exactly as the loop below does.
+		if ((prf instanceof CounterModePrf) && (ctr.length == prf.getBlockSize())){
+			((CounterModePrf) prf).computeCounterBlocks(ctr, outBytes, outOffset, outLen);
+			addToCtr((outLen + ctr.length - 1) / ctr.length);
+			return;
+		}
+		
 		int numGeneratedBytes = 0;	//Number of current generated bytes.
 		byte [] generatedBytes = new byte[ctr.length];
 
@@ -192,6 +206,66 @@ public class ScPrgFromPrf implements PseudorandomGenerator{
 
 	}
 
+	/**
+	 * Returns a copy of the counter that the next generated block will be computed on. 
+	 * Passing it later to {@link #setCounter(byte[])} resumes the stream from this point.
+	 * @throws IllegalStateException if no key was set.
+	 */
+	public byte[] getCounter() {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		return ctr.clone();
+	}
+	
+	/**
+	 * Sets the counter that the next generated block will be computed on.
+	 * @param counter a big endian counter, of the same size as the counter of this prg (see {@link #getCounter()}).
+	 * @throws IllegalStateException if no key was set.
+	 * @throws IllegalArgumentException if the given counter is not of the right size.
+	 */
+	public void setCounter(byte[] counter) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (counter.length != ctr.length){
+			throw new IllegalArgumentException("the counter should be " + ctr.length + " bytes long");
+		}
+		System.arraycopy(counter, 0, ctr, 0, ctr.length);
+	}
+	
+	/**
+	 * Sets the counter such that the next generated block is the given block of the stream, as if blockOffset blocks were 
+	 * generated since the key was set. Since each call to getPRGBytes uses a new block for each started block, the offset counts blocks and not bytes.
+	 * @param blockOffset the index of the next block in the stream.
+	 * @throws IllegalStateException if no key was set.
+	 * @throws IllegalArgumentException if the given offset is negative.
+	 */
+	public void setCounterOffset(long blockOffset) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (blockOffset < 0){
+			throw new IllegalArgumentException("the offset should be non negative");
+		}
+		//The stream starts with counter 1.
+		Arrays.fill(ctr, (byte) 0);
+		ctr[ctr.length-1] = 1;
+		addToCtr(blockOffset);
+	}
+	
+	/**
+	 * Adds the given non negative value to the ctr byte array. 
+	 */
+	private void addToCtr(long value){
+		long carry = value;
+		for (int i = ctr.length - 1; i >= 0 && carry != 0; i--){
+			long x = (ctr[i] & 0xff) + (carry & 0xff);
+			ctr[i] = (byte) x;
+			carry = (carry >>> 8) + (x >>> 8);
+		}
+	}
+	
 	/**
 	 * Increases the ctr byte array by 1 bit.
 	 */
@@ -85,6 +85,30 @@ public class HKDFBasedRO implements RandomOracle{
 		return key.getEncoded();
 	}
 	
+	/**
+	 * Computes the random oracle function on many inputs of the same length and puts the results in the given array, 
+	 * one after the other. HKDF already expands to any output length, so each result is equal to compute on the same input.
+	 * @param inputs the inputs, one after the other, starting at offset 0.
+	 * @param inLen length of each input.
+	 * @param numInputs number of inputs.
+	 * @param outLen required output length IN BYTES of each input.
+	 * @param output array to put the results in.
+	 * @param outOffset offset within the output array to put the first result from.
+	 */
+	public void computeMany(byte[] inputs, int inLen, int numInputs, int outLen, byte[] output, int outOffset){
+		if ((inLen < 0) || (outLen < 0) || (numInputs < 0) || (outOffset < 0) || 
+				((long) inLen * numInputs > inputs.length) || ((long) outLen * numInputs > output.length - outOffset)){
+			throw new ArrayIndexOutOfBoundsException("wrong length for the given input or output buffer");
+		}
+		//HKDF hashes the whole entropy source array, so each input is copied to an array of its own length.
+		byte[] input = new byte[inLen];
+		for (int i = 0; i < numInputs; i++){
+			System.arraycopy(inputs, i * inLen, input, 0, inLen);
+			byte[] result = compute(input, 0, inLen, outLen);
+			System.arraycopy(result, 0, output, outOffset + i * outLen, outLen);
+		}
+	}
+	
 	@Override
 	public String getAlgorithmName() {
 		
@@ -30,7 +30,11 @@ import edu.biu.scapi.primitives.hash.cryptopp.CryptoPpSHA1;
 import edu.biu.scapi.tools.Factories.CryptographicHashFactory;
 
 /**
- * Concrete class of random oracle based on CryptographicHash.
+ * Concrete class of random oracle based on CryptographicHash. <p>
+ * 
+ * The output is expanded in counter mode, so any output length can be requested: block i is H(len(x) || x || i), where 
+ * the length of x and i are written as 4 bytes big endian integers. The length prefix makes the encoding unambiguous, so a 
+ * block of one input never equals a block of another input.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
@@ -38,6 +42,9 @@ import edu.biu.scapi.tools.Factories.CryptographicHashFactory;
 public class HashBasedRO implements RandomOracle{
 	
 	private CryptographicHash hash; //The underlying object used to compute the random oracle function.
+	private byte[] block;			//Holds the last hash block when only part of it is needed.
+	private byte[] length = new byte[4];	//The length of the input, hashed before it.
+	private byte[] counter = new byte[4];
 	
 	/**
 	 * default constructor that sets default values to the underlying cryptographic hash.
@@ -53,6 +60,7 @@ public class HashBasedRO implements RandomOracle{
 	 */
 	public HashBasedRO(CryptographicHash hash){
 		this.hash = hash;
+		block = new byte[hash.getHashedMsgSize()];
 	}
 	
 	/**
@@ -73,27 +81,66 @@ public class HashBasedRO implements RandomOracle{
 	 * @return a string in the required length.
 	 */
 	public byte[] compute(byte[] input, int inOffset, int inLen, int outLen){
-		if (outLen>hash.getHashedMsgSize()){
-			throw new IllegalArgumentException("The given output length is greater then the output length of the hash function");
-		}
-		//Call the hash function with the input.
-		hash.update(input, inOffset, inLen);
-		
-		//Create output array in the required size.
-		byte[] out = new byte[hash.getHashedMsgSize()];
-		
-		//Compute the hash function.
-		hash.hashFinal(out, 0);
-		
 		byte[] output = new byte[outLen];
-		if (out.length > outLen){
-			System.arraycopy(out, 0, output, 0, outLen);
-		} else{
-			output = out;
-		}
+		expand(input, inOffset, inLen, output, 0, outLen);
 		return output;
 	}
+	
+	/**
+	 * Computes the random oracle function on many inputs of the same length and puts the results in the given array, 
+	 * one after the other.
+	 * @param inputs the inputs, one after the other, starting at offset 0.
+	 * @param inLen length of each input.
+	 * @param numInputs number of inputs.
+	 * @param outLen required output length IN BYTES of each input.
+	 * @param output array to put the results in.
+	 * @param outOffset offset within the output array to put the first result from.
+	 */
+	public void computeMany(byte[] inputs, int inLen, int numInputs, int outLen, byte[] output, int outOffset){
+		if ((inLen < 0) || (outLen < 0) || (numInputs < 0) || (outOffset < 0) || 
+				((long) inLen * numInputs > inputs.length) || ((long) outLen * numInputs > output.length - outOffset)){
+			throw new ArrayIndexOutOfBoundsException("wrong length for the given input or output buffer");
+		}
+		for (int i = 0; i < numInputs; i++){
+			expand(inputs, i * inLen, inLen, output, outOffset + i * outLen, outLen);
+		}
+	}
+	
+	/*
+	 * Computes outLen bytes of the random oracle on the given input and puts them in out from outOffset.
+	 * Whole hash blocks are written directly to the output array. Only the last partial block goes through the block buffer.
+	 */
+	private void expand(byte[] input, int inOffset, int inLen, byte[] out, int outOffset, int outLen){
+		int hashSize = block.length;
+		int done = 0;
+		writeInt(inLen, length);
+		for (int i = 0; done < outLen; i++){
+			hash.update(length, 0, length.length);
+			hash.update(input, inOffset, inLen);
+			writeInt(i, counter);
+			hash.update(counter, 0, counter.length);
+			
+			if (outLen - done >= hashSize){
+				hash.hashFinal(out, outOffset + done);
+				done += hashSize;
+			} else{
+				hash.hashFinal(block, 0);
+				System.arraycopy(block, 0, out, outOffset + done, outLen - done);
+				done = outLen;
+			}
+		}
+	}
+
 
+	/*
+	 * Writes the given value to the given 4 bytes array in big endian order.
+	 */
+	private static void writeInt(int value, byte[] out){
+		out[0] = (byte) (value >>> 24);
+		out[1] = (byte) (value >>> 16);
+		out[2] = (byte) (value >>> 8);
+		out[3] = (byte) value;
+	}
 
 	@Override
 	public String getAlgorithmName() {
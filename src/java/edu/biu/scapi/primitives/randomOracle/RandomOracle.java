@@ -51,4 +51,17 @@ public interface RandomOracle {
 	 * @return a string with the required length.
 	 */
 	public byte[] compute(byte[] input, int inOffset, int inLen, int outLen);
+	
+	/**
+	 * Computes the random oracle function on many inputs of the same length and puts the results in the given array, 
+	 * one after the other. <p>
+	 * The result of the i-th input is equal to the result of compute on the same input with the same output length.
+	 * @param inputs the inputs, one after the other, starting at offset 0.
+	 * @param inLen length of each input.
+	 * @param numInputs number of inputs.
+	 * @param outLen required output length IN BYTES of each input.
+	 * @param output array to put the results in. Should have room for numInputs*outLen bytes after outOffset.
+	 * @param outOffset offset within the output array to put the first result from.
+	 */
+	public void computeMany(byte[] inputs, int inLen, int numInputs, int outLen, byte[] output, int outOffset);
 }
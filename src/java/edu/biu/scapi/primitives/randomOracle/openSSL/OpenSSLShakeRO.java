@@ -0,0 +1,138 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.randomOracle.openSSL;
+
+import edu.biu.scapi.primitives.randomOracle.RandomOracle;
+
+/**
+ * A general adapter class of random oracle based on the extendable output functions (SHAKE) of OpenSSL. <p>
+ * An extendable output function returns any required number of output bytes in a single call, so there is no need for 
+ * counter mode expansion as in HashBasedRO. 
+ * 
+ * A concrete random oracle such as OpenSSLShake128RO only passes the name of the function in the constructor to this base class. 
+ * SHAKE requires OpenSSL 1.1.1 or later. 
+ * Since the underlying library is written in a native language we use the JNI architecture.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public abstract class OpenSSLShakeRO implements RandomOracle {
+
+	private long shake; //Pointer to the native SHAKE context.
+	private String name;
+	
+	//Native functions. These functions are implemented in a c++ dll using JNI that we load.
+	
+	//Creates a SHAKE context and returns the pointer, or 0 if the function is not supported by the native library.
+	private native long createShake(String name);
+	
+	//Computes outLen bytes of output on the given input.
+	private native void computeShake(long ptr, byte[] input, int inOffset, int inLen, byte[] output, int outOffset, int outLen);
+	
+	//Computes outLen bytes of output on each of the given inputs.
+	private native void computeShakeMany(long ptr, byte[] inputs, int inLen, int numInputs, byte[] output, int outOffset, int outLen);
+	
+	//Deletes the created pointer.
+	private native void deleteShake(long ptr);
+	
+	/**
+	 * Constructs the native SHAKE function using OpenSSL library.
+	 * @param name - SHAKE128 or SHAKE256.
+	 * @throws UnsupportedOperationException if the OpenSSL version that the native library was built with does not support SHAKE.
+	 */
+	protected OpenSSLShakeRO(String name) {
+		shake = createShake(name);
+		if (shake == 0){
+			throw new UnsupportedOperationException(name + " is not supported by the native OpenSSL library");
+		}
+		this.name = name;
+	}
+	
+	/**
+	 * @return the name of the extendable output function.
+	 */
+	public String getAlgorithmName() {
+		return name;
+	}
+	
+	/**
+	 * Computes the random oracle function on the given input.
+	 * @param input input to compute the random oracle function on.
+	 * @param inOffset offset within the input to take the bytes from.
+	 * @param inLen length of the input.
+	 * @param outLen required output length IN BYTES.
+	 * @return a string with the required length.
+	 */
+	public byte[] compute(byte[] input, int inOffset, int inLen, int outLen){
+		//Checks that the offset and length are correct.
+		if ((inOffset < 0) || (inLen < 0) || (inOffset + inLen > input.length)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if (outLen < 0){
+			throw new NegativeArraySizeException("wrong output length");
+		}
+		
+		byte[] output = new byte[outLen];
+		computeShake(shake, input, inOffset, inLen, output, 0, outLen);
+		return output;
+	}
+	
+	/**
+	 * Computes the random oracle function on many inputs of the same length and puts the results in the given array, 
+	 * one after the other. All the inputs are computed in one native call.
+	 * @param inputs the inputs, one after the other, starting at offset 0.
+	 * @param inLen length of each input.
+	 * @param numInputs number of inputs.
+	 * @param outLen required output length IN BYTES of each input.
+	 * @param output array to put the results in.
+	 * @param outOffset offset within the output array to put the first result from.
+	 */
+	public void computeMany(byte[] inputs, int inLen, int numInputs, int outLen, byte[] output, int outOffset){
+		if ((inLen < 0) || (outLen < 0) || (numInputs < 0) || (outOffset < 0) || 
+				((long) inLen * numInputs > inputs.length) || ((long) outLen * numInputs > output.length - outOffset)){
+			throw new ArrayIndexOutOfBoundsException("wrong length for the given input or output buffer");
+		}
+		computeShakeMany(shake, inputs, inLen, numInputs, output, outOffset, outLen);
+	}
+	
+	/**
+	 * Deletes the native SHAKE context.
+	 */
+	protected void finalize() throws Throwable {
+		
+		//Deletes from the dll the dynamic allocation of the context.
+		if (shake != 0){
+			deleteShake(shake);
+		}
+		
+		super.finalize();
+	}
+	
+	static {
+		
+		//loads the OpenSSL dll.
+		System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
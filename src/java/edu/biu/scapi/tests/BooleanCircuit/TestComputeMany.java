@@ -0,0 +1,123 @@
+package edu.biu.scapi.tests.BooleanCircuit;
+
+import static org.junit.Assert.*;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.File;
+import java.util.Arrays;
+import java.util.Random;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit.CircuitType;
+import edu.biu.scapi.exceptions.NotAllInputsSetException;
+
+/**
+ * Checks that computeMany of ScNativeGarbledBooleanCircuit on K sets of inputs gives the outputs of K calls to compute.
+ */
+public class TestComputeMany {
+
+	private static final String CIRCUIT_FILE = "src/java/edu/biu/scapi/tests/BooleanCircuit/NigelAes.txt";
+	//The three halves circuit computes four sets at a time, so 6 sets check both a full group and the remaining sets.
+	private static final int NUM_SETS = 6;
+
+	private Random random = new Random(89);
+
+	@Before
+	public void setUp() {
+		assumeTrue(new File(CIRCUIT_FILE).exists());
+	}
+
+	private ScNativeGarbledBooleanCircuit createCircuit(CircuitType type, boolean isNonXorOutputsRequired) {
+		try {
+			return new ScNativeGarbledBooleanCircuit(CIRCUIT_FILE, type, isNonXorOutputsRequired);
+		} catch (LinkageError e) {
+			//The native library is not available.
+			assumeTrue(false);
+			return null;
+		}
+	}
+
+	/**
+	 * @return the keys of both parties for random inputs.
+	 */
+	private byte[] randomInputKeys(ScNativeGarbledBooleanCircuit circuit, FastCircuitCreationValues values) throws Exception {
+		byte[] first = new byte[circuit.getNumberOfInputs(1)];
+		byte[] second = new byte[circuit.getNumberOfInputs(2)];
+		for (int i = 0; i < first.length; i++) {
+			first[i] = (byte) random.nextInt(2);
+		}
+		for (int i = 0; i < second.length; i++) {
+			second[i] = (byte) random.nextInt(2);
+		}
+		byte[] firstKeys = circuit.getGarbledInputFromUngarbledInput(first, values.getAllInputWireValues(), 1);
+		byte[] secondKeys = circuit.getGarbledInputFromUngarbledInput(second, values.getAllInputWireValues(), 2);
+		byte[] keys = new byte[firstKeys.length + secondKeys.length];
+		System.arraycopy(firstKeys, 0, keys, 0, firstKeys.length);
+		System.arraycopy(secondKeys, 0, keys, firstKeys.length, secondKeys.length);
+		return keys;
+	}
+
+	private void checkComputeMany(CircuitType type, boolean isNonXorOutputsRequired) throws Exception {
+		ScNativeGarbledBooleanCircuit circuit = createCircuit(type, isNonXorOutputsRequired);
+		byte[] seed = new byte[16];
+		random.nextBytes(seed);
+		FastCircuitCreationValues values = circuit.garble(seed);
+
+		byte[][] inputSets = new byte[NUM_SETS][];
+		byte[][] singleOutputs = new byte[NUM_SETS][];
+		for (int k = 0; k < NUM_SETS; k++) {
+			inputSets[k] = randomInputKeys(circuit, values);
+			circuit.setInputs(inputSets[k]);
+			singleOutputs[k] = circuit.compute();
+		}
+
+		//Each prefix of the sets checks a different split between the sets that are computed together and the remaining ones.
+		for (int numSets = 1; numSets <= NUM_SETS; numSets++) {
+			int setSize = inputSets[0].length;
+			byte[] allInputs = new byte[numSets * setSize];
+			for (int k = 0; k < numSets; k++) {
+				System.arraycopy(inputSets[k], 0, allInputs, k * setSize, setSize);
+			}
+
+			byte[] allOutputs = circuit.computeMany(allInputs);
+			int outputSize = singleOutputs[0].length;
+			assertEquals(numSets * outputSize, allOutputs.length);
+			for (int k = 0; k < numSets; k++) {
+				byte[] output = Arrays.copyOfRange(allOutputs, k * outputSize, (k + 1) * outputSize);
+				assertArrayEquals(type + " set " + k + " of " + numSets, singleOutputs[k], output);
+				assertArrayEquals(circuit.translate(singleOutputs[k]), circuit.translate(output));
+			}
+		}
+	}
+
+	@Test
+	public void TestComputeManyThreeHalves() throws Exception {
+		checkComputeMany(CircuitType.FREE_XOR_THREE_HALVES, false);
+	}
+
+	@Test
+	public void TestComputeManyThreeHalvesNonXorOutputs() throws Exception {
+		checkComputeMany(CircuitType.FREE_XOR_THREE_HALVES, true);
+	}
+
+	@Test
+	public void TestComputeManyHalfGates() throws Exception {
+		checkComputeMany(CircuitType.FREE_XOR_HALF_GATES, false);
+	}
+
+	@Test
+	public void TestComputeManyNoSets() throws Exception {
+		ScNativeGarbledBooleanCircuit circuit = createCircuit(CircuitType.FREE_XOR_THREE_HALVES, false);
+		assertEquals(0, circuit.computeMany(new byte[0]).length);
+	}
+
+	@Test(expected = NotAllInputsSetException.class)
+	public void TestComputeManyRejectsPartialSet() throws Exception {
+		ScNativeGarbledBooleanCircuit circuit = createCircuit(CircuitType.FREE_XOR_THREE_HALVES, false);
+		circuit.computeMany(new byte[circuit.getInputWireIndices().length * 16 + 16]);
+	}
+}
@@ -0,0 +1,181 @@
+package edu.biu.scapi.tests.BooleanCircuit;
+
+import static org.junit.Assert.*;
+import static org.junit.Assume.assumeTrue;
+
+import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.BitSet;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.Random;
+
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+import edu.biu.scapi.circuits.circuit.BooleanCircuit;
+import edu.biu.scapi.circuits.circuit.Gate;
+import edu.biu.scapi.circuits.circuit.Wire;
+import edu.biu.scapi.circuits.encryption.AESFixedKeyMultiKeyEncryption;
+import edu.biu.scapi.circuits.garbledCircuit.CircuitCreationValues;
+import edu.biu.scapi.circuits.garbledCircuit.FreeXORGarblingParameters;
+import edu.biu.scapi.circuits.garbledCircuit.GarbledBooleanCircuitImp;
+import edu.biu.scapi.circuits.garbledCircuit.GarbledWire;
+import edu.biu.scapi.circuits.garbledCircuit.GarblingParameters;
+import edu.biu.scapi.circuits.garbledCircuit.StandardGarblingParameters;
+import edu.biu.scapi.primitives.prg.ScPrgFromPrf;
+
+/**
+ * Checks that the native engine of GarbledBooleanCircuitImp creates the same garbled tables, translation tables and computed outputs
+ * as the java gates, for each circuit type that the engine supports.
+ */
+public class TestNativeGarbledGates {
+
+	private static final int INPUTS_PER_PARTY = 16;
+	private static final int NUM_GATES = 200;
+	private static final int NUM_OUTPUTS = 16;
+
+	//Truth tables of two input gates, the row of inputs (a, b) is bit 2a + b.
+	private static final int[] TRUTH_TABLES = {
+		0x8,	//AND
+		0xE,	//OR
+		0x6,	//XOR, a free xor gate
+		0x9,	//XNOR, a free xor not gate
+		0x7,	//NAND
+		0x2		//a AND NOT b
+	};
+
+	private BooleanCircuit bc;
+	private Map<Integer, Byte> input;
+	private byte[] seed;
+
+	@Before
+	public void setUp() throws Exception {
+		assumeTrue(GarbledBooleanCircuitImp.isNativeEngineAvailable());
+
+		Random random = new Random(2017);
+		bc = createCircuit(random);
+
+		input = new HashMap<Integer, Byte>();
+		for (int party = 1; party <= 2; party++) {
+			for (int w : bc.getInputWireIndices(party)) {
+				input.put(w, (byte) random.nextInt(2));
+			}
+		}
+		seed = new byte[16];
+		random.nextBytes(seed);
+	}
+
+	@After
+	public void tearDown() {
+		GarbledBooleanCircuitImp.setNativeEngineEnabled(true);
+	}
+
+	/**
+	 * Creates a random two party circuit of two input gates, where each gate takes its inputs from the input wires or the previous gates.
+	 */
+	private static BooleanCircuit createCircuit(Random random) {
+		int numInputs = 2 * INPUTS_PER_PARTY;
+		Gate[] gates = new Gate[NUM_GATES];
+		for (int g = 0; g < NUM_GATES; g++) {
+			int numWires = numInputs + g;
+			int[] inputs = { random.nextInt(numWires), random.nextInt(numWires) };
+			if (inputs[0] == inputs[1]) {
+				inputs[1] = (inputs[1] + 1) % numWires;
+			}
+			int table = TRUTH_TABLES[random.nextInt(TRUTH_TABLES.length)];
+			BitSet truthTable = new BitSet(4);
+			for (int row = 0; row < 4; row++) {
+				if ((table & (1 << row)) != 0) {
+					truthTable.set(row);
+				}
+			}
+			gates[g] = new Gate(g, truthTable, inputs, new int[] { numWires });
+		}
+
+		ArrayList<ArrayList<Integer>> inputWires = new ArrayList<ArrayList<Integer>>();
+		for (int party = 0; party < 2; party++) {
+			ArrayList<Integer> partyInputs = new ArrayList<Integer>();
+			for (int w = 0; w < INPUTS_PER_PARTY; w++) {
+				partyInputs.add(party * INPUTS_PER_PARTY + w);
+			}
+			inputWires.add(partyInputs);
+		}
+		ArrayList<ArrayList<Integer>> outputWires = new ArrayList<ArrayList<Integer>>();
+		ArrayList<Integer> outputs = new ArrayList<Integer>();
+		for (int w = numInputs + NUM_GATES - NUM_OUTPUTS; w < numInputs + NUM_GATES; w++) {
+			outputs.add(w);
+		}
+		outputWires.add(outputs);
+		return new BooleanCircuit(gates, outputWires, inputWires);
+	}
+
+	/**
+	 * The garbled circuit and its computed output, using one engine.
+	 */
+	private static class Result {
+		private GarbledBooleanCircuitImp circuit;
+		private HashMap<Integer, GarbledWire> output;
+	}
+
+	private Result garbleAndCompute(GarblingParameters parameters, boolean nativeEngine) throws Exception {
+		GarbledBooleanCircuitImp.setNativeEngineEnabled(nativeEngine);
+		Result result = new Result();
+		result.circuit = new GarbledBooleanCircuitImp(parameters, new ScPrgFromPrf());
+		CircuitCreationValues values = result.circuit.garble(seed);
+		result.circuit.setGarbledInputFromUngarbledInput(input, values.getAllInputWireValues());
+		result.output = result.circuit.compute();
+		return result;
+	}
+
+	private void checkSameAsJava(GarblingParameters javaParameters, GarblingParameters nativeParameters) throws Exception {
+		Result java = garbleAndCompute(javaParameters, false);
+		Result jni = garbleAndCompute(nativeParameters, true);
+
+		assertArrayEquals(java.circuit.getGarbledTables().toDoubleByteArray(), jni.circuit.getGarbledTables().toDoubleByteArray());
+		assertEquals(java.circuit.getTranslationTable(), jni.circuit.getTranslationTable());
+
+		assertEquals(java.output.keySet(), jni.output.keySet());
+		for (Map.Entry<Integer, GarbledWire> entry : java.output.entrySet()) {
+			assertArrayEquals(entry.getValue().getValueAndSignalBit().getEncoded(),
+					jni.output.get(entry.getKey()).getValueAndSignalBit().getEncoded());
+		}
+
+		//Both outputs translate to the output of the ungarbled circuit.
+		Map<Integer, Wire> expected = computeUngarbled();
+		Map<Integer, Wire> translated = jni.circuit.translate(jni.output);
+		for (Map.Entry<Integer, Wire> entry : translated.entrySet()) {
+			assertEquals(expected.get(entry.getKey()).getValue(), entry.getValue().getValue());
+		}
+	}
+
+	private Map<Integer, Wire> computeUngarbled() throws Exception {
+		for (int party = 1; party <= 2; party++) {
+			Map<Integer, Wire> partyInput = new HashMap<Integer, Wire>();
+			for (int w : bc.getInputWireIndices(party)) {
+				partyInput.put(w, new Wire(input.get(w)));
+			}
+			bc.setInputs(partyInput, party);
+		}
+		return bc.compute();
+	}
+
+	@Test
+	public void TestFreeXOR() throws Exception {
+		checkSameAsJava(new FreeXORGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), false),
+				new FreeXORGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), false));
+	}
+
+	@Test
+	public void TestFreeXORRowReduction() throws Exception {
+		checkSameAsJava(new FreeXORGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), true),
+				new FreeXORGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), true));
+	}
+
+	@Test
+	public void TestStandard() throws Exception {
+		checkSameAsJava(new StandardGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), new SecureRandom(), false),
+				new StandardGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), new SecureRandom(), false));
+	}
+}
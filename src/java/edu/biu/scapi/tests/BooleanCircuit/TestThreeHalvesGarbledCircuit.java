@@ -0,0 +1,158 @@
+package edu.biu.scapi.tests.BooleanCircuit;
+
+import static org.junit.Assert.*;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.File;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.Random;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import edu.biu.scapi.circuits.circuit.BooleanCircuit;
+import edu.biu.scapi.circuits.circuit.Wire;
+import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit.CircuitType;
+import edu.biu.scapi.circuits.garbledCircuit.JustGarbledGarbledTablesHolder;
+
+/**
+ * Garbles the AES circuit with the three halves type of ScNativeGarbledBooleanCircuit, computes, translates and verifies it,
+ * and checks the output against the ungarbled BooleanCircuit.
+ */
+public class TestThreeHalvesGarbledCircuit {
+
+	private static final String CIRCUIT_FILE = "src/java/edu/biu/scapi/tests/BooleanCircuit/NigelAes.txt";
+	private static final int NUM_INPUTS = 4;
+
+	private BooleanCircuit bc;
+	private ScNativeGarbledBooleanCircuit circuit;
+	private Random random = new Random(100);
+
+	@Before
+	public void setUp() throws Exception {
+		assumeTrue(new File(CIRCUIT_FILE).exists());
+		try {
+			circuit = new ScNativeGarbledBooleanCircuit(CIRCUIT_FILE, CircuitType.FREE_XOR_THREE_HALVES, false);
+		} catch (LinkageError e) {
+			//The native library is not available.
+			assumeTrue(false);
+		}
+		bc = new BooleanCircuit(new File(CIRCUIT_FILE));
+	}
+
+	private byte[] randomSeed() {
+		byte[] seed = new byte[16];
+		random.nextBytes(seed);
+		return seed;
+	}
+
+	/**
+	 * @return a random input bit for each input wire of each party.
+	 */
+	private byte[][] randomInput() throws Exception {
+		byte[][] input = new byte[2][];
+		for (int party = 1; party <= 2; party++) {
+			input[party - 1] = new byte[circuit.getNumberOfInputs(party)];
+			for (int i = 0; i < input[party - 1].length; i++) {
+				input[party - 1][i] = (byte) random.nextInt(2);
+			}
+		}
+		return input;
+	}
+
+	/**
+	 * @return the keys of both parties that match the given input.
+	 */
+	private byte[] selectInputKeys(FastCircuitCreationValues values, byte[][] input) {
+		byte[] first = circuit.getGarbledInputFromUngarbledInput(input[0], values.getAllInputWireValues(), 1);
+		byte[] second = circuit.getGarbledInputFromUngarbledInput(input[1], values.getAllInputWireValues(), 2);
+		byte[] keys = new byte[first.length + second.length];
+		System.arraycopy(first, 0, keys, 0, first.length);
+		System.arraycopy(second, 0, keys, first.length, second.length);
+		return keys;
+	}
+
+	/**
+	 * @return the output bits of the ungarbled circuit, in the order of the output wires of the garbled circuit.
+	 */
+	private byte[] computeUngarbled(byte[][] input) throws Exception {
+		for (int party = 1; party <= 2; party++) {
+			int[] indices = circuit.getInputWireIndices(party);
+			Map<Integer, Wire> partyInput = new HashMap<Integer, Wire>();
+			for (int i = 0; i < indices.length; i++) {
+				partyInput.put(indices[i], new Wire(input[party - 1][i]));
+			}
+			bc.setInputs(partyInput, party);
+		}
+		Map<Integer, Wire> output = bc.compute();
+
+		int[] outputIndices = circuit.getOutputWireIndices();
+		byte[] expected = new byte[outputIndices.length];
+		for (int i = 0; i < outputIndices.length; i++) {
+			expected[i] = output.get(outputIndices[i]).getValue();
+		}
+		return expected;
+	}
+
+	@Test
+	public void TestGarbleComputeTranslateVerify() throws Exception {
+		for (int i = 0; i < NUM_INPUTS; i++) {
+			FastCircuitCreationValues values = circuit.garble(randomSeed());
+			byte[][] input = randomInput();
+
+			circuit.setInputs(selectInputKeys(values, input));
+			assertArrayEquals(computeUngarbled(input), circuit.translate(circuit.compute()));
+			assertTrue(circuit.verify(values.getAllInputWireValues()));
+		}
+	}
+
+	@Test
+	public void TestComputeFromTables() throws Exception {
+		FastCircuitCreationValues values = circuit.garble(randomSeed());
+		byte[][] input = randomInput();
+
+		//The evaluator gets only the garbled tables and the translation table.
+		ScNativeGarbledBooleanCircuit evaluator = new ScNativeGarbledBooleanCircuit(CIRCUIT_FILE, CircuitType.FREE_XOR_THREE_HALVES, false);
+		evaluator.setGarbledTables(circuit.getGarbledTables());
+		evaluator.setTranslationTable(circuit.getTranslationTable());
+		evaluator.setInputs(selectInputKeys(values, input));
+		assertArrayEquals(computeUngarbled(input), evaluator.translate(evaluator.compute()));
+	}
+
+	@Test
+	public void TestSameOutputAsHalfGates() throws Exception {
+		byte[] seed = randomSeed();
+		byte[][] input = randomInput();
+		ScNativeGarbledBooleanCircuit halfGates = new ScNativeGarbledBooleanCircuit(CIRCUIT_FILE, CircuitType.FREE_XOR_HALF_GATES, false);
+
+		FastCircuitCreationValues values = circuit.garble(seed);
+		circuit.setInputs(selectInputKeys(values, input));
+		FastCircuitCreationValues halfGatesValues = halfGates.garble(seed);
+		halfGates.setInputs(selectInputKeys(halfGatesValues, input));
+
+		assertArrayEquals(halfGates.translate(halfGates.compute()), circuit.translate(circuit.compute()));
+	}
+
+	@Test
+	public void TestVerifyFailsOnChangedTables() throws Exception {
+		FastCircuitCreationValues values = circuit.garble(randomSeed());
+		byte[] tables = circuit.getGarbledTables().toDoubleByteArray()[0];
+
+		//Change a half ciphertext of the first AND gate and a control bit of the last one.
+		byte[] changed = tables.clone();
+		changed[0] ^= 1;
+		circuit.setGarbledTables(new JustGarbledGarbledTablesHolder(changed));
+		assertFalse(circuit.verify(values.getAllInputWireValues()));
+
+		changed = tables.clone();
+		changed[changed.length - 1] ^= 1;
+		circuit.setGarbledTables(new JustGarbledGarbledTablesHolder(changed));
+		assertFalse(circuit.verify(values.getAllInputWireValues()));
+
+		circuit.setGarbledTables(new JustGarbledGarbledTablesHolder(tables));
+		assertTrue(circuit.verify(values.getAllInputWireValues()));
+	}
+}
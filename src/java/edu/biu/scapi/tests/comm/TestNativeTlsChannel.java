@@ -0,0 +1,341 @@
+package edu.biu.scapi.tests.comm;
+
+import static org.junit.Assert.*;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.DataInputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.ObjectInputStream;
+import java.io.ObjectOutputStream;
+import java.io.OutputStream;
+import java.io.Serializable;
+import java.net.InetAddress;
+import java.net.Socket;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.file.Files;
+import java.security.KeyStore;
+import java.security.NoSuchAlgorithmException;
+import java.security.cert.CertificateFactory;
+import java.util.Map;
+import java.util.Random;
+import java.util.concurrent.TimeoutException;
+
+import javax.net.ssl.KeyManagerFactory;
+import javax.net.ssl.SSLContext;
+import javax.net.ssl.SSLServerSocket;
+import javax.net.ssl.SSLSocket;
+import javax.net.ssl.TrustManagerFactory;
+
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+import edu.biu.scapi.comm.Channel;
+import edu.biu.scapi.comm.twoPartyComm.NativeTlsSocketCommunicationSetup;
+import edu.biu.scapi.comm.twoPartyComm.SocketPartyData;
+
+/**
+ * Runs the native TLS channel on loopback against another native channel and against a plain java SSLSocket peer.<p>
+ * The certificates are created with the openssl command line tool: an authority and one certificate for 127.0.0.1 that
+ * both parties use. The tests are skipped if the tool or the native library is missing.
+ */
+public class TestNativeTlsChannel {
+
+	//Longer than the chunks that the native channel reads a message in, and not a multiple of them.
+	private static final int LARGE_MESSAGE_SIZE = 200003;
+	private static final long CONNECT_TIMEOUT = 20000;
+
+	private static File dir;
+	private static InetAddress ip;
+
+	private static boolean run(String... command) throws IOException, InterruptedException {
+		Process process = new ProcessBuilder(command).directory(dir).redirectErrorStream(true).start();
+		InputStream output = process.getInputStream();
+		while (output.read() != -1) {
+		}
+		return process.waitFor() == 0;
+	}
+
+	@BeforeClass
+	public static void createCertificates() throws Exception {
+		ip = InetAddress.getByName("127.0.0.1");
+		dir = Files.createTempDirectory("scapiTls").toFile();
+		boolean created;
+		try {
+			created = run("openssl", "req", "-x509", "-newkey", "ec", "-pkeyopt", "ec_paramgen_curve:P-256", "-nodes",
+						"-keyout", "ca.key", "-out", "ca.pem", "-subj", "/CN=scapi test ca", "-days", "2") &&
+					run("openssl", "req", "-new", "-newkey", "ec", "-pkeyopt", "ec_paramgen_curve:P-256", "-nodes",
+						"-keyout", "party.key", "-out", "party.csr", "-subj", "/CN=scapi test party");
+			Files.write(new File(dir, "ext.cnf").toPath(), "subjectAltName=IP:127.0.0.1\n".getBytes("US-ASCII"));
+			created = created &&
+					run("openssl", "x509", "-req", "-in", "party.csr", "-CA", "ca.pem", "-CAkey", "ca.key", "-CAcreateserial",
+						"-out", "party.pem", "-days", "2", "-extfile", "ext.cnf") &&
+					run("openssl", "pkcs12", "-export", "-in", "party.pem", "-inkey", "party.key", "-out", "party.p12",
+						"-passout", "pass:scapi");
+		} catch (IOException e) {
+			//The openssl tool is not installed.
+			created = false;
+		}
+		assumeTrue(created);
+	}
+
+	private static String path(String name) {
+		return new File(dir, name).getPath();
+	}
+
+	private static NativeTlsSocketCommunicationSetup createSetup(int myPort, int otherPort, String peerName) throws Exception {
+		try {
+			return new NativeTlsSocketCommunicationSetup(new SocketPartyData(ip, myPort), new SocketPartyData(ip, otherPort),
+					path("party.pem"), path("party.key"), path("ca.pem"), false, peerName);
+		} catch (LinkageError e) {
+			//The native library is not available.
+			assumeTrue(false);
+			return null;
+		}
+	}
+
+	private static Channel connect(NativeTlsSocketCommunicationSetup setup, long timeout) throws TimeoutException {
+		Map<String, Channel> connections = setup.prepareForCommunication(1, timeout);
+		return connections.values().iterator().next();
+	}
+
+	/**
+	 * Connects the setup in another thread. result waits and returns the channel, or throws what the connection threw.
+	 */
+	private static class Connector extends Thread {
+		private NativeTlsSocketCommunicationSetup setup;
+		private long timeout;
+		private Channel channel;
+		private Exception failure;
+
+		Connector(NativeTlsSocketCommunicationSetup setup, long timeout) {
+			this.setup = setup;
+			this.timeout = timeout;
+			start();
+		}
+
+		public void run() {
+			try {
+				channel = connect(setup, timeout);
+			} catch (Exception e) {
+				failure = e;
+			}
+		}
+
+		Channel result() throws Exception {
+			join();
+			if (failure != null) {
+				throw failure;
+			}
+			return channel;
+		}
+	}
+
+	private static byte[] largeMessage(long seed) {
+		byte[] message = new byte[LARGE_MESSAGE_SIZE];
+		new Random(seed).nextBytes(message);
+		return message;
+	}
+
+	@Test
+	public void TestNativeToNative() throws Exception {
+		NativeTlsSocketCommunicationSetup setup0 = createSetup(25101, 25102, null);
+		NativeTlsSocketCommunicationSetup setup1 = createSetup(25102, 25101, null);
+		Connector other = new Connector(setup1, CONNECT_TIMEOUT);
+		Channel channel0 = connect(setup0, CONNECT_TIMEOUT);
+		Channel channel1 = other.result();
+
+		channel0.send(largeMessage(0));
+		channel1.send(largeMessage(1));
+		channel0.send("done");
+		assertArrayEquals(largeMessage(0), (byte[]) channel1.receive());
+		assertArrayEquals(largeMessage(1), (byte[]) channel0.receive());
+		assertEquals("done", channel1.receive());
+
+		channel0.close();
+		channel1.close();
+		setup0.close();
+		setup1.close();
+	}
+
+	@Test
+	public void TestWrongPeerNameIsRejected() throws Exception {
+		//The certificate of the other party is trusted, but it is issued to 127.0.0.1 and not to the expected name.
+		NativeTlsSocketCommunicationSetup setup0 = createSetup(25103, 25104, "another-party");
+		NativeTlsSocketCommunicationSetup setup1 = createSetup(25104, 25103, null);
+		Connector other = new Connector(setup1, 5000);
+		try {
+			connect(setup0, 5000);
+			fail("connected to a party with another name");
+		} catch (TimeoutException e) {
+		}
+		try {
+			other.result();
+			fail("connected to a party that rejects the connections");
+		} catch (TimeoutException e) {
+		}
+		setup0.close();
+		setup1.close();
+	}
+
+	@Test
+	public void TestSilentPeerIsDropped() throws Exception {
+		NativeTlsSocketCommunicationSetup setup0 = createSetup(25105, 25106, null);
+		NativeTlsSocketCommunicationSetup setup1 = createSetup(25106, 25105, null);
+		setup0.setHandshakeTimeout(500);
+		Connector first = new Connector(setup0, CONNECT_TIMEOUT);
+
+		//Connect to the listener of the first party before the second party does, and never start the handshake.
+		Socket silent = null;
+		while (silent == null) {
+			try {
+				silent = new Socket(ip, 25105);
+			} catch (IOException e) {
+				Thread.sleep(100);
+			}
+		}
+		Channel channel1 = connect(setup1, CONNECT_TIMEOUT);
+		Channel channel0 = first.result();
+
+		channel1.send("after the silent peer");
+		assertEquals("after the silent peer", channel0.receive());
+
+		silent.close();
+		channel0.close();
+		channel1.close();
+		setup0.close();
+		setup1.close();
+	}
+
+	@Test
+	public void TestCloseWhileReceiveIsBlocked() throws Exception {
+		NativeTlsSocketCommunicationSetup setup0 = createSetup(25107, 25108, null);
+		NativeTlsSocketCommunicationSetup setup1 = createSetup(25108, 25107, null);
+		Connector other = new Connector(setup1, CONNECT_TIMEOUT);
+		final Channel channel0 = connect(setup0, CONNECT_TIMEOUT);
+		Channel channel1 = other.result();
+
+		final Exception[] failure = new Exception[1];
+		Thread receiver = new Thread() {
+			public void run() {
+				try {
+					channel0.receive();
+				} catch (Exception e) {
+					failure[0] = e;
+				}
+			}
+		};
+		receiver.start();
+		Thread.sleep(500);
+		assertTrue(receiver.isAlive());
+
+		channel0.close();
+		receiver.join(5000);
+		assertFalse("the receive is still blocked", receiver.isAlive());
+		assertTrue(failure[0] instanceof IOException);
+		assertTrue(channel0.isClosed());
+
+		channel1.close();
+		setup0.close();
+		setup1.close();
+	}
+
+	/*
+	 * The plain peer frames the messages as the native channel does: the size as a 4 byte int in the byte order of the
+	 * machine, followed by the serialized message.
+	 */
+
+	private static void sendFramed(OutputStream out, Serializable message) throws IOException {
+		ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+		ObjectOutputStream objects = new ObjectOutputStream(bytes);
+		objects.writeObject(message);
+		objects.close();
+		out.write(ByteBuffer.allocate(4).order(ByteOrder.nativeOrder()).putInt(bytes.size()).array());
+		out.write(bytes.toByteArray());
+		out.flush();
+	}
+
+	private static Object receiveFramed(InputStream in) throws IOException, ClassNotFoundException {
+		DataInputStream data = new DataInputStream(in);
+		byte[] size = new byte[4];
+		data.readFully(size);
+		byte[] message = new byte[ByteBuffer.wrap(size).order(ByteOrder.nativeOrder()).getInt()];
+		data.readFully(message);
+		return new ObjectInputStream(new ByteArrayInputStream(message)).readObject();
+	}
+
+	private static SSLContext createJavaContext() throws Exception {
+		SSLContext context;
+		try {
+			context = SSLContext.getInstance("TLSv1.3");
+		} catch (NoSuchAlgorithmException e) {
+			//The native channel uses TLS 1.3 only.
+			assumeTrue(false);
+			return null;
+		}
+
+		KeyStore keys = KeyStore.getInstance("PKCS12");
+		FileInputStream in = new FileInputStream(path("party.p12"));
+		try {
+			keys.load(in, "scapi".toCharArray());
+		} finally {
+			in.close();
+		}
+		KeyManagerFactory keyManagers = KeyManagerFactory.getInstance(KeyManagerFactory.getDefaultAlgorithm());
+		keyManagers.init(keys, "scapi".toCharArray());
+
+		KeyStore trusted = KeyStore.getInstance(KeyStore.getDefaultType());
+		trusted.load(null, null);
+		in = new FileInputStream(path("ca.pem"));
+		try {
+			trusted.setCertificateEntry("ca", CertificateFactory.getInstance("X.509").generateCertificate(in));
+		} finally {
+			in.close();
+		}
+		TrustManagerFactory trustManagers = TrustManagerFactory.getInstance(TrustManagerFactory.getDefaultAlgorithm());
+		trustManagers.init(trusted);
+
+		context.init(keyManagers.getKeyManagers(), trustManagers.getTrustManagers(), null);
+		return context;
+	}
+
+	@Test
+	public void TestNativeToSSLSocket() throws Exception {
+		SSLContext context = createJavaContext();
+		NativeTlsSocketCommunicationSetup setup = createSetup(25109, 25110, null);
+
+		//The java peer accepts the send connection of the native channel, and connects to its listener.
+		SSLServerSocket server = (SSLServerSocket) context.getServerSocketFactory().createServerSocket(25110, 1, ip);
+		server.setNeedClientAuth(true);
+		Connector nativeParty = new Connector(setup, CONNECT_TIMEOUT);
+		SSLSocket fromNative = (SSLSocket) server.accept();
+		fromNative.startHandshake();
+		SSLSocket toNative = null;
+		while (toNative == null) {
+			try {
+				toNative = (SSLSocket) context.getSocketFactory().createSocket(ip, 25109);
+				toNative.startHandshake();
+			} catch (IOException e) {
+				toNative = null;
+				Thread.sleep(100);
+			}
+		}
+		Channel channel = nativeParty.result();
+
+		sendFramed(toNative.getOutputStream(), largeMessage(2));
+		assertArrayEquals(largeMessage(2), (byte[]) channel.receive());
+		channel.send(largeMessage(3));
+		assertArrayEquals(largeMessage(3), (byte[]) receiveFramed(fromNative.getInputStream()));
+
+		channel.close();
+		toNative.close();
+		fromNative.close();
+		server.close();
+		setup.close();
+	}
+}
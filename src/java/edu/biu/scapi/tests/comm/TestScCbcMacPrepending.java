@@ -12,6 +12,7 @@ import java.util.Arrays;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Map;
+import java.util.Random;
 import java.util.concurrent.TimeoutException;
 
 import javax.crypto.SecretKey;
@@ -34,7 +35,10 @@ import edu.biu.scapi.exceptions.InvalidChannelException;
 import edu.biu.scapi.exceptions.SecurityLevelException;
 import edu.biu.scapi.midLayer.symmetricCrypto.mac.Mac;
 import edu.biu.scapi.midLayer.symmetricCrypto.mac.ScCbcMacPrepending;
+import edu.biu.scapi.primitives.prf.PrpFixed;
 import edu.biu.scapi.primitives.prf.bc.BcAES;
+import edu.biu.scapi.primitives.prf.cryptopp.CryptoPpAES;
+import edu.biu.scapi.primitives.prf.openSSL.OpenSSLAES;
 import junit.framework.AssertionFailedError;
 
 
@@ -141,5 +145,118 @@ public class TestScCbcMacPrepending {
 		Channel c1 = setCommunicationNotNative(party1, party0);
 		testChannel(c1, dataFrom1To0, dataFrom0To1);
 	}
+	
+	//More messages than the native chains that are computed side by side, and not a multiple of them.
+	private static final int NUM_MSGS = 19;
+	
+	//An empty message, messages shorter than a block, a whole block, and a few blocks with and without a partial last block.
+	private static final int[] MSG_LENS = {0, 1, 13, 16, 48, 53};
+	
+	private static final byte[] MAC_KEY = new byte[]{-61, -19, 106, -97, 106, 40, 52, -64, -115, -19, -87, -67, 98, 102, 16, 21};
+	
+	private static ScCbcMacPrepending createMac(PrpFixed prp) throws InvalidKeyException {
+		ScCbcMacPrepending mac = new ScCbcMacPrepending(prp);
+		mac.setKey(new SecretKeySpec(MAC_KEY, "AES"));
+		return mac;
+	}
+	
+	/**
+	 * Checks that macMany and verifyMany of the given prp agree with mac of the java prp on each message.
+	 */
+	private void checkMacMany(PrpFixed prp) throws InvalidKeyException {
+		ScCbcMacPrepending mac = createMac(prp);
+		ScCbcMacPrepending javaMac = createMac(new BcAES());
+		int macSize = mac.getMacSize();
+		int tagsOffset = 3;
+		Random random = new Random(93);
+		
+		for (int msgLen : MSG_LENS) {
+			byte[] msgs = new byte[msgLen * NUM_MSGS];
+			random.nextBytes(msgs);
+			byte[] tags = new byte[tagsOffset + macSize * NUM_MSGS];
+			mac.macMany(msgs, msgLen, NUM_MSGS, tags, tagsOffset);
+			
+			for (int i = 0; i < NUM_MSGS; i++) {
+				byte[] expected = javaMac.mac(msgs, i * msgLen, msgLen);
+				byte[] tag = Arrays.copyOfRange(tags, tagsOffset + i * macSize, tagsOffset + (i + 1) * macSize);
+				assertArrayEquals("message " + i + " of length " + msgLen, expected, tag);
+				assertArrayEquals("message " + i + " of length " + msgLen, expected, mac.mac(msgs, i * msgLen, msgLen));
+			}
+			
+			//Corrupt the tag of one message, only its verification should fail.
+			int corrupted = random.nextInt(NUM_MSGS);
+			tags[tagsOffset + corrupted * macSize + random.nextInt(macSize)] ^= 1;
+			boolean[] results = mac.verifyMany(msgs, msgLen, NUM_MSGS, tags, tagsOffset);
+			assertEquals(NUM_MSGS, results.length);
+			for (int i = 0; i < NUM_MSGS; i++) {
+				assertEquals("message " + i + " of length " + msgLen, i != corrupted, results[i]);
+			}
+		}
+	}
+	
+	//The key 000102...0f and the tags of the messages 00 01 02 ... of each length in KNOWN_LENS. The tags were computed with 
+	//"openssl enc -aes-128-cbc -nopad" and a zero iv on the length block followed by the zero padded message.
+	private static final byte[] KNOWN_KEY = hex("000102030405060708090a0b0c0d0e0f");
+	private static final int[] KNOWN_LENS = {0, 32, 40, 200};
+	private static final String[] KNOWN_TAGS = {
+		"c6a13b37878f5b826f4f8162a1c8d879",
+		"7daed6ac5e505f70daa38d02a7a69003",
+		"bc06b905b242cf4eff4a6981b0d45176",
+		"be7884e9f86437abadc5bc68de678636"
+	};
+	
+	private static byte[] hex(String hex) {
+		byte[] bytes = new byte[hex.length() / 2];
+		for (int i = 0; i < bytes.length; i++) {
+			bytes[i] = (byte) Integer.parseInt(hex.substring(2 * i, 2 * i + 2), 16);
+		}
+		return bytes;
+	}
+	
+	/**
+	 * Checks mac and macMany of the given prp against tags that were computed outside of scapi.
+	 */
+	private void checkKnownAnswers(PrpFixed prp) throws InvalidKeyException {
+		ScCbcMacPrepending mac = new ScCbcMacPrepending(prp);
+		mac.setKey(new SecretKeySpec(KNOWN_KEY, "AES"));
+		for (int i = 0; i < KNOWN_LENS.length; i++) {
+			byte[] msg = new byte[KNOWN_LENS[i]];
+			for (int j = 0; j < msg.length; j++) {
+				msg[j] = (byte) j;
+			}
+			byte[] expected = hex(KNOWN_TAGS[i]);
+			assertArrayEquals("message of length " + msg.length, expected, mac.mac(msg, 0, msg.length));
+			
+			//The same message twice, the second tag is taken.
+			byte[] msgs = Arrays.copyOf(msg, 2 * msg.length);
+			System.arraycopy(msg, 0, msgs, msg.length, msg.length);
+			byte[] tags = new byte[2 * mac.getMacSize()];
+			mac.macMany(msgs, msg.length, 2, tags, 0);
+			assertArrayEquals("message of length " + msg.length, expected, Arrays.copyOfRange(tags, mac.getMacSize(), tags.length));
+		}
+	}
+	
+	@Test
+	public void TestMacManyJava() throws InvalidKeyException {
+		checkKnownAnswers(new BcAES());
+		checkMacMany(new BcAES());
+	}
+	
+	@Test
+	public void TestMacManyOpenSSL() throws InvalidKeyException {
+		checkKnownAnswers(new OpenSSLAES());
+		checkMacMany(new OpenSSLAES());
+	}
+	
+	@Test
+	public void TestMacManyCryptoPp() throws InvalidKeyException {
+		checkKnownAnswers(new CryptoPpAES());
+		checkMacMany(new CryptoPpAES());
+	}
+	
+	@Test(expected = ArrayIndexOutOfBoundsException.class)
+	public void TestVerifyManyRejectsOverflowingCount() throws InvalidKeyException {
+		//2^28 tags of 16 bytes are 2^32 bytes, which is 0 when computed in int.
+		createMac(new BcAES()).verifyMany(new byte[0], 0, 1 << 28, new byte[16], 0);
+	}
 }
-
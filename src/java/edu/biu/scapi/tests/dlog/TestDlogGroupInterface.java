@@ -45,6 +45,54 @@ public abstract class TestDlogGroupInterface {
 		assertEquals(res_exp, res_mul);
 	}
 	
+	private static void assertSameElement(GroupElement expected, GroupElement actual){
+		assertEquals(expected.isIdentity(), actual.isIdentity());
+		if (!expected.isIdentity()){
+			assertEquals(expected, actual);
+		}
+	}
+	
+	/**
+	 * Checks exponentiateMany against exponentiate of each base, with the identity as a base and the exponents 0, 1, 
+	 * q-1, q, a negative exponent and random exponents.
+	 */
+	protected static void checkExponentiateMany(DlogGroup dlog, Random random){
+		BigInteger q = dlog.getOrder();
+		BigInteger[] exponents = { BigInteger.ZERO, BigInteger.ONE, q.subtract(BigInteger.ONE), q, BigInteger.valueOf(-5), 
+				BigInteger.ZERO, new BigInteger(q.bitLength(), random), new BigInteger(q.bitLength(), random), 
+				new BigInteger(q.bitLength(), random) };
+		GroupElement[] bases = new GroupElement[exponents.length];
+		for (int i = 0; i < bases.length; i++){
+			bases[i] = dlog.createRandomElement();
+		}
+		bases[5] = dlog.getIdentity();
+		bases[6] = dlog.getIdentity();
+		bases[8] = bases[7];
+		
+		GroupElement[] results = dlog.exponentiateMany(bases, exponents);
+		assertEquals(bases.length, results.length);
+		for (int i = 0; i < bases.length; i++){
+			assertSameElement(dlog.exponentiate(bases[i], exponents[i]), results[i]);
+		}
+		assertTrue(results[0].isIdentity());
+		assertEquals(bases[1], results[1]);
+		assertEquals(dlog.getInverse(bases[2]), results[2]);
+		assertTrue(results[3].isIdentity());
+		assertTrue(results[6].isIdentity());
+		
+		assertEquals(0, dlog.exponentiateMany(new GroupElement[0], new BigInteger[0]).length);
+	}
+	
+	@Test
+	public void TestExponentiateMany(){
+		checkExponentiateMany(dlog, new Random(95));
+	}
+	
+	@Test(expected = IllegalArgumentException.class)
+	public void TestExponentiateManyRejectsDifferentLengths(){
+		dlog.exponentiateMany(new GroupElement[]{ dlog.getGenerator() }, new BigInteger[0]);
+	}
+	
 	@Test
 	public void TestSimultaneousMultipleExponentiations(){
 		GroupElement ge1 = dlog.createRandomElement();
@@ -3,8 +3,14 @@ package edu.biu.scapi.tests.dlog;
 import static org.junit.Assert.*;
 
 import java.io.IOException;
+import java.math.BigInteger;
+import java.util.Random;
+
+import org.junit.Test;
 
 import edu.biu.scapi.primitives.dlog.DlogGroup;
+import edu.biu.scapi.primitives.dlog.ECElement;
+import edu.biu.scapi.primitives.dlog.GroupElement;
 import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECF2m;
 
 public class TestOpenSSLDlogECF2m extends TestDlogGroupInterface{
@@ -22,4 +28,128 @@ public class TestOpenSSLDlogECF2m extends TestDlogGroupInterface{
 		return "ECF2m";
 	}
 	
-}
\ No newline at end of file
+	private static final String[] KOBLITZ_CURVES = { "K-163", "K-233", "K-283" };
+	private static final int NUM_RANDOM_SCALARS = 20;
+	
+	/**
+	 * The scalars of the tau-adic checks: 0, 1, q-1 and random values, some of them larger than q.
+	 */
+	private static BigInteger[] tnafScalars(BigInteger q, Random random) {
+		BigInteger[] scalars = new BigInteger[3 + NUM_RANDOM_SCALARS];
+		scalars[0] = BigInteger.ZERO;
+		scalars[1] = BigInteger.ONE;
+		scalars[2] = q.subtract(BigInteger.ONE);
+		for (int i = 3; i < scalars.length; i++) {
+			scalars[i] = new BigInteger(q.bitLength() + 1, random);
+		}
+		return scalars;
+	}
+	
+	private static void assertSamePoint(GroupElement expected, GroupElement actual) {
+		ECElement expectedPoint = (ECElement) expected;
+		ECElement actualPoint = (ECElement) actual;
+		assertEquals(expectedPoint.isInfinity(), actualPoint.isInfinity());
+		if (!expectedPoint.isInfinity()) {
+			assertEquals(expectedPoint.getX(), actualPoint.getX());
+			assertEquals(expectedPoint.getY(), actualPoint.getY());
+		}
+	}
+	
+	/**
+	 * Known scalar multiples of the generator, as {scalar, x, y} in hex. The scalars are 2, 3, a random scalar, q-1 and 
+	 * 2^m-1, which is larger than q.
+	 */
+	private static final String[][] K163_KNOWN_ANSWERS = {
+		{ "2", "cb5ca2738fe300aacfb00b42a77b828d8a5c41eb", "229c79e9ab85f90acd3d5fa3a696664515efefa6b" },
+		{ "3", "2acfcfcc9a2af8e3f2828024f820033db20f69520", "5729c47f915badc7b4c17df14e5804109ffecdfe4" },
+		{ "358fe29650bc82fd6f467b5dc476131546b76345d", "2ec1e6e6c4a77b2b43fc7b3ba9f71e5a9b8bd08aa", "19dfcb2d86f84e10a3fac10036c20dab45a8764c3" },
+		{ "4000000000000000000020108a2e0cc0d99f8a5ee", "2fe13c0537bbc11acaa07d793de4e6d5e5c94eee8", "7714cfe32684eef49818f913db78b866904e4d31" },
+		{ "7ffffffffffffffffffffffffffffffffffffffff", "57a00c419a325a4cbe2c306d5ab91fcd229512b10", "2a938f91c6795f8d26daa41071623344f3ae92f11" }
+	};
+	
+	private static final String[][] K233_KNOWN_ANSWERS = {
+		{ "2", "1a96a52534c02824c92539163f2ed13243feb57b45adbe4cf7ec61957f6", "1f9d11ccd5ff37c021bb64dff8df25af3ebc5c3f9bfc5cb17b2203703a8" },
+		{ "3", "4656e0aabbe341407715ca4a7fac287b41baa1f789c29bfa27e53a7a46", "f79a7245fba513df787a64c618e97ebcc078638ebaaa562e9862bc00ce" },
+		{ "3bd4e736a9d7b5f1079ef63d5cc7b406b99d90f4595954b83d8a950479", "17bfd49305d2881e49e7888ff6e308c99227c54c41bafadcec74a264a02", "12fa4fd9cfb6a184011b5ea078a294742383c58ef6cffb0ed6a25b279c8" },
+		{ "8000000000000000000000000000069d5bb915bcd46efb1ad5f173abde", "17232ba853a7e731af129f22ff4149563a419c26bf50a4c9d6eefad6126", "a961c769d267c4edfe7ca84830333dae3fe848806e5cac5c7eb9578785" },
+		{ "1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffff", "1025c0cab20a82874cd4a4210c458d0f23364a6ca6cc0078c6cdb2f8ffa", "96b2dffc93692048054a8a2fce253c5a9db4feecf984080347990dae73" }
+	};
+	
+	/**
+	 * Checks the known multiples of the generator with exponentiate, and with exponentiateWithPublicExponent using the 
+	 * default and the portable field arithmetic.
+	 */
+	private static void checkKnownAnswers(String curveName, String[][] knownAnswers) throws IOException {
+		OpenSSLDlogECF2m koblitz = new OpenSSLDlogECF2m(curveName);
+		GroupElement generator = koblitz.getGenerator();
+		for (boolean portable : new boolean[] { false, true }) {
+			boolean hasTnaf = koblitz.setPortableTnaf(portable);
+			//The portable arithmetic doesn't depend on the processor.
+			assertTrue(hasTnaf || !portable);
+			for (String[] answer : knownAnswers) {
+				BigInteger scalar = new BigInteger(answer[0], 16);
+				String message = curveName + " portable " + portable + " scalar " + answer[0];
+				ECElement plain = (ECElement) koblitz.exponentiate(generator, scalar);
+				assertEquals(message, new BigInteger(answer[1], 16), plain.getX());
+				assertEquals(message, new BigInteger(answer[2], 16), plain.getY());
+				ECElement tnaf = (ECElement) koblitz.exponentiateWithPublicExponent(generator, scalar);
+				assertEquals(message, new BigInteger(answer[1], 16), tnaf.getX());
+				assertEquals(message, new BigInteger(answer[2], 16), tnaf.getY());
+			}
+		}
+	}
+	
+	@Test
+	public void TestKoblitzKnownAnswers() throws IOException {
+		checkKnownAnswers("K-163", K163_KNOWN_ANSWERS);
+		checkKnownAnswers("K-233", K233_KNOWN_ANSWERS);
+	}
+	
+	@Test
+	public void TestKoblitzTnafExponentiate() throws IOException {
+		Random random = new Random(163);
+		for (String curveName : KOBLITZ_CURVES) {
+			OpenSSLDlogECF2m koblitz = new OpenSSLDlogECF2m(curveName);
+			BigInteger[] scalars = tnafScalars(koblitz.getOrder(), random);
+			GroupElement base = koblitz.createRandomElement();
+			
+			for (boolean portable : new boolean[] { false, true }) {
+				if (!koblitz.setPortableTnaf(portable)) {
+					continue;
+				}
+				for (BigInteger scalar : scalars) {
+					assertSamePoint(koblitz.exponentiate(base, scalar), koblitz.exponentiateWithPublicExponent(base, scalar));
+				}
+				
+				//Check the edge scalars also against their expected values.
+				assertTrue(((ECElement) koblitz.exponentiateWithPublicExponent(base, BigInteger.ZERO)).isInfinity());
+				assertSamePoint(base, koblitz.exponentiateWithPublicExponent(base, BigInteger.ONE));
+				assertSamePoint(koblitz.getInverse(base), koblitz.exponentiateWithPublicExponent(base, scalars[2]));
+			}
+		}
+	}
+	
+	@Test
+	public void TestKoblitzTnafExponentiateMany() throws IOException {
+		Random random = new Random(233);
+		for (String curveName : KOBLITZ_CURVES) {
+			OpenSSLDlogECF2m koblitz = new OpenSSLDlogECF2m(curveName);
+			BigInteger[] scalars = tnafScalars(koblitz.getOrder(), random);
+			GroupElement[] bases = new GroupElement[scalars.length];
+			for (int i = 0; i < bases.length; i++) {
+				bases[i] = koblitz.createRandomElement();
+			}
+			
+			for (boolean portable : new boolean[] { false, true }) {
+				if (!koblitz.setPortableTnaf(portable)) {
+					continue;
+				}
+				GroupElement[] tnaf = koblitz.exponentiateManyWithPublicExponents(bases, scalars);
+				GroupElement[] plain = koblitz.exponentiateMany(bases, scalars);
+				for (int i = 0; i < bases.length; i++) {
+					assertSamePoint(plain[i], tnaf[i]);
+				}
+			}
+		}
+	}
+}
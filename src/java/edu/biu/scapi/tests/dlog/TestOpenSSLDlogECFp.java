@@ -3,8 +3,14 @@ package edu.biu.scapi.tests.dlog;
 import static org.junit.Assert.*;
 
 import java.io.IOException;
+import java.math.BigInteger;
+import java.util.Random;
+
+import org.junit.Test;
 
 import edu.biu.scapi.primitives.dlog.DlogGroup;
+import edu.biu.scapi.primitives.dlog.ECElement;
+import edu.biu.scapi.primitives.dlog.GroupElement;
 import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECFp;
 
 public class TestOpenSSLDlogECFp extends TestDlogGroupInterface{
@@ -21,4 +27,119 @@ public class TestOpenSSLDlogECFp extends TestDlogGroupInterface{
 	public String getGroupType(){
 		return "ECFp";
 	}
-}
\ No newline at end of file
+	
+	//Known multiples of the secp256k1 generator: the scalar, and the x and y coordinates of scalar*G.
+	private static final String[][] SECP256K1_VECTORS = {
+		{ "2",
+		  "c6047f9441ed7d6d3045406e95c07cd85c778e4b8cef3ca7abac09b95c709ee5",
+		  "1ae168fea63dc339a3c58419466ceaeef7f632653266d0e1236431a950cfe52a" },
+		{ "3",
+		  "f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9",
+		  "388f7b0f632de8140fe337e62a37f3566500a99934c2231b6cb9fd7584b8e672" },
+		{ "aa5e28d6a97a2479a65527f7290311a3624d4cc0fa1578598ee3c2613bf99522",
+		  "34f9460f0e4f08393d192b3c5133a6ba099aa0ad9fd54ebccfacdfa239ff49c6",
+		  "0b71ea9bd730fd8923f6d25a7a91e7dd7728a960686cb5a901bb419e0f2ca232" },
+		{ "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+		  "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798",
+		  "b7c52588d95c3b9aa25b0403f1eef75702e84bb7597aabe663b82f6f04ef2777" },
+		{ "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+		  "9166c289b9f905e55f9e3df9f69d7f356b4a22095f894f4715714aa4b56606af",
+		  "f181eb966be4acb5cff9e16b66d809be94e214f06c93fd091099af98499255e7" }
+	};
+	
+	private static final int NUM_RANDOM_SCALARS = 20;
+	
+	private static OpenSSLDlogECFp createSecp256k1() throws IOException {
+		OpenSSLDlogECFp secp256k1 = new OpenSSLDlogECFp("P-256K1");
+		assertTrue(secp256k1.hasEndomorphism());
+		return secp256k1;
+	}
+	
+	/**
+	 * The scalars of the GLV checks: 0, 1, q-1 and random 256 bit values, some of them larger than q.
+	 */
+	private static BigInteger[] glvScalars(BigInteger q) {
+		Random random = new Random(256);
+		BigInteger[] scalars = new BigInteger[3 + NUM_RANDOM_SCALARS];
+		scalars[0] = BigInteger.ZERO;
+		scalars[1] = BigInteger.ONE;
+		scalars[2] = q.subtract(BigInteger.ONE);
+		for (int i = 3; i < scalars.length; i++) {
+			scalars[i] = new BigInteger(256, random);
+		}
+		return scalars;
+	}
+	
+	private static void assertSamePoint(GroupElement expected, GroupElement actual) {
+		ECElement expectedPoint = (ECElement) expected;
+		ECElement actualPoint = (ECElement) actual;
+		assertEquals(expectedPoint.isInfinity(), actualPoint.isInfinity());
+		if (!expectedPoint.isInfinity()) {
+			assertEquals(expectedPoint.getX(), actualPoint.getX());
+			assertEquals(expectedPoint.getY(), actualPoint.getY());
+		}
+	}
+	
+	@Test
+	public void TestSecp256k1KnownAnswers() throws IOException {
+		OpenSSLDlogECFp secp256k1 = createSecp256k1();
+		GroupElement generator = secp256k1.getGenerator();
+		for (boolean glv : new boolean[] { true, false }) {
+			secp256k1.setEndomorphismEnabled(glv);
+			for (String[] vector : SECP256K1_VECTORS) {
+				ECElement result = (ECElement) secp256k1.exponentiate(generator, new BigInteger(vector[0], 16));
+				assertEquals(new BigInteger(vector[1], 16), result.getX());
+				assertEquals(new BigInteger(vector[2], 16), result.getY());
+			}
+		}
+	}
+	
+	@Test
+	public void TestExponentiateManyP256() throws IOException {
+		//P-256 has no endomorphism, so exponentiateMany uses the generic exponentiation with the batch normalization.
+		checkExponentiateMany(new OpenSSLDlogECFp("P-256"), new Random(256));
+	}
+	
+	@Test
+	public void TestSecp256k1GlvExponentiate() throws IOException {
+		OpenSSLDlogECFp secp256k1 = createSecp256k1();
+		BigInteger[] scalars = glvScalars(secp256k1.getOrder());
+		GroupElement base = secp256k1.createRandomElement();
+		
+		for (BigInteger scalar : scalars) {
+			secp256k1.setEndomorphismEnabled(true);
+			GroupElement glv = secp256k1.exponentiate(base, scalar);
+			secp256k1.setEndomorphismEnabled(false);
+			GroupElement plain = secp256k1.exponentiate(base, scalar);
+			assertSamePoint(plain, glv);
+		}
+		
+		//Check the edge scalars also against their expected values.
+		assertTrue(((ECElement) secp256k1.exponentiate(base, BigInteger.ZERO)).isInfinity());
+		secp256k1.setEndomorphismEnabled(true);
+		assertTrue(((ECElement) secp256k1.exponentiate(base, BigInteger.ZERO)).isInfinity());
+		assertSamePoint(base, secp256k1.exponentiate(base, BigInteger.ONE));
+		assertSamePoint(secp256k1.getInverse(base), secp256k1.exponentiate(base, scalars[2]));
+	}
+	
+	@Test
+	public void TestSecp256k1GlvExponentiateMany() throws IOException {
+		OpenSSLDlogECFp secp256k1 = createSecp256k1();
+		BigInteger[] scalars = glvScalars(secp256k1.getOrder());
+		GroupElement[] bases = new GroupElement[scalars.length];
+		for (int i = 0; i < bases.length; i++) {
+			bases[i] = secp256k1.createRandomElement();
+		}
+		
+		secp256k1.setEndomorphismEnabled(true);
+		GroupElement[] glv = secp256k1.exponentiateMany(bases, scalars);
+		GroupElement glvSimultaneous = secp256k1.simultaneousMultipleExponentiations(bases, scalars);
+		secp256k1.setEndomorphismEnabled(false);
+		GroupElement plainSimultaneous = secp256k1.simultaneousMultipleExponentiations(bases, scalars);
+		
+		for (int i = 0; i < bases.length; i++) {
+			assertSamePoint(secp256k1.exponentiate(bases[i], scalars[i]), glv[i]);
+		}
+		assertSamePoint(plainSimultaneous, glvSimultaneous);
+	}
+}
@@ -0,0 +1,221 @@
+package edu.biu.scapi.tests.gmw;
+
+import static org.junit.Assert.*;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileReader;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+
+import org.junit.Test;
+
+import edu.biu.SCProtocols.gmw.GmwBatch;
+
+/**
+ * Checks the batch circuit and inputs of GmwBatch, and that evaluating the batch circuit on the batch inputs gives the outputs
+ * of the single executions.
+ */
+public class TestGmwBatch {
+
+	private static final int BATCH_SIZE = 5;
+
+	//Two parties with two inputs each. Party 1 gets wires 6 and 7, party 2 gets wire 7.
+	//The gates are AND, XOR, a AND NOT b and NOT, so a wrong wire order changes the output.
+	private static final String CIRCUIT =
+			"4 2\n" +
+			"1 2\n0\n1\n\n" +
+			"2 2\n2\n3\n\n" +
+			"1 2\n6\n7\n\n" +
+			"2 1\n7\n\n" +
+			"2 1 0 2 4 0001\n" +
+			"2 1 1 3 5 0110\n" +
+			"2 1 4 5 6 0010\n" +
+			"1 1 6 7 10\n";
+
+	private static File write(String content) throws IOException {
+		File file = File.createTempFile("gmwBatch", ".txt");
+		file.deleteOnExit();
+		FileWriter out = new FileWriter(file);
+		try {
+			out.write(content);
+		} finally {
+			out.close();
+		}
+		return file;
+	}
+
+	private static List<String> readTokens(File file) throws IOException {
+		List<String> tokens = new ArrayList<String>();
+		BufferedReader in = new BufferedReader(new FileReader(file));
+		try {
+			String line;
+			while ((line = in.readLine()) != null) {
+				for (String token : line.trim().split("\\s+")) {
+					if (!token.isEmpty()) {
+						tokens.add(token);
+					}
+				}
+			}
+		} finally {
+			in.close();
+		}
+		return tokens;
+	}
+
+	/**
+	 * Evaluates a circuit in the format of the native GMW circuits in the clear.
+	 * The truth table of a gate is indexed by its inputs, the first input being the most significant bit.
+	 * @param inputs the input file of each party.
+	 * @return the output of each party, in the order of its output wires.
+	 */
+	private static byte[][] evaluate(File circuit, File[] inputs) throws IOException {
+		List<String> tokens = readTokens(circuit);
+		int next = 0;
+		int numGates = Integer.parseInt(tokens.get(next++));
+		int numParties = Integer.parseInt(tokens.get(next++));
+		Map<Integer, Byte> values = new HashMap<Integer, Byte>();
+
+		for (int p = 0; p < numParties; p++) {
+			next++;	//The party number.
+			int numInputs = Integer.parseInt(tokens.get(next++));
+			List<String> partyInputs = readTokens(inputs[p]);
+			assertEquals(numInputs, partyInputs.size());
+			for (int i = 0; i < numInputs; i++) {
+				values.put(Integer.parseInt(tokens.get(next++)), Byte.parseByte(partyInputs.get(i)));
+			}
+		}
+		int[][] outputWires = new int[numParties][];
+		for (int p = 0; p < numParties; p++) {
+			next++;	//The party number.
+			outputWires[p] = new int[Integer.parseInt(tokens.get(next++))];
+			for (int i = 0; i < outputWires[p].length; i++) {
+				outputWires[p][i] = Integer.parseInt(tokens.get(next++));
+			}
+		}
+
+		for (int g = 0; g < numGates; g++) {
+			int numInputs = Integer.parseInt(tokens.get(next++));
+			int numOutputs = Integer.parseInt(tokens.get(next++));
+			int row = 0;
+			for (int i = 0; i < numInputs; i++) {
+				Byte value = values.get(Integer.parseInt(tokens.get(next++)));
+				assertNotNull("a gate is evaluated before its inputs", value);
+				row = (row << 1) | value;
+			}
+			int[] outputs = new int[numOutputs];
+			for (int i = 0; i < numOutputs; i++) {
+				outputs[i] = Integer.parseInt(tokens.get(next++));
+			}
+			byte value = (byte) (tokens.get(next++).charAt(row) - '0');
+			for (int w : outputs) {
+				values.put(w, value);
+			}
+		}
+
+		byte[][] result = new byte[numParties][];
+		for (int p = 0; p < numParties; p++) {
+			result[p] = new byte[outputWires[p].length];
+			for (int i = 0; i < outputWires[p].length; i++) {
+				result[p][i] = values.get(outputWires[p][i]);
+			}
+		}
+		return result;
+	}
+
+	@Test
+	public void TestCreateBatchCircuit() throws IOException {
+		File circuit = write(CIRCUIT);
+		File batch = File.createTempFile("gmwBatch", ".txt");
+		batch.deleteOnExit();
+		GmwBatch.createBatchCircuit(circuit.getPath(), 2, batch.getPath());
+
+		List<String> expected = Arrays.asList(
+				"8", "2",
+				"1", "4", "0", "1", "8", "9",
+				"2", "4", "2", "3", "10", "11",
+				"1", "4", "6", "7", "14", "15",
+				"2", "2", "7", "15",
+				//The copies of each gate are next to each other.
+				"2", "1", "0", "2", "4", "0001",
+				"2", "1", "8", "10", "12", "0001",
+				"2", "1", "1", "3", "5", "0110",
+				"2", "1", "9", "11", "13", "0110",
+				"2", "1", "4", "5", "6", "0010",
+				"2", "1", "12", "13", "14", "0010",
+				"1", "1", "6", "7", "10",
+				"1", "1", "14", "15", "10");
+		assertEquals(expected, readTokens(batch));
+	}
+
+	@Test(expected = IllegalArgumentException.class)
+	public void TestCreateBatchCircuitRejectsEmptyBatch() throws IOException {
+		GmwBatch.createBatchCircuit(write(CIRCUIT).getPath(), 0, "unused.txt");
+	}
+
+	@Test
+	public void TestCreateBatchInputs() throws IOException {
+		File batch = File.createTempFile("gmwBatch", ".txt");
+		batch.deleteOnExit();
+		//Blank lines and surrounding spaces are dropped.
+		File[] inputs = { write("1\n0\n"), write(" 0\n\n1 \n"), write("1\n1") };
+		GmwBatch.createBatchInputs(new String[] { inputs[0].getPath(), inputs[1].getPath(), inputs[2].getPath() }, batch.getPath());
+		assertEquals(Arrays.asList("1", "0", "0", "1", "1", "1"), readTokens(batch));
+	}
+
+	@Test
+	public void TestSplitOutput() {
+		byte[][] outputs = GmwBatch.splitOutput(new byte[] { 1, 0, 0, 1, 1, 1 }, 3);
+		assertEquals(3, outputs.length);
+		assertArrayEquals(new byte[] { 1, 0 }, outputs[0]);
+		assertArrayEquals(new byte[] { 0, 1 }, outputs[1]);
+		assertArrayEquals(new byte[] { 1, 1 }, outputs[2]);
+	}
+
+	@Test(expected = IllegalArgumentException.class)
+	public void TestSplitOutputRejectsWrongSize() {
+		GmwBatch.splitOutput(new byte[5], 2);
+	}
+
+	@Test
+	public void TestBatchMatchesSingleExecutions() throws IOException {
+		Random random = new Random(85);
+		File circuit = write(CIRCUIT);
+		File batchCircuit = File.createTempFile("gmwBatch", ".txt");
+		batchCircuit.deleteOnExit();
+		GmwBatch.createBatchCircuit(circuit.getPath(), BATCH_SIZE, batchCircuit.getPath());
+
+		//The input files of each party in each execution, and the outputs of the single executions.
+		String[][] inputFileNames = new String[2][BATCH_SIZE];
+		byte[][][] singleOutputs = new byte[BATCH_SIZE][][];
+		for (int k = 0; k < BATCH_SIZE; k++) {
+			File[] inputs = new File[2];
+			for (int p = 0; p < 2; p++) {
+				inputs[p] = write(random.nextInt(2) + "\n" + random.nextInt(2) + "\n");
+				inputFileNames[p][k] = inputs[p].getPath();
+			}
+			singleOutputs[k] = evaluate(circuit, inputs);
+		}
+
+		File[] batchInputs = new File[2];
+		for (int p = 0; p < 2; p++) {
+			batchInputs[p] = File.createTempFile("gmwBatch", ".txt");
+			batchInputs[p].deleteOnExit();
+			GmwBatch.createBatchInputs(inputFileNames[p], batchInputs[p].getPath());
+		}
+		byte[][] batchOutputs = evaluate(batchCircuit, batchInputs);
+
+		for (int p = 0; p < 2; p++) {
+			byte[][] split = GmwBatch.splitOutput(batchOutputs[p], BATCH_SIZE);
+			for (int k = 0; k < BATCH_SIZE; k++) {
+				assertArrayEquals("party " + (p + 1) + " execution " + k, singleOutputs[k][p], split[k]);
+			}
+		}
+	}
+}
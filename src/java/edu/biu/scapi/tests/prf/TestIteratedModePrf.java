@@ -0,0 +1,107 @@
+package edu.biu.scapi.tests.prf;
+
+import static org.junit.Assert.*;
+
+import java.security.InvalidKeyException;
+import java.util.Arrays;
+import java.util.Random;
+
+import javax.crypto.IllegalBlockSizeException;
+import javax.crypto.SecretKey;
+import javax.crypto.spec.SecretKeySpec;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.prf.IteratedPrfVarying;
+import edu.biu.scapi.primitives.prf.LubyRackoffPrpFromPrfVarying;
+import edu.biu.scapi.primitives.prf.bc.BcHMAC;
+import edu.biu.scapi.primitives.prf.openSSL.OpenSSLHMAC;
+
+/**
+ * Checks that the native IteratedPrfVarying and Luby-Rackoff computations of OpenSSLHMAC are equal to the java compositions over 
+ * the java HMAC, in both directions of the permutation.
+ */
+public class TestIteratedModePrf {
+
+	private static final int NUM_BLOCKS = 7;
+	private static final int OFFSET = 3;
+	
+	//Input lengths, including an empty input.
+	private static final int[] IN_LENS = { 0, 5, 20, 33 };
+	//Output lengths shorter than, equal to and longer than the SHA-1 output.
+	private static final int[] OUT_LENS = { 1, 20, 45 };
+	//Even block lengths of the permutation.
+	private static final int[] PRP_LENS = { 2, 20, 64 };
+
+	private Random random;
+	private OpenSSLHMAC nativeHmac;
+	private IteratedPrfVarying javaIterated;
+	private LubyRackoffPrpFromPrfVarying javaLubyRackoff;
+
+	@Before
+	public void setUp() throws InvalidKeyException {
+		random = new Random(94);
+		byte[] keyBytes = new byte[16];
+		random.nextBytes(keyBytes);
+		SecretKey key = new SecretKeySpec(keyBytes, "HMAC");
+
+		nativeHmac = new OpenSSLHMAC();
+		nativeHmac.setKey(key);
+		javaIterated = new IteratedPrfVarying(new BcHMAC());
+		javaIterated.setKey(key);
+		javaLubyRackoff = new LubyRackoffPrpFromPrfVarying(new IteratedPrfVarying(new BcHMAC()));
+		javaLubyRackoff.setKey(key);
+	}
+
+	private byte[] randomBytes(int length) {
+		byte[] bytes = new byte[length];
+		random.nextBytes(bytes);
+		return bytes;
+	}
+
+	@Test
+	public void TestIteratedBlocks() {
+		for (int inLen : IN_LENS) {
+			for (int outLen : OUT_LENS) {
+				byte[] in = randomBytes(OFFSET + inLen * NUM_BLOCKS);
+				byte[] out = new byte[OFFSET + outLen * NUM_BLOCKS];
+				nativeHmac.computeIteratedBlocks(in, OFFSET, inLen, out, OFFSET, outLen, NUM_BLOCKS);
+
+				for (int i = 0; i < NUM_BLOCKS; i++) {
+					byte[] expected = new byte[outLen];
+					javaIterated.computeBlock(in, OFFSET + i * inLen, inLen, expected, 0, outLen);
+					int from = OFFSET + i * outLen;
+					assertArrayEquals("input length " + inLen + " output length " + outLen + " block " + i, 
+							expected, Arrays.copyOfRange(out, from, from + outLen));
+				}
+			}
+		}
+	}
+
+	@Test
+	public void TestLubyRackoffBlocks() throws IllegalBlockSizeException {
+		for (int len : PRP_LENS) {
+			byte[] in = randomBytes(OFFSET + len * NUM_BLOCKS);
+			byte[] out = new byte[OFFSET + len * NUM_BLOCKS];
+			nativeHmac.computeLubyRackoffBlocks(in, OFFSET, out, OFFSET, len, NUM_BLOCKS, false);
+
+			byte[] inverted = new byte[OFFSET + len * NUM_BLOCKS];
+			nativeHmac.computeLubyRackoffBlocks(out, OFFSET, inverted, OFFSET, len, NUM_BLOCKS, true);
+
+			for (int i = 0; i < NUM_BLOCKS; i++) {
+				int from = OFFSET + i * len;
+				byte[] expected = new byte[len];
+				javaLubyRackoff.computeBlock(in, from, len, expected, 0);
+				assertArrayEquals("length " + len + " block " + i, expected, Arrays.copyOfRange(out, from, from + len));
+
+				//The java inversion of the native result, and the native inversion, both give back the input.
+				byte[] javaInverted = new byte[len];
+				javaLubyRackoff.invertBlock(out, from, javaInverted, 0, len);
+				assertArrayEquals("length " + len + " block " + i, Arrays.copyOfRange(in, from, from + len), javaInverted);
+				assertArrayEquals("length " + len + " block " + i, Arrays.copyOfRange(in, from, from + len), 
+						Arrays.copyOfRange(inverted, from, from + len));
+			}
+		}
+	}
+}
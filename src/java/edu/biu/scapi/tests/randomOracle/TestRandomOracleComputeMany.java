@@ -0,0 +1,122 @@
+package edu.biu.scapi.tests.randomOracle;
+
+import static org.junit.Assert.*;
+import static org.junit.Assume.assumeNoException;
+
+import java.math.BigInteger;
+import java.util.Arrays;
+import java.util.Random;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.hash.bc.BcSHA256;
+import edu.biu.scapi.primitives.randomOracle.HKDFBasedRO;
+import edu.biu.scapi.primitives.randomOracle.HashBasedRO;
+import edu.biu.scapi.primitives.randomOracle.RandomOracle;
+import edu.biu.scapi.primitives.randomOracle.openSSL.OpenSSLShake128RO;
+import edu.biu.scapi.primitives.randomOracle.openSSL.OpenSSLShake256RO;
+
+/**
+ * Checks that computeMany of the random oracles gives the same results as compute on each input, and that it rejects bad lengths.
+ */
+public class TestRandomOracleComputeMany {
+
+	private static final int IN_LEN = 33;
+	private static final int NUM_INPUTS = 20;
+	private static final int OUT_OFFSET = 5;
+	
+	//Shorter than a hash block, a whole SHA-256 block, and a few blocks of counter mode expansion.
+	private static final int[] OUT_LENS = { 1, 17, 32, 100 };
+
+	private void checkSameAsCompute(RandomOracle oracle) {
+		Random random = new Random(92);
+		byte[] inputs = new byte[IN_LEN * NUM_INPUTS];
+		random.nextBytes(inputs);
+
+		for (int outLen : OUT_LENS) {
+			byte[] output = new byte[OUT_OFFSET + outLen * NUM_INPUTS];
+			oracle.computeMany(inputs, IN_LEN, NUM_INPUTS, outLen, output, OUT_OFFSET);
+			for (int i = 0; i < NUM_INPUTS; i++) {
+				byte[] input = Arrays.copyOfRange(inputs, i * IN_LEN, (i + 1) * IN_LEN);
+				byte[] expected = oracle.compute(input, 0, IN_LEN, outLen);
+				int from = OUT_OFFSET + i * outLen;
+				assertArrayEquals(oracle.getAlgorithmName() + " input " + i + " output length " + outLen, 
+						expected, Arrays.copyOfRange(output, from, from + outLen));
+			}
+		}
+	}
+
+	private void checkBadLengths(RandomOracle oracle) {
+		byte[] inputs = new byte[IN_LEN * NUM_INPUTS];
+		byte[] output = new byte[32 * NUM_INPUTS];
+		//Negative lengths, and lengths whose product with the number of inputs overflows an int.
+		int[][] badArgs = {
+			{ -1, NUM_INPUTS, 32 },
+			{ IN_LEN, NUM_INPUTS, -32 },
+			{ IN_LEN, -1, 32 },
+			{ 1 << 30, 4, 32 },
+			{ IN_LEN, 1 << 27, 32 },
+		};
+		for (int[] args : badArgs) {
+			try {
+				oracle.computeMany(inputs, args[0], args[1], args[2], output, 0);
+				fail(oracle.getAlgorithmName() + " accepted inLen " + args[0] + ", numInputs " + args[1] + ", outLen " + args[2]);
+			} catch (ArrayIndexOutOfBoundsException e) {
+				//Expected.
+			}
+		}
+	}
+
+	@Test
+	public void TestHashBasedRO() {
+		HashBasedRO oracle = new HashBasedRO(new BcSHA256());
+		checkSameAsCompute(oracle);
+		checkBadLengths(oracle);
+	}
+
+	@Test
+	public void TestHashBasedROKnownAnswer() {
+		//SHA-256(00000003 || "abc" || 00000000) || SHA-256(00000003 || "abc" || 00000001), computed with python's hashlib.
+		byte[] expected = new BigInteger("2ddb14a1438cb06f0658085e174f50efba5cfb97b27cfcc9d5c69735e9602e1eba82d25578b9f9b3", 16).toByteArray();
+		HashBasedRO oracle = new HashBasedRO(new BcSHA256());
+		byte[] input = "abc".getBytes();
+		assertArrayEquals(expected, oracle.compute(input, 0, input.length, expected.length));
+	}
+
+	@Test
+	public void TestHashBasedROBlocksDoNotCollide() {
+		//Without the length prefix, block 1 of RO(x) was block 0 of RO(x || 00000001).
+		HashBasedRO oracle = new HashBasedRO(new BcSHA256());
+		byte[] input = "abc".getBytes();
+		byte[] extended = Arrays.copyOf(input, input.length + 4);
+		extended[extended.length - 1] = 1;
+		byte[] output = oracle.compute(input, 0, input.length, 64);
+		byte[] extendedOutput = oracle.compute(extended, 0, extended.length, 32);
+		assertFalse(Arrays.equals(Arrays.copyOfRange(output, 32, 64), extendedOutput));
+	}
+
+	@Test
+	public void TestHKDFBasedRO() {
+		HKDFBasedRO oracle = new HKDFBasedRO();
+		checkSameAsCompute(oracle);
+		checkBadLengths(oracle);
+	}
+
+	@Test
+	public void TestOpenSSLShake() {
+		RandomOracle[] oracles;
+		try {
+			oracles = new RandomOracle[] { new OpenSSLShake128RO(), new OpenSSLShake256RO() };
+		} catch (UnsatisfiedLinkError e) {
+			assumeNoException(e);
+			return;
+		} catch (UnsupportedOperationException e) {
+			assumeNoException(e);
+			return;
+		}
+		for (RandomOracle oracle : oracles) {
+			checkSameAsCompute(oracle);
+			checkBadLengths(oracle);
+		}
+	}
+}
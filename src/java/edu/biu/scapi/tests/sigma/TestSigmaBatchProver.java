@@ -0,0 +1,181 @@
+package edu.biu.scapi.tests.sigma;
+
+import static org.junit.Assert.*;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.ObjectOutputStream;
+import java.math.BigInteger;
+import java.security.NoSuchAlgorithmException;
+import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.Random;
+
+import org.junit.Test;
+
+import edu.biu.scapi.exceptions.CheatAttemptException;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.SigmaBatchProverComputation;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.dh.SigmaDHProverComputation;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.dh.SigmaDHProverInput;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.dhExtended.SigmaDHExtendedProverComputation;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.dhExtended.SigmaDHExtendedProverInput;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.dlog.SigmaDlogProverComputation;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.dlog.SigmaDlogProverInput;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.pedersenCmtKnowledge.SigmaPedersenCmtKnowledgeProverComputation;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.pedersenCmtKnowledge.SigmaPedersenCmtKnowledgeProverInput;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProtocolMsg;
+import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProverInput;
+import edu.biu.scapi.primitives.dlog.DlogGroup;
+import edu.biu.scapi.primitives.dlog.GroupElement;
+import edu.biu.scapi.primitives.dlog.ScZqVectorOps;
+import edu.biu.scapi.primitives.dlog.ZqVectorOps;
+import edu.biu.scapi.primitives.dlog.bc.BcDlogECFp;
+
+/**
+ * Checks that the batch provers compute the same messages as separate proofs that use the same random values.
+ */
+public class TestSigmaBatchProver {
+
+	private static final int T = 80;
+	private static final int NUM_PROOFS = 9;
+	private static final byte[] SEED = "batch sigma proofs".getBytes();
+
+	private DlogGroup dlog;
+	private Random random = new Random(98);
+
+	public TestSigmaBatchProver() throws IOException {
+		dlog = new BcDlogECFp();
+	}
+
+	/**
+	 * @return a SecureRandom that returns the same values in every call to this function.
+	 */
+	private static SecureRandom seededRandom() throws NoSuchAlgorithmException {
+		SecureRandom secureRandom = SecureRandom.getInstance("SHA1PRNG");
+		secureRandom.setSeed(SEED);
+		return secureRandom;
+	}
+
+	private BigInteger randomScalar() {
+		return new BigInteger(dlog.getOrder().bitLength() + 8, random).mod(dlog.getOrder());
+	}
+
+	private byte[][] randomChallenges() {
+		byte[][] challenges = new byte[NUM_PROOFS][T / 8];
+		for (byte[] challenge : challenges) {
+			random.nextBytes(challenge);
+		}
+		return challenges;
+	}
+
+	private static byte[] serialize(SigmaProtocolMsg msg) throws IOException {
+		ByteArrayOutputStream bytes = new ByteArrayOutputStream();
+		ObjectOutputStream out = new ObjectOutputStream(bytes);
+		out.writeObject(msg);
+		out.close();
+		return bytes.toByteArray();
+	}
+
+	/**
+	 * Runs the batch on one prover and the separate proofs on the other, with the same randomness, and compares the messages.
+	 */
+	private void checkBatch(SigmaBatchProverComputation batchProver, SigmaBatchProverComputation singleProver, SigmaProverInput[] inputs)
+			throws CheatAttemptException, IOException {
+		byte[][] challenges = randomChallenges();
+
+		SigmaProtocolMsg[] firstMsgs = batchProver.computeFirstMsgs(inputs);
+		SigmaProtocolMsg[] secondMsgs = batchProver.computeSecondMsgs(challenges);
+		assertEquals(NUM_PROOFS, firstMsgs.length);
+		assertEquals(NUM_PROOFS, secondMsgs.length);
+
+		//Each separate proof takes its random values in the same order as the batch, since the second message takes none.
+		for (int i = 0; i < NUM_PROOFS; i++) {
+			SigmaProtocolMsg firstMsg = singleProver.computeFirstMsg(inputs[i]);
+			SigmaProtocolMsg secondMsg = singleProver.computeSecondMsg(challenges[i]);
+			assertArrayEquals(serialize(firstMsg), serialize(firstMsgs[i]));
+			assertArrayEquals(serialize(secondMsg), serialize(secondMsgs[i]));
+		}
+	}
+
+	@Test
+	public void TestDlogBatch() throws Exception {
+		SigmaProverInput[] inputs = new SigmaProverInput[NUM_PROOFS];
+		for (int i = 0; i < NUM_PROOFS; i++) {
+			BigInteger w = randomScalar();
+			inputs[i] = new SigmaDlogProverInput(dlog.exponentiate(dlog.getGenerator(), w), w);
+		}
+		checkBatch(new SigmaDlogProverComputation(dlog, T, seededRandom()), new SigmaDlogProverComputation(dlog, T, seededRandom()), inputs);
+	}
+
+	@Test
+	public void TestDHBatch() throws Exception {
+		SigmaProverInput[] inputs = new SigmaProverInput[NUM_PROOFS];
+		for (int i = 0; i < NUM_PROOFS; i++) {
+			BigInteger w = randomScalar();
+			GroupElement h = dlog.createRandomElement();
+			inputs[i] = new SigmaDHProverInput(h, dlog.exponentiate(dlog.getGenerator(), w), dlog.exponentiate(h, w), w);
+		}
+		checkBatch(new SigmaDHProverComputation(dlog, T, seededRandom()), new SigmaDHProverComputation(dlog, T, seededRandom()), inputs);
+	}
+
+	@Test
+	public void TestDHExtendedBatch() throws Exception {
+		SigmaProverInput[] inputs = new SigmaProverInput[NUM_PROOFS];
+		for (int i = 0; i < NUM_PROOFS; i++) {
+			BigInteger w = randomScalar();
+			ArrayList<GroupElement> gArray = new ArrayList<GroupElement>();
+			ArrayList<GroupElement> hArray = new ArrayList<GroupElement>();
+			for (int j = 0; j < 3; j++) {
+				GroupElement g = dlog.createRandomElement();
+				gArray.add(g);
+				hArray.add(dlog.exponentiate(g, w));
+			}
+			inputs[i] = new SigmaDHExtendedProverInput(gArray, hArray, w);
+		}
+		checkBatch(new SigmaDHExtendedProverComputation(dlog, T, seededRandom()), new SigmaDHExtendedProverComputation(dlog, T, seededRandom()), inputs);
+	}
+
+	@Test
+	public void TestPedersenCmtKnowledgeBatch() throws Exception {
+		GroupElement h = dlog.createRandomElement();
+		SigmaProverInput[] inputs = new SigmaProverInput[NUM_PROOFS];
+		for (int i = 0; i < NUM_PROOFS; i++) {
+			BigInteger x = randomScalar();
+			BigInteger r = randomScalar();
+			GroupElement commitment = dlog.multiplyGroupElements(dlog.exponentiate(dlog.getGenerator(), r), dlog.exponentiate(h, x));
+			inputs[i] = new SigmaPedersenCmtKnowledgeProverInput(h, commitment, x, r);
+		}
+		checkBatch(new SigmaPedersenCmtKnowledgeProverComputation(dlog, T, seededRandom()),
+				new SigmaPedersenCmtKnowledgeProverComputation(dlog, T, seededRandom()), inputs);
+	}
+
+	@Test
+	public void TestZqVectorOpsMatchesBigInteger() {
+		BigInteger q = dlog.getOrder();
+		BigInteger[] a = new BigInteger[NUM_PROOFS];
+		BigInteger[] b = new BigInteger[NUM_PROOFS];
+		BigInteger[] c = new BigInteger[NUM_PROOFS];
+		for (int i = 0; i < NUM_PROOFS; i++) {
+			a[i] = randomScalar();
+			b[i] = randomScalar();
+			c[i] = randomScalar();
+		}
+
+		//The BigInteger implementation, and the native one if its library is available.
+		for (ZqVectorOps zq : new ZqVectorOps[] { new ScZqVectorOps(q), ScZqVectorOps.create(q) }) {
+			BigInteger[] result = zq.unpack(zq.multiplyAdd(zq.pack(a), zq.pack(b), zq.pack(c), null));
+			for (int i = 0; i < NUM_PROOFS; i++) {
+				assertEquals(a[i].multiply(b[i]).add(c[i]).mod(q), result[i]);
+			}
+		}
+	}
+
+	@Test(expected = CheatAttemptException.class)
+	public void TestWrongChallengeLength() throws Exception {
+		SigmaDlogProverComputation prover = new SigmaDlogProverComputation(dlog, T, seededRandom());
+		BigInteger w = randomScalar();
+		SigmaProverInput input = new SigmaDlogProverInput(dlog.exponentiate(dlog.getGenerator(), w), w);
+		prover.computeFirstMsgs(new SigmaProverInput[] { input, input });
+		prover.computeSecondMsgs(new byte[][] { new byte[T / 8], new byte[T / 8 + 1] });
+	}
+}
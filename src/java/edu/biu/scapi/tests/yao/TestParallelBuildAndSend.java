@@ -0,0 +1,130 @@
+package edu.biu.scapi.tests.yao;
+
+import static org.junit.Assert.*;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+import org.junit.Test;
+
+import edu.biu.protocols.yao.offlineOnline.subroutines.ParallelBuildAndSend;
+
+public class TestParallelBuildAndSend {
+
+	private static final int NUM_ITEMS = 37;
+	private static final int NUM_THREADS = 4;
+
+	/**
+	 * Records the items that were sent on each channel.
+	 */
+	private static class RecordingSender implements ParallelBuildAndSend.Sender {
+		private final List<List<Integer>> sent = new ArrayList<List<Integer>>();
+
+		RecordingSender() {
+			for (int i = 0; i < NUM_THREADS; i++) {
+				sent.add(Collections.synchronizedList(new ArrayList<Integer>()));
+			}
+		}
+
+		public void send(int item, int thread) throws IOException {
+			sent.get(thread).add(item);
+		}
+	}
+
+	/**
+	 * A builder that throws the given exception when asked to build the failing item.
+	 */
+	private static ParallelBuildAndSend.Builder failingBuilder(final int failingItem, final Throwable failure) {
+		return new ParallelBuildAndSend.Builder() {
+			public void build(int item, int thread) {
+				if (item == failingItem) {
+					if (failure instanceof Error) {
+						throw (Error) failure;
+					}
+					throw (RuntimeException) failure;
+				}
+			}
+		};
+	}
+
+	@Test(timeout = 10000)
+	public void TestEveryChannelSendsItsRangeInOrder() throws IOException {
+		RecordingSender sender = new RecordingSender();
+		ParallelBuildAndSend.run(NUM_ITEMS, NUM_THREADS, failingBuilder(-1, null), sender);
+
+		int perThread = NUM_ITEMS / NUM_THREADS;
+		for (int i = 0; i < NUM_THREADS; i++) {
+			int to = (i == NUM_THREADS - 1) ? NUM_ITEMS : (i + 1) * perThread;
+			List<Integer> expected = new ArrayList<Integer>();
+			for (int j = i * perThread; j < to; j++) {
+				expected.add(j);
+			}
+			assertEquals(expected, sender.sent.get(i));
+		}
+	}
+
+	@Test(timeout = 10000)
+	public void TestErrorInBuilderDoesNotBlockTheSenders() throws IOException {
+		//The first item fails, so the error is thrown before any other item is taken by the failing thread.
+		RecordingSender sender = new RecordingSender();
+		AssertionError error = new AssertionError("build failed");
+		try {
+			ParallelBuildAndSend.run(NUM_ITEMS, NUM_THREADS, failingBuilder(0, error), sender);
+			fail("The error of the builder was not thrown");
+		} catch (AssertionError e) {
+			assertSame(error, e);
+		}
+		assertTrue(sender.sent.get(0).isEmpty());
+	}
+
+	@Test(timeout = 10000)
+	public void TestRuntimeExceptionInBuilderStopsItsRange() throws IOException {
+		int failingItem = 12;
+		RecordingSender sender = new RecordingSender();
+		try {
+			ParallelBuildAndSend.run(NUM_ITEMS, NUM_THREADS, failingBuilder(failingItem, new IllegalArgumentException()), sender);
+			fail("The exception of the builder was not thrown");
+		} catch (IllegalStateException e) {
+			assertTrue(e.getCause() instanceof IllegalArgumentException);
+		}
+		//Item 12 is in the range of the second channel, which stops before it.
+		assertEquals(3, sender.sent.get(1).size());
+		assertEquals(9 * (NUM_THREADS - 1) + 1, sender.sent.get(0).size() + sender.sent.get(2).size() + sender.sent.get(3).size());
+	}
+
+	@Test(timeout = 10000)
+	public void TestSendFailureIsThrown() {
+		final IOException failure = new IOException("send failed");
+		try {
+			ParallelBuildAndSend.run(NUM_ITEMS, NUM_THREADS, failingBuilder(-1, null), new ParallelBuildAndSend.Sender() {
+				public void send(int item, int thread) throws IOException {
+					if (item == NUM_ITEMS - 1) {
+						throw failure;
+					}
+				}
+			});
+			fail("The exception of the sender was not thrown");
+		} catch (IOException e) {
+			assertSame(failure, e);
+		}
+	}
+
+	@Test(timeout = 10000)
+	public void TestRuntimeExceptionInSenderIsThrown() throws IOException {
+		final IllegalArgumentException failure = new IllegalArgumentException("send failed");
+		try {
+			ParallelBuildAndSend.run(NUM_ITEMS, NUM_THREADS, failingBuilder(-1, null), new ParallelBuildAndSend.Sender() {
+				public void send(int item, int thread) throws IOException {
+					if (item == 5) {
+						throw failure;
+					}
+				}
+			});
+			fail("The exception of the sender was not thrown");
+		} catch (IllegalArgumentException e) {
+			assertSame(failure, e);
+		}
+	}
+}
@@ -0,0 +1,120 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.tools.Benchmarks;
+
+import java.io.IOException;
+import java.math.BigInteger;
+import java.security.SecureRandom;
+import java.util.Arrays;
+
+import edu.biu.scapi.primitives.dlog.GroupElement;
+import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECFp;
+
+/**
+ * Compares the generic exponentiation of OpenSSLDlogECFp to the exponentiation that uses the GLV endomorphism, on the 
+ * secp256k1 curve (P-256K1 in the NIST properties file). <p>
+ * 
+ * The benchmark raises a random base to random scalars, once with the endomorphism disabled and once with it enabled,
+ * checks that the results are identical and prints the throughput of both in exponentiations per second. 
+ * The same is done for simultaneousMultipleExponentiations with two bases. <p>
+ * 
+ * Usage: java edu.biu.scapi.tools.Benchmarks.DlogGlvBenchmark [numScalars] [curveName]
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public class DlogGlvBenchmark {
+
+	private static double perSecond(int count, long start, long end) {
+		return count / ((end - start) / 1000000000.0);
+	}
+
+	/**
+	 * Measures the exponentiations with and without the endomorphism and prints the results if print is true.
+	 */
+	public static void measure(OpenSSLDlogECFp dlog, GroupElement[] bases, BigInteger[] scalars, int numScalars, boolean print) {
+		GroupElement[] generic = new GroupElement[numScalars];
+		GroupElement[] glv = new GroupElement[numScalars];
+
+		dlog.setEndomorphismEnabled(false);
+		long start = System.nanoTime();
+		for (int i = 0; i < numScalars; i++) {
+			generic[i] = dlog.exponentiate(bases[0], scalars[i]);
+		}
+		long genericEnd = System.nanoTime();
+		dlog.setEndomorphismEnabled(true);
+		for (int i = 0; i < numScalars; i++) {
+			glv[i] = dlog.exponentiate(bases[0], scalars[i]);
+		}
+		long glvEnd = System.nanoTime();
+		boolean identical = Arrays.equals(generic, glv);
+
+		int numPairs = numScalars / 2;
+		GroupElement[] genericPairs = new GroupElement[numPairs];
+		GroupElement[] glvPairs = new GroupElement[numPairs];
+		dlog.setEndomorphismEnabled(false);
+		long pairsStart = System.nanoTime();
+		for (int i = 0; i < numPairs; i++) {
+			genericPairs[i] = dlog.simultaneousMultipleExponentiations(bases, new BigInteger[]{ scalars[2 * i], scalars[2 * i + 1] });
+		}
+		long genericPairsEnd = System.nanoTime();
+		dlog.setEndomorphismEnabled(true);
+		for (int i = 0; i < numPairs; i++) {
+			glvPairs[i] = dlog.simultaneousMultipleExponentiations(bases, new BigInteger[]{ scalars[2 * i], scalars[2 * i + 1] });
+		}
+		long glvPairsEnd = System.nanoTime();
+		boolean pairsIdentical = Arrays.equals(genericPairs, glvPairs);
+
+		if (!print) {
+			return;
+		}
+		System.out.printf("exponentiate:          generic: %10.0f ops/s, glv: %10.0f ops/s, identical: %b%n",
+				perSecond(numScalars, start, genericEnd), perSecond(numScalars, genericEnd, glvEnd), identical);
+		System.out.printf("simultaneous (2 bases): generic: %10.0f ops/s, glv: %10.0f ops/s, identical: %b%n",
+				perSecond(numPairs, pairsStart, genericPairsEnd), perSecond(numPairs, genericPairsEnd, glvPairsEnd), pairsIdentical);
+	}
+
+	public static void main(String[] args) throws IOException {
+		int numScalars = (args.length > 0) ? Integer.parseInt(args[0]) : 100000;
+		String curveName = (args.length > 1) ? args[1] : "P-256K1";
+
+		OpenSSLDlogECFp dlog = new OpenSSLDlogECFp(curveName);
+		if (!dlog.hasEndomorphism()) {
+			System.out.println(curveName + " has no GLV endomorphism, both measurements use the generic exponentiation.");
+		}
+
+		SecureRandom random = new SecureRandom();
+		BigInteger q = dlog.getOrder();
+		GroupElement[] bases = { dlog.createRandomElement(), dlog.createRandomElement() };
+		BigInteger[] scalars = new BigInteger[numScalars];
+		for (int i = 0; i < numScalars; i++) {
+			scalars[i] = new BigInteger(q.bitLength(), random).mod(q);
+		}
+
+		//The first round warms up the jit, only the second is printed.
+		measure(dlog, bases, scalars, Math.min(numScalars, 1000), false);
+		measure(dlog, bases, scalars, numScalars, true);
+	}
+}
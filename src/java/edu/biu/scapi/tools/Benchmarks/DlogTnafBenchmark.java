@@ -0,0 +1,109 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.tools.Benchmarks;
+
+import java.io.IOException;
+import java.math.BigInteger;
+import java.security.SecureRandom;
+import java.util.Arrays;
+
+import edu.biu.scapi.primitives.dlog.GroupElement;
+import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECF2m;
+
+/**
+ * Compares the generic exponentiation of OpenSSLDlogECF2m to the exponentiation that uses the tau-adic NAF of the 
+ * exponent, on the Koblitz curves K-163, K-233 and K-283. <p>
+ * 
+ * For each curve, the benchmark raises random bases to random scalars, once with the constant time exponentiate and once 
+ * with exponentiateWithPublicExponent, which uses the tau-adic exponentiation, checks that the results are identical and prints the throughput of both in exponentiations per 
+ * second. Some of the bases are not in the main subgroup, since the result should be the same for every point of the curve. <p>
+ * 
+ * Usage: java edu.biu.scapi.tools.Benchmarks.DlogTnafBenchmark [numScalars] [curveName...]
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public class DlogTnafBenchmark {
+
+	private static double perSecond(int count, long start, long end) {
+		return count / ((end - start) / 1000000000.0);
+	}
+
+	/**
+	 * Measures the exponentiations with and without the tau-adic NAF and prints the results if print is true.
+	 */
+	public static void measure(OpenSSLDlogECF2m dlog, GroupElement[] bases, BigInteger[] scalars, int numScalars, boolean print) {
+		GroupElement[] generic = new GroupElement[numScalars];
+		GroupElement[] tnaf = new GroupElement[numScalars];
+
+		long start = System.nanoTime();
+		for (int i = 0; i < numScalars; i++) {
+			generic[i] = dlog.exponentiate(bases[i % bases.length], scalars[i]);
+		}
+		long genericEnd = System.nanoTime();
+		for (int i = 0; i < numScalars; i++) {
+			tnaf[i] = dlog.exponentiateWithPublicExponent(bases[i % bases.length], scalars[i]);
+		}
+		long tnafEnd = System.nanoTime();
+		boolean identical = Arrays.equals(generic, tnaf);
+
+		if (!print) {
+			return;
+		}
+		System.out.printf("exponentiate: generic: %10.0f ops/s, tnaf: %10.0f ops/s, identical: %b%n",
+				perSecond(numScalars, start, genericEnd), perSecond(numScalars, genericEnd, tnafEnd), identical);
+	}
+
+	public static void main(String[] args) throws IOException {
+		int numScalars = (args.length > 0) ? Integer.parseInt(args[0]) : 100000;
+		String[] curveNames = { "K-163", "K-233", "K-283" };
+		if (args.length > 1) {
+			curveNames = Arrays.copyOfRange(args, 1, args.length);
+		}
+
+		SecureRandom random = new SecureRandom();
+		for (String curveName : curveNames) {
+			OpenSSLDlogECF2m dlog = new OpenSSLDlogECF2m(curveName);
+			System.out.println(curveName + ":");
+			if (!dlog.hasTnaf()) {
+				System.out.println("The tau-adic exponentiation is not supported, both measurements use the generic exponentiation.");
+			}
+
+			//The point (0, 1) has order 2, so adding it to a random element gives a point outside the main subgroup.
+			GroupElement orderTwo = dlog.generateElement(false, BigInteger.ZERO, BigInteger.ONE);
+			GroupElement[] bases = { dlog.createRandomElement(), 
+									 dlog.multiplyGroupElements(dlog.createRandomElement(), orderTwo) };
+			BigInteger q = dlog.getOrder();
+			BigInteger[] scalars = new BigInteger[numScalars];
+			for (int i = 0; i < numScalars; i++) {
+				scalars[i] = new BigInteger(q.bitLength(), random).mod(q);
+			}
+
+			//The first round warms up the jit, only the second is printed.
+			measure(dlog, bases, scalars, Math.min(numScalars, 1000), false);
+			measure(dlog, bases, scalars, numScalars, true);
+		}
+	}
+}
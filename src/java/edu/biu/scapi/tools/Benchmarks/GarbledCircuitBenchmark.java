@@ -0,0 +1,163 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.tools.Benchmarks;
+
+import java.io.File;
+import java.security.SecureRandom;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import javax.crypto.SecretKey;
+
+import edu.biu.scapi.circuits.circuit.BooleanCircuit;
+import edu.biu.scapi.circuits.encryption.AESFixedKeyMultiKeyEncryption;
+import edu.biu.scapi.circuits.garbledCircuit.CircuitCreationValues;
+import edu.biu.scapi.circuits.garbledCircuit.FreeXORGarblingParameters;
+import edu.biu.scapi.circuits.garbledCircuit.GarbledBooleanCircuitImp;
+import edu.biu.scapi.circuits.garbledCircuit.GarbledWire;
+import edu.biu.scapi.circuits.garbledCircuit.GarblingParameters;
+import edu.biu.scapi.circuits.garbledCircuit.StandardGarblingParameters;
+import edu.biu.scapi.primitives.prg.ScPrgFromPrf;
+
+/**
+ * Compares the java garbling of GarbledBooleanCircuitImp to its native engine, side by side. <p>
+ * 
+ * Each circuit type is garbled with the same seed once with the native engine disabled and once with it enabled. The benchmark prints 
+ * the garbling and computing times of both and checks that the garbled tables, the translation tables and the computed outputs are identical. <p>
+ * 
+ * Usage: java edu.biu.scapi.tools.Benchmarks.GarbledCircuitBenchmark circuitFile [iterations]
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public class GarbledCircuitBenchmark {
+
+	private static final String[] TYPES = { "FreeXOR", "FreeXOR row reduction", "Standard" };
+	
+	private static GarblingParameters createParameters(String type, BooleanCircuit bc) {
+		if (type.equals("FreeXOR")) {
+			return new FreeXORGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), false);
+		}
+		if (type.equals("FreeXOR row reduction")) {
+			return new FreeXORGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), true);
+		}
+		return new StandardGarblingParameters(bc, new AESFixedKeyMultiKeyEncryption(), new SecureRandom(), false);
+	}
+	
+	/**
+	 * The results of one engine.
+	 */
+	private static class Run {
+		private GarbledBooleanCircuitImp circuit;
+		private HashMap<Integer, GarbledWire> output;
+		private double garbleMillis;
+		private double computeMillis;
+	}
+	
+	private static Run run(String type, BooleanCircuit bc, byte[] seed, Map<Integer, Byte> input, int iterations, boolean nativeEngine) throws Exception {
+		GarbledBooleanCircuitImp.setNativeEngineEnabled(nativeEngine);
+		Run run = new Run();
+		run.circuit = new GarbledBooleanCircuitImp(createParameters(type, bc), new ScPrgFromPrf());
+		
+		//The first garbling and computation warm up the jit.
+		CircuitCreationValues values = run.circuit.garble(seed);
+		long start = System.nanoTime();
+		for (int i = 0; i < iterations; i++) {
+			values = run.circuit.garble(seed);
+		}
+		run.garbleMillis = (System.nanoTime() - start) / 1000000.0 / iterations;
+		
+		run.circuit.setGarbledInputFromUngarbledInput(input, values.getAllInputWireValues());
+		run.output = run.circuit.compute();
+		start = System.nanoTime();
+		for (int i = 0; i < iterations; i++) {
+			run.circuit.setGarbledInputFromUngarbledInput(input, values.getAllInputWireValues());
+			run.output = run.circuit.compute();
+		}
+		run.computeMillis = (System.nanoTime() - start) / 1000000.0 / iterations;
+		return run;
+	}
+	
+	private static boolean sameOutput(Map<Integer, GarbledWire> first, Map<Integer, GarbledWire> second) {
+		if (!first.keySet().equals(second.keySet())) {
+			return false;
+		}
+		for (Map.Entry<Integer, GarbledWire> entry : first.entrySet()) {
+			SecretKey firstKey = entry.getValue().getValueAndSignalBit();
+			SecretKey secondKey = second.get(entry.getKey()).getValueAndSignalBit();
+			if (!Arrays.equals(firstKey.getEncoded(), secondKey.getEncoded())) {
+				return false;
+			}
+		}
+		return true;
+	}
+	
+	/**
+	 * Measures the given circuit type and prints the results.
+	 */
+	public static void measure(String type, BooleanCircuit bc, int iterations) throws Exception {
+		SecureRandom random = new SecureRandom();
+		byte[] seed = new byte[16];
+		random.nextBytes(seed);
+		
+		//A random input for all parties.
+		Map<Integer, Byte> input = new HashMap<Integer, Byte>();
+		for (int party = 1; party <= bc.getNumberOfParties(); party++) {
+			List<Integer> indices = bc.getInputWireIndices(party);
+			for (int w : indices) {
+				input.put(w, (byte) random.nextInt(2));
+			}
+		}
+		
+		Run java = run(type, bc, seed, input, iterations, false);
+		Run jni = run(type, bc, seed, input, iterations, true);
+		
+		boolean sameTables = Arrays.deepEquals(java.circuit.getGarbledTables().toDoubleByteArray(), jni.circuit.getGarbledTables().toDoubleByteArray());
+		boolean sameTranslation = java.circuit.getTranslationTable().equals(jni.circuit.getTranslationTable());
+		boolean sameOutput = sameOutput(java.output, jni.output);
+		
+		System.out.printf("%-22s garble: java %9.3f ms, native %9.3f ms (x%.1f) | compute: java %9.3f ms, native %9.3f ms (x%.1f) | identical tables: %b, translation: %b, output: %b%n",
+				type, java.garbleMillis, jni.garbleMillis, java.garbleMillis / jni.garbleMillis, 
+				java.computeMillis, jni.computeMillis, java.computeMillis / jni.computeMillis, sameTables, sameTranslation, sameOutput);
+	}
+
+	public static void main(String[] args) throws Exception {
+		if (args.length < 1) {
+			System.out.println("Usage: java edu.biu.scapi.tools.Benchmarks.GarbledCircuitBenchmark circuitFile [iterations]");
+			return;
+		}
+		if (!GarbledBooleanCircuitImp.isNativeEngineAvailable()) {
+			System.out.println("The native library ScGarbledCircuitJavaInterface is not available");
+			return;
+		}
+		BooleanCircuit bc = new BooleanCircuit(new File(args[0]));
+		int iterations = (args.length > 1) ? Integer.parseInt(args[1]) : 10;
+		for (String type : TYPES) {
+			measure(type, bc, iterations);
+		}
+	}
+}
@@ -0,0 +1,190 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.tools.Benchmarks;
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.InputStreamReader;
+import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+
+import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit.CircuitType;
+
+/**
+ * Compares the three halves circuit of ScNativeGarbledBooleanCircuit with its large native buffers on huge pages and on regular pages. <p>
+ * 
+ * The wire keys and the garbled tables of the circuit and the buffers of computeMany are allocated by the huge page allocator of the 
+ * native library, so buffers of 2MB and above are backed by huge pages unless SCAPI_HUGE_PAGES=0. The allocator reads SCAPI_HUGE_PAGES 
+ * once, when the library is loaded, so each mode is measured in its own jvm with the same arguments. The benchmark prints the garbling, 
+ * computing and computeMany times of both modes and the counters of the allocator, that show whether the buffers were mapped. <p>
+ * 
+ * With -perf, each jvm runs under perf stat and the dTLB load and store misses of the whole jvm are printed as well. <p>
+ * 
+ * The wire keys reach 2MB at 131072 wires (the SHA-256 circuit) and the keys of computeMany, four sets of keys for each wire, at 32768 
+ * wires (the AES circuit). <p>
+ * 
+ * Usage: java edu.biu.scapi.tools.Benchmarks.HugePageBenchmark [-perf] [circuitFile] [iterations] [numSets]
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public class HugePageBenchmark {
+
+	private static final String DEFAULT_CIRCUIT = "src/java/edu/biu/SCProtocols/NativeMaliciousYao/assets/circuits/SHA256/NigelSHA256.txt";
+	private static final String CHILD = "-child";
+	private static final String RESULT = "result";
+	
+	/**
+	 * Measures the circuit in this jvm and prints a single result line: the garble, compute and computeMany times in milliseconds and 
+	 * the computeMany throughput in gates x sets per second.
+	 */
+	private static void measure(String fileName, int iterations, int numSets) throws Exception {
+		SecureRandom random = new SecureRandom();
+		byte[] seed = new byte[16];
+		random.nextBytes(seed);
+		
+		ScNativeGarbledBooleanCircuit circuit = new ScNativeGarbledBooleanCircuit(fileName, CircuitType.FREE_XOR_THREE_HALVES, false);
+		int keySize = circuit.getKeySize();
+		int numInputs = circuit.getInputWireIndices().length;
+		
+		//The first garbling and computation warm up the jit and the free list of the allocator.
+		FastCircuitCreationValues values = circuit.garble(seed);
+		long start = System.nanoTime();
+		for (int i = 0; i < iterations; i++) {
+			values = circuit.garble(seed);
+		}
+		double garbleMillis = (System.nanoTime() - start) / 1000000.0 / iterations;
+		
+		//Random keys for each set, the first set is also used by compute.
+		byte[] allInputWireValues = values.getAllInputWireValues();
+		byte[] inputSets = new byte[numSets * numInputs * keySize];
+		for (int set = 0; set < numSets; set++) {
+			for (int i = 0; i < numInputs; i++) {
+				System.arraycopy(allInputWireValues, (2 * i + random.nextInt(2)) * keySize, inputSets, (set * numInputs + i) * keySize, keySize);
+			}
+		}
+		byte[] inputKeys = new byte[numInputs * keySize];
+		System.arraycopy(inputSets, 0, inputKeys, 0, inputKeys.length);
+		
+		circuit.setInputs(inputKeys);
+		circuit.compute();
+		start = System.nanoTime();
+		for (int i = 0; i < iterations; i++) {
+			circuit.compute();
+		}
+		double computeMillis = (System.nanoTime() - start) / 1000000.0 / iterations;
+		
+		circuit.computeMany(inputSets);
+		double throughput = 0;
+		start = System.nanoTime();
+		for (int i = 0; i < iterations; i++) {
+			circuit.computeMany(inputSets);
+			throughput += circuit.getComputeManyThroughput();
+		}
+		double computeManyMillis = (System.nanoTime() - start) / 1000000.0 / iterations;
+		
+		System.out.println(RESULT + " " + garbleMillis + " " + computeMillis + " " + computeManyMillis + " " + (throughput / iterations));
+	}
+	
+	/**
+	 * Runs the benchmark in a new jvm with the given huge page mode and prints its results.
+	 * @param hugePages false to run with SCAPI_HUGE_PAGES=0.
+	 */
+	private static void runMode(boolean hugePages, boolean perf, String fileName, int iterations, int numSets) throws Exception {
+		List<String> command = new ArrayList<String>();
+		if (perf) {
+			command.add("perf");
+			command.add("stat");
+			command.add("-x,");
+			command.add("-e");
+			command.add("dTLB-load-misses,dTLB-store-misses");
+		}
+		command.add(System.getProperty("java.home") + File.separator + "bin" + File.separator + "java");
+		command.add("-cp");
+		command.add(System.getProperty("java.class.path"));
+		command.add("-Djava.library.path=" + System.getProperty("java.library.path"));
+		command.add(HugePageBenchmark.class.getName());
+		command.add(CHILD);
+		command.add(fileName);
+		command.add(Integer.toString(iterations));
+		command.add(Integer.toString(numSets));
+		
+		ProcessBuilder builder = new ProcessBuilder(command);
+		Map<String, String> environment = builder.environment();
+		if (!hugePages) {
+			environment.put("SCAPI_HUGE_PAGES", "0");
+		} else if ("0".equals(environment.get("SCAPI_HUGE_PAGES"))) {
+			environment.remove("SCAPI_HUGE_PAGES");
+		}
+		environment.put("SCAPI_HUGE_PAGE_STATS", "1");
+		builder.redirectErrorStream(true);
+		Process process = builder.start();
+		
+		String mode = hugePages ? "huge pages" : "regular pages";
+		BufferedReader output = new BufferedReader(new InputStreamReader(process.getInputStream()));
+		String line;
+		while ((line = output.readLine()) != null) {
+			String[] fields;
+			if (line.startsWith(RESULT + " ")) {
+				fields = line.split(" ");
+				System.out.printf("%-13s garble %9.3f ms, compute %9.3f ms, computeMany(%d) %9.3f ms, %.3e gates x sets/s%n", mode, 
+						Double.parseDouble(fields[1]), Double.parseDouble(fields[2]), numSets, Double.parseDouble(fields[3]), Double.parseDouble(fields[4]));
+			} else if ((fields = line.split(",")).length > 2 && fields[2].startsWith("dTLB")) {
+				//A csv line of perf stat: the count, the unit and the event.
+				System.out.printf("%-13s %s: %s%n", mode, fields[2], fields[0]);
+			} else if (line.startsWith("[scapi huge pages]")) {
+				System.out.printf("%-13s %s%n", mode, line);
+			} else if (line.length() > 0) {
+				System.out.println(line);
+			}
+		}
+		if (process.waitFor() != 0) {
+			System.out.println(mode + ": the benchmark failed");
+		}
+	}
+	
+	public static void main(String[] args) throws Exception {
+		if (args.length > 0 && args[0].equals(CHILD)) {
+			measure(args[1], Integer.parseInt(args[2]), Integer.parseInt(args[3]));
+			return;
+		}
+		
+		int next = 0;
+		boolean perf = args.length > next && args[next].equals("-perf");
+		if (perf) {
+			next++;
+		}
+		String fileName = (args.length > next) ? args[next] : DEFAULT_CIRCUIT;
+		int iterations = (args.length > next + 1) ? Integer.parseInt(args[next + 1]) : 20;
+		int numSets = (args.length > next + 2) ? Integer.parseInt(args[next + 2]) : 16;
+		
+		System.out.println(fileName + ", " + iterations + " iterations:");
+		runMode(false, perf, fileName, iterations, numSets);
+		runMode(true, perf, fileName, iterations, numSets);
+	}
+}
@@ -0,0 +1,156 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.tools.Benchmarks;
+
+import java.math.BigInteger;
+
+import javax.crypto.spec.SecretKeySpec;
+
+import edu.biu.scapi.primitives.dlog.GroupElement;
+import edu.biu.scapi.primitives.dlog.miracl.MiraclDlogECFp;
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLSHA256;
+import edu.biu.scapi.primitives.prf.cryptopp.CryptoPpAES;
+
+/**
+ * Measures the startup cost of the native libraries: the time it takes to load each library (including its JNI_OnLoad,
+ * where the native methods are registered) and the time to the first operation of the library, compared to the time
+ * of the same operation once everything is initialized. <p>
+ * 
+ * The numbers are meaningful only for the first library that is used in a jvm, so each library should be measured in a
+ * new jvm, for example: <p>
+ * java edu.biu.scapi.tools.Benchmarks.NativeStartupBenchmark OpenSSL <p>
+ * Without arguments, all the libraries are measured one after the other.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public class NativeStartupBenchmark {
+
+	/**
+	 * An operation of one of the native libraries.
+	 */
+	private interface Operation {
+		/**
+		 * Creates the objects that are needed to run the operation (and loads the native library through their classes).
+		 */
+		void init() throws Exception;
+
+		/**
+		 * Runs the operation once.
+		 */
+		void run() throws Exception;
+	}
+
+	private static class OpenSSLOperation implements Operation {
+		private OpenSSLSHA256 hash;
+		private byte[] in = new byte[64];
+		private byte[] out = new byte[32];
+
+		public void init() {
+			hash = new OpenSSLSHA256();
+		}
+
+		public void run() {
+			hash.update(in, 0, in.length);
+			hash.hashFinal(out, 0);
+		}
+	}
+
+	private static class CryptoPPOperation implements Operation {
+		private CryptoPpAES aes;
+		private byte[] in = new byte[16];
+		private byte[] out = new byte[16];
+
+		public void init() throws Exception {
+			aes = new CryptoPpAES();
+			aes.setKey(new SecretKeySpec(new byte[16], "AES"));
+		}
+
+		public void run() throws Exception {
+			aes.computeBlock(in, 0, out, 0);
+		}
+	}
+
+	private static class MiraclOperation implements Operation {
+		private MiraclDlogECFp dlog;
+		private GroupElement generator;
+		private BigInteger exponent = BigInteger.valueOf(0x123456789L);
+
+		public void init() throws Exception {
+			dlog = new MiraclDlogECFp("P-192");
+			generator = dlog.getGenerator();
+		}
+
+		public void run() {
+			dlog.exponentiate(generator, exponent);
+		}
+	}
+
+	private static Operation createOperation(String library) {
+		if (library.equals("OpenSSL")) {
+			return new OpenSSLOperation();
+		}
+		if (library.equals("CryptoPP")) {
+			return new CryptoPPOperation();
+		}
+		if (library.equals("Miracl")) {
+			return new MiraclOperation();
+		}
+		throw new IllegalArgumentException("unknown library " + library + ". Should be one of OpenSSL, CryptoPP, Miracl");
+	}
+
+	private static double millis(long start, long end) {
+		return (end - start) / 1000000.0;
+	}
+
+	/**
+	 * Measures the given library and prints the results.
+	 * @param library one of OpenSSL, CryptoPP, Miracl.
+	 */
+	public static void measure(String library) throws Exception {
+		Operation operation = createOperation(library);
+
+		long start = System.nanoTime();
+		System.loadLibrary(library + "JavaInterface");
+		long loaded = System.nanoTime();
+		operation.init();
+		long initialized = System.nanoTime();
+		operation.run();
+		long firstOperation = System.nanoTime();
+		operation.run();
+		long secondOperation = System.nanoTime();
+
+		System.out.printf("%-10s load: %8.3f ms, init: %8.3f ms, first operation: %8.3f ms, time to first operation: %8.3f ms, warm operation: %8.3f ms%n",
+				library, millis(start, loaded), millis(loaded, initialized), millis(initialized, firstOperation),
+				millis(start, firstOperation), millis(firstOperation, secondOperation));
+	}
+
+	public static void main(String[] args) throws Exception {
+		String[] libraries = (args.length > 0) ? args : new String[] { "OpenSSL", "CryptoPP", "Miracl" };
+		for (String library : libraries) {
+			measure(library);
+		}
+	}
+}
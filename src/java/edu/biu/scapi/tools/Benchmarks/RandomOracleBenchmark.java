@@ -0,0 +1,109 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.tools.Benchmarks;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLSHA256;
+import edu.biu.scapi.primitives.randomOracle.HKDFBasedRO;
+import edu.biu.scapi.primitives.randomOracle.HashBasedRO;
+import edu.biu.scapi.primitives.randomOracle.RandomOracle;
+import edu.biu.scapi.primitives.randomOracle.openSSL.OpenSSLShake128RO;
+import edu.biu.scapi.primitives.randomOracle.openSSL.OpenSSLShake256RO;
+
+/**
+ * Compares the per-call compute of the random oracles to the batched computeMany, on 32 bytes inputs. <p>
+ * 
+ * For each random oracle the benchmark computes the same inputs once with compute and once with computeMany into a 
+ * preallocated buffer, checks that the results are identical and prints the throughput of both in inputs per second. <p>
+ * 
+ * Usage: java edu.biu.scapi.tools.Benchmarks.RandomOracleBenchmark [numInputs] [outLen]
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public class RandomOracleBenchmark {
+
+	private static final int IN_LEN = 32;
+
+	private static List<RandomOracle> createOracles() {
+		List<RandomOracle> oracles = new ArrayList<RandomOracle>();
+		oracles.add(new HashBasedRO(new OpenSSLSHA256()));
+		oracles.add(new HKDFBasedRO());
+		try {
+			oracles.add(new OpenSSLShake128RO());
+			oracles.add(new OpenSSLShake256RO());
+		} catch (UnsupportedOperationException e) {
+			System.out.println("SHAKE is not measured: " + e.getMessage());
+		}
+		return oracles;
+	}
+
+	private static double perSecond(int count, long start, long end) {
+		return count / ((end - start) / 1000000000.0);
+	}
+
+	/**
+	 * Measures the given random oracle and prints the results if print is true.
+	 */
+	public static void measure(RandomOracle oracle, byte[] inputs, int numInputs, int outLen, boolean print) {
+		byte[] perCall = new byte[numInputs * outLen];
+		byte[] batched = new byte[numInputs * outLen];
+
+		long start = System.nanoTime();
+		for (int i = 0; i < numInputs; i++) {
+			byte[] out = oracle.compute(inputs, i * IN_LEN, IN_LEN, outLen);
+			System.arraycopy(out, 0, perCall, i * outLen, outLen);
+		}
+		long computed = System.nanoTime();
+		oracle.computeMany(inputs, IN_LEN, numInputs, outLen, batched, 0);
+		long computedMany = System.nanoTime();
+
+		if (!print) {
+			return;
+		}
+		System.out.printf("%-20s compute: %12.0f inputs/s, computeMany: %12.0f inputs/s, identical: %b%n",
+				oracle.getClass().getSimpleName(), perSecond(numInputs, start, computed), perSecond(numInputs, computed, computedMany),
+				Arrays.equals(perCall, batched));
+	}
+
+	public static void main(String[] args) {
+		int numInputs = (args.length > 0) ? Integer.parseInt(args[0]) : 100000;
+		int outLen = (args.length > 1) ? Integer.parseInt(args[1]) : 64;
+
+		byte[] inputs = new byte[numInputs * IN_LEN];
+		for (int i = 0; i < inputs.length; i++) {
+			inputs[i] = (byte) (i * 31 + 7);
+		}
+
+		for (RandomOracle oracle : createOracles()) {
+			//The first round warms up the jit, only the second is printed.
+			measure(oracle, inputs, Math.min(numInputs, 1000), outLen, false);
+			measure(oracle, inputs, numInputs, outLen, true);
+		}
+	}
+}
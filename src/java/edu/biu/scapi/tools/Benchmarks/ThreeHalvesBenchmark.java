@@ -0,0 +1,147 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+package edu.biu.scapi.tools.Benchmarks;
+
+import java.security.SecureRandom;
+import java.util.Arrays;
+
+import edu.biu.scapi.circuits.fastGarbledCircuit.FastCircuitCreationValues;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit;
+import edu.biu.scapi.circuits.fastGarbledCircuit.ScNativeGarbledBooleanCircuit.CircuitType;
+
+/**
+ * Compares the three halves garbling of ScNativeGarbledBooleanCircuit to the half gates garbling, on the AES and SHA-256 circuits. <p>
+ * 
+ * For each circuit, both types are garbled with the same seed. The benchmark prints the size of the garbled tables that are sent 
+ * to the evaluator and the garbling and computing times of both types. It checks that the translated outputs of both types are 
+ * identical, that the three halves circuit is verified with its input keys and that a second circuit that gets the garbled tables 
+ * and the translation table computes the same output. <p>
+ * 
+ * Usage: java edu.biu.scapi.tools.Benchmarks.ThreeHalvesBenchmark [iterations] [circuitFile...]
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public class ThreeHalvesBenchmark {
+
+	private static final String CIRCUITS_DIR = "src/java/edu/biu/SCProtocols/NativeMaliciousYao/assets/circuits/";
+	
+	/**
+	 * The results of one circuit type.
+	 */
+	private static class Run {
+		private int tablesSize;
+		private double garbleMillis;
+		private double computeMillis;
+		private byte[] output;
+		private boolean verified;
+		private boolean sameAfterSetTables;
+	}
+	
+	/**
+	 * Returns the key of each input wire that matches the given input bit.
+	 */
+	private static byte[] selectInputKeys(byte[] allInputWireValues, byte[] input, int keySize) {
+		byte[] keys = new byte[input.length * keySize];
+		for (int i = 0; i < input.length; i++) {
+			System.arraycopy(allInputWireValues, (2 * i + input[i]) * keySize, keys, i * keySize, keySize);
+		}
+		return keys;
+	}
+	
+	private static Run run(String fileName, CircuitType type, byte[] seed, byte[] input, int iterations) throws Exception {
+		Run run = new Run();
+		ScNativeGarbledBooleanCircuit circuit = new ScNativeGarbledBooleanCircuit(fileName, type, false);
+		int keySize = circuit.getKeySize();
+		
+		//The first garbling and computation warm up the jit.
+		FastCircuitCreationValues values = circuit.garble(seed);
+		long start = System.nanoTime();
+		for (int i = 0; i < iterations; i++) {
+			values = circuit.garble(seed);
+		}
+		run.garbleMillis = (System.nanoTime() - start) / 1000000.0 / iterations;
+		byte[] tables = circuit.getGarbledTables().toDoubleByteArray()[0];
+		run.tablesSize = tables.length;
+		
+		byte[] inputKeys = selectInputKeys(values.getAllInputWireValues(), input, keySize);
+		circuit.setInputs(inputKeys);
+		byte[] outputKeys = circuit.compute();
+		start = System.nanoTime();
+		for (int i = 0; i < iterations; i++) {
+			outputKeys = circuit.compute();
+		}
+		run.computeMillis = (System.nanoTime() - start) / 1000000.0 / iterations;
+		run.output = circuit.translate(outputKeys);
+		run.verified = circuit.verify(values.getAllInputWireValues());
+		
+		//The evaluator gets only the garbled tables and the translation table.
+		ScNativeGarbledBooleanCircuit evaluator = new ScNativeGarbledBooleanCircuit(fileName, type, false);
+		evaluator.setGarbledTables(circuit.getGarbledTables());
+		evaluator.setTranslationTable(circuit.getTranslationTable());
+		evaluator.setInputs(inputKeys);
+		run.sameAfterSetTables = Arrays.equals(run.output, evaluator.translate(evaluator.compute()));
+		return run;
+	}
+	
+	/**
+	 * Measures both circuit types on the given circuit and prints the results.
+	 */
+	public static void measure(String fileName, int iterations) throws Exception {
+		SecureRandom random = new SecureRandom();
+		byte[] seed = new byte[16];
+		random.nextBytes(seed);
+		
+		//A random input for all the input wires of all the parties.
+		int numInputs = new ScNativeGarbledBooleanCircuit(fileName, CircuitType.FREE_XOR_HALF_GATES, false).getInputWireIndices().length;
+		byte[] input = new byte[numInputs];
+		for (int i = 0; i < numInputs; i++) {
+			input[i] = (byte) random.nextInt(2);
+		}
+		
+		Run halfGates = run(fileName, CircuitType.FREE_XOR_HALF_GATES, seed, input, iterations);
+		Run threeHalves = run(fileName, CircuitType.FREE_XOR_THREE_HALVES, seed, input, iterations);
+		
+		System.out.println(fileName + ":");
+		System.out.printf("tables: half gates %10d bytes, three halves %10d bytes (%.1f%%)%n", 
+				halfGates.tablesSize, threeHalves.tablesSize, 100.0 * threeHalves.tablesSize / halfGates.tablesSize);
+		System.out.printf("garble: half gates %10.3f ms,    three halves %10.3f ms%n", halfGates.garbleMillis, threeHalves.garbleMillis);
+		System.out.printf("compute: half gates %9.3f ms,    three halves %10.3f ms%n", halfGates.computeMillis, threeHalves.computeMillis);
+		System.out.printf("identical output: %b, verified: %b, computed from the tables: %b%n", 
+				Arrays.equals(halfGates.output, threeHalves.output), threeHalves.verified, threeHalves.sameAfterSetTables);
+	}
+
+	public static void main(String[] args) throws Exception {
+		int iterations = (args.length > 0) ? Integer.parseInt(args[0]) : 100;
+		String[] fileNames = { CIRCUITS_DIR + "AES/NigelAes.txt", CIRCUITS_DIR + "SHA256/NigelSHA256.txt" };
+		if (args.length > 1) {
+			fileNames = Arrays.copyOfRange(args, 1, args.length);
+		}
+		
+		for (String fileName : fileNames) {
+			measure(fileName, iterations);
+		}
+	}
+}
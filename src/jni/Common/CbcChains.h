@@ -0,0 +1,83 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+#ifndef SCAPI_CBC_CHAINS_H
+#define SCAPI_CBC_CHAINS_H
+
+/*
+ * CBC chains for the native CBC-MAC of the PRPs (see edu.biu.scapi.primitives.prf.CbcChainPrp).
+ *
+ * A CBC chain is inherently serial, so a single chain cannot use the pipelining of the AES instructions. When there are
+ * many messages, up to CBC_CHAIN_LANES independent chains are computed side by side: in each step, the current block of
+ * every chain is xored into its chaining value and all the chaining values are encrypted together in one call of the
+ * underlying cipher, that interleaves them (with AES-NI, when available).
+ *
+ * The last block of a message that is not aligned to the block size is padded with zeros, the same as the padding of
+ * ScCbcMacPrepending.
+ */
+
+#include <string.h>
+
+namespace scapi_native {
+
+const int CBC_CHAIN_LANES = 8;
+const int CBC_BLOCK_SIZE = 16;
+
+/*
+ * Computes numMsgs CBC chains. Message i is the msgLen bytes that start at in + i * msgLen. Every chain starts from the
+ * given iv, and its final chaining value is written to out + i * CBC_BLOCK_SIZE.
+ * encryptBlocks(blocks, n) should encrypt the n consecutive blocks in place.
+ */
+template<class EncryptBlocks>
+inline void computeCbcChains(EncryptBlocks& encryptBlocks, const unsigned char* iv, const unsigned char* in, int msgLen, int numMsgs, unsigned char* out) {
+	unsigned char chains[CBC_CHAIN_LANES * CBC_BLOCK_SIZE];
+	int numBlocks = (msgLen + CBC_BLOCK_SIZE - 1) / CBC_BLOCK_SIZE;
+
+	for (int first = 0; first < numMsgs; first += CBC_CHAIN_LANES) {
+		int lanes = (numMsgs - first < CBC_CHAIN_LANES) ? numMsgs - first : CBC_CHAIN_LANES;
+		for (int k = 0; k < lanes; k++) {
+			memcpy(chains + k * CBC_BLOCK_SIZE, iv, CBC_BLOCK_SIZE);
+		}
+
+		for (int b = 0; b < numBlocks; b++) {
+			//The last block may be partial. Xoring only its bytes is the same as xoring the zero padded block.
+			int blockLen = (msgLen - b * CBC_BLOCK_SIZE < CBC_BLOCK_SIZE) ? msgLen - b * CBC_BLOCK_SIZE : CBC_BLOCK_SIZE;
+			for (int k = 0; k < lanes; k++) {
+				const unsigned char* block = in + (long) (first + k) * msgLen + b * CBC_BLOCK_SIZE;
+				unsigned char* chain = chains + k * CBC_BLOCK_SIZE;
+				for (int j = 0; j < blockLen; j++) {
+					chain[j] ^= block[j];
+				}
+			}
+			encryptBlocks(chains, lanes);
+		}
+
+		memcpy(out + first * CBC_BLOCK_SIZE, chains, lanes * CBC_BLOCK_SIZE);
+	}
+}
+
+} // namespace scapi_native
+
+#endif // SCAPI_CBC_CHAINS_H
@@ -0,0 +1,67 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+#ifndef SCAPI_COUNTER_BLOCKS_H
+#define SCAPI_COUNTER_BLOCKS_H
+
+/*
+ * Counter blocks for the native counter mode of the PRFs (see edu.biu.scapi.primitives.prf.CounterModePrf).
+ *
+ * The counter is a big endian number of the size of the block. It is increased by one for each block and wraps around
+ * to zero, the same as the counter of ScPrgFromPrf. The blocks are generated in chunks of COUNTER_CHUNK_BLOCKS so that
+ * the underlying cipher can encrypt many blocks in one call (and pipeline them) without allocating a buffer of the whole
+ * requested output.
+ */
+
+#include <string.h>
+
+namespace scapi_native {
+
+const int COUNTER_CHUNK_BLOCKS = 256;
+
+/*
+ * Increases the given big endian counter by one.
+ */
+inline void increaseCounter(unsigned char* ctr, int blockSize) {
+	for (int i = blockSize - 1; i >= 0; i--) {
+		if (++ctr[i] != 0) {
+			break;
+		}
+	}
+}
+
+/*
+ * Writes numBlocks consecutive counter blocks, starting from ctr, to blocks. At the end, ctr holds the next counter.
+ */
+inline void fillCounterBlocks(unsigned char* blocks, unsigned char* ctr, int numBlocks, int blockSize) {
+	for (int i = 0; i < numBlocks; i++) {
+		memcpy(blocks + i * blockSize, ctr, blockSize);
+		increaseCounter(ctr, blockSize);
+	}
+}
+
+} // namespace scapi_native
+
+#endif // SCAPI_COUNTER_BLOCKS_H
@@ -0,0 +1,304 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+
+#ifndef SCAPI_HUGE_PAGE_ALLOCATOR_H
+#define SCAPI_HUGE_PAGE_ALLOCATOR_H
+
+/*
+ * Aligned allocator for the large, sequentially scanned buffers of the native code (wire keys, garbled tables,
+ * probe resistant keys).
+ *
+ * Buffers that are smaller than the threshold are allocated with the regular aligned malloc. Larger buffers are mapped
+ * on 2MB aligned addresses and backed by huge pages, which cuts the number of TLB misses when the buffer is scanned.
+ * By default, transparent huge pages are requested with madvise. Setting SCAPI_HUGE_PAGES=explicit uses the reserved
+ * huge pages of the system (MAP_HUGETLB) and falls back to transparent huge pages if none are available.
+ * SCAPI_HUGE_PAGES=0 disables the huge pages altogether.
+ *
+ * Released large buffers are kept in a free list, by size class, so that the next call of the same size reuses the
+ * mapping instead of mapping (and faulting) new memory. The free list holds up to SCAPI_HUGE_PAGE_CACHE_MB megabytes
+ * (default 256). A buffer is wiped before it is put in the free list, since it may hold wire keys or garbled tables that
+ * should not be handed to the next caller. Setting SCAPI_HUGE_PAGE_STATS=1 prints the allocator counters when the library is unloaded; the effect
+ * on the TLB can be measured with perf stat -e dTLB-load-misses,dTLB-store-misses. The java HugePageBenchmark (tools/Benchmarks)
+ * runs the three halves circuit in both modes and does that with -perf.
+ *
+ * On Windows, all the buffers are allocated with _aligned_malloc.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace scapi_native {
+
+const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+struct HugePageStats {
+	long long hugePageAllocations;	//Large buffers that were mapped.
+	long long reusedAllocations;	//Large buffers that were taken from the free list.
+	long long fallbackAllocations;	//Large buffers that could not be mapped and were allocated with malloc.
+	long long mappedBytes;			//Bytes currently mapped, including the free list.
+	long long cachedBytes;			//Bytes currently in the free list.
+
+	HugePageStats() : hugePageAllocations(0), reusedAllocations(0), fallbackAllocations(0), mappedBytes(0), cachedBytes(0) {}
+};
+
+class HugePageAllocator {
+
+private:
+	bool enabled;
+	bool explicitPages;
+	bool printStats;
+	size_t threshold;
+	size_t maxCachedBytes;
+	std::mutex lock;
+	struct LiveBlock {
+		size_t size;		//The mapped size.
+		size_t usedBytes;	//The largest size that was requested for the buffer since it was mapped.
+	};
+
+	std::map<void*, LiveBlock> liveBlocks;				//Mapped buffers that are in use.
+	std::map<size_t, std::vector<void*> > freeBlocks;	//Released buffers, by their mapped size.
+	std::map<void*, size_t> cachedUsedBytes;			//The used bytes of each buffer in the free list.
+	std::atomic<long> numLiveBlocks;
+	HugePageStats stats;
+
+	HugePageAllocator() : numLiveBlocks(0) {
+		const char* mode = getenv("SCAPI_HUGE_PAGES");
+		enabled = (mode == NULL) || (strcmp(mode, "0") != 0);
+		explicitPages = (mode != NULL) && (strcmp(mode, "explicit") == 0);
+		const char* cache = getenv("SCAPI_HUGE_PAGE_CACHE_MB");
+		maxCachedBytes = (size_t) ((cache == NULL) ? 256 : atol(cache)) * 1024 * 1024;
+		const char* print = getenv("SCAPI_HUGE_PAGE_STATS");
+		printStats = (print != NULL) && (strcmp(print, "0") != 0);
+		threshold = HUGE_PAGE_SIZE;
+#ifdef _WIN32
+		enabled = false;
+#endif
+	}
+
+	/*
+	 * Rounds the given size up to its size class: a whole number of huge pages, rounded up to 1, 1.25, 1.5 or 1.75 times
+	 * a power of two pages. This keeps the waste under 25% while letting buffers of close sizes share the free list.
+	 */
+	static size_t sizeClass(size_t bytes) {
+		size_t pages = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE;
+		if (pages > 4) {
+			size_t power = 1;
+			while (power * 2 <= pages) {
+				power *= 2;
+			}
+			size_t step = power / 4;
+			pages = ((pages + step - 1) / step) * step;
+		}
+		return pages * HUGE_PAGE_SIZE;
+	}
+
+	/*
+	 * Zeroes the given buffer. The barrier keeps the compiler from dropping the memset of a buffer that is not read again.
+	 */
+	static void wipe(void* ptr, size_t bytes) {
+		memset(ptr, 0, bytes);
+#ifndef _WIN32
+		__asm__ __volatile__("" : : "r"(ptr) : "memory");
+#endif
+	}
+
+#ifndef _WIN32
+	/*
+	 * Maps size bytes (a multiple of HUGE_PAGE_SIZE) on a 2MB aligned address. Returns NULL if the memory could not be mapped.
+	 */
+	void* map(size_t size) {
+#ifdef MAP_HUGETLB
+		if (explicitPages) {
+			void* block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (block != MAP_FAILED) {
+				return block;
+			}
+		}
+#endif
+		//Map an extra huge page and unmap the unaligned head and tail, so that the buffer starts on a huge page boundary.
+		size_t mappedSize = size + HUGE_PAGE_SIZE;
+		char* mapped = (char*) mmap(NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapped == (char*) MAP_FAILED) {
+			return NULL;
+		}
+		char* block = (char*) (((size_t) mapped + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+		if (block != mapped) {
+			munmap(mapped, block - mapped);
+		}
+		size_t tail = (mapped + mappedSize) - (block + size);
+		if (tail > 0) {
+			munmap(block + size, tail);
+		}
+#ifdef MADV_HUGEPAGE
+		madvise(block, size, MADV_HUGEPAGE);
+#endif
+		return block;
+	}
+#endif
+
+public:
+	~HugePageAllocator() {
+		if (printStats) {
+			fprintf(stderr, "[scapi huge pages] %lld mapped, %lld reused, %lld fallback, %lld bytes mapped, %lld bytes cached\n",
+					stats.hugePageAllocations, stats.reusedAllocations, stats.fallbackAllocations, stats.mappedBytes, stats.cachedBytes);
+		}
+	}
+
+	/*
+	 * Returns the allocator of this library.
+	 */
+	static HugePageAllocator& get() {
+		static HugePageAllocator allocator;
+		return allocator;
+	}
+
+	/*
+	 * Allocates bytes bytes, aligned to alignment (which should be a power of two, up to HUGE_PAGE_SIZE).
+	 * The buffer should be released with release(). The content of the buffer is not initialized.
+	 */
+	void* allocate(size_t bytes, size_t alignment) {
+#ifdef _WIN32
+		return _aligned_malloc(bytes, alignment);
+#else
+		if (enabled && bytes >= threshold) {
+			size_t size = sizeClass(bytes);
+			std::lock_guard<std::mutex> guard(lock);
+			void* block = NULL;
+			size_t usedBytes = bytes;
+			std::map<size_t, std::vector<void*> >::iterator cached = freeBlocks.find(size);
+			if (cached != freeBlocks.end() && !cached->second.empty()) {
+				block = cached->second.back();
+				cached->second.pop_back();
+				//the buffer was wiped up to the largest size it was used with, so only that part is touched again.
+				usedBytes = std::max(usedBytes, cachedUsedBytes[block]);
+				cachedUsedBytes.erase(block);
+				stats.cachedBytes -= size;
+				stats.reusedAllocations++;
+			} else if ((block = map(size)) != NULL) {
+				stats.mappedBytes += size;
+				stats.hugePageAllocations++;
+			}
+			if (block != NULL) {
+				LiveBlock live = { size, usedBytes };
+				liveBlocks[block] = live;
+				numLiveBlocks++;
+				return block;
+			}
+			stats.fallbackAllocations++;
+		}
+
+		void* block = NULL;
+		if (posix_memalign(&block, (alignment < sizeof(void*)) ? sizeof(void*) : alignment, bytes) != 0) {
+			return NULL;
+		}
+		return block;
+#endif
+	}
+
+	/*
+	 * Releases a buffer that was allocated by allocate(). Large buffers are kept in the free list as long as it has room,
+	 * and unmapped otherwise.
+	 */
+	void release(void* ptr) {
+		if (ptr == NULL) {
+			return;
+		}
+#ifdef _WIN32
+		_aligned_free(ptr);
+#else
+		if (numLiveBlocks > 0) {
+			LiveBlock live = { 0, 0 };
+			bool cache = false;
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				std::map<void*, LiveBlock>::iterator it = liveBlocks.find(ptr);
+				if (it != liveBlocks.end()) {
+					live = it->second;
+					liveBlocks.erase(it);
+					numLiveBlocks--;
+					cache = (stats.cachedBytes + live.size <= maxCachedBytes);
+				}
+			}
+			if (live.size != 0) {
+				//the wipe is done outside the lock, so a large buffer does not hold up the other threads.
+				if (cache) {
+					wipe(ptr, live.usedBytes);
+				}
+				std::lock_guard<std::mutex> guard(lock);
+				if (cache && stats.cachedBytes + live.size <= maxCachedBytes) {
+					freeBlocks[live.size].push_back(ptr);
+					cachedUsedBytes[ptr] = live.usedBytes;
+					stats.cachedBytes += live.size;
+				} else {
+					//an unmapped buffer is zeroed by the kernel if the memory is mapped again.
+					munmap(ptr, live.size);
+					stats.mappedBytes -= live.size;
+				}
+				return;
+			}
+		}
+		free(ptr);
+#endif
+	}
+
+	/*
+	 * Returns a copy of the counters of the allocator.
+	 */
+	HugePageStats getStats() {
+		std::lock_guard<std::mutex> guard(lock);
+		return stats;
+	}
+};
+
+/*
+ * Allocates an aligned buffer, backed by huge pages if it is large enough. Replaces _aligned_malloc / _mm_malloc.
+ */
+inline void* alignedAlloc(size_t bytes, size_t alignment = 16) {
+	return HugePageAllocator::get().allocate(bytes, alignment);
+}
+
+/*
+ * Releases a buffer that was allocated by alignedAlloc. Replaces _aligned_free / _mm_free.
+ */
+inline void alignedFree(void* ptr) {
+	HugePageAllocator::get().release(ptr);
+}
+
+} // namespace scapi_native
+
+#endif // SCAPI_HUGE_PAGE_ALLOCATOR_H
@@ -0,0 +1,515 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+#ifndef SCAPI_KOBLITZ_TNAF_H
+#define SCAPI_KOBLITZ_TNAF_H
+
+/*
+ * Scalar multiplication on the NIST Koblitz curves K-163, K-233 and K-283 (y^2 + xy = x^3 + ax^2 + 1 over GF(2^m)), using
+ * the Frobenius endomorphism tau(x, y) = (x^2, y^2).
+ *
+ * The scalar is given as a width-w tau-adic NAF, sum of u_i * tau^i, where every non zero digit u is odd and stands for
+ * the point alpha_u * P (the precomputed points). The recoding is done by the caller (see
+ * edu.biu.scapi.primitives.dlog.ECF2mKoblitzTnaf), which also gives the digits of each alpha_u as a width-2 tau-adic NAF.
+ * Evaluating the expansion costs a Frobenius map, three squarings in Lopez-Dahab coordinates, for each digit, and a mixed
+ * addition for each non zero digit only. There are no doublings.
+ *
+ * The number of digits and the additions depend on the scalar, so the running time leaks it. This arithmetic should only
+ * be used with public scalars; the exponentiations with secret scalars use the Montgomery ladder of OpenSSL.
+ *
+ * The field arithmetic works on fixed size arrays of 64 bit words. The carry-less multiplication uses the PCLMULQDQ
+ * instruction when the processor supports it (unless the curve is created with allowPclmul false), and a portable shift and
+ * xor loop otherwise.
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <wmmintrin.h>
+#define SCAPI_KOBLITZ_PCLMUL 1
+#define SCAPI_KOBLITZ_PCLMUL_TARGET __attribute__((target("pclmul,sse2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#include <wmmintrin.h>
+#define SCAPI_KOBLITZ_PCLMUL 1
+#define SCAPI_KOBLITZ_PCLMUL_TARGET
+#endif
+
+namespace scapi_native {
+
+const int KOBLITZ_MAX_WORDS = 5;	//283 bits.
+
+typedef uint64_t KoblitzElement[KOBLITZ_MAX_WORDS];
+
+struct KoblitzAffinePoint {
+	KoblitzElement x, y;
+	bool infinity;
+};
+
+struct KoblitzLdPoint {
+	//Lopez-Dahab projective coordinates: x = X/Z, y = Y/Z^2.
+	KoblitzElement X, Y, Z;
+	bool infinity;
+};
+
+/*
+ * Returns true if the processor supports the PCLMULQDQ instruction.
+ */
+inline bool koblitzHasPclmul() {
+#if defined(SCAPI_KOBLITZ_PCLMUL) && defined(__GNUC__)
+	unsigned int eax, ebx, ecx, edx;
+	return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_PCLMUL);
+#elif defined(SCAPI_KOBLITZ_PCLMUL)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 1)) != 0;
+#else
+	return false;
+#endif
+}
+
+/*
+ * Carry-less multiplication of two 64 bit words into two words, without special instructions.
+ */
+inline void koblitzClmulPortable(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+	lo = 0;
+	hi = 0;
+	for (int i = 0; i < 64; i++) {
+		uint64_t mask = 0 - ((a >> i) & 1);
+		lo ^= (b << i) & mask;
+		if (i != 0) {
+			hi ^= (b >> (64 - i)) & mask;
+		}
+	}
+}
+
+#ifdef SCAPI_KOBLITZ_PCLMUL
+/*
+ * Multiplies the words of two polynomials without reduction, using PCLMULQDQ.
+ */
+SCAPI_KOBLITZ_PCLMUL_TARGET inline void koblitzPolyMulPclmul(const uint64_t* a, const uint64_t* b, int words, uint64_t* product) {
+	memset(product, 0, 2 * words * sizeof(uint64_t));
+	for (int i = 0; i < words; i++) {
+		__m128i ai = _mm_set_epi64x(0, (long long) a[i]);
+		for (int j = 0; j < words; j++) {
+			uint64_t out[2];
+			_mm_storeu_si128((__m128i*) out, _mm_clmulepi64_si128(ai, _mm_set_epi64x(0, (long long) b[j]), 0x00));
+			product[i + j] ^= out[0];
+			product[i + j + 1] ^= out[1];
+		}
+	}
+}
+
+/*
+ * Squares a polynomial without reduction, using PCLMULQDQ. The cross products cancel, so only the words are squared.
+ */
+SCAPI_KOBLITZ_PCLMUL_TARGET inline void koblitzPolySqrPclmul(const uint64_t* a, int words, uint64_t* product) {
+	for (int i = 0; i < words; i++) {
+		__m128i ai = _mm_set_epi64x(0, (long long) a[i]);
+		_mm_storeu_si128((__m128i*) (product + 2 * i), _mm_clmulepi64_si128(ai, ai, 0x00));
+	}
+}
+#endif
+
+class KoblitzCurve {
+
+private:
+	int m;				//The degree of the field.
+	int words;			//The number of 64 bit words of a field element.
+	int a;				//The coefficient a of the curve, 0 or 1.
+	int terms[3];		//The middle terms of the reduction polynomial x^m + x^terms[0] + ... + 1.
+	int numTerms;
+	bool pclmul;
+
+	//The width-2 tau-adic NAF of each alpha_u, least significant digit first.
+	std::vector<std::vector<signed char> > alphaDigits;
+
+	void reduce(uint64_t* c) const {
+		int top = m / 64;
+		int topBits = m % 64;
+		for (int i = 2 * words - 1; i >= top; i--) {
+			uint64_t t = c[i];
+			int base = 64 * i;
+			if (i == top) {
+				t >>= topBits;
+				c[i] &= (((uint64_t) 1) << topBits) - 1;
+				base = m;
+			} else {
+				c[i] = 0;
+			}
+			if (t == 0) {
+				continue;
+			}
+			//t * x^base = t * x^(base - m) * (x^terms + 1).
+			xorShifted(c, t, base - m);
+			for (int k = 0; k < numTerms; k++) {
+				xorShifted(c, t, base - m + terms[k]);
+			}
+		}
+	}
+
+	static void xorShifted(uint64_t* c, uint64_t t, int position) {
+		int word = position / 64;
+		int shift = position % 64;
+		c[word] ^= t << shift;
+		if (shift != 0) {
+			c[word + 1] ^= t >> (64 - shift);
+		}
+	}
+
+	void polyMul(const uint64_t* x, const uint64_t* y, uint64_t* product) const {
+#ifdef SCAPI_KOBLITZ_PCLMUL
+		if (pclmul) {
+			koblitzPolyMulPclmul(x, y, words, product);
+			return;
+		}
+#endif
+		memset(product, 0, 2 * words * sizeof(uint64_t));
+		for (int i = 0; i < words; i++) {
+			for (int j = 0; j < words; j++) {
+				uint64_t lo, hi;
+				koblitzClmulPortable(x[i], y[j], lo, hi);
+				product[i + j] ^= lo;
+				product[i + j + 1] ^= hi;
+			}
+		}
+	}
+
+public:
+	/*
+	 * Creates the curve of the given degree, which should be 163, 233 or 283, see isSupported.
+	 * If allowPclmul is false, the portable carry-less multiplication is used also when the processor has PCLMULQDQ.
+	 */
+	KoblitzCurve(int m, int a, bool allowPclmul = true) : m(m), a(a), numTerms(0) {
+		words = (m + 63) / 64;
+		if (m == 163) {
+			terms[0] = 7; terms[1] = 6; terms[2] = 3;
+			numTerms = 3;
+		} else if (m == 233) {
+			terms[0] = 74;
+			numTerms = 1;
+		} else if (m == 283) {
+			terms[0] = 12; terms[1] = 7; terms[2] = 5;
+			numTerms = 3;
+		}
+		pclmul = allowPclmul && koblitzHasPclmul();
+	}
+
+	/*
+	 * Returns true if the degree is one of the supported Koblitz curves.
+	 */
+	bool isSupported() const {
+		return numTerms != 0 && (a == 0 || a == 1);
+	}
+
+	int getDegree() const { return m; }
+	int getWords() const { return words; }
+	bool usesPclmul() const { return pclmul; }
+
+	/*
+	 * Returns the exponents of the reduction polynomial, from the highest to 0, followed by -1.
+	 */
+	void getPolynomial(int* exponents) const {
+		exponents[0] = m;
+		for (int k = 0; k < numTerms; k++) {
+			exponents[k + 1] = terms[k];
+		}
+		exponents[numTerms + 1] = 0;
+		exponents[numTerms + 2] = -1;
+	}
+
+	/*
+	 * Sets the width-2 tau-adic NAF of alpha_1, alpha_3, ..., alpha_(2^(w-1)-1).
+	 */
+	void setAlphaDigits(const std::vector<std::vector<signed char> >& digits) {
+		alphaDigits = digits;
+	}
+
+	int getNumAlphas() const { return (int) alphaDigits.size(); }
+
+	/*** Field arithmetic ***/
+
+	void mul(KoblitzElement r, const KoblitzElement x, const KoblitzElement y) const {
+		uint64_t product[2 * KOBLITZ_MAX_WORDS];
+		polyMul(x, y, product);
+		reduce(product);
+		memcpy(r, product, words * sizeof(uint64_t));
+	}
+
+	void sqr(KoblitzElement r, const KoblitzElement x) const {
+		uint64_t product[2 * KOBLITZ_MAX_WORDS];
+#ifdef SCAPI_KOBLITZ_PCLMUL
+		if (pclmul) {
+			koblitzPolySqrPclmul(x, words, product);
+		} else
+#endif
+		{
+			for (int i = 0; i < words; i++) {
+				koblitzClmulPortable(x[i], x[i], product[2 * i], product[2 * i + 1]);
+			}
+		}
+		reduce(product);
+		memcpy(r, product, words * sizeof(uint64_t));
+	}
+
+	void add(KoblitzElement r, const KoblitzElement x, const KoblitzElement y) const {
+		for (int i = 0; i < words; i++) {
+			r[i] = x[i] ^ y[i];
+		}
+	}
+
+	bool isZero(const KoblitzElement x) const {
+		uint64_t acc = 0;
+		for (int i = 0; i < words; i++) {
+			acc |= x[i];
+		}
+		return acc == 0;
+	}
+
+	void setOne(KoblitzElement r) const {
+		memset(r, 0, words * sizeof(uint64_t));
+		r[0] = 1;
+	}
+
+	/*
+	 * Computes 1/x, for a non zero x, using Itoh-Tsujii: 1/x = (x^(2^(m-1) - 1))^2.
+	 */
+	void inv(KoblitzElement r, const KoblitzElement x) const {
+		//beta holds x^(2^k - 1). Go over the bits of m-1 from the top.
+		KoblitzElement beta, t;
+		memcpy(beta, x, sizeof(KoblitzElement));
+		int k = 1;
+		int n = m - 1;
+		int bit = 31;
+		while (((n >> bit) & 1) == 0) {
+			bit--;
+		}
+		for (bit--; bit >= 0; bit--) {
+			//x^(2^2k - 1) = (x^(2^k - 1))^(2^k) * x^(2^k - 1)
+			memcpy(t, beta, sizeof(KoblitzElement));
+			for (int i = 0; i < k; i++) {
+				sqr(t, t);
+			}
+			mul(beta, t, beta);
+			k *= 2;
+			if ((n >> bit) & 1) {
+				//x^(2^(k+1) - 1) = (x^(2^k - 1))^2 * x
+				sqr(beta, beta);
+				mul(beta, beta, x);
+				k++;
+			}
+		}
+		sqr(r, beta);
+	}
+
+	/*** Point arithmetic ***/
+
+	void negate(KoblitzAffinePoint& r, const KoblitzAffinePoint& p) const {
+		r = p;
+		add(r.y, p.x, p.y);
+	}
+
+	/*
+	 * Applies the Frobenius map, tau(x, y) = (x^2, y^2).
+	 */
+	void frobenius(KoblitzLdPoint& p) const {
+		if (p.infinity) {
+			return;
+		}
+		sqr(p.X, p.X);
+		sqr(p.Y, p.Y);
+		sqr(p.Z, p.Z);
+	}
+
+	/*
+	 * Doubles the point in Lopez-Dahab coordinates (b = 1).
+	 */
+	void dbl(KoblitzLdPoint& p) const {
+		if (p.infinity) {
+			return;
+		}
+		KoblitzElement t1, t2, z3;
+		sqr(t1, p.Z);			//Z1^2
+		sqr(t2, p.X);			//X1^2
+		mul(z3, t1, t2);		//Z3 = X1^2 * Z1^2
+		sqr(p.X, t2);			//X1^4
+		sqr(t1, t1);			//b * Z1^4
+		add(p.X, p.X, t1);		//X3 = X1^4 + b*Z1^4
+		sqr(t2, p.Y);			//Y1^2
+		if (a == 1) {
+			add(t2, t2, z3);
+		}
+		add(t2, t2, t1);		//Y1^2 + a*Z3 + b*Z1^4
+		mul(p.Y, p.X, t2);
+		mul(t1, t1, z3);
+		add(p.Y, p.Y, t1);		//Y3 = b*Z1^4*Z3 + X3*(a*Z3 + Y1^2 + b*Z1^4)
+		memcpy(p.Z, z3, sizeof(KoblitzElement));
+		if (isZero(p.Z)) {
+			p.infinity = true;
+		}
+	}
+
+	/*
+	 * Adds an affine point to a point in Lopez-Dahab coordinates.
+	 */
+	void addMixed(KoblitzLdPoint& p, const KoblitzAffinePoint& q) const {
+		if (q.infinity) {
+			return;
+		}
+		if (p.infinity) {
+			memcpy(p.X, q.x, sizeof(KoblitzElement));
+			memcpy(p.Y, q.y, sizeof(KoblitzElement));
+			setOne(p.Z);
+			p.infinity = false;
+			return;
+		}
+
+		KoblitzElement t1, t2, t3, y3, z3;
+		KoblitzElement x3 = { 0 };
+		mul(t1, p.Z, q.x);		//Z1*x2
+		sqr(t2, p.Z);			//Z1^2
+		add(x3, p.X, t1);		//B = X1 + Z1*x2
+		mul(t1, p.Z, x3);		//C = Z1*B
+		mul(t3, t2, q.y);
+		add(y3, p.Y, t3);		//A = Y1 + Z1^2*y2
+		if (isZero(x3)) {
+			if (isZero(y3)) {
+				//p == q.
+				memcpy(p.X, q.x, sizeof(KoblitzElement));
+				memcpy(p.Y, q.y, sizeof(KoblitzElement));
+				setOne(p.Z);
+				dbl(p);
+			} else {
+				//p == -q.
+				p.infinity = true;
+			}
+			return;
+		}
+
+		sqr(z3, t1);			//Z3 = C^2
+		mul(t3, t1, y3);		//E = A*C
+		if (a == 1) {
+			add(t1, t1, t2);	//C + a*Z1^2
+		}
+		sqr(t2, x3);			//B^2
+		mul(x3, t2, t1);		//D = B^2*(C + a*Z1^2)
+		sqr(t2, y3);			//A^2
+		add(x3, x3, t2);
+		add(x3, x3, t3);		//X3 = A^2 + D + E
+		mul(t2, q.x, z3);
+		add(t2, t2, x3);		//F = X3 + x2*Z3
+		sqr(t1, z3);
+		add(t3, t3, z3);		//E + Z3
+		mul(y3, t3, t2);		//(E + Z3)*F
+		add(t2, q.x, q.y);
+		mul(t3, t1, t2);		//(x2 + y2)*Z3^2
+		add(y3, y3, t3);		//Y3 = (E + Z3)*F + (x2 + y2)*Z3^2
+
+		memcpy(p.X, x3, sizeof(KoblitzElement));
+		memcpy(p.Y, y3, sizeof(KoblitzElement));
+		memcpy(p.Z, z3, sizeof(KoblitzElement));
+	}
+
+	/*
+	 * Converts the given points to affine coordinates, with a single inversion for all of them.
+	 */
+	void toAffine(const KoblitzLdPoint* points, KoblitzAffinePoint* result, int num) const {
+		//prefix + i * KOBLITZ_MAX_WORDS is the product of the Z's of the finite points before point i.
+		std::vector<uint64_t> products((num + 1) * KOBLITZ_MAX_WORDS);
+		uint64_t* prefix = products.data();
+		setOne(prefix);
+		for (int i = 0; i < num; i++) {
+			uint64_t* next = prefix + (i + 1) * KOBLITZ_MAX_WORDS;
+			if (points[i].infinity) {
+				memcpy(next, prefix + i * KOBLITZ_MAX_WORDS, sizeof(KoblitzElement));
+			} else {
+				mul(next, prefix + i * KOBLITZ_MAX_WORDS, points[i].Z);
+			}
+		}
+
+		KoblitzElement inverse, zInverse, t;
+		inv(inverse, prefix + num * KOBLITZ_MAX_WORDS);	//The inverse of the product of all the Z's.
+		for (int i = num - 1; i >= 0; i--) {
+			result[i].infinity = points[i].infinity;
+			if (points[i].infinity) {
+				continue;
+			}
+			mul(zInverse, inverse, prefix + i * KOBLITZ_MAX_WORDS);	//1/Z_i
+			mul(inverse, inverse, points[i].Z);		//The inverse of the product of the Z's before point i.
+			mul(result[i].x, points[i].X, zInverse);
+			sqr(t, zInverse);
+			mul(result[i].y, points[i].Y, t);
+		}
+	}
+
+	/*
+	 * Computes the scalar multiple of p that is given by the width-w tau-adic NAF digits, least significant first.
+	 * Not constant time, see above.
+	 */
+	void multiply(const KoblitzAffinePoint& p, const signed char* digits, int numDigits, KoblitzAffinePoint& result) const {
+		int numAlphas = getNumAlphas();
+		KoblitzAffinePoint negP;
+		negate(negP, p);
+
+		//Precompute alpha_u * p for every odd u, by the width-2 tau-adic NAF of alpha_u.
+		std::vector<KoblitzLdPoint> precomputedLd(numAlphas);
+		for (int j = 0; j < numAlphas; j++) {
+			const std::vector<signed char>& alpha = alphaDigits[j];
+			precomputedLd[j].infinity = true;
+			for (int i = (int) alpha.size() - 1; i >= 0; i--) {
+				frobenius(precomputedLd[j]);
+				if (alpha[i] != 0) {
+					addMixed(precomputedLd[j], (alpha[i] > 0) ? p : negP);
+				}
+			}
+		}
+		std::vector<KoblitzAffinePoint> precomputed(numAlphas), negPrecomputed(numAlphas);
+		toAffine(precomputedLd.data(), precomputed.data(), numAlphas);
+		for (int j = 0; j < numAlphas; j++) {
+			negate(negPrecomputed[j], precomputed[j]);
+		}
+
+		//Horner's rule with tau instead of doubling.
+		KoblitzLdPoint q;
+		q.infinity = true;
+		for (int i = numDigits - 1; i >= 0; i--) {
+			frobenius(q);
+			int u = digits[i];
+			if (u > 0) {
+				addMixed(q, precomputed[u / 2]);
+			} else if (u < 0) {
+				addMixed(q, negPrecomputed[(-u) / 2]);
+			}
+		}
+		toAffine(&q, &result, 1);
+	}
+};
+
+} // namespace scapi_native
+
+#endif // SCAPI_KOBLITZ_TNAF_H
@@ -0,0 +1,262 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+#ifndef SCAPI_NATIVE_ALLOCATION_REGISTRY_H
+#define SCAPI_NATIVE_ALLOCATION_REGISTRY_H
+
+/*
+ * Accounting of the native objects that are handed to java as jlong pointers.
+ *
+ * Every jni library that includes this header gets its own registry (the class has hidden visibility, otherwise the
+ * registry of get() would be a single symbol shared by all the loaded libraries). The registry is enabled by setting the environment
+ * variable SCAPI_NATIVE_ALLOC_TRACKING=1 before the library is loaded. When it is disabled, tracking an object costs a
+ * single check of a boolean. When it is enabled, the registry keeps the live objects of each type, so that the live count
+ * and bytes of each type can be queried from java (see edu.biu.scapi.generals.NativeAllocationStats).
+ * Setting SCAPI_NATIVE_ALLOC_DUMP=1 also prints the objects that are still alive when the library is unloaded.
+ *
+ * The sizes are the sizes known at the jni level (the object itself and the buffers it is known to own). Memory that is
+ * allocated internally by the underlying libraries is not counted.
+ */
+
+#include <jni.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace scapi_native {
+
+//Number of counters returned to java for each type: live count, live bytes, total allocations, total releases.
+const int NUM_ALLOCATION_COUNTERS = 4;
+
+struct AllocationStats {
+	long long liveCount;
+	long long liveBytes;
+	long long totalAllocations;
+	long long totalReleases;
+
+	AllocationStats() : liveCount(0), liveBytes(0), totalAllocations(0), totalReleases(0) {}
+};
+
+#if defined(__GNUC__) && !defined(_WIN32)
+	#define SCAPI_NATIVE_LIBRARY_LOCAL __attribute__((visibility("hidden")))
+#else
+	#define SCAPI_NATIVE_LIBRARY_LOCAL
+#endif
+
+class SCAPI_NATIVE_LIBRARY_LOCAL NativeAllocationRegistry {
+
+private:
+	struct Entry {
+		const char* type;
+		size_t bytes;
+	};
+
+	bool enabled;
+	bool dumpOnUnload;
+	const char* libraryName;
+	std::mutex lock;
+	std::map<const void*, Entry> liveObjects;
+	std::map<std::string, AllocationStats> stats;
+
+	static bool isSet(const char* variable) {
+		const char* value = getenv(variable);
+		return (value != NULL) && (strcmp(value, "0") != 0) && (value[0] != '\0');
+	}
+
+	NativeAllocationRegistry(const char* library) : libraryName(library) {
+		enabled = isSet("SCAPI_NATIVE_ALLOC_TRACKING");
+		dumpOnUnload = enabled && isSet("SCAPI_NATIVE_ALLOC_DUMP");
+	}
+
+public:
+	~NativeAllocationRegistry() {
+		if (dumpOnUnload) {
+			dump(stderr);
+		}
+	}
+
+	/*
+	 * Returns the registry of this library.
+	 */
+	static NativeAllocationRegistry& get() {
+		static NativeAllocationRegistry registry("scapi");
+		return registry;
+	}
+
+	bool isEnabled() const { return enabled; }
+
+	/*
+	 * Sets the library name that is printed in the dump.
+	 */
+	bool setLibraryName(const char* library) {
+		libraryName = library;
+		return true;
+	}
+
+	/*
+	 * Records that the given object was created and handed to java.
+	 */
+	void add(const void* ptr, const char* type, size_t bytes) {
+		std::lock_guard<std::mutex> guard(lock);
+		std::map<const void*, Entry>::iterator it = liveObjects.find(ptr);
+		if (it != liveObjects.end()) {
+			//The address was reused without a release that we know of, so the previous object has leaked or was freed
+			//by a path that is not tracked. Count it as released so the live numbers stay correct.
+			removeLocked(it);
+		}
+		Entry entry = { type, bytes };
+		liveObjects[ptr] = entry;
+		AllocationStats& typeStats = stats[type];
+		typeStats.liveCount++;
+		typeStats.liveBytes += bytes;
+		typeStats.totalAllocations++;
+	}
+
+	/*
+	 * Records that the given object was deleted. Objects that were not tracked are ignored.
+	 */
+	void remove(const void* ptr) {
+		std::lock_guard<std::mutex> guard(lock);
+		std::map<const void*, Entry>::iterator it = liveObjects.find(ptr);
+		if (it != liveObjects.end()) {
+			removeLocked(it);
+		}
+	}
+
+	/*
+	 * Fills the given vectors with the type names and their statistics.
+	 */
+	void snapshot(std::vector<std::string>& types, std::vector<AllocationStats>& values) {
+		std::lock_guard<std::mutex> guard(lock);
+		for (std::map<std::string, AllocationStats>::iterator it = stats.begin(); it != stats.end(); ++it) {
+			types.push_back(it->first);
+			values.push_back(it->second);
+		}
+	}
+
+	/*
+	 * Prints the statistics of all types that still have live objects.
+	 */
+	void dump(FILE* out) {
+		std::vector<std::string> types;
+		std::vector<AllocationStats> values;
+		snapshot(types, values);
+		for (size_t i = 0; i < types.size(); i++) {
+			if (values[i].liveCount != 0) {
+				fprintf(out, "[%s] %s: %lld live objects, %lld bytes (%lld allocated, %lld released)\n", libraryName,
+						types[i].c_str(), values[i].liveCount, values[i].liveBytes, values[i].totalAllocations, values[i].totalReleases);
+			}
+		}
+	}
+
+private:
+	void removeLocked(std::map<const void*, Entry>::iterator it) {
+		AllocationStats& typeStats = stats[it->second.type];
+		typeStats.liveCount--;
+		typeStats.liveBytes -= it->second.bytes;
+		typeStats.totalReleases++;
+		liveObjects.erase(it);
+	}
+};
+
+/*
+ * Records the given object, if tracking is enabled, and returns it.
+ * Used at the point where a native object is returned to java, e.g. return (long) trackAllocation(point, "EC_POINT", size);
+ */
+template<typename T>
+inline T* trackAllocation(T* ptr, const char* type, size_t bytes = sizeof(T)) {
+	NativeAllocationRegistry& registry = NativeAllocationRegistry::get();
+	if (registry.isEnabled() && ptr != NULL) {
+		registry.add(ptr, type, bytes);
+	}
+	return ptr;
+}
+
+/*
+ * Records that the given object is about to be deleted, if tracking is enabled.
+ */
+inline void trackRelease(const void* ptr) {
+	NativeAllocationRegistry& registry = NativeAllocationRegistry::get();
+	if (registry.isEnabled() && ptr != NULL) {
+		registry.remove(ptr);
+	}
+}
+
+/*
+ * Returns the statistics of the tracked types as a java Object array of two entries: a String array of the type names,
+ * and a long array of NUM_ALLOCATION_COUNTERS counters for each type, in the same order.
+ * Both are taken from a single snapshot of the registry, so a type that is registered meanwhile cannot misalign them.
+ */
+inline jobjectArray getAllocationStats(JNIEnv* env) {
+	std::vector<std::string> types;
+	std::vector<AllocationStats> values;
+	NativeAllocationRegistry::get().snapshot(types, values);
+
+	jobjectArray names = env->NewObjectArray(types.size(), env->FindClass("java/lang/String"), NULL);
+	for (size_t i = 0; i < types.size(); i++) {
+		jstring name = env->NewStringUTF(types[i].c_str());
+		env->SetObjectArrayElement(names, i, name);
+		env->DeleteLocalRef(name);
+	}
+
+	std::vector<jlong> counters;
+	for (size_t i = 0; i < values.size(); i++) {
+		counters.push_back(values[i].liveCount);
+		counters.push_back(values[i].liveBytes);
+		counters.push_back(values[i].totalAllocations);
+		counters.push_back(values[i].totalReleases);
+	}
+	jlongArray counterArray = env->NewLongArray(counters.size());
+	if (!counters.empty()) {
+		env->SetLongArrayRegion(counterArray, 0, counters.size(), counters.data());
+	}
+
+	jobjectArray result = env->NewObjectArray(2, env->FindClass("java/lang/Object"), NULL);
+	env->SetObjectArrayElement(result, 0, names);
+	env->SetObjectArrayElement(result, 1, counterArray);
+	return result;
+}
+
+} // namespace scapi_native
+
+/*
+ * Defines the jni functions that return the statistics of the including library to java.
+ * Should be used once in each library, with the library name as used in NativeAllocationStats.Library, for example:
+ * DEFINE_NATIVE_ALLOCATION_STATS(OpenSSL)
+ */
+#define DEFINE_NATIVE_ALLOCATION_STATS(library) \
+	extern "C" JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_generals_NativeAllocationStats_get##library##Stats(JNIEnv* env, jclass) { \
+		return scapi_native::getAllocationStats(env); \
+	} \
+	extern "C" JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_generals_NativeAllocationStats_is##library##TrackingEnabled(JNIEnv*, jclass) { \
+		return scapi_native::NativeAllocationRegistry::get().isEnabled(); \
+	} \
+	static const bool scapi_native_registry_named = scapi_native::NativeAllocationRegistry::get().setLibraryName(#library);
+
+#endif // SCAPI_NATIVE_ALLOCATION_REGISTRY_H
@@ -0,0 +1,88 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+
+#ifndef SCAPI_NATIVE_REGISTRATION_H
+#define SCAPI_NATIVE_REGISTRATION_H
+
+/*
+ * Explicit registration of the native methods of a jni library.
+ *
+ * Without registration, the jvm resolves every native method by looking up its mangled Java_* symbol the first time the
+ * method is called. A library that includes this header defines a table of its classes and methods and registers them
+ * from JNI_OnLoad, so all the methods are bound once, when the library is loaded.
+ * The Java_* functions remain exported, so a class that cannot be registered (for example, a class that is not in the
+ * classpath) still works through the symbol lookup. Setting the environment variable SCAPI_JNI_REGISTER_NATIVES=0
+ * disables the registration.
+ */
+
+#include <jni.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Some versions of jni.h declare the name and signature of JNINativeMethod as char*.
+#define SCAPI_NATIVE_METHOD(name, signature, function) { const_cast<char*>(name), const_cast<char*>(signature), (void*) function }
+#define SCAPI_NATIVE_CLASS(className, methods) { className, methods, sizeof(methods) / sizeof(methods[0]) }
+
+namespace scapi_native {
+
+struct NativeClassMethods {
+	const char* className;
+	const JNINativeMethod* methods;
+	int numMethods;
+};
+
+/*
+ * Registers the methods of the given classes. Should be called from JNI_OnLoad and its result returned from it.
+ * A class that cannot be found or registered is skipped, and its methods are left to the symbol lookup of the jvm.
+ */
+inline jint registerNativeClasses(JavaVM* vm, const NativeClassMethods* classes, int numClasses) {
+	JNIEnv* env;
+	if (vm->GetEnv((void**) &env, JNI_VERSION_1_6) != JNI_OK) {
+		return JNI_ERR;
+	}
+
+	const char* value = getenv("SCAPI_JNI_REGISTER_NATIVES");
+	if (value != NULL && strcmp(value, "0") == 0) {
+		return JNI_VERSION_1_6;
+	}
+
+	for (int i = 0; i < numClasses; i++) {
+		jclass clazz = env->FindClass(classes[i].className);
+		if (clazz == NULL) {
+			env->ExceptionClear();
+			continue;
+		}
+		if (env->RegisterNatives(clazz, classes[i].methods, classes[i].numMethods) != 0) {
+			env->ExceptionClear();
+		}
+		env->DeleteLocalRef(clazz);
+	}
+	return JNI_VERSION_1_6;
+}
+
+} // namespace scapi_native
+
+#endif // SCAPI_NATIVE_REGISTRATION_H
@@ -0,0 +1,61 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+
+#ifndef SCAPI_PROBES_H
+#define SCAPI_PROBES_H
+
+/*
+ * Static user space tracepoints (USDT) for the hot native paths.
+ *
+ * The probes are compiled in when <sys/sdt.h> is available (the systemtap-sdt-dev / systemtap-sdt-devel package),
+ * unless SCAPI_DISABLE_PROBES is defined. A probe that is not attached is a single nop instruction, so the probes
+ * can stay in production builds. They are attached by perf, bpftrace or systemtap under the provider name "scapi",
+ * e.g. scripts/scapi_latency.bt prints a latency histogram of each operation.
+ *
+ * Each operation fires <name>_start and <name>_done probes from the same thread, with the sizes of the operation
+ * (number of gates, number of OTs, etc.) as arguments. All arguments are 64 bit integers.
+ */
+
+#if !defined(SCAPI_DISABLE_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SCAPI_PROBES_ENABLED 1
+#endif
+#endif
+
+#ifdef SCAPI_PROBES_ENABLED
+#define SCAPI_PROBE(name) DTRACE_PROBE(scapi, name)
+#define SCAPI_PROBE1(name, a1) DTRACE_PROBE1(scapi, name, (long long) (a1))
+#define SCAPI_PROBE2(name, a1, a2) DTRACE_PROBE2(scapi, name, (long long) (a1), (long long) (a2))
+#define SCAPI_PROBE3(name, a1, a2, a3) DTRACE_PROBE3(scapi, name, (long long) (a1), (long long) (a2), (long long) (a3))
+#else
+#define SCAPI_PROBE(name) do {} while (0)
+#define SCAPI_PROBE1(name, a1) do {} while (0)
+#define SCAPI_PROBE2(name, a1, a2) do {} while (0)
+#define SCAPI_PROBE3(name, a1, a2, a3) do {} while (0)
+#endif
+
+#endif // SCAPI_PROBES_H
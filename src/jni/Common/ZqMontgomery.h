@@ -0,0 +1,239 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+#ifndef SCAPI_ZQ_MONTGOMERY_H
+#define SCAPI_ZQ_MONTGOMERY_H
+
+/*
+ * Arithmetic modulo an odd q of up to ZQ_MAX_WORDS 64 bit words (576 bits, which covers the orders of the NIST curves up to
+ * P-521), over packed vectors of elements.
+ *
+ * An element is kept as a fixed number of little endian 64 bit words. Multiplications use the Montgomery representation
+ * internally (CIOS, Koc et al., "Analyzing and Comparing Montgomery Multiplication Algorithms"), but all the public
+ * operations take and return elements in the normal representation. The operations do not branch on the values of the
+ * elements, since the elements are usually secrets such as witnesses and randomness.
+ */
+
+#include <string.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace scapi_native {
+
+const int ZQ_MAX_WORDS = 9;
+
+/*
+ * Returns the low word of a*b + c + d and puts the high word in hi. The result always fits in 128 bits.
+ */
+inline uint64_t zqMulAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 t = (unsigned __int128) a * b + c + d;
+	hi = (uint64_t) (t >> 64);
+	return (uint64_t) t;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	uint64_t high;
+	uint64_t low = _umul128(a, b, &high);
+	unsigned char carry = _addcarry_u64(0, low, c, &low);
+	_addcarry_u64(carry, high, 0, &high);
+	carry = _addcarry_u64(0, low, d, &low);
+	_addcarry_u64(carry, high, 0, &high);
+	hi = high;
+	return low;
+#else
+	uint64_t a0 = (uint32_t) a, a1 = a >> 32, b0 = (uint32_t) b, b1 = b >> 32;
+	uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+	uint64_t middle = (p00 >> 32) + (uint32_t) p01 + (uint32_t) p10;
+	uint64_t low = (middle << 32) | (uint32_t) p00;
+	uint64_t high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+	low += c;
+	high += (low < c);
+	low += d;
+	high += (low < d);
+	hi = high;
+	return low;
+#endif
+}
+
+class ZqMontgomery {
+
+private:
+	int words;							//The number of words of an element.
+	uint64_t q[ZQ_MAX_WORDS];
+	uint64_t qInv;						//-q^-1 mod 2^64.
+	uint64_t r2[ZQ_MAX_WORDS];			//R^2 mod q, where R = 2^(64*words).
+	uint64_t one[ZQ_MAX_WORDS];
+
+	/*
+	 * r = x - y and returns the borrow.
+	 */
+	uint64_t subtract(uint64_t* r, const uint64_t* x, const uint64_t* y) const {
+		uint64_t borrow = 0;
+		for (int i = 0; i < words; i++) {
+			uint64_t xi = x[i], yi = y[i];
+			uint64_t d = xi - yi;
+			uint64_t b1 = (xi < yi);
+			r[i] = d - borrow;
+			borrow = b1 | (d < borrow);
+		}
+		return borrow;
+	}
+
+	/*
+	 * Reduces x, which is smaller than 2q, given the bit above its top word.
+	 */
+	void reduceOnce(uint64_t* r, const uint64_t* x, uint64_t top) const {
+		uint64_t t[ZQ_MAX_WORDS];
+		uint64_t borrow = subtract(t, x, q);
+		//Keep x if x < q, that is, there was a borrow that the top bit does not cover.
+		uint64_t keep = (uint64_t) 0 - (borrow & (top ^ 1));
+		for (int i = 0; i < words; i++) {
+			r[i] = (x[i] & keep) | (t[i] & ~keep);
+		}
+	}
+
+	/*
+	 * r = x*y/R mod q, for x, y < q.
+	 */
+	void montMul(uint64_t* r, const uint64_t* x, const uint64_t* y) const {
+		uint64_t t[ZQ_MAX_WORDS + 2];
+		memset(t, 0, sizeof(t));
+		for (int i = 0; i < words; i++) {
+			uint64_t carry = 0;
+			for (int j = 0; j < words; j++) {
+				t[j] = zqMulAdd(x[j], y[i], t[j], carry, carry);
+			}
+			uint64_t sum = t[words] + carry;
+			t[words + 1] = (sum < carry);
+			t[words] = sum;
+
+			uint64_t m = t[0] * qInv;
+			zqMulAdd(m, q[0], t[0], 0, carry);
+			for (int j = 1; j < words; j++) {
+				t[j - 1] = zqMulAdd(m, q[j], t[j], carry, carry);
+			}
+			sum = t[words] + carry;
+			t[words - 1] = sum;
+			t[words] = t[words + 1] + (sum < carry);
+		}
+		reduceOnce(r, t, t[words]);
+	}
+
+public:
+	/*
+	 * Creates the arithmetic modulo q. q must be odd, given as little endian words.
+	 * r2 is R^2 mod q, which the caller computes with its big number library.
+	 */
+	ZqMontgomery(const uint64_t* modulus, const uint64_t* rSquare, int numWords) : words(numWords) {
+		memset(this->q, 0, sizeof(this->q));
+		memset(this->r2, 0, sizeof(this->r2));
+		memset(this->one, 0, sizeof(this->one));
+		memcpy(this->q, modulus, words * sizeof(uint64_t));
+		memcpy(this->r2, rSquare, words * sizeof(uint64_t));
+		one[0] = 1;
+
+		//Newton iteration for q^-1 mod 2^64. Each step doubles the number of correct bits, starting from 3.
+		uint64_t inv = q[0];
+		for (int i = 0; i < 5; i++) {
+			inv *= 2 - q[0] * inv;
+		}
+		qInv = (uint64_t) 0 - inv;
+	}
+
+	int getWords() const { return words; }
+
+	/*
+	 * Returns true if x < q.
+	 */
+	bool isReduced(const uint64_t* x) const {
+		uint64_t t[ZQ_MAX_WORDS];
+		return subtract(t, x, q) == 1;
+	}
+
+	void add(uint64_t* r, const uint64_t* x, const uint64_t* y) const {
+		uint64_t t[ZQ_MAX_WORDS];
+		uint64_t carry = 0;
+		for (int i = 0; i < words; i++) {
+			uint64_t s = x[i] + carry;
+			uint64_t c1 = (s < carry);
+			t[i] = s + y[i];
+			carry = c1 | (t[i] < s);
+		}
+		reduceOnce(r, t, carry);
+	}
+
+	void sub(uint64_t* r, const uint64_t* x, const uint64_t* y) const {
+		uint64_t t[ZQ_MAX_WORDS];
+		uint64_t borrow = subtract(t, x, y);
+		//Add q back if there was a borrow.
+		uint64_t mask = (uint64_t) 0 - borrow;
+		uint64_t carry = 0;
+		for (int i = 0; i < words; i++) {
+			uint64_t s = t[i] + carry;
+			uint64_t c1 = (s < carry);
+			r[i] = s + (q[i] & mask);
+			carry = c1 | (r[i] < s);
+		}
+	}
+
+	void mul(uint64_t* r, const uint64_t* x, const uint64_t* y) const {
+		uint64_t t[ZQ_MAX_WORDS];
+		montMul(t, x, y);		//x*y/R
+		montMul(r, t, r2);		//x*y
+	}
+
+	/*
+	 * r = x*y + z.
+	 */
+	void mulAdd(uint64_t* r, const uint64_t* x, const uint64_t* y, const uint64_t* z) const {
+		uint64_t t[ZQ_MAX_WORDS];
+		mul(t, x, y);
+		add(r, t, z);
+	}
+
+	/*
+	 * Converts x to the Montgomery representation x*R and back.
+	 */
+	void toMontgomery(uint64_t* r, const uint64_t* x) const {
+		montMul(r, x, r2);
+	}
+
+	void fromMontgomery(uint64_t* r, const uint64_t* x) const {
+		montMul(r, x, one);
+	}
+
+	/*
+	 * Multiplication of two elements in the Montgomery representation.
+	 */
+	void mulMontgomery(uint64_t* r, const uint64_t* x, const uint64_t* y) const {
+		montMul(r, x, y);
+	}
+};
+
+} // namespace scapi_native
+
+#endif // SCAPI_ZQ_MONTGOMERY_H
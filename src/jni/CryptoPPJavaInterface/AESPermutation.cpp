@@ -37,6 +37,8 @@
 
 // local includes
 #include "AESPermutation.h"
+#include "../Common/CounterBlocks.h"
+#include "../Common/CbcChains.h"
 
 using namespace std;
 using namespace CryptoPP;
@@ -133,3 +135,70 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_de
 	  delete((AESEncryption*)aesCompute);
 	  delete((AESEncryption*)aesInvert);
 }
+
+/*
+ * Computes AES on the counter blocks ctr, ctr+1, ... and writes the first outLen bytes of the results to outBytes, from outOffset.
+ * Each chunk of counter blocks is encrypted with one AdvancedProcessBlocks call, that pipelines the blocks with AES-NI when available.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeCounterBlocks
+  (JNIEnv *env, jobject, jlong aes, jbyteArray ctr, jbyteArray outBytes, jint outOffset, jint outLen){
+
+	  AESEncryption* aesEncryption = (AESEncryption*)aes;
+	  const int blockSize = AESEncryption::BLOCKSIZE;
+	  byte counter[blockSize];
+	  env->GetByteArrayRegion(ctr, 0, blockSize, (jbyte*)counter);
+
+	  byte* inChunk = new byte[scapi_native::COUNTER_CHUNK_BLOCKS * blockSize];
+	  byte* outChunk = new byte[scapi_native::COUNTER_CHUNK_BLOCKS * blockSize];
+	  int numBlocks = (outLen + blockSize - 1) / blockSize;
+	  int generated = 0;
+
+	  while (numBlocks > 0){
+		  int chunkBlocks = (numBlocks < scapi_native::COUNTER_CHUNK_BLOCKS) ? numBlocks : scapi_native::COUNTER_CHUNK_BLOCKS;
+		  scapi_native::fillCounterBlocks(inChunk, counter, chunkBlocks, blockSize);
+
+		  aesEncryption->AdvancedProcessBlocks(inChunk, NULL, outChunk, chunkBlocks * blockSize, 0);
+
+		  //The last block may be copied partially.
+		  int toCopy = (outLen - generated < chunkBlocks * blockSize) ? outLen - generated : chunkBlocks * blockSize;
+		  env->SetByteArrayRegion(outBytes, outOffset + generated, toCopy, (jbyte*)outChunk);
+		  generated += toCopy;
+		  numBlocks -= chunkBlocks;
+	  }
+
+	  delete [] inChunk;
+	  delete [] outChunk;
+}
+
+/*
+ * Encrypts consecutive blocks in place with one AdvancedProcessBlocks call.
+ */
+struct CryptoPPEncryptBlocks {
+	AESEncryption* aes;
+
+	void operator()(unsigned char* blocks, int numBlocks) {
+		aes->AdvancedProcessBlocks(blocks, NULL, blocks, numBlocks * scapi_native::CBC_BLOCK_SIZE, 0);
+	}
+};
+
+/*
+ * Computes the CBC chains of numMsgs messages of msgLen bytes each, starting from the given iv, and writes the final chaining 
+ * value of each message to outBytes, from outOffset. The last block of each message is padded with zeros.
+ * Up to 8 chains are encrypted together with one AdvancedProcessBlocks call, that interleaves them with AES-NI when available.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeCbcChains
+  (JNIEnv *env, jobject, jlong aes, jbyteArray iv, jbyteArray inBytes, jint inOffset, jint msgLen, jint numMsgs, jbyteArray outBytes, jint outOffset){
+
+	  unsigned char chainIv[scapi_native::CBC_BLOCK_SIZE];
+	  env->GetByteArrayRegion(iv, 0, scapi_native::CBC_BLOCK_SIZE, (jbyte*)chainIv);
+
+	  //No jni calls are made while the arrays are held, so the critical versions can be used and the messages are not copied.
+	  unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(inBytes, 0);
+	  unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(outBytes, 0);
+
+	  CryptoPPEncryptBlocks encryptBlocks = { (AESEncryption*)aes };
+	  scapi_native::computeCbcChains(encryptBlocks, chainIv, in + inOffset, msgLen, numMsgs, out + outOffset);
+
+	  env->ReleasePrimitiveArrayCritical(outBytes, out, 0);
+	  env->ReleasePrimitiveArrayCritical(inBytes, in, JNI_ABORT);
+}
@@ -91,6 +91,22 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_ge
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_deleteAES
   (JNIEnv *, jobject, jlong, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES
+ * Method:    computeCounterBlocks
+ * Signature: (J[B[BII)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeCounterBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES
+ * Method:    computeCbcChains
+ * Signature: (J[B[BIII[BI)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeCbcChains
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint, jint, jbyteArray, jint);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,7 +26,148 @@
 //
 
 #include "StdAfx.h"
+#include <jni.h>
+#include "../Common/NativeRegistration.h"
+#include "AESPermutation.h"
+#include "CollisionResistantHash.h"
+#include "DlogElement.h"
+#include "DlogGroup.h"
+#include "RSAOaep.h"
+#include "RSAPermutation.h"
+#include "RSAPss.h"
+#include "RabinPermutation.h"
+#include "TPElement.h"
 
+static const JNINativeMethod cryptoPPRSAPssMethods[] = {
+	SCAPI_NATIVE_METHOD("createRSASigner", "()J", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_CryptoPPRSAPss_createRSASigner),
+	SCAPI_NATIVE_METHOD("createRSAVerifier", "()J", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_CryptoPPRSAPss_createRSAVerifier),
+	SCAPI_NATIVE_METHOD("initRSAVerifier", "(J[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_CryptoPPRSAPss_initRSAVerifier),
+	SCAPI_NATIVE_METHOD("initRSACrtSigner", "(J[B[B[B[B[B[B[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_CryptoPPRSAPss_initRSACrtSigner),
+	SCAPI_NATIVE_METHOD("initRSASigner", "(J[B[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_CryptoPPRSAPss_initRSASigner),
+	SCAPI_NATIVE_METHOD("doSign", "(J[BI)[B", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_CryptoPPRSAPss_doSign),
+	SCAPI_NATIVE_METHOD("doVerify", "(J[B[BI)Z", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_CryptoPPRSAPss_doVerify),
+	SCAPI_NATIVE_METHOD("deleteRSA", "(JJ)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_CryptoPPRSAPss_deleteRSA)
+};
+
+static const JNINativeMethod cryptoPPRSAOaepMethods[] = {
+	SCAPI_NATIVE_METHOD("createRSAEncryptor", "()J", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_createRSAEncryptor),
+	SCAPI_NATIVE_METHOD("createRSADecryptor", "()J", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_createRSADecryptor),
+	SCAPI_NATIVE_METHOD("initRSAEncryptor", "(J[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_initRSAEncryptor),
+	SCAPI_NATIVE_METHOD("initRSADecryptor", "(J[B[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_initRSADecryptor),
+	SCAPI_NATIVE_METHOD("initRSACrtDecryptor", "(J[B[B[B[B[B[B[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_initRSACrtDecryptor),
+	SCAPI_NATIVE_METHOD("doEncrypt", "(J[B)[B", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_doEncrypt),
+	SCAPI_NATIVE_METHOD("doDecrypt", "(J[B)[B", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_doDecrypt),
+	SCAPI_NATIVE_METHOD("getPlaintextLength", "(J)I", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_getPlaintextLength),
+	SCAPI_NATIVE_METHOD("deleteRSA", "(JJ)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_CryptoPPRSAOaep_deleteRSA)
+};
+
+static const JNINativeMethod cryptoPpDlogZpSafePrimeMethods[] = {
+	SCAPI_NATIVE_METHOD("createDlogZp", "([B[B[B)J", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_createDlogZp),
+	SCAPI_NATIVE_METHOD("createRandomDlogZp", "(I)J", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_createRandomDlogZp),
+	SCAPI_NATIVE_METHOD("getGenerator", "(J)J", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_getGenerator),
+	SCAPI_NATIVE_METHOD("getP", "(J)[B", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_getP),
+	SCAPI_NATIVE_METHOD("getQ", "(J)[B", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_getQ),
+	SCAPI_NATIVE_METHOD("inverseElement", "(JJ)J", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_inverseElement),
+	SCAPI_NATIVE_METHOD("exponentiateElement", "(JJ[B)J", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_exponentiateElement),
+	SCAPI_NATIVE_METHOD("multiplyElements", "(JJJ)J", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_multiplyElements),
+	SCAPI_NATIVE_METHOD("validateZpGroup", "(J)Z", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_validateZpGroup),
+	SCAPI_NATIVE_METHOD("validateZpGenerator", "(J)Z", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_validateZpGenerator),
+	SCAPI_NATIVE_METHOD("validateZpElement", "(JJ)Z", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_validateZpElement),
+	SCAPI_NATIVE_METHOD("deleteDlogZp", "(J)V", Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_deleteDlogZp)
+};
+
+static const JNINativeMethod zpSafePrimeElementCryptoPpMethods[] = {
+	SCAPI_NATIVE_METHOD("getPointerToElement", "([B)J", Java_edu_biu_scapi_primitives_dlog_cryptopp_ZpSafePrimeElementCryptoPp_getPointerToElement),
+	SCAPI_NATIVE_METHOD("getElement", "(J)[B", Java_edu_biu_scapi_primitives_dlog_cryptopp_ZpSafePrimeElementCryptoPp_getElement),
+	SCAPI_NATIVE_METHOD("deleteElement", "(J)J", Java_edu_biu_scapi_primitives_dlog_cryptopp_ZpSafePrimeElementCryptoPp_deleteElement)
+};
+
+static const JNINativeMethod cryptoPpHashMethods[] = {
+	SCAPI_NATIVE_METHOD("createHash", "(Ljava/lang/String;)J", Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_createHash),
+	SCAPI_NATIVE_METHOD("algName", "(J)Ljava/lang/String;", Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_algName),
+	SCAPI_NATIVE_METHOD("updateHash", "(J[BJ)V", Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_updateHash),
+	SCAPI_NATIVE_METHOD("finalHash", "(J[B)V", Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_finalHash),
+	SCAPI_NATIVE_METHOD("getDigestSize", "(J)I", Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_getDigestSize),
+	SCAPI_NATIVE_METHOD("deleteHash", "(J)V", Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_deleteHash)
+};
+
+static const JNINativeMethod cryptoPpAESMethods[] = {
+	SCAPI_NATIVE_METHOD("createAESCompute", "()J", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_createAESCompute),
+	SCAPI_NATIVE_METHOD("createAESInvert", "()J", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_createAESInvert),
+	SCAPI_NATIVE_METHOD("setNativeKey", "(JJ[B)V", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_setNativeKey),
+	SCAPI_NATIVE_METHOD("computeBlock", "(J[B[BIZ)V", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeBlock),
+	SCAPI_NATIVE_METHOD("optimizedCompute", "(J[B[BZ)V", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_optimizedCompute),
+	SCAPI_NATIVE_METHOD("getName", "(J)Ljava/lang/String;", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_getName),
+	SCAPI_NATIVE_METHOD("getBlockSize", "(J)I", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_getBlockSize),
+	SCAPI_NATIVE_METHOD("deleteAES", "(JJ)V", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_deleteAES),
+	SCAPI_NATIVE_METHOD("computeCounterBlocks", "(J[B[BII)V", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeCounterBlocks),
+	SCAPI_NATIVE_METHOD("computeCbcChains", "(J[B[BIII[BI)V", Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeCbcChains)
+};
+
+static const JNINativeMethod cryptoPpRSAElementMethods[] = {
+	SCAPI_NATIVE_METHOD("getPointerToRandomRSAElement", "([B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAElement_getPointerToRandomRSAElement)
+};
+
+static const JNINativeMethod cryptoPpRSAPermutationMethods[] = {
+	SCAPI_NATIVE_METHOD("initRSAPublicPrivate", "([B[B[B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_initRSAPublicPrivate),
+	SCAPI_NATIVE_METHOD("initRSAPublicPrivateCrt", "([B[B[B[B[B[B[B[B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_initRSAPublicPrivateCrt),
+	SCAPI_NATIVE_METHOD("initRSAPublic", "([B[B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_initRSAPublic),
+	SCAPI_NATIVE_METHOD("loadRSAName", "(J)Ljava/lang/String;", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_loadRSAName),
+	SCAPI_NATIVE_METHOD("checkRSAValidity", "(JJ)Z", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_checkRSAValidity),
+	SCAPI_NATIVE_METHOD("computeRSA", "(JJ)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_computeRSA),
+	SCAPI_NATIVE_METHOD("invertRSA", "(JJ)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_invertRSA),
+	SCAPI_NATIVE_METHOD("deleteRSA", "(J)V", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_deleteRSA)
+};
+
+static const JNINativeMethod cryptoPpRabinElementMethods[] = {
+	SCAPI_NATIVE_METHOD("getPointerToRandomRabinElement", "([B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinElement_getPointerToRandomRabinElement)
+};
+
+static const JNINativeMethod cryptoPpRabinPermutationMethods[] = {
+	SCAPI_NATIVE_METHOD("initRabinPublicPrivate", "([B[B[B[B[B[B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_initRabinPublicPrivate),
+	SCAPI_NATIVE_METHOD("initRabinPublic", "([B[B[B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_initRabinPublic),
+	SCAPI_NATIVE_METHOD("initRabinRandomly", "(I)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_initRabinRandomly),
+	SCAPI_NATIVE_METHOD("loadRabinName", "(J)Ljava/lang/String;", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_loadRabinName),
+	SCAPI_NATIVE_METHOD("getRabinModulus", "(J)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_getRabinModulus),
+	SCAPI_NATIVE_METHOD("getPrime1", "(J)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_getPrime1),
+	SCAPI_NATIVE_METHOD("getPrime2", "(J)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_getPrime2),
+	SCAPI_NATIVE_METHOD("getinversePModQ", "(J)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_getinversePModQ),
+	SCAPI_NATIVE_METHOD("getQuadraticResidueModPrime1", "(J)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_getQuadraticResidueModPrime1),
+	SCAPI_NATIVE_METHOD("getQuadraticResidueModPrime2", "(J)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_getQuadraticResidueModPrime2),
+	SCAPI_NATIVE_METHOD("checkRabinValidity", "(JJ)Z", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_checkRabinValidity),
+	SCAPI_NATIVE_METHOD("computeRabin", "(JJ)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_computeRabin),
+	SCAPI_NATIVE_METHOD("invertRabin", "(JJ)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_invertRabin),
+	SCAPI_NATIVE_METHOD("deleteRabin", "(J)V", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_deleteRabin)
+};
+
+static const JNINativeMethod cryptoPpTrapdoorElementMethods[] = {
+	SCAPI_NATIVE_METHOD("getPointerToElement", "([B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpTrapdoorElement_getPointerToElement),
+	SCAPI_NATIVE_METHOD("getElement", "(J)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpTrapdoorElement_getElement),
+	SCAPI_NATIVE_METHOD("deleteElement", "(J)V", Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpTrapdoorElement_deleteElement)
+};
+
+static const scapi_native::NativeClassMethods nativeClasses[] = {
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/midLayer/asymmetricCrypto/digitalSignature/CryptoPPRSAPss", cryptoPPRSAPssMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/midLayer/asymmetricCrypto/encryption/CryptoPPRSAOaep", cryptoPPRSAOaepMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/cryptopp/CryptoPpDlogZpSafePrime", cryptoPpDlogZpSafePrimeMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/cryptopp/ZpSafePrimeElementCryptoPp", zpSafePrimeElementCryptoPpMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/hash/cryptopp/CryptoPpHash", cryptoPpHashMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/prf/cryptopp/CryptoPpAES", cryptoPpAESMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/trapdoorPermutation/cryptopp/CryptoPpRSAElement", cryptoPpRSAElementMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/trapdoorPermutation/cryptopp/CryptoPpRSAPermutation", cryptoPpRSAPermutationMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/trapdoorPermutation/cryptopp/CryptoPpRabinElement", cryptoPpRabinElementMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/trapdoorPermutation/cryptopp/CryptoPpRabinPermutation", cryptoPpRabinPermutationMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/trapdoorPermutation/cryptopp/CryptoPpTrapdoorElement", cryptoPpTrapdoorElementMethods)
+};
+
+/*
+ * function JNI_OnLoad	: Registers the native methods of the library when it is loaded by the jvm.
+ */
+extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*){
+	return scapi_native::registerNativeClasses(vm, nativeClasses, sizeof(nativeClasses) / sizeof(nativeClasses[0]));
+}
+
+#ifdef _WIN32
 BOOL APIENTRY DllMain( HANDLE hModule, 
                        DWORD  ul_reason_for_call, 
                        LPVOID lpReserved
@@ -35,5 +176,4 @@ BOOL APIENTRY DllMain( HANDLE hModule,
 
     return TRUE;
 }
-
-
+#endif
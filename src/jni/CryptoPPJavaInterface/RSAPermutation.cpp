@@ -53,7 +53,7 @@ using namespace CryptoPP;
  * param privExp			: private exponent (d)
  * return jlong				: pointer to the native object
  */
-JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_initRSAWithPublicPrivate
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_initRSAPublicPrivate
   (JNIEnv *env, jobject, jbyteArray modulus, jbyteArray pubExp, jbyteArray privExp) {
 	  
 	  Integer n, e, d;
@@ -257,7 +257,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 /*
  * Delete the native object
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpTrapdoorPermutation_deleteRSA
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_deleteRSA
 	(JNIEnv *, jobject, jlong tpPtr) {
 		delete((RSAFunction*) tpPtr);
 }
@@ -361,7 +361,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 /*
  * Delete the native object
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpTrapdoorPermutation_deleteRabin
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_deleteRabin
 	(JNIEnv *, jobject, jlong tpPtr) {
 		delete((RabinFunction*) tpPtr);
 }
@@ -0,0 +1,131 @@
+#ifndef LIBSCAPIJAVAINTERFACE_GMWHANDLER_H
+#define LIBSCAPIJAVAINTERFACE_GMWHANDLER_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <libscapi/protocols/GMW/GMWParty.h>
+
+/**
+ * This class holds the GMW party and the state of its offline phase.
+ * A pointer to this class is sent to the java object as the pointer to the native implementation.
+ *
+ * The offline phase generates the multiplication triples of one execution, and the online phase consumes them.
+ * The triples are kept inside the party, so at most one offline phase can be done ahead of the online phase.
+ * When executions are set to be preprocessed ahead, the offline phase of the next execution is started in a background
+ * thread as soon as an online phase ends, except after the last of these executions, so the next online phase only has
+ * to wait for the communication rounds of the circuit.
+ * Both parties should use the same setting, since the offline phase is interactive.
+ */
+class GMWHandler {
+private:
+	GMWParty* party;
+	int executionsAhead;				//Number of the next executions that are followed by a background offline phase.
+	bool offlineReady;					//True if the triples of the next execution were generated.
+	bool offlineRunning;				//True while an offline phase runs (in the background thread or in runOffline).
+	std::exception_ptr offlineError;	//The failure of the background offline phase, thrown by the next runOffline/runOnline.
+	std::thread background;
+	std::mutex lock;
+	std::condition_variable offlineDone;
+
+	//Starts the offline phase of the next execution in a background thread. Should be called with the lock held.
+	void startBackgroundOffline() {
+		if (background.joinable()) {
+			//The previous offline phase has already finished (offlineRunning is false), only its thread is left.
+			background.join();
+		}
+		offlineRunning = true;
+		background = std::thread([this] {
+			std::exception_ptr error;
+			try {
+				party->runOffline();
+			} catch (...) {
+				error = std::current_exception();
+			}
+			std::lock_guard<std::mutex> guard(lock);
+			offlineRunning = false;
+			offlineReady = !error;
+			offlineError = error;
+			offlineDone.notify_all();
+		});
+	}
+
+public:
+	GMWHandler(GMWParty* party) : party(party), executionsAhead(0), offlineReady(false), offlineRunning(false) {}
+
+	~GMWHandler() {
+		if (background.joinable()) {
+			background.join();
+		}
+		delete party;
+	}
+
+	/**
+	 * Sets the number of the next executions whose online phase is followed by the offline phase of the execution after
+	 * them. The offline phase is not started after the last of them, so 0 disables the background offline phase.
+	 */
+	void setPreprocessAhead(int executions) {
+		std::lock_guard<std::mutex> guard(lock);
+		executionsAhead = executions;
+	}
+
+	bool isOfflineReady() {
+		std::lock_guard<std::mutex> guard(lock);
+		return offlineReady;
+	}
+
+	/**
+	 * Generates the triples of the next execution, unless they were already generated (or are being generated).
+	 * Throws the failure of the background offline phase, if it failed.
+	 */
+	void runOffline() {
+		std::unique_lock<std::mutex> guard(lock);
+		offlineDone.wait(guard, [this] { return !offlineRunning; });
+		if (offlineError) {
+			std::exception_ptr error = offlineError;
+			offlineError = nullptr;
+			std::rethrow_exception(error);
+		}
+		if (offlineReady) {
+			return;
+		}
+
+		//The lock is not held during the offline phase itself, so that isOfflineReady and setPreprocessAhead do not block.
+		offlineRunning = true;
+		guard.unlock();
+		try {
+			party->runOffline();
+		} catch (...) {
+			guard.lock();
+			offlineRunning = false;
+			offlineDone.notify_all();
+			throw;
+		}
+		guard.lock();
+		offlineRunning = false;
+		offlineReady = true;
+		offlineDone.notify_all();
+	}
+
+	/**
+	 * Runs the online phase on the triples of the offline phase (running the offline phase first if needed).
+	 */
+	vector<byte> runOnline() {
+		runOffline();
+		{
+			//The online phase consumes the triples even if it fails, so a failed run is followed by a fresh offline phase.
+			std::lock_guard<std::mutex> guard(lock);
+			offlineReady = false;
+		}
+		auto output = party->runOnline();
+
+		std::lock_guard<std::mutex> guard(lock);
+		if (executionsAhead > 0 && --executionsAhead > 0) {
+			startBackgroundOffline();
+		}
+		return output;
+	}
+};
+
+#endif //LIBSCAPIJAVAINTERFACE_GMWHANDLER_H
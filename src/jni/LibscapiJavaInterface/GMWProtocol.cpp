@@ -2,7 +2,8 @@
 // Created by moriya on 31/01/17.
 //
 #include "GMWProtocol.h"
-#include <libscapi/protocols/GMW/GMWParty.h>
+#include "GMWHandler.h"
+#include "ProtocolFailure.h"
 #include <libscapi/protocols/GMW/Circuit.h>
 
 /**
@@ -25,18 +26,22 @@ cout<<"after circuit"<<endl;
     GMWParty* party = new GMWParty(id, circuit, partiesFile, numThreads, inputFile);
 	
 	//Return a pointer to the protocol object.
-    return (long) party;
+    return (long) new GMWHandler(party);
 }
 
 /**
- * Run the GMW protocol - offline then online. 
+ * Run the GMW protocol - offline (unless it was already done) then online. 
  */
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runProtocol
-		(JNIEnv *env, jobject, jlong party){
+		(JNIEnv *env, jobject, jlong handler){
 
-	//Run the protocol/
-    ((GMWParty*)party)->runOffline();
-    auto output = ((GMWParty*)party)->runOnline();
+	vector<byte> output;
+	try {
+		output = ((GMWHandler*)handler)->runOnline();
+	} catch (...) {
+		throwProtocolFailure(env, "the GMW protocol failed");
+		return NULL;
+	}
 	
 	//Create a jni object and fill it with the protocol output.
 	jbyteArray result = env->NewByteArray(output.size());
@@ -46,10 +51,39 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runProtocol
 	return result;
 }
 
+/**
+ * Run the offline phase of the next execution - generates the multiplication triples.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runOffline
+		(JNIEnv *env, jobject, jlong handler){
+
+	try {
+		((GMWHandler*)handler)->runOffline();
+	} catch (...) {
+		throwProtocolFailure(env, "the GMW offline phase failed");
+	}
+}
+
 /**
  * Delete the allocated memory.
  */
 JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_deleteGMW
-(JNIEnv *, jobject, jlong party) {
-	delete (GMWParty*)party;
+(JNIEnv *, jobject, jlong handler) {
+	delete (GMWHandler*)handler;
+}
+
+/**
+ * Sets the number of the next executions that are followed by the offline phase of the execution after them, in the background.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_setPreprocessAhead
+(JNIEnv *, jobject, jlong handler, jint executions) {
+	((GMWHandler*)handler)->setPreprocessAhead(executions);
+}
+
+/**
+ * Returns true if the triples of the next execution are ready.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_isOfflineReady
+(JNIEnv *, jobject, jlong handler) {
+	return ((GMWHandler*)handler)->isOfflineReady();
 }
\ No newline at end of file
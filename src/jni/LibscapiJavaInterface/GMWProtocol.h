@@ -31,6 +31,30 @@ extern "C" {
 	JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runProtocol
 		(JNIEnv *, jobject, jlong);
 
+	/*
+	* Class:     edu_biu_SCProtocols_gmw_GmwParty
+	* Method:    runOffline
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_runOffline
+		(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     edu_biu_SCProtocols_gmw_GmwParty
+	* Method:    setPreprocessAhead
+	* Signature: (JI)V
+	*/
+	JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_setPreprocessAhead
+		(JNIEnv *, jobject, jlong, jint);
+
+	/*
+	* Class:     edu_biu_SCProtocols_gmw_GmwParty
+	* Method:    isOfflineReady
+	* Signature: (J)Z
+	*/
+	JNIEXPORT jboolean JNICALL Java_edu_biu_SCProtocols_gmw_GmwParty_isOfflineReady
+		(JNIEnv *, jobject, jlong);
+
 	/*
 	* Class:     edu_biu_SCProtocols_gmw_GmwParty
 	* Method:    deleteGMW
@@ -1,4 +1,5 @@
 #include "MaliciousYaoProtocol.h"
+#include "../Common/ScapiProbes.h"
 
 /**
  * Create the offline protocol.
@@ -30,6 +31,15 @@ JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYao
 	for (int i = 0; i < commParty.size(); i++)
 		commParty[i]->join(500, 5000);
 
+	long party = createOfflineProtocol(id, yaoConfig, commConfig);
+	return (long) new MaliciousYaoHandler(party, yaoConfig, commConfig, io_service);
+}
+
+/**
+ * Create the offline protocol party (p1 or p2, according to the given id) on the given communication.
+ * Creates the circuits and other execution parameters for the protocol and the OT sender / receiver.
+ */
+long createOfflineProtocol(int id, const MaliciousYaoConfig & yaoConfig, const shared_ptr<CommunicationConfig> & commConfig) {
 	//make circuit
 	vector<shared_ptr<GarbledBooleanCircuit>> mainCircuit;
 	vector<shared_ptr<GarbledBooleanCircuit>> crCircuit;
@@ -45,7 +55,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYao
 	auto mainExecution = make_shared<ExecutionParameters>(nullptr, mainCircuit, yaoConfig.n1, yaoConfig.s1, yaoConfig.b1, yaoConfig.p1);
 	auto crExecution = make_shared<ExecutionParameters>(nullptr, crCircuit, yaoConfig.n2, yaoConfig.s2, yaoConfig.b2, yaoConfig.p2);
 
-	MaliciousYaoHandler* handler = nullptr;
+	long party = 0;
 	if (id == 1) {
 
 		//OT malicious sender
@@ -57,9 +67,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYao
 		shared_ptr<OTBatchSender> otSender = make_shared<OTExtensionBristolSender>(maliciousOtServer->getPort(), false, commConfig->getCommParty()[0]);
 #endif
 
-		OfflineProtocolP1* p1 = new OfflineProtocolP1(mainExecution, crExecution, commConfig, otSender);
-
-		handler = new MaliciousYaoHandler((long)p1, yaoConfig, commConfig, io_service);
+		party = (long) new OfflineProtocolP1(mainExecution, crExecution, commConfig, otSender);
 	}
 	else if (id == 2) {
 		//OT malicious receiver
@@ -71,10 +79,9 @@ JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYao
 		shared_ptr<OTBatchReceiver> otReceiver = make_shared<OTExtensionBristolReceiver>(maliciousOtServer->getIpAddress().to_string(), maliciousOtServer->getPort(), false, commConfig->getCommParty()[0]);
 #endif
 
-		OfflineProtocolP2* p2 = new OfflineProtocolP2(mainExecution, crExecution, commConfig, otReceiver, false);
-		handler = new MaliciousYaoHandler((long)p2, yaoConfig, commConfig, io_service);
+		party = (long) new OfflineProtocolP2(mainExecution, crExecution, commConfig, otReceiver, false);
 	}
-	return (long)handler;
+	return party;
 }
 
 /**
@@ -93,7 +100,9 @@ JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoO
 		
 		auto start = chrono::high_resolution_clock::now();
 
+		SCAPI_PROBE1(yao_offline_start, id);
 		p1->run();
+		SCAPI_PROBE1(yao_offline_done, id);
 
 		// we measure how much time did the protocol take
 		auto end = chrono::high_resolution_clock::now();
@@ -103,10 +112,7 @@ JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoO
 		cout << "\nSaving buckets to files...\n";
 		start = chrono::high_resolution_clock::now();
 
-		auto mainBuckets = p1->getMainBuckets();
-		auto crBuckets = p1->getCheatingRecoveryBuckets();
-		mainBuckets->saveToFiles(handler->getConfig().bucket_prefix_main1);
-		crBuckets->saveToFiles(handler->getConfig().bucket_prefix_cr1);
+		saveOfflineBuckets(id, (long)p1, handler->getConfig());
 
 		end = chrono::high_resolution_clock::now();
 		runtime = chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
@@ -122,7 +128,9 @@ JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoO
 		auto start = chrono::high_resolution_clock::now();
 
 		//run the protocol
+		SCAPI_PROBE1(yao_offline_start, id);
 		p2->run();
+		SCAPI_PROBE1(yao_offline_done, id);
 
 		// we measure how much time did the protocol take
 		auto end = chrono::high_resolution_clock::now();
@@ -132,12 +140,7 @@ JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoO
 		cout << "\nSaving buckets to files...\n";
 		start = chrono::high_resolution_clock::now();
 
-		auto mainBuckets = p2->getMainBuckets();
-		auto crBuckets = p2->getCheatingRecoveryBuckets();
-		mainBuckets->saveToFiles(handler->getConfig().bucket_prefix_main2);
-		crBuckets->saveToFiles(handler->getConfig().bucket_prefix_cr2);
-		p2->getMainProbeResistantMatrix()->saveToFile(handler->getConfig().main_matrix);
-		p2->getCheatingRecoveryProbeResistantMatrix()->saveToFile(handler->getConfig().cr_matrix);
+		saveOfflineBuckets(id, (long)p2, handler->getConfig());
 
 		end = chrono::high_resolution_clock::now();
 		runtime = chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
@@ -152,11 +155,40 @@ JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoO
 JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoOfflineParty_deleteMaliciousYao
 (JNIEnv *, jobject, jint id, jlong maliciousHandler) {
 	MaliciousYaoHandler* handler = (MaliciousYaoHandler*)maliciousHandler;
+	deleteOfflineProtocol(id, handler->getParty());
+	delete handler;
+}
+
+/**
+ * Save the buckets that were created by the given offline party to the files named in the config.
+ * Party two also saves the probe resistant matrices.
+ */
+void saveOfflineBuckets(int id, long party, const MaliciousYaoConfig & yaoConfig) {
+	if (id == 1) {
+		OfflineProtocolP1* p1 = (OfflineProtocolP1*)party;
+		auto mainBuckets = p1->getMainBuckets();
+		auto crBuckets = p1->getCheatingRecoveryBuckets();
+		mainBuckets->saveToFiles(yaoConfig.bucket_prefix_main1);
+		crBuckets->saveToFiles(yaoConfig.bucket_prefix_cr1);
+	} else {
+		OfflineProtocolP2* p2 = (OfflineProtocolP2*)party;
+		auto mainBuckets = p2->getMainBuckets();
+		auto crBuckets = p2->getCheatingRecoveryBuckets();
+		mainBuckets->saveToFiles(yaoConfig.bucket_prefix_main2);
+		crBuckets->saveToFiles(yaoConfig.bucket_prefix_cr2);
+		p2->getMainProbeResistantMatrix()->saveToFile(yaoConfig.main_matrix);
+		p2->getCheatingRecoveryProbeResistantMatrix()->saveToFile(yaoConfig.cr_matrix);
+	}
+}
+
+/**
+ * Delete an offline party that was created by createOfflineProtocol.
+ */
+void deleteOfflineProtocol(int id, long party) {
 	if (id == 1) {
-		delete (OfflineProtocolP1*)handler->getParty();
+		delete (OfflineProtocolP1*)party;
 	} else 
-		delete (OfflineProtocolP2*)handler->getParty();
-	delete handler;
+		delete (OfflineProtocolP2*)party;
 }
 
 /**
@@ -191,24 +223,27 @@ JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYao
 
 	MaliciousYaoHandler* handler = nullptr;
 	if (id == 1) {
-		// we load the bundles from file
-		vector<shared_ptr<BucketBundle>> mainBuckets(yaoConfig.n1), crBuckets(yaoConfig.n1);
+		// we load the main bundles from file. The cheating recovery bundles are loaded by the handler when they are needed.
+		vector<shared_ptr<BucketBundle>> mainBuckets(yaoConfig.n1);
 		
+		SCAPI_PROBE2(yao_load_buckets_start, id, yaoConfig.n1);
 		for (int i = 0; i<yaoConfig.n1; i++) {
 
-			mainBuckets[i] = BucketBundleList::loadBucketFromFile(yaoConfig.bucket_prefix_main1 + "." + to_string(BUCKET_ID) + ".cbundle");
-			crBuckets[i] = BucketBundleList::loadBucketFromFile(yaoConfig.bucket_prefix_cr1 + "." + to_string(BUCKET_ID++) + ".cbundle");
+			mainBuckets[i] = BucketBundleList::loadBucketFromFile(yaoConfig.bucket_prefix_main1 + "." + to_string(BUCKET_ID++) + ".cbundle");
 		}
+		SCAPI_PROBE2(yao_load_buckets_done, id, yaoConfig.n1);
 		auto input = CircuitInput::fromFile(yaoConfig.input_file_1);
-		handler = new MaliciousYaoHandler(yaoConfig, commConfig, io_service, mainBuckets, crBuckets, input);
+		handler = new MaliciousYaoHandler(yaoConfig, commConfig, io_service, mainBuckets, yaoConfig.bucket_prefix_cr1, input);
 	}
 	else if (id == 2) {
-		vector<shared_ptr<BucketLimitedBundle>> mainBuckets(yaoConfig.n1), crBuckets(yaoConfig.n1);
+		// we load the main bundles from file. The cheating recovery bundles are loaded by the handler when they are needed.
+		vector<shared_ptr<BucketLimitedBundle>> mainBuckets(yaoConfig.n1);
+		SCAPI_PROBE2(yao_load_buckets_start, id, yaoConfig.n1);
 		for (int i = 0; i < yaoConfig.n1; i++) {
 
-			mainBuckets[i] = BucketLimitedBundleList::loadBucketFromFile(yaoConfig.bucket_prefix_main2 + "." + to_string(BUCKET_ID) + ".cbundle");
-			crBuckets[i] = BucketLimitedBundleList::loadBucketFromFile(yaoConfig.bucket_prefix_cr2 + "." + to_string(BUCKET_ID++) + ".cbundle");
+			mainBuckets[i] = BucketLimitedBundleList::loadBucketFromFile(yaoConfig.bucket_prefix_main2 + "." + to_string(BUCKET_ID++) + ".cbundle");
 		} 
+		SCAPI_PROBE2(yao_load_buckets_done, id, yaoConfig.n1);
 		
 		//create boolean circuit
 		auto mainBC = make_shared<BooleanCircuit>(new scannerpp::File(yaoConfig.main_circuit_file));
@@ -236,7 +271,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYao
 		mainMatrix->loadFromFile(yaoConfig.main_matrix);
 		crMatrix->loadFromFile(yaoConfig.cr_matrix);
 		auto input = CircuitInput::fromFile(yaoConfig.input_file_2);
-		handler = new MaliciousYaoHandler(yaoConfig, commConfig, io_service, mainExecution, crExecution, mainMatrix, crMatrix, mainBuckets, crBuckets, input);
+		handler = new MaliciousYaoHandler(yaoConfig, commConfig, io_service, mainExecution, crExecution, mainMatrix, crMatrix, mainBuckets, yaoConfig.bucket_prefix_cr2, input);
 	}
 	return (long)handler;
 }
@@ -265,13 +300,18 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_Malicio
 			int readsize = commParty[0]->read(tmpBuf, tmp.size());
 			
 			auto mainBucket = handler->getMainBuckets1()[i];
-			auto crBucket = handler->getCRBuckets1()[i];
+			auto crBucket = handler->getCRBucket1(i);
+			//load the cheating recovery bucket of the next execution while this one runs
+			if (i + 1 < endExecutionNumber)
+				handler->prefetchCRBucket1(i + 1);
 
 			start = chrono::high_resolution_clock::now();
 
 			OnlineProtocolP1 protocol(*(handler->getCommConfig()), *mainBucket, *crBucket);
 			protocol.setInput(handler->getInput());
+			SCAPI_PROBE2(yao_online_start, id, i);
 			protocol.run();
+			SCAPI_PROBE2(yao_online_done, id, i);
 
 			end = chrono::high_resolution_clock::now();
 			time = chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
@@ -283,23 +323,31 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_Malicio
 			commParty[0]->write((const byte*)tmp.c_str(), tmp.size());
 
 			auto mainBucket = handler->getMainBuckets2()[i];
-			auto crBucket = handler->getCRBuckets2()[i];
+			auto crBucket = handler->getCRBucket2(i);
+			//load the cheating recovery bucket of the next execution while this one runs
+			if (i + 1 < endExecutionNumber)
+				handler->prefetchCRBucket2(i + 1);
 
+			//the cheating recovery tables are copied in parallel to the main tables
+			auto crTablesFuture = async(launch::async, saveBucketGarbledTables, handler->getConfig().b2, crBucket.get());
 			auto mainTables = saveBucketGarbledTables(handler->getConfig().b1, mainBucket.get());
-			auto crTables = saveBucketGarbledTables(handler->getConfig().b2, crBucket.get());
+			auto crTables = crTablesFuture.get();
 
 			start = chrono::high_resolution_clock::now();
 
 			OnlineProtocolP2 protocol(*(handler->getMainExecution()), *(handler->getCRExecution()), handler->getCommConfig()->getCommParty()[0], mainBucket, crBucket, handler->getMainMatrix().get(), handler->getCRMatrix().get());
 			protocol.setInput(*handler->getInput());
+			SCAPI_PROBE2(yao_online_start, id, i);
 			protocol.run();
+			SCAPI_PROBE2(yao_online_done, id, i);
 
 			end = chrono::high_resolution_clock::now();
 			time = chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
 			times.push_back(time);
 
+			auto crRestore = async(launch::async, restoreBucketTables, handler->getConfig().b2, crBucket.get(), crTables);
 			restoreBucketTables(handler->getConfig().b1, mainBucket.get(), mainTables);
-			restoreBucketTables(handler->getConfig().b2, crBucket.get(), crTables);
+			crRestore.get();
 			output = protocol.getOutput().getOutput();
 		}
 	}
@@ -340,6 +388,7 @@ block** saveBucketGarbledTables(int size, BucketLimitedBundle * bucket) {
 
 	for (int i = 0; i<size; i++) {
 		auto bundle = bucket->getLimitedBundleAt(i);
+		//the copy is handed back to the bundle, that frees it with _mm_free, so it cannot come from scapi_native::alignedAlloc.
 		tables[i] = (block *)_mm_malloc(bundle->getGarbledTablesSize(), SIZE_OF_BLOCK);
 		memcpy((byte *)tables[i], (byte *)bundle->getGarbledTables(), bundle->getGarbledTablesSize());
 	}
@@ -13,6 +13,7 @@
 #include <libscapi/protocols/MaliciousYao/lib/include/OfflineOnline/specs/OnlineProtocolP2.hpp>
 #include <libscapi/include/interactive_mid_protocols/OTExtensionBristol.hpp>
 #include <libscapi/protocols/MaliciousYao/lib/include/primitives/CheatingRecoveryCircuitCreator.hpp>
+#include <future>
 
 /* Header for class edu_biu_scapi_protocols_maliciousYao_MaliciousYaoParty */
 
@@ -149,9 +150,10 @@ private:
 	shared_ptr<CommunicationConfig> commConfig;		//manage the communication
 	boost::asio::io_service* io_service;			//used in the communication
 	vector<shared_ptr<BucketBundle>> mainBucketsP1; //used in online p1
-	vector<shared_ptr<BucketBundle>> crBucketsP1;	//used in online p1
+	vector<shared_future<shared_ptr<BucketBundle>>> crBucketsP1;	//used in online p1, loaded on demand
 	vector<shared_ptr<BucketLimitedBundle>> mainBucketsP2; //used in online p2
-	vector<shared_ptr<BucketLimitedBundle>> crBucketsP2;   //used in online p2
+	vector<shared_future<shared_ptr<BucketLimitedBundle>>> crBucketsP2;   //used in online p2, loaded on demand
+	string crBucketPrefix;							//The prefix of the cheating recovery bucket files, used in online p1 and p2
 	shared_ptr<ExecutionParameters> mainExecution;	//Used in Online p2
 	shared_ptr<ExecutionParameters> crExecution;	//Used in Online p2
 	shared_ptr<KProbeResistantMatrix> mainMatrix, crMatrix; //Used in Online p2
@@ -168,18 +170,20 @@ public:
 	* This constructor used by party one of the online protocol
 	*/
 	MaliciousYaoHandler(MaliciousYaoConfig yaoConfig, const shared_ptr<CommunicationConfig> & commConfig, boost::asio::io_service* io_service, 
-		const vector<shared_ptr<BucketBundle>> & mainBuckets, const vector<shared_ptr<BucketBundle>> & crBuckets, const shared_ptr<CircuitInput> & input)
-		: yaoConfig(yaoConfig), commConfig(commConfig), io_service(io_service), mainBucketsP1(mainBuckets), crBucketsP1(crBuckets), input(input){}
+		const vector<shared_ptr<BucketBundle>> & mainBuckets, const string & crBucketPrefix, const shared_ptr<CircuitInput> & input)
+		: yaoConfig(yaoConfig), commConfig(commConfig), io_service(io_service), mainBucketsP1(mainBuckets), crBucketsP1(mainBuckets.size()), 
+		  crBucketPrefix(crBucketPrefix), input(input){}
 
 	/**
 	* This constructor used by party two of the online protocol
 	*/
 	MaliciousYaoHandler(MaliciousYaoConfig yaoConfig, const shared_ptr<CommunicationConfig> & commConfig, boost::asio::io_service* io_service, 
 		const shared_ptr<ExecutionParameters> & mainExecution, const shared_ptr<ExecutionParameters> & crExecution, const shared_ptr<KProbeResistantMatrix> & mainMatrix, 
-		const shared_ptr<KProbeResistantMatrix> & crMatrix, const vector<shared_ptr<BucketLimitedBundle>> & mainBuckets, const vector<shared_ptr<BucketLimitedBundle>> & crBuckets,
+		const shared_ptr<KProbeResistantMatrix> & crMatrix, const vector<shared_ptr<BucketLimitedBundle>> & mainBuckets, const string & crBucketPrefix,
 		const shared_ptr<CircuitInput> & input)
 		: yaoConfig(yaoConfig), commConfig(commConfig), io_service(io_service), mainExecution(mainExecution), crExecution(crExecution),
-		  mainMatrix(mainMatrix), crMatrix(crMatrix), mainBucketsP2(mainBuckets), crBucketsP2(crBuckets), input(input){}
+		  mainMatrix(mainMatrix), crMatrix(crMatrix), mainBucketsP2(mainBuckets), crBucketsP2(mainBuckets.size()), 
+		  crBucketPrefix(crBucketPrefix), input(input){}
 
 	/**
 	 * The party should be deleted outside since this class does not know which concrete party it have.
@@ -199,9 +203,41 @@ public:
 	shared_ptr<KProbeResistantMatrix> getMainMatrix() { return mainMatrix; }
 	shared_ptr<KProbeResistantMatrix> getCRMatrix() { return crMatrix; }
 	vector<shared_ptr<BucketBundle>> getMainBuckets1() {	return mainBucketsP1; }
-	vector<shared_ptr<BucketBundle>> getCRBuckets1() { return crBucketsP1; }
+
+	/**
+	 * Returns the cheating recovery bucket of the given execution (p1), loading it from its file if it was not loaded yet.
+	 * The cheating recovery bucket is only needed at the end of the execution, so prefetchCRBucket1 can be used to load 
+	 * it in the background while the main circuits are evaluated.
+	 */
+	shared_ptr<BucketBundle> getCRBucket1(int i) { 
+		prefetchCRBucket1(i); 
+		return crBucketsP1[i].get(); 
+	}
+
+	void prefetchCRBucket1(int i) {
+		if (i < (int) crBucketsP1.size() && !crBucketsP1[i].valid()) {
+			string file = crBucketPrefix + "." + to_string(i) + ".cbundle";
+			crBucketsP1[i] = async(launch::async, [file] { return BucketBundleList::loadBucketFromFile(file); }).share();
+		}
+	}
+
 	vector<shared_ptr<BucketLimitedBundle>> getMainBuckets2() { return mainBucketsP2; }
-	vector<shared_ptr<BucketLimitedBundle>> getCRBuckets2() { return crBucketsP2; }
+
+	/**
+	 * Same as getCRBucket1 and prefetchCRBucket1, for p2.
+	 */
+	shared_ptr<BucketLimitedBundle> getCRBucket2(int i) { 
+		prefetchCRBucket2(i); 
+		return crBucketsP2[i].get(); 
+	}
+
+	void prefetchCRBucket2(int i) {
+		if (i < (int) crBucketsP2.size() && !crBucketsP2[i].valid()) {
+			string file = crBucketPrefix + "." + to_string(i) + ".cbundle";
+			crBucketsP2[i] = async(launch::async, [file] { return BucketLimitedBundleList::loadBucketFromFile(file); }).share();
+		}
+	}
+
 	shared_ptr<CircuitInput> getInput() { return input; }
 };
 
@@ -209,6 +245,11 @@ public:
 block** saveBucketGarbledTables(int size, BucketLimitedBundle * bucket);
 void restoreBucketTables(int size, BucketLimitedBundle* bucket, block** tables);
 
+//Used by the offline protocol and by the service (see MaliciousYaoService.h).
+long createOfflineProtocol(int id, const MaliciousYaoConfig & yaoConfig, const shared_ptr<CommunicationConfig> & commConfig);
+void saveOfflineBuckets(int id, long party, const MaliciousYaoConfig & yaoConfig);
+void deleteOfflineProtocol(int id, long party);
+
 
 #endif
 #endif
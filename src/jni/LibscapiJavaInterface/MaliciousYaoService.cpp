@@ -0,0 +1,359 @@
+#include "MaliciousYaoService.h"
+#include "ProtocolFailure.h"
+#include "../Common/ScapiProbes.h"
+#include <cmath>
+#include <cstdio>
+
+/**
+ * Returns the value of the given entry in the config file, or an empty string if the entry does not exist.
+ */
+static string optionalValue(const ConfigFile & cf, const string & section, const string & entry) {
+	try {
+		return cf.Value(section, entry);
+	} catch (...) {
+		return "";
+	}
+}
+
+static long long microsSince(const chrono::high_resolution_clock::time_point & start) {
+	return chrono::duration_cast<std::chrono::microseconds>(chrono::high_resolution_clock::now() - start).count();
+}
+
+MaliciousYaoService::MaliciousYaoService(int id, const string & configFile)
+	: id(id), yaoConfig(configFile), nextBatch(0), executionsStarted(0), refilling(false), abandoned(false) {
+	for (int i = 0; i < NUM_SERVICE_METRICS; i++) {
+		metrics[i] = 0;
+	}
+
+#ifdef _WIN32
+	string os = "Windows";
+#else
+	string os = "Linux";
+#endif
+	ConfigFile cf(configFile);
+	string watermark = optionalValue(cf, "", "service_low_watermark");
+	lowWatermark = watermark.empty() ? yaoConfig.n1 / 4 : stoi(watermark);
+	//A single batch is generated at a time, so a new batch can only be needed once the previous batch is being used.
+	lowWatermark = max(0, min(lowWatermark, yaoConfig.n1 - 1));
+	string timeout = optionalValue(cf, "", "service_shutdown_timeout");
+	shutdownTimeout = timeout.empty() ? 30 : stoi(timeout);
+	string offlinePartiesFile = optionalValue(cf, cf.Value("", "input_section") + "-" + os, "service_offline_parties_file");
+
+	//set crypto primitives
+	CryptoPrimitives::setCryptoPrimitives(yaoConfig.ec_file);
+	CryptoPrimitives::setNumOfThreads(yaoConfig.num_threads);
+
+	onlineIoService = new boost::asio::io_service();
+	onlineComm = connect(yaoConfig.parties_file, *onlineIoService);
+	if (offlinePartiesFile.empty()) {
+		offlineIoService = nullptr;
+		offlineComm = onlineComm;
+	} else {
+		offlineIoService = new boost::asio::io_service();
+		offlineComm = connect(offlinePartiesFile, *offlineIoService);
+	}
+
+	if (id == 1) {
+		input = CircuitInput::fromFile(yaoConfig.input_file_1);
+	} else {
+		//create boolean circuit
+		auto mainBC = make_shared<BooleanCircuit>(new scannerpp::File(yaoConfig.main_circuit_file));
+		auto crBC = make_shared<BooleanCircuit>(new scannerpp::File(yaoConfig.cr_circuit_file));
+
+		//create garbled circuit
+		vector<shared_ptr<GarbledBooleanCircuit>> mainCircuit(yaoConfig.b1);
+		vector<shared_ptr<GarbledBooleanCircuit>> crCircuit(yaoConfig.b2);
+		for (int i = 0; i<yaoConfig.b1; i++) {
+			mainCircuit[i] = shared_ptr<GarbledBooleanCircuit>(GarbledCircuitFactory::createCircuit(yaoConfig.main_circuit_file,
+				GarbledCircuitFactory::CircuitType::FIXED_KEY_FREE_XOR_HALF_GATES, true));
+		}
+		for (int i = 0; i<yaoConfig.b2; i++) {
+			crCircuit[i] = shared_ptr<GarbledBooleanCircuit>(CheatingRecoveryCircuitCreator(yaoConfig.cr_circuit_file, mainCircuit[0]->getNumberOfGates()).create());
+		}
+		mainExecution = make_shared<ExecutionParameters>(mainBC, mainCircuit, yaoConfig.n1, yaoConfig.s1, yaoConfig.b1, yaoConfig.p1);
+		crExecution = make_shared<ExecutionParameters>(crBC, crCircuit, yaoConfig.n2, yaoConfig.s2, yaoConfig.b2, yaoConfig.p2);
+		input = CircuitInput::fromFile(yaoConfig.input_file_2);
+	}
+}
+
+MaliciousYaoService::~MaliciousYaoService() {
+	if (refillThread.joinable()) {
+		//The batch has already finished (see destroy), only its thread is left.
+		refillThread.join();
+	}
+	onlineIoService->stop();
+	delete onlineIoService;
+	if (offlineIoService != nullptr) {
+		offlineIoService->stop();
+		delete offlineIoService;
+	}
+}
+
+shared_ptr<CommunicationConfig> MaliciousYaoService::connect(const string & partiesFile, boost::asio::io_service & ioService) {
+	shared_ptr<CommunicationConfig> commConfig(new CommunicationConfig(partiesFile, id, ioService));
+	auto commParty = commConfig->getCommParty();
+	//make connection
+	for (int i = 0; i < commParty.size(); i++)
+		commParty[i]->join(500, 5000);
+	return commConfig;
+}
+
+void MaliciousYaoService::destroy(MaliciousYaoService* service) {
+	std::unique_lock<std::mutex> guard(service->lock);
+	if (!service->poolChanged.wait_for(guard, chrono::seconds(service->shutdownTimeout), [service] { return !service->refilling; })) {
+		//The other party does not complete the batch (it may be gone). Joining the refill thread could block forever,
+		//so the service is left to the thread, which deletes it when the batch ends or fails.
+		service->abandoned = true;
+		service->refillThread.detach();
+		return;
+	}
+	guard.unlock();
+	delete service;
+}
+
+/**
+ * Removes the files that the offline protocol of a batch saved its buckets to.
+ */
+static void removeBatchFiles(const MaliciousYaoConfig & batchConfig) {
+	int numBuckets = max(batchConfig.n1, batchConfig.n2);
+	for (const string & prefix : { batchConfig.bucket_prefix_main1, batchConfig.bucket_prefix_cr1, batchConfig.bucket_prefix_main2, batchConfig.bucket_prefix_cr2 }) {
+		for (int i = 0; i < numBuckets; i++) {
+			remove((prefix + "." + to_string(i) + ".cbundle").c_str());
+		}
+	}
+	remove(batchConfig.main_matrix.c_str());
+	remove(batchConfig.cr_matrix.c_str());
+}
+
+/**
+ * Runs the offline protocol on the offline communication, saves its buckets to the files of the batch and adds them
+ * to the pool. The files are removed once the buckets are loaded (or the batch fails).
+ */
+void MaliciousYaoService::generateBatch(int batch) {
+	auto start = chrono::high_resolution_clock::now();
+
+	MaliciousYaoConfig batchConfig = yaoConfig;
+	string suffix = ".batch" + to_string(batch);
+	batchConfig.bucket_prefix_main1 += suffix;
+	batchConfig.bucket_prefix_cr1 += suffix;
+	batchConfig.bucket_prefix_main2 += suffix;
+	batchConfig.bucket_prefix_cr2 += suffix;
+	batchConfig.main_matrix += suffix;
+	batchConfig.cr_matrix += suffix;
+
+	vector<PoolEntry> entries(yaoConfig.n1);
+	try {
+		SCAPI_PROBE1(yao_offline_start, id);
+		long party = createOfflineProtocol(id, batchConfig, offlineComm);
+		try {
+			if (id == 1) {
+				((OfflineProtocolP1*)party)->run();
+			} else {
+				((OfflineProtocolP2*)party)->run();
+			}
+			saveOfflineBuckets(id, party, batchConfig);
+		} catch (...) {
+			deleteOfflineProtocol(id, party);
+			throw;
+		}
+		deleteOfflineProtocol(id, party);
+		SCAPI_PROBE1(yao_offline_done, id);
+
+		//Load the buckets of the batch.
+		SCAPI_PROBE2(yao_load_buckets_start, id, yaoConfig.n1);
+		if (id == 1) {
+			for (int i = 0; i < yaoConfig.n1; i++) {
+				entries[i].mainBucket1 = BucketBundleList::loadBucketFromFile(batchConfig.bucket_prefix_main1 + "." + to_string(i) + ".cbundle");
+				entries[i].crBucket1 = BucketBundleList::loadBucketFromFile(batchConfig.bucket_prefix_cr1 + "." + to_string(i) + ".cbundle");
+			}
+		} else {
+			auto mainMatrix = make_shared<KProbeResistantMatrix>();
+			auto crMatrix = make_shared<KProbeResistantMatrix>();
+			mainMatrix->loadFromFile(batchConfig.main_matrix);
+			crMatrix->loadFromFile(batchConfig.cr_matrix);
+			for (int i = 0; i < yaoConfig.n1; i++) {
+				entries[i].mainBucket2 = BucketLimitedBundleList::loadBucketFromFile(batchConfig.bucket_prefix_main2 + "." + to_string(i) + ".cbundle");
+				entries[i].crBucket2 = BucketLimitedBundleList::loadBucketFromFile(batchConfig.bucket_prefix_cr2 + "." + to_string(i) + ".cbundle");
+				entries[i].mainMatrix = mainMatrix;
+				entries[i].crMatrix = crMatrix;
+			}
+		}
+		SCAPI_PROBE2(yao_load_buckets_done, id, yaoConfig.n1);
+	} catch (...) {
+		removeBatchFiles(batchConfig);
+		throw;
+	}
+	//The buckets are kept in memory, the files are not needed anymore.
+	removeBatchFiles(batchConfig);
+
+	//All the circuits of the batch, checked and evaluated (N * B / p for each of the main and cheating recovery executions).
+	long long circuits = (long long) ceil(yaoConfig.n1 * yaoConfig.b1 / yaoConfig.p1) + (long long) ceil(yaoConfig.n2 * yaoConfig.b2 / yaoConfig.p2);
+
+	std::lock_guard<std::mutex> guard(lock);
+	pool.insert(pool.end(), entries.begin(), entries.end());
+	metrics[OFFLINE_BATCHES]++;
+	metrics[CIRCUITS_GARBLED] += circuits;
+	metrics[OFFLINE_MICROS] += microsSince(start);
+	poolChanged.notify_all();
+}
+
+/**
+ * Starts generating the next batch in the background. Should be called with the lock held.
+ * A failure of the batch is kept and thrown by the following executions.
+ */
+void MaliciousYaoService::startBackgroundRefill(std::unique_lock<std::mutex> & guard) {
+	//The watermark is below n1, so the previous batch normally finished before its buckets were used.
+	poolChanged.wait(guard, [this] { return !refilling; });
+	if (refillThread.joinable()) {
+		//The previous refill has already finished, only its thread is left.
+		refillThread.join();
+	}
+	refilling = true;
+	int batch = nextBatch++;
+	refillThread = std::thread([this, batch] {
+		std::exception_ptr error;
+		try {
+			generateBatch(batch);
+		} catch (...) {
+			error = std::current_exception();
+		}
+		std::unique_lock<std::mutex> guard(lock);
+		refilling = false;
+		if (error && !batchError) {
+			batchError = error;
+		}
+		poolChanged.notify_all();
+		if (abandoned) {
+			//The service was destroyed while the batch was running, and left to this thread.
+			guard.unlock();
+			delete this;
+		}
+	});
+}
+
+vector<byte> MaliciousYaoService::execute() {
+	auto start = chrono::high_resolution_clock::now();
+	bool background = (offlineComm != onlineComm);
+
+	PoolEntry entry;
+	int execution;
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		if (batchError) {
+			std::rethrow_exception(batchError);
+		}
+		//The buckets of the batches that were started and not used yet. It depends only on the number of executions, so
+		//both parties start the batches at the same executions, regardless of the timing of their background threads.
+		long long available = (long long) nextBatch * yaoConfig.n1 - executionsStarted;
+		if (background && available <= lowWatermark) {
+			startBackgroundRefill(guard);
+		} else if (!background && available == 0) {
+			//The offline protocol shares the communication with the online protocol, so generate the batch now.
+			int batch = nextBatch++;
+			guard.unlock();
+			try {
+				generateBatch(batch);
+			} catch (...) {
+				guard.lock();
+				batchError = std::current_exception();
+				throw;
+			}
+			guard.lock();
+		}
+		poolChanged.wait(guard, [this] { return !pool.empty() || batchError; });
+		if (pool.empty()) {
+			std::rethrow_exception(batchError);
+		}
+		entry = pool.front();
+		pool.pop_front();
+		execution = (int) executionsStarted++;
+	}
+
+	vector<byte> output;
+	SCAPI_PROBE2(yao_online_start, id, execution);
+	if (id == 1) {
+		OnlineProtocolP1 protocol(*onlineComm, *entry.mainBucket1, *entry.crBucket1);
+		protocol.setInput(input);
+		protocol.run();
+	} else {
+		//Each bucket is used once, so there is no need to save and restore its garbled tables.
+		OnlineProtocolP2 protocol(*mainExecution, *crExecution, onlineComm->getCommParty()[0], entry.mainBucket2, entry.crBucket2, entry.mainMatrix.get(), entry.crMatrix.get());
+		protocol.setInput(*input);
+		protocol.run();
+		output = protocol.getOutput().getOutput();
+	}
+	SCAPI_PROBE2(yao_online_done, id, execution);
+
+	long long latency = microsSince(start);
+	std::lock_guard<std::mutex> guard(lock);
+	metrics[EXECUTIONS]++;
+	metrics[LAST_LATENCY_MICROS] = latency;
+	metrics[TOTAL_LATENCY_MICROS] += latency;
+	if (latency > metrics[MAX_LATENCY_MICROS]) {
+		metrics[MAX_LATENCY_MICROS] = latency;
+	}
+	return output;
+}
+
+void MaliciousYaoService::getMetrics(long long* values) {
+	std::lock_guard<std::mutex> guard(lock);
+	metrics[POOL_DEPTH] = pool.size();
+	for (int i = 0; i < NUM_SERVICE_METRICS; i++) {
+		values[i] = metrics[i];
+	}
+}
+
+/**
+ * Create the service party. The first batch of buckets is generated on the first execution.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty_createService
+(JNIEnv *env, jobject, jint id, jstring configFileName) {
+	const char* configFile = env->GetStringUTFChars(configFileName, NULL);
+	MaliciousYaoService* service = new MaliciousYaoService(id, configFile);
+	env->ReleaseStringUTFChars(configFileName, configFile);
+	return (long)service;
+}
+
+/**
+ * Run one online execution and return its output.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty_execute
+(JNIEnv *env, jobject, jlong service) {
+	vector<byte> output;
+	try {
+		output = ((MaliciousYaoService*)service)->execute();
+	} catch (...) {
+		throwProtocolFailure(env, "the malicious yao execution failed");
+		return NULL;
+	}
+
+	//Create a jni object and fill it with the protocol output.
+	jbyteArray result = env->NewByteArray(output.size());
+	env->SetByteArrayRegion(result, 0, output.size(), (jbyte*)output.data());
+	return result;
+}
+
+/**
+ * Return the metrics of the service, in the order of MaliciousYaoServiceMetric.
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty_getMetrics
+(JNIEnv *env, jobject, jlong service) {
+	long long values[NUM_SERVICE_METRICS];
+	((MaliciousYaoService*)service)->getMetrics(values);
+
+	jlong javaValues[NUM_SERVICE_METRICS];
+	for (int i = 0; i < NUM_SERVICE_METRICS; i++) {
+		javaValues[i] = values[i];
+	}
+	jlongArray result = env->NewLongArray(NUM_SERVICE_METRICS);
+	env->SetLongArrayRegion(result, 0, NUM_SERVICE_METRICS, javaValues);
+	return result;
+}
+
+/**
+ * Delete the allocated memory (or leave it to a background batch that does not finish, see MaliciousYaoService::destroy).
+ */
+JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty_deleteService
+(JNIEnv *, jobject, jlong service) {
+	MaliciousYaoService::destroy((MaliciousYaoService*)service);
+}
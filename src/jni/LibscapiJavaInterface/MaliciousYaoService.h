@@ -0,0 +1,137 @@
+#ifndef MALICIOUS_YAO_SERVICE_H
+#define MALICIOUS_YAO_SERVICE_H
+
+#include "MaliciousYaoProtocol.h"
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	/*
+	* Class:     edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty
+	* Method:    createService
+	* Signature: (ILjava/lang/String;)J
+	*/
+	JNIEXPORT jlong JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty_createService
+		(JNIEnv *, jobject, jint, jstring);
+
+	/*
+	* Class:     edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty
+	* Method:    execute
+	* Signature: (J)[B
+	*/
+	JNIEXPORT jbyteArray JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty_execute
+		(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty
+	* Method:    getMetrics
+	* Signature: (J)[J
+	*/
+	JNIEXPORT jlongArray JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty_getMetrics
+		(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty
+	* Method:    deleteService
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_edu_biu_SCProtocols_NativeMaliciousYao_MaliciousYaoServiceParty_deleteService
+		(JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+
+/**
+ * The metrics of the service, in the order they are returned to java.
+ */
+enum MaliciousYaoServiceMetric {
+	POOL_DEPTH,					//Number of buckets that are ready to be used.
+	OFFLINE_BATCHES,			//Number of offline batches that were generated.
+	EXECUTIONS,					//Number of online executions that were served.
+	CIRCUITS_GARBLED,			//Number of circuits (main and cheating recovery, checked and evaluated) garbled by all the batches.
+	LAST_LATENCY_MICROS,		//Time of the last execution, including the time it waited for a bucket.
+	TOTAL_LATENCY_MICROS,		//Sum of the times of all the executions.
+	MAX_LATENCY_MICROS,			//Maximal time of a single execution.
+	OFFLINE_MICROS,				//Sum of the times of all the offline batches.
+	NUM_SERVICE_METRICS
+};
+
+/**
+ * A long running malicious yao party, that keeps a pool of buckets produced by the offline protocol and uses one bucket
+ * for each online execution.
+ *
+ * The offline protocol runs in batches of n1 buckets. Each batch runs the cut and choose on its own circuits, saves the
+ * buckets to files (the bucket prefixes of the config, followed by ".batch<k>") and adds them to the pool.
+ * When the config contains "service_offline_parties_file", the offline batches use a separate communication that is
+ * created from that file, and the next batch is started in a background thread once the buckets that were not used drop
+ * to the low watermark ("service_low_watermark", default n1/4, at most n1-1). Otherwise, a batch is generated inline when
+ * an execution finds the pool empty. The files of a batch are removed once its buckets are loaded.
+ *
+ * The batches are started at fixed executions (the unused buckets are counted from the number of started batches and
+ * executions, not from the timing of the background thread), so both parties start the same batches at the same points
+ * and the offline batches and online executions stay matched without any extra messages.
+ * A failure of a batch is thrown by the following executions, since the parties cannot agree on retrying it.
+ */
+class MaliciousYaoService {
+private:
+	struct PoolEntry {
+		shared_ptr<BucketBundle> mainBucket1, crBucket1;				//Used by p1
+		shared_ptr<BucketLimitedBundle> mainBucket2, crBucket2;		//Used by p2
+		shared_ptr<KProbeResistantMatrix> mainMatrix, crMatrix;		//Used by p2, shared by all the buckets of a batch
+	};
+
+	int id;
+	MaliciousYaoConfig yaoConfig;
+	int lowWatermark;
+	shared_ptr<CommunicationConfig> onlineComm, offlineComm;
+	boost::asio::io_service* onlineIoService;
+	boost::asio::io_service* offlineIoService;
+
+	//Used in p2 online executions.
+	shared_ptr<ExecutionParameters> mainExecution, crExecution;
+	shared_ptr<CircuitInput> input;
+
+	std::deque<PoolEntry> pool;
+	int nextBatch;
+	long long executionsStarted;		//Number of buckets that were taken from the pool.
+	bool refilling;
+	bool abandoned;						//True when the service was destroyed while a batch was running, see destroy.
+	int shutdownTimeout;				//Seconds to wait for a running batch on destroy ("service_shutdown_timeout", default 30).
+	std::exception_ptr batchError;		//The failure of a batch, thrown by the following executions.
+	std::thread refillThread;
+	std::mutex lock;
+	std::condition_variable poolChanged;
+	long long metrics[NUM_SERVICE_METRICS];
+
+	shared_ptr<CommunicationConfig> connect(const string & partiesFile, boost::asio::io_service & ioService);
+	void generateBatch(int batch);
+	void startBackgroundRefill(std::unique_lock<std::mutex> & guard);
+	~MaliciousYaoService();
+
+public:
+	MaliciousYaoService(int id, const string & configFile);
+
+	/**
+	 * Deletes the service once its background batch is done. If the batch does not finish within the shutdown timeout
+	 * (the other party may be gone), returns without blocking and the refill thread deletes the service when the batch ends.
+	 */
+	static void destroy(MaliciousYaoService* service);
+
+	/**
+	 * Runs an online execution on the next bucket of the pool and returns the output (p2) or an empty output (p1).
+	 */
+	vector<byte> execute();
+
+	/**
+	 * Copies the current metrics to the given array of NUM_SERVICE_METRICS values.
+	 */
+	void getMetrics(long long* values);
+};
+
+#endif
+#endif
@@ -0,0 +1,26 @@
+#ifndef LIBSCAPIJAVAINTERFACE_PROTOCOLFAILURE_H
+#define LIBSCAPIJAVAINTERFACE_PROTOCOLFAILURE_H
+
+#include <jni.h>
+#include <exception>
+#include <string>
+
+/**
+ * Throws the exception that is being handled as a java IllegalStateException, so that a failure of a native protocol
+ * reaches the java caller instead of terminating the JVM. Should be called from a catch block.
+ */
+inline void throwProtocolFailure(JNIEnv *env, const char* defaultMessage) {
+	std::string message = defaultMessage;
+	try {
+		throw;
+	} catch (const std::exception & e) {
+		message = e.what();
+	} catch (...) {
+	}
+	jclass exceptionClass = env->FindClass("java/lang/IllegalStateException");
+	if (exceptionClass != NULL) {
+		env->ThrowNew(exceptionClass, message.c_str());
+	}
+}
+
+#endif //LIBSCAPIJAVAINTERFACE_PROTOCOLFAILURE_H
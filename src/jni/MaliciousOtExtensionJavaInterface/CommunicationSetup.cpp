@@ -1,11 +1,96 @@
 #include "CommunicationSetup.h"
 #include <string.h>
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#ifndef _WIN32
+	#include <sys/socket.h>
+#endif
 #include <MaliciousOTExtension/util/socket.h>
 
 using namespace std;
 using namespace maliciousot;
 
+/*
+ * The send side of a native channel.
+ * Every message is framed as [int size][size bytes]. When batching is off, a small frame is written with a single 
+ * Send call (instead of one call for the size and one for the payload), and a large message is written directly from 
+ * the java array after its size, without copying it to a frame. When batching is on, frames are accumulated in 
+ * pendingData and written together when flush is called or when the pending data reaches the threshold, so that 
+ * a whole protocol round goes out as one segment.
+ * The receive side is not affected since the framing on the wire stays the same.
+ */
+struct NativeSendChannel {
+	CSocket* socket;
+	vector<char> pendingData;
+	bool batching;
+	size_t threshold;
+
+	//counters
+	jlong messages;		//number of messages given to send.
+	jlong syscalls;		//number of Send calls made on the socket.
+	jlong bytes;		//number of bytes written to the socket, including the size headers.
+	jlong rounds;		//number of non empty flushes (every unbatched message is a round of its own).
+
+	NativeSendChannel(CSocket* s) : socket(s), batching(false), threshold(0), messages(0), syscalls(0), bytes(0), rounds(0) {}
+};
+
+//Number of counters returned by getSendCounters.
+#define NUM_SEND_COUNTERS 4
+
+//Default number of pending bytes that causes an automatic flush when batching without an explicit threshold.
+#define DEFAULT_BATCH_THRESHOLD (64 * 1024)
+
+//Unbatched messages up to this size are copied to a frame and sent with one Send call, larger messages are sent without a copy.
+#define MAX_COPIED_MESSAGE_SIZE 1024
+
+//MSG_MORE tells the kernel that more data follows, so the size and a large payload still leave in the same segment.
+#ifndef MSG_MORE
+#define MSG_MORE 0
+#endif
+
+/*
+ * Writes all the pending frames to the socket in one Send call.
+ */
+static void flushPending(NativeSendChannel* channel){
+	if (channel->pendingData.empty()) 
+		return;
+
+	channel->socket->Send(channel->pendingData.data(), channel->pendingData.size());
+	channel->syscalls++;
+	channel->rounds++;
+	channel->bytes += channel->pendingData.size();
+	channel->pendingData.clear();
+
+	//a single large batch should not keep its memory for the lifetime of the channel.
+	if (channel->pendingData.capacity() > 2 * max(channel->threshold, (size_t) DEFAULT_BATCH_THRESHOLD)){
+		vector<char>().swap(channel->pendingData);
+	}
+}
+
+/*
+ * Writes the size of the given message and then the message itself, without copying the message.
+ */
+static void sendUnframed(NativeSendChannel* channel, const char* msg, int size){
+	channel->socket->Send(&size, sizeof(int), MSG_MORE);
+	channel->socket->Send(msg, size);
+	channel->messages++;
+	channel->syscalls += 2;
+	channel->rounds++;
+	channel->bytes += sizeof(int) + size;
+}
+
+/*
+ * Appends the frame of the given message to the pending data.
+ */
+static void appendFrame(NativeSendChannel* channel, const char* msg, int size){
+	size_t offset = channel->pendingData.size();
+	channel->pendingData.resize(offset + sizeof(int) + size);
+	memcpy(channel->pendingData.data() + offset, &size, sizeof(int));
+	memcpy(channel->pendingData.data() + offset + sizeof(int), msg, size);
+	channel->messages++;
+}
+
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_initSendSocket
   (JNIEnv *env, jobject, jstring ip, jint port){
 
@@ -20,10 +105,10 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_initS
 
 	 if (connect){
 		 s->DisableNagle();
-		 return (long) s;
+		 return (long) new NativeSendChannel(s);
 	 } else{ 
-		 return 0;
 		 delete s;
+		 return 0;
 	 }
 
 }
@@ -31,14 +116,60 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_initS
 JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_send
   (JNIEnv *env, jobject, jlong sendSocketPtr, jbyteArray data){
 	  
-	  jbyte* msg = env->GetByteArrayElements(data, 0);
+	  NativeSendChannel* channel = (NativeSendChannel*) sendSocketPtr;
 
+	  jbyte* msg = env->GetByteArrayElements(data, 0);
 	  int size = env->GetArrayLength(data);
-	  ((CSocket*)sendSocketPtr)->Send(&size, sizeof(int));
-	  
-	  ((CSocket*)sendSocketPtr)->Send((char*)msg, size);
 
-	  env->ReleaseByteArrayElements(data, msg, 0);
+	  if (!channel->batching && size > MAX_COPIED_MESSAGE_SIZE){
+		  //copying a large message only to put the size before it costs more than the second Send call.
+		  sendUnframed(channel, (char*)msg, size);
+	  } else {
+		  //put the size and the message in one frame, so they will be sent together.
+		  appendFrame(channel, (char*)msg, size);
+		  if (!channel->batching || channel->pendingData.size() >= channel->threshold){
+			  flushPending(channel);
+		  }
+	  }
+
+	  //the array is only read, so there is no need to copy it back.
+	  env->ReleaseByteArrayElements(data, msg, JNI_ABORT);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_setBatching
+  (JNIEnv *, jobject, jlong sendSocketPtr, jboolean batching, jint threshold){
+	  NativeSendChannel* channel = (NativeSendChannel*) sendSocketPtr;
+
+	  //when batching is turned off, the pending messages should not wait for the next send.
+	  if (!batching){
+		  flushPending(channel);
+	  }
+
+	  channel->batching = batching;
+	  channel->threshold = (threshold > 0) ? threshold : DEFAULT_BATCH_THRESHOLD;
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_flush
+  (JNIEnv *, jobject, jlong sendSocketPtr){
+	  flushPending((NativeSendChannel*) sendSocketPtr);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_getSendCounters
+  (JNIEnv *env, jobject, jlong sendSocketPtr, jlongArray counters){
+	  NativeSendChannel* channel = (NativeSendChannel*) sendSocketPtr;
+
+	  jlong values[NUM_SEND_COUNTERS] = { channel->messages, channel->syscalls, channel->bytes, channel->rounds };
+	  env->SetLongArrayRegion(counters, 0, NUM_SEND_COUNTERS, values);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_resetSendCounters
+  (JNIEnv *, jobject, jlong sendSocketPtr){
+	  NativeSendChannel* channel = (NativeSendChannel*) sendSocketPtr;
+
+	  channel->messages = 0;
+	  channel->syscalls = 0;
+	  channel->bytes = 0;
+	  channel->rounds = 0;
 }
 
 
@@ -62,10 +193,16 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_
 
 JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_closeSockets
   (JNIEnv *, jobject, jlong sendSocketPtr, jlong receiveSocketPtr){
-	  ((CSocket*)sendSocketPtr)->Close();
+	  NativeSendChannel* channel = (NativeSendChannel*) sendSocketPtr;
+
+	  //do not lose messages that were batched but not flushed yet.
+	  flushPending(channel);
+
+	  channel->socket->Close();
 	  ((CSocket*)receiveSocketPtr)->Close();
 
-	  delete (CSocket*)sendSocketPtr;
+	  delete channel->socket;
+	  delete channel;
 	  delete (CSocket*)receiveSocketPtr;
 }
 
@@ -41,6 +41,38 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_
 JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_closeSockets
   (JNIEnv *, jobject, jlong, jlong);
 
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeChannel
+ * Method:    setBatching
+ * Signature: (JZI)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_setBatching
+  (JNIEnv *, jobject, jlong, jboolean, jint);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeChannel
+ * Method:    flush
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_flush
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeChannel
+ * Method:    getSendCounters
+ * Signature: (J[J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_getSendCounters
+  (JNIEnv *, jobject, jlong, jlongArray);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeChannel
+ * Method:    resetSendCounters
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_resetSendCounters
+  (JNIEnv *, jobject, jlong);
+
 //JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeChannel_enableNagle
  // (JNIEnv *, jobject, jlong, jlong);
 
@@ -1,4 +1,5 @@
 #include "OTExtensionMaliciousReceiverInterface.h"
+#include "../Common/ScapiProbes.h"
 
 maliciousot::OtExtensionMaliciousReceiverInterface::OtExtensionMaliciousReceiverInterface(const char* address, 
 									     int port,
@@ -70,7 +71,9 @@ BOOL maliciousot::OtExtensionMaliciousReceiverInterface::precompute_base_ots_rec
 	
   U.Create(m_num_base_ots * log_nVals, m_receiver_seed, cnt);
 	
+  SCAPI_PROBE1(base_ot_start, m_num_base_ots);
   m_baseot_handler->Receiver(nSndVals, m_num_base_ots, U, m_connection_manager->get_socket(0), pBuf);
+  SCAPI_PROBE1(base_ot_done, m_num_base_ots);
 	
   //Key expansion
   BYTE* pBufIdx = pBuf;
@@ -96,9 +99,11 @@ BOOL maliciousot::OtExtensionMaliciousReceiverInterface::obliviously_receive(CBi
     bool success = FALSE;
 
     // Execute OT receiver routine 	
+    SCAPI_PROBE2(ot_receive_start, numOTs, bitlength);
     success = m_receiver->receive(numOTs, bitlength, choices, ret, version, 
 				  m_connection_manager->get_num_of_threads(), 
 				  masking_function);
+    SCAPI_PROBE2(ot_receive_done, numOTs, bitlength);
     
     return success;
 }
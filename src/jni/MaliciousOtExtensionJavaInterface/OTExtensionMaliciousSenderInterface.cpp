@@ -1,4 +1,5 @@
 #include "OTExtensionMaliciousSenderInterface.h"
+#include "../Common/ScapiProbes.h"
 
 maliciousot::OtExtensionMaliciousSenderInterface::OtExtensionMaliciousSenderInterface(const char* address, 
 										      int port,
@@ -67,7 +68,9 @@ BOOL maliciousot::OtExtensionMaliciousSenderInterface::precompute_base_ots_sende
     BYTE* pBuf = new BYTE[SHA1_BYTES * m_num_base_ots * nSndVals];
 
     //=================================================	
+    SCAPI_PROBE1(base_ot_start, m_num_base_ots);
     m_baseot_handler->Sender(nSndVals, m_num_base_ots, m_connection_manager->get_socket(0), pBuf);
+    SCAPI_PROBE1(base_ot_done, m_num_base_ots);
 	
     BYTE* pBufIdx = pBuf;
     for(int i=0; i<m_num_base_ots * nSndVals; i++) {
@@ -93,9 +96,11 @@ BOOL maliciousot::OtExtensionMaliciousSenderInterface::obliviously_send(CBitVect
     int nSndVals = 2; //Perform 1-out-of-2 OT
     
     // Execute OT sender routine
+    SCAPI_PROBE2(ot_send_start, num_ots, bitlength);
     success = m_sender->send(num_ots, bitlength, X1, X2, version, 
 			     m_connection_manager->get_num_of_threads(), 
 			     masking_function);
+    SCAPI_PROBE2(ot_send_done, num_ots, bitlength);
     
     return success;
 }
@@ -0,0 +1,219 @@
+#include "CommitmentVerifier.h"
+
+#include <string.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <openssl/evp.h>
+#include <immintrin.h>
+
+using namespace std;
+
+//Batches smaller than this are verified by the calling thread.
+#define MIN_COMMITMENTS_PER_THREAD 2048
+#define MAX_VERIFY_THREADS 8
+#define SHA256_LANES 8
+
+static const uint32_t SHA256_K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t SHA256_IV[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+bool multiBufferSha256Supported(){
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+#else
+	return false;
+#endif
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#define ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+__attribute__((target("avx2")))
+void sha256x8(const unsigned char* r, int rSize, const unsigned char* x, int xSize, unsigned char* digests){
+	int length = rSize + xSize;
+
+	//Build the single padded block of each message and transpose it, so that word t of all the lanes is in w[t].
+	unsigned char blocks[SHA256_LANES][64];
+	uint32_t words[16][SHA256_LANES] __attribute__((aligned(32)));
+	for (int lane = 0; lane < SHA256_LANES; lane++){
+		unsigned char* block = blocks[lane];
+		memcpy(block, r + lane*rSize, rSize);
+		memcpy(block + rSize, x + lane*xSize, xSize);
+		memset(block + length, 0, 64 - length);
+		block[length] = 0x80;
+		uint64_t bits = (uint64_t) length * 8;
+		for (int i = 0; i < 8; i++){
+			block[63 - i] = (unsigned char) (bits >> (8 * i));
+		}
+		for (int t = 0; t < 16; t++){
+			words[t][lane] = ((uint32_t) block[4*t] << 24) | ((uint32_t) block[4*t + 1] << 16) | ((uint32_t) block[4*t + 2] << 8) | block[4*t + 3];
+		}
+	}
+
+	__m256i w[64];
+	for (int t = 0; t < 16; t++){
+		w[t] = _mm256_load_si256((const __m256i*) words[t]);
+	}
+	for (int t = 16; t < 64; t++){
+		__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROTR(w[t-15], 7), ROTR(w[t-15], 18)), _mm256_srli_epi32(w[t-15], 3));
+		__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROTR(w[t-2], 17), ROTR(w[t-2], 19)), _mm256_srli_epi32(w[t-2], 10));
+		w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t-16], s0), _mm256_add_epi32(w[t-7], s1));
+	}
+
+	__m256i state[8];
+	for (int i = 0; i < 8; i++){
+		state[i] = _mm256_set1_epi32((int) SHA256_IV[i]);
+	}
+	__m256i a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+
+	for (int t = 0; t < 64; t++){
+		__m256i S1 = _mm256_xor_si256(_mm256_xor_si256(ROTR(e, 6), ROTR(e, 11)), ROTR(e, 25));
+		__m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+		__m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, S1), _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32((int) SHA256_K[t]), w[t])));
+		__m256i S0 = _mm256_xor_si256(_mm256_xor_si256(ROTR(a, 2), ROTR(a, 13)), ROTR(a, 22));
+		__m256i maj = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)), _mm256_and_si256(b, c));
+		__m256i t2 = _mm256_add_epi32(S0, maj);
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(t1, t2);
+	}
+
+	state[0] = _mm256_add_epi32(state[0], a);
+	state[1] = _mm256_add_epi32(state[1], b);
+	state[2] = _mm256_add_epi32(state[2], c);
+	state[3] = _mm256_add_epi32(state[3], d);
+	state[4] = _mm256_add_epi32(state[4], e);
+	state[5] = _mm256_add_epi32(state[5], f);
+	state[6] = _mm256_add_epi32(state[6], g);
+	state[7] = _mm256_add_epi32(state[7], h);
+
+	//Transpose back and write each digest in big endian.
+	uint32_t out[8][SHA256_LANES] __attribute__((aligned(32)));
+	for (int i = 0; i < 8; i++){
+		_mm256_store_si256((__m256i*) out[i], state[i]);
+	}
+	for (int lane = 0; lane < SHA256_LANES; lane++){
+		unsigned char* digest = digests + lane*32;
+		for (int i = 0; i < 8; i++){
+			uint32_t word = out[i][lane];
+			digest[4*i] = (unsigned char) (word >> 24);
+			digest[4*i + 1] = (unsigned char) (word >> 16);
+			digest[4*i + 2] = (unsigned char) (word >> 8);
+			digest[4*i + 3] = (unsigned char) word;
+		}
+	}
+}
+
+#else
+
+void sha256x8(const unsigned char*, int, const unsigned char*, int, unsigned char*){
+}
+
+#endif
+
+/*
+ * Returns the OpenSSL digest whose output size is hashSize, or NULL if there is no such digest.
+ */
+static const EVP_MD* getDigest(int hashSize){
+	switch (hashSize){
+	case 20: return EVP_sha1();
+	case 28: return EVP_sha224();
+	case 32: return EVP_sha256();
+	case 48: return EVP_sha384();
+	case 64: return EVP_sha512();
+	default: return NULL;
+	}
+}
+
+/*
+ * Hashes the commitments from..to-1 and returns the OR of all the differences between the results and the commitments,
+ * so the returned value is zero only if all the commitments are correct.
+ */
+static unsigned char verifyRange(const unsigned char* commitments, const unsigned char* r, const unsigned char* x, int from, int to,
+								 int hashSize, int valueSize, const EVP_MD* md){
+	unsigned char difference = 0;
+	unsigned char output[EVP_MAX_MD_SIZE * SHA256_LANES];
+	int j = from;
+
+	if (hashSize == 32 && hashSize + valueSize <= 55 && multiBufferSha256Supported()){
+		for (; j + SHA256_LANES <= to; j += SHA256_LANES){
+			sha256x8(r + j*hashSize, hashSize, x + j*valueSize, valueSize, output);
+			const unsigned char* expected = commitments + j*hashSize;
+			for (int i = 0; i < SHA256_LANES * 32; i++){
+				difference |= output[i] ^ expected[i];
+			}
+		}
+	}
+
+	//The remaining commitments are hashed one by one.
+	EVP_MD_CTX* ctx = EVP_MD_CTX_create();
+	for (; j < to; j++){
+		unsigned int size;
+		EVP_DigestInit_ex(ctx, md, NULL);
+		EVP_DigestUpdate(ctx, r + j*hashSize, hashSize);
+		EVP_DigestUpdate(ctx, x + j*valueSize, valueSize);
+		EVP_DigestFinal_ex(ctx, output, &size);
+		const unsigned char* expected = commitments + j*hashSize;
+		for (int i = 0; i < hashSize; i++){
+			difference |= output[i] ^ expected[i];
+		}
+	}
+	EVP_MD_CTX_destroy(ctx);
+
+	return difference;
+}
+
+bool verifyCommitments(const unsigned char* commitments, const unsigned char* r, const unsigned char* x, int rounds, int hashSize, int valueSize){
+	const EVP_MD* md = getDigest(hashSize);
+	if (md == NULL){
+		return false;
+	}
+
+	int numThreads = min((int) thread::hardware_concurrency(), MAX_VERIFY_THREADS);
+	numThreads = min(numThreads, rounds / MIN_COMMITMENTS_PER_THREAD);
+	if (numThreads <= 1){
+		return verifyRange(commitments, r, x, 0, rounds, hashSize, valueSize, md) == 0;
+	}
+
+	//Split the commitments between the threads, in multiples of the number of lanes.
+	int perThread = ((rounds / numThreads + SHA256_LANES - 1) / SHA256_LANES) * SHA256_LANES;
+	vector<unsigned char> differences(numThreads, 0);
+	vector<thread> threads;
+	for (int t = 0; t < numThreads; t++){
+		int from = t * perThread;
+		int to = min(rounds, from + perThread);
+		if (from >= to){
+			break;
+		}
+		threads.push_back(thread([=, &differences](){
+			differences[t] = verifyRange(commitments, r, x, from, to, hashSize, valueSize, md);
+		}));
+	}
+
+	unsigned char difference = 0;
+	for (size_t t = 0; t < threads.size(); t++){
+		threads[t].join();
+		difference |= differences[t];
+	}
+	return difference == 0;
+}
@@ -0,0 +1,36 @@
+#ifndef COMMITMENT_VERIFIER_H
+#define COMMITMENT_VERIFIER_H
+
+/**
+ * Verification of many simple hash commitments, comm_j = H(r_j || x_j), where all the r_j have the same length (the
+ * size of the hash output) and all the x_j have the same length.
+ *
+ * When the hash is SHA-256 and each r_j || x_j fits in a single SHA-256 block (up to 55 bytes), the commitments are
+ * hashed eight at a time in the lanes of AVX2 registers. Otherwise (or on CPUs without AVX2) each commitment is hashed
+ * with OpenSSL. The hash is chosen by its output size: 20 bytes for SHA-1, 28/32/48/64 bytes for the SHA-2 family.
+ *
+ * The comparison is done in constant time: all the commitments are hashed and compared, and the result does not depend
+ * on where a mismatch was found. Large batches are split between several threads.
+ */
+
+/**
+ * Returns true if all the commitments are correct, false if at least one of them is not (or the hash size is not supported).
+ * param commitments	: rounds commitments of hashSize bytes each, one after the other.
+ * param r				: rounds random values of hashSize bytes each.
+ * param x				: rounds committed values of valueSize bytes each.
+ */
+bool verifyCommitments(const unsigned char* commitments, const unsigned char* r, const unsigned char* x, int rounds, int hashSize, int valueSize);
+
+/**
+ * Computes SHA-256 of eight messages of length rSize + xSize (at most 55 bytes), where message i is r + i*rSize
+ * followed by x + i*xSize. Writes the eight 32 byte digests, one after the other, to digests.
+ * Should only be called when multiBufferSha256Supported() returns true.
+ */
+void sha256x8(const unsigned char* r, int rSize, const unsigned char* x, int xSize, unsigned char* digests);
+
+/**
+ * Returns true if the CPU supports the eight lanes implementation of SHA-256.
+ */
+bool multiBufferSha256Supported();
+
+#endif
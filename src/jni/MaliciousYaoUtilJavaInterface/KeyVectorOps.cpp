@@ -0,0 +1,188 @@
+#include "KeyVectorOps.h"
+#include <string.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+static bool avx2Supported(){
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+#else
+	return false;
+#endif
+}
+
+/*
+ * Each operation has a 128 bit implementation that handles any size, and (with gcc/clang) an AVX2 implementation that
+ * handles the 32 byte chunks and leaves the rest to the 128 bit one.
+ * All the loads and stores are unaligned, since the buffers are usually pinned java arrays.
+ */
+
+static void xorKeyVectors128(const unsigned char* a, const unsigned char* b, unsigned char* out, int size){
+	int i = 0;
+	for (; i + 16 <= size; i += 16){
+		__m128i x = _mm_loadu_si128((const __m128i*) (a + i));
+		__m128i y = _mm_loadu_si128((const __m128i*) (b + i));
+		_mm_storeu_si128((__m128i*) (out + i), _mm_xor_si128(x, y));
+	}
+	for (; i < size; i++){
+		out[i] = a[i] ^ b[i];
+	}
+}
+
+static void maskKeyVector128(const unsigned char* keys, __m128i mask, unsigned char* out, int numKeys){
+	for (int i = 0; i < numKeys; i++){
+		__m128i key = _mm_loadu_si128((const __m128i*) (keys + 16*i));
+		_mm_storeu_si128((__m128i*) (out + 16*i), _mm_xor_si128(key, mask));
+	}
+}
+
+static void selectKeys128(const unsigned char* keys0, const unsigned char* keys1, const unsigned char* bits, unsigned char* out, int numKeys){
+	for (int i = 0; i < numKeys; i++){
+		//All ones if the bit is set, all zeros otherwise.
+		__m128i choice = _mm_set1_epi8((char) -(bits[i] != 0));
+		__m128i k0 = _mm_loadu_si128((const __m128i*) (keys0 + 16*i));
+		__m128i k1 = _mm_loadu_si128((const __m128i*) (keys1 + 16*i));
+		__m128i selected = _mm_xor_si128(k0, _mm_and_si128(choice, _mm_xor_si128(k0, k1)));
+		_mm_storeu_si128((__m128i*) (out + 16*i), selected);
+	}
+}
+
+static __m128i differences128(const unsigned char* a, const unsigned char* b, int size, int& done){
+	__m128i diff = _mm_setzero_si128();
+	int i = 0;
+	for (; i + 16 <= size; i += 16){
+		__m128i x = _mm_loadu_si128((const __m128i*) (a + i));
+		__m128i y = _mm_loadu_si128((const __m128i*) (b + i));
+		diff = _mm_or_si128(diff, _mm_xor_si128(x, y));
+	}
+	done = i;
+	return diff;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+__attribute__((target("avx2")))
+static int xorKeyVectors256(const unsigned char* a, const unsigned char* b, unsigned char* out, int size){
+	int i = 0;
+	for (; i + 32 <= size; i += 32){
+		__m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+		__m256i y = _mm256_loadu_si256((const __m256i*) (b + i));
+		_mm256_storeu_si256((__m256i*) (out + i), _mm256_xor_si256(x, y));
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static int maskKeyVector256(const unsigned char* keys, const unsigned char* mask, unsigned char* out, int numKeys){
+	__m256i mask2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) mask));
+	int i = 0;
+	for (; i + 2 <= numKeys; i += 2){
+		__m256i twoKeys = _mm256_loadu_si256((const __m256i*) (keys + 16*i));
+		_mm256_storeu_si256((__m256i*) (out + 16*i), _mm256_xor_si256(twoKeys, mask2));
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static int selectKeys256(const unsigned char* keys0, const unsigned char* keys1, const unsigned char* bits, unsigned char* out, int numKeys){
+	int i = 0;
+	for (; i + 2 <= numKeys; i += 2){
+		//The low half of the choice belongs to key i and the high half to key i+1.
+		__m256i choice = _mm256_setr_m128i(_mm_set1_epi8((char) -(bits[i] != 0)), _mm_set1_epi8((char) -(bits[i + 1] != 0)));
+		__m256i k0 = _mm256_loadu_si256((const __m256i*) (keys0 + 16*i));
+		__m256i k1 = _mm256_loadu_si256((const __m256i*) (keys1 + 16*i));
+		__m256i selected = _mm256_xor_si256(k0, _mm256_and_si256(choice, _mm256_xor_si256(k0, k1)));
+		_mm256_storeu_si256((__m256i*) (out + 16*i), selected);
+	}
+	return i;
+}
+
+__attribute__((target("avx2")))
+static int differences256(const unsigned char* a, const unsigned char* b, int size, __m128i& diff){
+	__m256i diff2 = _mm256_setzero_si256();
+	int i = 0;
+	for (; i + 32 <= size; i += 32){
+		__m256i x = _mm256_loadu_si256((const __m256i*) (a + i));
+		__m256i y = _mm256_loadu_si256((const __m256i*) (b + i));
+		diff2 = _mm256_or_si256(diff2, _mm256_xor_si256(x, y));
+	}
+	diff = _mm_or_si128(_mm256_castsi256_si128(diff2), _mm256_extracti128_si256(diff2, 1));
+	return i;
+}
+
+#endif
+
+void xorKeyVectors(const unsigned char* a, const unsigned char* b, unsigned char* out, int size){
+	int done = 0;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	if (avx2Supported()){
+		done = xorKeyVectors256(a, b, out, size);
+	}
+#endif
+	xorKeyVectors128(a + done, b + done, out + done, size - done);
+}
+
+void maskKeyVector(const unsigned char* keys, const unsigned char* mask, unsigned char* out, int numKeys, int keySize){
+	if (keySize != 16){
+		for (int i = 0; i < numKeys; i++){
+			xorKeyVectors128(keys + i*keySize, mask, out + i*keySize, keySize);
+		}
+		return;
+	}
+
+	int done = 0;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	if (avx2Supported()){
+		done = maskKeyVector256(keys, mask, out, numKeys);
+	}
+#endif
+	maskKeyVector128(keys + 16*done, _mm_loadu_si128((const __m128i*) mask), out + 16*done, numKeys - done);
+}
+
+void selectKeys(const unsigned char* keys0, const unsigned char* keys1, const unsigned char* bits, unsigned char* out, int numKeys, int keySize){
+	if (keySize != 16){
+		for (int i = 0; i < numKeys; i++){
+			unsigned char choice = (unsigned char) -(bits[i] != 0);
+			for (int j = 0; j < keySize; j++){
+				int index = i*keySize + j;
+				out[index] = keys0[index] ^ (choice & (keys0[index] ^ keys1[index]));
+			}
+		}
+		return;
+	}
+
+	int done = 0;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	if (avx2Supported()){
+		done = selectKeys256(keys0, keys1, bits, out, numKeys);
+	}
+#endif
+	selectKeys128(keys0 + 16*done, keys1 + 16*done, bits + done, out + 16*done, numKeys - done);
+}
+
+bool equalKeyVectors(const unsigned char* a, const unsigned char* b, int size){
+	__m128i diff = _mm_setzero_si128();
+	int done = 0;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	if (avx2Supported()){
+		done = differences256(a, b, size, diff);
+	}
+#endif
+	int done128;
+	diff = _mm_or_si128(diff, differences128(a + done, b + done, size - done, done128));
+	done += done128;
+
+	unsigned char tail = 0;
+	for (int i = done; i < size; i++){
+		tail |= a[i] ^ b[i];
+	}
+
+	//Fold all the differences to a single byte without branching on the content.
+	unsigned char lanes[16];
+	_mm_storeu_si128((__m128i*) lanes, diff);
+	for (int i = 0; i < 16; i++){
+		tail |= lanes[i];
+	}
+	return tail == 0;
+}
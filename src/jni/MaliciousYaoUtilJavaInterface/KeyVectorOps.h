@@ -0,0 +1,36 @@
+#ifndef KEY_VECTOR_OPS_H
+#define KEY_VECTOR_OPS_H
+
+/**
+ * Operations on vectors of keys, where a vector is a byte array that holds the keys one after the other.
+ *
+ * The operations work on whole vectors (e.g. all the input keys of a bundle) in a single pass. On CPUs that support AVX2
+ * two keys are processed in each 256 bit register, otherwise one key in each 128 bit register. Any of the outputs may be
+ * the same buffer as one of the inputs, so the operations can be done in place.
+ *
+ * The select and equal operations run in a time that does not depend on the selection bits or on the content of the keys.
+ */
+
+/**
+ * out = a XOR b, byte by byte. All the buffers contain size bytes.
+ */
+void xorKeyVectors(const unsigned char* a, const unsigned char* b, unsigned char* out, int size);
+
+/**
+ * Xors each key in the given vector with the given mask (of keySize bytes) and puts the result in out.
+ * param numKeys	: the number of keys in keys and out, each of keySize bytes.
+ */
+void maskKeyVector(const unsigned char* keys, const unsigned char* mask, unsigned char* out, int numKeys, int keySize);
+
+/**
+ * For each key index i, copies key i of keys1 to key i of out if bits[i] is not zero, and key i of keys0 otherwise.
+ * param bits		: numKeys bytes, one for each key.
+ */
+void selectKeys(const unsigned char* keys0, const unsigned char* keys1, const unsigned char* bits, unsigned char* out, int numKeys, int keySize);
+
+/**
+ * Returns true if the size bytes of a and b are equal.
+ */
+bool equalKeyVectors(const unsigned char* a, const unsigned char* b, int size);
+
+#endif
@@ -1,5 +1,8 @@
 #include "MaliciousYaoUtil.h"
 #include "TedKrovetzAesNiWrapperC.h"
+#include "../Common/HugePageAllocator.h"
+#include "CommitmentVerifier.h"
+#include "KeyVectorOps.h"
 #include <iostream>
 
 
@@ -8,8 +11,8 @@ using namespace std;
 JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatrix_restoreKeys
   (JNIEnv *env, jobject, jbyteArray receivedKeysArray, jobjectArray matrixArray, int n, int m, jbyteArray restoredKeysArray){
 
-	  block* receivedKeys = (block *)  _mm_malloc(sizeof(block) * m, 16);
-	  block* restoredKeys = (block *)  _mm_malloc(sizeof(block) * n, 16);
+	  block* receivedKeys = (block *)  scapi_native::alignedAlloc(sizeof(block) * m, 16);
+	  block* restoredKeys = (block *)  scapi_native::alignedAlloc(sizeof(block) * n, 16);
 	  
 	  jbyte *carr = env->GetByteArrayElements(receivedKeysArray, 0);
 	  memcpy(receivedKeys, carr, sizeof(block) * m);
@@ -31,8 +34,8 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
 	  env->SetByteArrayRegion(restoredKeysArray, 0, n*SIZE_OF_BLOCK,  (jbyte*)restoredKeys);
 
 	  env->ReleaseByteArrayElements(receivedKeysArray,carr,JNI_ABORT);
-	  _mm_free(receivedKeys);
-	  _mm_free(restoredKeys);
+	  scapi_native::alignedFree(receivedKeys);
+	  scapi_native::alignedFree(restoredKeys);
 
 	  delete matrix;
 
@@ -45,17 +48,17 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
 	  jbyte *probeResistantKeys = env->GetByteArrayElements(probeResistantKeysBytes, 0);
 	  jbyte *seed = env->GetByteArrayElements(seedBytes, 0);
 
-	  block* originalKeysb = (block *)  _mm_malloc(sizeof(block) * n * 2, 16);
-	  block* probeResistantKeysb = (block *)  _mm_malloc(sizeof(block) * m * 2, 16);
-	  block* newKeysb = (block *)  _mm_malloc(sizeof(block) * n, 16);
-	  block * indexArray = (block *)_mm_malloc(sizeof(block) * n, 16);
+	  block* originalKeysb = (block *)  scapi_native::alignedAlloc(sizeof(block) * n * 2, 16);
+	  block* probeResistantKeysb = (block *)  scapi_native::alignedAlloc(sizeof(block) * m * 2, 16);
+	  block* newKeysb = (block *)  scapi_native::alignedAlloc(sizeof(block) * n, 16);
+	  block * indexArray = (block *)scapi_native::alignedAlloc(sizeof(block) * n, 16);
 	
 	  for (int i = 0; i < n; i++){
 
 		indexArray[i] = _mm_set_epi32(0, 0, 0, i);
 	  }
 
-	  AES_KEY * aesSeedKey = (AES_KEY *)_mm_malloc(sizeof(AES_KEY), 16);
+	  AES_KEY * aesSeedKey = (AES_KEY *)scapi_native::alignedAlloc(sizeof(AES_KEY), 16);
 	  AES_set_encrypt_key((const unsigned char *)seed, 128, aesSeedKey);
 	  AES_ecb_encrypt_chunk_in_out(indexArray, newKeysb, n, aesSeedKey);
 
@@ -82,11 +85,11 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
 	 env->ReleaseByteArrayElements(originalKeysBytes,originalKeys,0);
 	 env->ReleaseByteArrayElements(seedBytes,seed,0);
 
-	 _mm_free(originalKeysb);
-	 _mm_free(probeResistantKeysb);
-	 _mm_free(newKeysb);
-	 _mm_free(indexArray);
-	 _mm_free(aesSeedKey);
+	 scapi_native::alignedFree(originalKeysb);
+	 scapi_native::alignedFree(probeResistantKeysb);
+	 scapi_native::alignedFree(newKeysb);
+	 scapi_native::alignedFree(indexArray);
+	 scapi_native::alignedFree(aesSeedKey);
 
 	 delete matrix;
 }
@@ -95,7 +98,7 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
   (JNIEnv *env, jobject, jbyteArray probeResistantKeysBytes, jbyteArray originalKey0Bytes, jbyteArray originalKey1Bytes, 
   int i, jbyteArray newKeyBytes, int n, int m, jobjectArray matrixArray){
 	  
-	  block* probeResistantKeys = (block *)  _mm_malloc(sizeof(block) * m * 2, 16);
+	  block* probeResistantKeys = (block *)  scapi_native::alignedAlloc(sizeof(block) * m * 2, 16);
 	  
 	  jbyte *carr = env->GetByteArrayElements(probeResistantKeysBytes, 0);
 	  jbyte *key0 = env->GetByteArrayElements(originalKey0Bytes, 0);
@@ -128,104 +131,147 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
 	  env->ReleaseByteArrayElements(originalKey1Bytes, (jbyte*)key1, JNI_ABORT);
 	  env->ReleaseByteArrayElements(newKeyBytes, (jbyte*) newKey, JNI_ABORT);
 
-	  _mm_free(probeResistantKeys);
+	  scapi_native::alignedFree(probeResistantKeys);
 
 	  delete matrix;
 }
 
-JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_xorKeysWithMask
-  (JNIEnv *env, jobject, jbyteArray keysArray, jbyteArray maskBytes, int size){
-
-	  block* keysBlocks = (block *)  _mm_malloc(sizeof(block) * size, 16);
-	 
-	  jbyte *keys = env->GetByteArrayElements(keysArray, 0);
-	  jbyte *maskArray = env->GetByteArrayElements(maskBytes, 0);
-	  
-	  memcpy(keysBlocks, keys, sizeof(block) * size);
-	   
-	  block mask;
-	  memcpy(&mask, maskArray, sizeof(block));
-	 
-	  for (int i = 0; i < size; i++) {
-		keysBlocks[i] =  _mm_xor_si128(keysBlocks[i], mask);
+/*
+ * Pins up to four java arrays with GetPrimitiveArrayCritical and releases them in the reverse order.
+ * An array that is the same object as one that was already pinned gets the same pointer, so the key vector operations can
+ * write their output over one of their inputs. No other jni function may be called while the arrays are pinned.
+ */
+class CriticalArrays {
+	JNIEnv* env;
+	jbyteArray arrays[4];
+	unsigned char* elements[4];
+	int alias[4];		//The index of an earlier array that is the same object, or -1.
+	int count;
+
+public:
+	CriticalArrays(JNIEnv* env) : env(env), count(0) {}
+
+	//Should be called for all the arrays before the first call to get.
+	void add(jbyteArray array) {
+		arrays[count] = array;
+		elements[count] = NULL;
+		alias[count] = -1;
+		for (int i = 0; i < count; i++) {
+			if (alias[i] == -1 && env->IsSameObject(arrays[i], array)) {
+				alias[count] = i;
+				break;
+			}
+		}
+		count++;
 	}
 
-	  env->ReleaseByteArrayElements(keysArray,keys,JNI_ABORT);
-	  env->ReleaseByteArrayElements(maskBytes,maskArray,JNI_ABORT);
+	void pin() {
+		for (int i = 0; i < count; i++) {
+			if (alias[i] == -1) {
+				elements[i] = (unsigned char*) env->GetPrimitiveArrayCritical(arrays[i], 0);
+			} else {
+				elements[i] = elements[alias[i]];
+			}
+		}
+	}
 
-	  env->SetByteArrayRegion(keysArray, 0, size*SIZE_OF_BLOCK,  (jbyte*)keysBlocks);
+	unsigned char* get(int i) { return elements[i]; }
 
-	   _mm_free(keysBlocks);
+	bool valid() {
+		for (int i = 0; i < count; i++) {
+			if (elements[i] == NULL) return false;
+		}
+		return true;
+	}
 
+	~CriticalArrays() {
+		for (int i = count - 1; i >= 0; i--) {
+			if (alias[i] == -1 && elements[i] != NULL) {
+				//Mode 0 copies the content back if the vm gave us a copy. The inputs are not changed so this is harmless for them.
+				env->ReleasePrimitiveArrayCritical(arrays[i], elements[i], 0);
+			}
+		}
+	}
+};
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KeyVectorOps_xor
+  (JNIEnv *env, jclass, jbyteArray a, jbyteArray b, jbyteArray output, jint size){
+
+	  CriticalArrays pinned(env);
+	  pinned.add(a);
+	  pinned.add(b);
+	  pinned.add(output);
+	  pinned.pin();
+	  if (pinned.valid()) {
+		  xorKeyVectors(pinned.get(0), pinned.get(1), pinned.get(2), size);
+	  }
 }
 
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KeyVectorOps_mask
+  (JNIEnv *env, jclass, jbyteArray keys, jbyteArray mask, jbyteArray output, jint numKeys, jint keySize){
 
-JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_xorKeys
-  (JNIEnv * env, jobject, jbyteArray keys1Array, jbyteArray keys2Array, jbyteArray output, int size){
-	  
-	  block* keys1Blocks = (block *)  _mm_malloc(sizeof(block) * size, 16);
-	  block* keys2Blocks = (block *)  _mm_malloc(sizeof(block) * size, 16);
-	  block* outputBlocks = (block *)  _mm_malloc(sizeof(block) * size, 16);
-	 
-	  jbyte *keys1 = env->GetByteArrayElements(keys1Array, 0);
-	  jbyte *keys2 = env->GetByteArrayElements(keys2Array, 0);
-	  
-	  memcpy(keys1Blocks, keys1, sizeof(block) * size);
-	  memcpy(keys2Blocks, keys2, sizeof(block) * size);
-	   
-	  for (int i = 0; i < size; i++) {
-		outputBlocks[i] =  _mm_xor_si128(keys1Blocks[i], keys2Blocks[i]);
-	}
-
-	  env->ReleaseByteArrayElements(keys1Array,keys1,JNI_ABORT);
-	  env->ReleaseByteArrayElements(keys1Array,keys2,JNI_ABORT);
+	  CriticalArrays pinned(env);
+	  pinned.add(keys);
+	  pinned.add(mask);
+	  pinned.add(output);
+	  pinned.pin();
+	  if (pinned.valid()) {
+		  maskKeyVector(pinned.get(0), pinned.get(1), pinned.get(2), numKeys, keySize);
+	  }
+}
 
-	  env->SetByteArrayRegion(output, 0, size*SIZE_OF_BLOCK,  (jbyte*)outputBlocks);
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KeyVectorOps_select
+  (JNIEnv *env, jclass, jbyteArray keys0, jbyteArray keys1, jbyteArray bits, jbyteArray output, jint numKeys, jint keySize){
+
+	  CriticalArrays pinned(env);
+	  pinned.add(keys0);
+	  pinned.add(keys1);
+	  pinned.add(bits);
+	  pinned.add(output);
+	  pinned.pin();
+	  if (pinned.valid()) {
+		  selectKeys(pinned.get(0), pinned.get(1), pinned.get(2), pinned.get(3), numKeys, keySize);
+	  }
+}
 
-	   _mm_free(keys2Blocks);
-	   _mm_free(outputBlocks);
+JNIEXPORT jboolean JNICALL Java_edu_biu_protocols_yao_primitives_KeyVectorOps_equal
+  (JNIEnv *env, jclass, jbyteArray a, jbyteArray b, jint size){
+
+	  bool equal = false;
+	  {
+		  CriticalArrays pinned(env);
+		  pinned.add(a);
+		  pinned.add(b);
+		  pinned.pin();
+		  if (pinned.valid()) {
+			  equal = equalKeyVectors(pinned.get(0), pinned.get(1), size);
+		  }
+	  }
+	  return equal;
 }
 
 
 JNIEXPORT bool JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitment
 	(JNIEnv * env, jobject, jbyteArray commitment, jbyteArray rArray, jbyteArray xArray){
 
+		int rounds = env->GetArrayLength(xArray)/SIZE_OF_BLOCK;
+		if (rounds == 0){
+			return true;
+		}
+		int hashSize = env->GetArrayLength(rArray)/rounds;
+
 		jbyte *comm = env->GetByteArrayElements(commitment, 0);
 		jbyte *r = env->GetByteArrayElements(rArray, 0);
 		jbyte *x = env->GetByteArrayElements(xArray, 0);
 
-		SHA_CTX sha;
-		
-		int rounds = env->GetArrayLength(xArray)/SIZE_OF_BLOCK;
-		int hashSize = env->GetArrayLength(rArray)/rounds;
+		//Hash all the commitments (in parallel lanes and threads where possible) and compare them in constant time.
+		//The hash function is the one whose output size matches the commitments.
+		bool verified = verifyCommitments((unsigned char*) comm, (unsigned char*) r, (unsigned char*) x, rounds, hashSize, SIZE_OF_BLOCK);
 
-		char* output = new char[hashSize];
-		
-		for (int j=0; j<rounds; j++){
-			SHA1_Init(&sha);
-			SHA1_Update(&sha, r+j*hashSize, hashSize);
-			SHA1_Update(&sha, x+j*SIZE_OF_BLOCK, SIZE_OF_BLOCK);
-			SHA1_Final((unsigned char*) output, &sha);
-			
-			bool equal = true;
-			for (int i=0; i<hashSize; i++){
-				if (output[i] != (comm+j*hashSize)[i]){
-					cout<<"not equal. j = "<<j<< endl;
-					delete output;
-					env->ReleaseByteArrayElements(commitment,comm,JNI_ABORT);
-					env->ReleaseByteArrayElements(rArray,r,JNI_ABORT);
-					env->ReleaseByteArrayElements(xArray,x,JNI_ABORT);
-
-					return false;
-				}
-			}
-		}
-
-		delete output;
 		env->ReleaseByteArrayElements(commitment,comm,JNI_ABORT);
 		env->ReleaseByteArrayElements(rArray,r,JNI_ABORT);
 		env->ReleaseByteArrayElements(xArray,x,JNI_ABORT);
 
-		return true;
+		return verified;
 }
 
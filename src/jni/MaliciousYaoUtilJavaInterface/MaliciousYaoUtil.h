@@ -32,15 +32,24 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
  * Method:    restoreKeys
  * Signature: ([B)[B
  */                         
-JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_xorKeysWithMask
-  (JNIEnv *, jobject, jbyteArray, jbyteArray, int);
-
-JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_xorKeys
-  (JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray, int);
-
 JNIEXPORT bool JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitment
 	(JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray);
 
+/*
+ * Class:     edu_biu_protocols_yao_primitives_KeyVectorOps
+ */
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KeyVectorOps_xor
+  (JNIEnv *, jclass, jbyteArray, jbyteArray, jbyteArray, jint);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KeyVectorOps_mask
+  (JNIEnv *, jclass, jbyteArray, jbyteArray, jbyteArray, jint, jint);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KeyVectorOps_select
+  (JNIEnv *, jclass, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jint, jint);
+
+JNIEXPORT jboolean JNICALL Java_edu_biu_protocols_yao_primitives_KeyVectorOps_equal
+  (JNIEnv *, jclass, jbyteArray, jbyteArray, jint);
+
 #ifdef __cplusplus
 }
 #endif
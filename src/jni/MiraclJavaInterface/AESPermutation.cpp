@@ -35,6 +35,8 @@ extern "C" {
 #include <miracl.h>
 }
 #include "AESPermutation.h"
+#include "../Common/CounterBlocks.h"
+#include "../Common/CbcChains.h"
 
 using namespace std;
 
@@ -178,3 +180,85 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_delete
   (JNIEnv *, jobject, jlong aesPointer){
 	  aes_end((aes*) aesPointer);
 }
+
+/* function computeCounterBlocks : This function computes the aes permutation on the counter blocks ctr, ctr+1, ... and writes 
+ *								   the first outLen bytes of the results to the output array.
+ *								   Miracl encrypts a block at a time, but all the blocks are computed in one call to the native code.
+ * param aesPointer				 : pointer to the aes struct
+ * param ctr					 : the first counter block. It is not changed.
+ * param outBytes				 : the output array.
+ * param outOffset				 : the offset in the output array to put the result from.
+ * param outLen					 : the number of bytes to write.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_computeCounterBlocks
+  (JNIEnv *env, jobject, jlong aesPointer, jbyteArray ctr, jbyteArray outBytes, jint outOffset, jint outLen){
+
+	  const int blockSize = 16;
+	  unsigned char counter[blockSize];
+	  env->GetByteArrayRegion(ctr, 0, blockSize, (jbyte*)counter);
+
+	  char* chunk = new char[scapi_native::COUNTER_CHUNK_BLOCKS * blockSize];
+	  int numBlocks = (outLen + blockSize - 1) / blockSize;
+	  int generated = 0;
+
+	  while (numBlocks > 0){
+		  int chunkBlocks = (numBlocks < scapi_native::COUNTER_CHUNK_BLOCKS) ? numBlocks : scapi_native::COUNTER_CHUNK_BLOCKS;
+		  scapi_native::fillCounterBlocks((unsigned char*)chunk, counter, chunkBlocks, blockSize);
+
+		  //aes_encrypt computes the block in place.
+		  for (int i = 0; i < chunkBlocks; i++){
+			  aes_encrypt((aes*)aesPointer, chunk + i * blockSize);
+		  }
+
+		  //The last block may be copied partially.
+		  int toCopy = (outLen - generated < chunkBlocks * blockSize) ? outLen - generated : chunkBlocks * blockSize;
+		  env->SetByteArrayRegion(outBytes, outOffset + generated, toCopy, (jbyte*)chunk);
+		  generated += toCopy;
+		  numBlocks -= chunkBlocks;
+	  }
+
+	  delete [] chunk;
+}
+
+/*
+ * Encrypts consecutive blocks in place, one block at a time.
+ */
+struct MiraclEncryptBlocks {
+	aes* a;
+
+	void operator()(unsigned char* blocks, int numBlocks) {
+		for (int i = 0; i < numBlocks; i++) {
+			aes_encrypt(a, (char*)blocks + i * scapi_native::CBC_BLOCK_SIZE);
+		}
+	}
+};
+
+/* function computeCbcChains	 : This function computes the CBC chains of numMsgs messages of msgLen bytes each, starting from 
+ *								   the given iv, and writes the final chaining value of each message to the output array. 
+ *								   The last block of each message is padded with zeros.
+ *								   Miracl encrypts a block at a time, but all the messages are computed in one call to the native code.
+ * param aesPointer				 : pointer to the aes struct
+ * param iv						 : the initial chaining value of every message.
+ * param inBytes				 : the messages, one after the other.
+ * param inOffset				 : the offset of the first message in the input array.
+ * param msgLen					 : the length of each message.
+ * param numMsgs				 : the number of messages.
+ * param outBytes				 : the output array.
+ * param outOffset				 : the offset in the output array to put the result from.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_computeCbcChains
+  (JNIEnv *env, jobject, jlong aesPointer, jbyteArray iv, jbyteArray inBytes, jint inOffset, jint msgLen, jint numMsgs, jbyteArray outBytes, jint outOffset){
+
+	  unsigned char chainIv[scapi_native::CBC_BLOCK_SIZE];
+	  env->GetByteArrayRegion(iv, 0, scapi_native::CBC_BLOCK_SIZE, (jbyte*)chainIv);
+
+	  //No jni calls are made while the arrays are held, so the critical versions can be used and the messages are not copied.
+	  unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(inBytes, 0);
+	  unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(outBytes, 0);
+
+	  MiraclEncryptBlocks encryptBlocks = { (aes*)aesPointer };
+	  scapi_native::computeCbcChains(encryptBlocks, chainIv, in + inOffset, msgLen, numMsgs, out + outOffset);
+
+	  env->ReleasePrimitiveArrayCritical(outBytes, out, 0);
+	  env->ReleasePrimitiveArrayCritical(inBytes, in, JNI_ABORT);
+}
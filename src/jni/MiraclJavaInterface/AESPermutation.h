@@ -55,6 +55,22 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_optimi
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_deleteAES
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_prf_miracl_MiraclAES
+ * Method:    computeCounterBlocks
+ * Signature: (J[B[BII)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_computeCounterBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_prf_miracl_MiraclAES
+ * Method:    computeCbcChains
+ * Signature: (J[B[BIII[BI)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_computeCbcChains
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint, jint, jbyteArray, jint);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,12 +34,41 @@
 #include <map>
 #include <string.h> // For memcpy
 #include <time.h> 
+#include <mutex>
+#include <random>
 extern "C" {
 #include <miracl.h>
 }
 #include "Dlog.h"
 #include "Utils.h"
 
+static std::once_flag miraclRngInitialized;
+static std::mutex miraclRngLock;
+static csprng miraclRng;
+
+/* function getRandomBytes : Fills the given buffer with random bytes of the miracl strong random generator.
+ *							 The generator is created and seeded once, by the first call to this function.
+ * param buffer			   : the buffer to fill
+ * param size			   : number of bytes to fill
+ */
+static void getRandomBytes(char* buffer, int size){
+	std::call_once(miraclRngInitialized, [](){
+		//Seed the generator with random bytes of the system and the time.
+		std::random_device device;
+		char raw[32];
+		for (int i=0; i<32; i++){
+			raw[i] = (char) device();
+		}
+		strong_init(&miraclRng, 32, raw, (mr_unsign32) time(NULL));
+	});
+
+	//The generator is shared by all the threads.
+	std::lock_guard<std::mutex> guard(miraclRngLock);
+	for (int i=0; i<size; i++){
+		buffer[i] = strong_rng(&miraclRng);
+	}
+}
+
 
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_miracl_MiraclAdapterDlogEC_createMip
   (JNIEnv *env, jobject obj){
@@ -386,7 +415,7 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogE
  * param yVal			  : y value of the generator
  * return			      : true if the generator is valid or not 
  */
-JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_miracl_MiraclAdapterDlogEC_validateF2mGenerator
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_validateF2mGenerator
   (JNIEnv *env, jobject obj, jlong m, jlong generator, jbyteArray xVal, jbyteArray yVal){
 	  /* convert the accepted parameters to MIRACL parameters*/
 	  miracl* mip = (miracl*)m;
@@ -574,17 +603,9 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp
 	  int counter = 0;
 	  bool success = 0;
 
-	  csprng rng;  
-      srand(time(0));
-	  long seed;  
-	  char raw = rand();
-	  time((time_t*)&seed);  
-	  strong_init(&rng,1,&raw,seed);                 
 	  do{
 		  
-			for (int i=0; i<l-k-2; i++){
-				  randomArray[i] = strong_rng(&rng);
-			}
+			getRandomBytes(randomArray, l-k-2);
 			
 			memcpy(newString, randomArray, l-k-2);
 			
@@ -27,8 +27,78 @@
 //
 
 #include "stdafx.h"
+#include <jni.h>
+#include "../Common/NativeRegistration.h"
+#include "Dlog.h"
+#include "ECF2mPoint.h"
+#include "ECFpPoint.h"
 
+static const JNINativeMethod eCF2mPointMiraclMethods[] = {
+	SCAPI_NATIVE_METHOD("createF2mPoint", "(J[B[B)J", Java_edu_biu_scapi_primitives_dlog_miracl_ECF2mPointMiracl_createF2mPoint),
+	SCAPI_NATIVE_METHOD("checkInfinityF2m", "(J)Z", Java_edu_biu_scapi_primitives_dlog_miracl_ECF2mPointMiracl_checkInfinityF2m),
+	SCAPI_NATIVE_METHOD("getXValueF2mPoint", "(JJ)[B", Java_edu_biu_scapi_primitives_dlog_miracl_ECF2mPointMiracl_getXValueF2mPoint),
+	SCAPI_NATIVE_METHOD("getYValueF2mPoint", "(JJ)[B", Java_edu_biu_scapi_primitives_dlog_miracl_ECF2mPointMiracl_getYValueF2mPoint),
+	SCAPI_NATIVE_METHOD("deletePointF2m", "(J)V", Java_edu_biu_scapi_primitives_dlog_miracl_ECF2mPointMiracl_deletePointF2m)
+};
 
+static const JNINativeMethod eCFpPointMiraclMethods[] = {
+	SCAPI_NATIVE_METHOD("createFpPoint", "(J[B[B)J", Java_edu_biu_scapi_primitives_dlog_miracl_ECFpPointMiracl_createFpPoint),
+	SCAPI_NATIVE_METHOD("checkInfinityFp", "(J)Z", Java_edu_biu_scapi_primitives_dlog_miracl_ECFpPointMiracl_checkInfinityFp),
+	SCAPI_NATIVE_METHOD("getXValueFpPoint", "(JJ)[B", Java_edu_biu_scapi_primitives_dlog_miracl_ECFpPointMiracl_getXValueFpPoint),
+	SCAPI_NATIVE_METHOD("getYValueFpPoint", "(JJ)[B", Java_edu_biu_scapi_primitives_dlog_miracl_ECFpPointMiracl_getYValueFpPoint),
+	SCAPI_NATIVE_METHOD("deletePointFp", "(J)V", Java_edu_biu_scapi_primitives_dlog_miracl_ECFpPointMiracl_deletePointFp)
+};
+
+static const JNINativeMethod miraclAdapterDlogECMethods[] = {
+	SCAPI_NATIVE_METHOD("createMip", "()J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclAdapterDlogEC_createMip),
+	SCAPI_NATIVE_METHOD("deleteMip", "(J)V", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclAdapterDlogEC_deleteMip)
+};
+
+static const JNINativeMethod miraclDlogECF2mMethods[] = {
+	SCAPI_NATIVE_METHOD("initF2mCurve", "(JIIII[B[B)V", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_initF2mCurve),
+	SCAPI_NATIVE_METHOD("validateF2mGenerator", "(JJ[B[B)Z", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_validateF2mGenerator),
+	SCAPI_NATIVE_METHOD("multiplyF2mPoints", "(JJJ)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_multiplyF2mPoints),
+	SCAPI_NATIVE_METHOD("simultaneousMultiplyF2m", "(J[J[[B)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_simultaneousMultiplyF2m),
+	SCAPI_NATIVE_METHOD("exponentiateF2mPoint", "(JJ[B)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_exponentiateF2mPoint),
+	SCAPI_NATIVE_METHOD("invertF2mPoint", "(JJ)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_invertF2mPoint),
+	SCAPI_NATIVE_METHOD("isF2mMember", "(JJ)Z", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_isF2mMember),
+	SCAPI_NATIVE_METHOD("createInfinityF2mPoint", "(J)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_createInfinityF2mPoint),
+	SCAPI_NATIVE_METHOD("initF2mExponentiateWithPrecomputedValues", "(JIIII[B[BJII)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_initF2mExponentiateWithPrecomputedValues),
+	SCAPI_NATIVE_METHOD("computeF2mExponentiateWithPrecomputedValues", "(JJ[B)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_computeF2mExponentiateWithPrecomputedValues),
+	SCAPI_NATIVE_METHOD("endF2mExponentiateWithPreComputedValues", "(J)V", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECF2m_endF2mExponentiateWithPreComputedValues)
+};
+
+static const JNINativeMethod miraclDlogECFpMethods[] = {
+	SCAPI_NATIVE_METHOD("initFpCurve", "(J[B[B[B)V", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_initFpCurve),
+	SCAPI_NATIVE_METHOD("multiplyFpPoints", "(JJJ)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_multiplyFpPoints),
+	SCAPI_NATIVE_METHOD("simultaneousMultiplyFp", "(J[J[[B)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_simultaneousMultiplyFp),
+	SCAPI_NATIVE_METHOD("exponentiateFpPoint", "(JJ[B)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_exponentiateFpPoint),
+	SCAPI_NATIVE_METHOD("invertFpPoint", "(JJ)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_invertFpPoint),
+	SCAPI_NATIVE_METHOD("validateFpGenerator", "(JJ[B[B)Z", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_validateFpGenerator),
+	SCAPI_NATIVE_METHOD("isFpMember", "(JJ)Z", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_isFpMember),
+	SCAPI_NATIVE_METHOD("createInfinityFpPoint", "(J)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_createInfinityFpPoint),
+	SCAPI_NATIVE_METHOD("encodeByteArrayToPoint", "(J[BI)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_encodeByteArrayToPoint),
+	SCAPI_NATIVE_METHOD("initFpExponentiateWithPrecomputedValues", "(J[B[B[BJ[BII)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_initFpExponentiateWithPrecomputedValues),
+	SCAPI_NATIVE_METHOD("computeFpExponentiateWithPrecomputedValues", "(JJ[B)J", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_computeFpExponentiateWithPrecomputedValues),
+	SCAPI_NATIVE_METHOD("endFpExponentiateWithPreComputedValues", "(J)V", Java_edu_biu_scapi_primitives_dlog_miracl_MiraclDlogECFp_endFpExponentiateWithPreComputedValues)
+};
+
+static const scapi_native::NativeClassMethods nativeClasses[] = {
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/miracl/ECF2mPointMiracl", eCF2mPointMiraclMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/miracl/ECFpPointMiracl", eCFpPointMiraclMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/miracl/MiraclAdapterDlogEC", miraclAdapterDlogECMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/miracl/MiraclDlogECF2m", miraclDlogECF2mMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/miracl/MiraclDlogECFp", miraclDlogECFpMethods)
+};
+
+/*
+ * function JNI_OnLoad	: Registers the native methods of the library when it is loaded by the jvm.
+ */
+extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*){
+	return scapi_native::registerNativeClasses(vm, nativeClasses, sizeof(nativeClasses) / sizeof(nativeClasses[0]));
+}
+
+#ifdef _WIN32
 BOOL APIENTRY DllMain( HMODULE hModule,
                        DWORD  ul_reason_for_call,
                        LPVOID lpReserved
@@ -44,4 +114,4 @@ BOOL APIENTRY DllMain( HMODULE hModule,
 	}
 	return TRUE;
 }
-
+#endif
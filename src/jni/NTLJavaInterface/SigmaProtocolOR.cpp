@@ -32,6 +32,9 @@
 #include "NTL/vec_GF2E.h"
 #include "NTL/GF2EX.h"
 #include "NTL/ZZ.h"
+#include "../Common/NativeAllocationRegistry.h"
+
+DEFINE_NATIVE_ALLOCATION_STATS(NTL)
 
 /* function initField : Initialize the field GF2E with irreducible polynomial.
 	This function is used by the prover.
@@ -104,7 +107,7 @@ jobjectArray sampleRandomFieldElements(JNIEnv * env, jint numElements, jlongArra
 		 
 		  env->ReleaseByteArrayElements(elArr, el, 0);
 		  //put the element address in the pointers array
-		  pointers[i] = (jlong)element;
+		  pointers[i] = (jlong)scapi_native::trackAllocation(element, "GF2E", sizeof(GF2E) + NumBytes(rep(*element)));
 
 	  }
 
@@ -211,7 +214,7 @@ jlong interpolate(JNIEnv * env, jbyteArray challenge, jlongArray fieldElements,
 	  //free the allocated memory
 	  env->ReleaseIntArrayElements(sampledIndexes, indexes, 0);
 	  env->ReleaseLongArrayElements(fieldElements, bElements, 0);
-	  return (jlong)polynomial;
+	  return (jlong)scapi_native::trackAllocation(polynomial, "GF2EX", sizeof(GF2EX) + (deg(*polynomial) + 1) * sizeof(GF2E));
 }
 
 
@@ -225,7 +228,7 @@ GF2E generateIndexPolynomial(int i){
 	GF2X indexPoly;
 	GF2XFromBytes(indexPoly, (unsigned char*)indexBytes, 4);
 	
-	delete (indexBytes);
+	delete[] indexBytes;
 	
 	return to_GF2E(indexPoly);
 }
@@ -345,10 +348,13 @@ void deleteMemory(JNIEnv *env, jlong polynomial, jlongArray fieldElements){
 	  
 	  //delete all field elements.
 	  for (int i=0; i<size; i++){
+		 scapi_native::trackRelease((GF2E*)elements[i]);
 		 delete ((GF2E*)elements[i]); 
 	  }
+	  env->ReleaseLongArrayElements(fieldElements, elements, JNI_ABORT);
 
 	  //delete the allocated memory for the polynomial.
+	  scapi_native::trackRelease((GF2EX*)polynomial);
 	  delete((GF2EX*)polynomial);
 }
 
@@ -28,6 +28,8 @@
 #include "AES.h"
 #include <openssl/evp.h>
 #include <iostream>
+#include "../Common/CounterBlocks.h"
+#include "../Common/CbcChains.h"
 
 using namespace std;
 
@@ -94,3 +96,88 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_setK
 	  env->ReleaseByteArrayElements(key, keyBytes, 0);
 	  
 }
+
+/* 
+ * function computeCounterBlocks : Computes AES on the counter blocks ctr, ctr+1, ... and writes the first outLen bytes of the 
+ *								   results to the output array.
+ *								   The counter blocks are encrypted in chunks with one EVP_EncryptUpdate call each, so OpenSSL
+ *								   pipelines the blocks (with AES-NI, when available).
+ * param aesCompute				 : pointer to the AES object that compute the prmutation.
+ * param ctr					 : the first counter block. It is not changed.
+ * param outBytes				 : the output array.
+ * param outOffset				 : the offset in the output array to put the result from.
+ * param outLen					 : the number of bytes to write.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_computeCounterBlocks
+  (JNIEnv *env, jobject, jlong aesCompute, jbyteArray ctr, jbyteArray outBytes, jint outOffset, jint outLen){
+
+	  const int blockSize = 16;
+	  unsigned char counter[blockSize];
+	  env->GetByteArrayRegion(ctr, 0, blockSize, (jbyte*)counter);
+
+	  unsigned char* inChunk = new unsigned char[scapi_native::COUNTER_CHUNK_BLOCKS * blockSize];
+	  unsigned char* outChunk = new unsigned char[scapi_native::COUNTER_CHUNK_BLOCKS * blockSize];
+	  int numBlocks = (outLen + blockSize - 1) / blockSize;
+	  int generated = 0;
+
+	  while (numBlocks > 0){
+		  int chunkBlocks = (numBlocks < scapi_native::COUNTER_CHUNK_BLOCKS) ? numBlocks : scapi_native::COUNTER_CHUNK_BLOCKS;
+		  scapi_native::fillCounterBlocks(inChunk, counter, chunkBlocks, blockSize);
+
+		  int len;
+		  EVP_EncryptUpdate((EVP_CIPHER_CTX *)aesCompute, outChunk, &len, inChunk, chunkBlocks * blockSize);
+
+		  //The last block may be copied partially.
+		  int toCopy = (outLen - generated < len) ? outLen - generated : len;
+		  env->SetByteArrayRegion(outBytes, outOffset + generated, toCopy, (jbyte*)outChunk);
+		  generated += toCopy;
+		  numBlocks -= chunkBlocks;
+	  }
+
+	  delete [] inChunk;
+	  delete [] outChunk;
+}
+
+/*
+ * Encrypts consecutive blocks in place with one EVP_EncryptUpdate call on the ECB context.
+ */
+struct EvpEncryptBlocks {
+	EVP_CIPHER_CTX* ctx;
+
+	void operator()(unsigned char* blocks, int numBlocks) {
+		int len;
+		EVP_EncryptUpdate(ctx, blocks, &len, blocks, numBlocks * scapi_native::CBC_BLOCK_SIZE);
+	}
+};
+
+/* 
+ * function computeCbcChains	 : Computes the CBC chains of numMsgs messages of msgLen bytes each and writes the final chaining 
+ *								   value of each message to the output array. Every chain starts from the given iv and the last
+ *								   block of each message is padded with zeros.
+ *								   Up to 8 chains are encrypted together with one EVP_EncryptUpdate call, so OpenSSL interleaves
+ *								   them (with AES-NI, when available).
+ * param aesCompute				 : pointer to the AES object that compute the prmutation.
+ * param iv						 : the initial chaining value of every message.
+ * param inBytes				 : the messages, one after the other.
+ * param inOffset				 : the offset of the first message in the input array.
+ * param msgLen					 : the length of each message.
+ * param numMsgs				 : the number of messages.
+ * param outBytes				 : the output array.
+ * param outOffset				 : the offset in the output array to put the result from.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_computeCbcChains
+  (JNIEnv *env, jobject, jlong aesCompute, jbyteArray iv, jbyteArray inBytes, jint inOffset, jint msgLen, jint numMsgs, jbyteArray outBytes, jint outOffset){
+
+	  unsigned char chainIv[scapi_native::CBC_BLOCK_SIZE];
+	  env->GetByteArrayRegion(iv, 0, scapi_native::CBC_BLOCK_SIZE, (jbyte*)chainIv);
+
+	  //No jni calls are made while the arrays are held, so the critical versions can be used and the messages are not copied.
+	  unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(inBytes, 0);
+	  unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(outBytes, 0);
+
+	  EvpEncryptBlocks encryptBlocks = { (EVP_CIPHER_CTX *)aesCompute };
+	  scapi_native::computeCbcChains(encryptBlocks, chainIv, in + inOffset, msgLen, numMsgs, out + outOffset);
+
+	  env->ReleasePrimitiveArrayCritical(outBytes, out, 0);
+	  env->ReleasePrimitiveArrayCritical(inBytes, in, JNI_ABORT);
+}
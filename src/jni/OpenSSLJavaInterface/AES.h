@@ -51,6 +51,22 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_cre
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_setKey
   (JNIEnv *, jobject, jlong, jlong, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES
+ * Method:    computeCounterBlocks
+ * Signature: (J[B[BII)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_computeCounterBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES
+ * Method:    computeCbcChains
+ * Signature: (J[B[BIII[BI)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_computeCbcChains
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint, jint, jbyteArray, jint);
+
 #ifdef __cplusplus
 }
 #endif
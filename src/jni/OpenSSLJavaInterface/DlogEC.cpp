@@ -26,11 +26,15 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "DlogEC.h"
+#include "../Common/ScapiProbes.h"
 #include <openssl/ec.h>
+#include <openssl/obj_mac.h>
 #include <iostream>
 
 using namespace std;
 
+DEFINE_NATIVE_ALLOCATION_STATS(OpenSSL)
+
 /* 
  * function createInfinityPoint		: Creates an infinity point.
  * param dlog						: Pointer to the dlog group.
@@ -40,7 +44,7 @@ JNIEXPORT jlong JNICALL JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenS
   (JNIEnv *env , jobject, jlong dlog){
 
 	  //Call the function in the Dlog group that perform the creation of infinity point.
-	  return (long) ((DlogEC*)dlog)->createInfinityPoint();
+	  return (long) ((DlogEC*)dlog)->track(((DlogEC*)dlog)->createInfinityPoint());
 }
 
 /* 
@@ -53,7 +57,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapte
   (JNIEnv *env, jobject, jlong dlog, jlong point){
 	  
 	  //Call the function in the Dlog group that inverts the point.
-	  return (long)((DlogEC*)dlog)->inversePoint((EC_POINT*)point);
+	  return (long)((DlogEC*)dlog)->track(((DlogEC*)dlog)->inversePoint((EC_POINT*)point));
 	  
 }
 
@@ -75,9 +79,11 @@ JNIEXPORT jlong JNICALL JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenS
 	  }
 	  env ->ReleaseByteArrayElements(exponentBytes, (jbyte*) exponent_bytes, 0);
 
-	  EC_POINT *result;
 	  //Call the function in the Dlog group that exponentiates the base to the exponent
-	  if(0 == (result = ((DlogEC*)dlog)->exponentiate((EC_POINT*)base, exponent))){
+	  SCAPI_PROBE1(dlog_exponentiate_start, BN_num_bits(exponent));
+	  EC_POINT *result = ((DlogEC*)dlog)->exponentiate((EC_POINT*)base, exponent);
+	  SCAPI_PROBE1(dlog_exponentiate_done, BN_num_bits(exponent));
+	  if(0 == result){
 		  BN_free(exponent);
 		  return 0;
 	  }
@@ -85,7 +91,7 @@ JNIEXPORT jlong JNICALL JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenS
 	  //Release the allocated memory.
 	  BN_free(exponent);
 	  
-	  return (long) result; //return the result
+	  return (long) ((DlogEC*)dlog)->track(result); //return the result
 }
 
 /* 
@@ -99,7 +105,7 @@ JNIEXPORT jlong JNICALL JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenS
   (JNIEnv *, jobject, jlong dlog, jlong point1, jlong point2){
 	  
 	  //Call the function in the Dlog group that multiplies the points.
-	  return (long) ((DlogEC*)dlog)->multiply((EC_POINT*)point1, (EC_POINT*)point2); //return the result
+	  return (long) ((DlogEC*)dlog)->track(((DlogEC*)dlog)->multiply((EC_POINT*)point1, (EC_POINT*)point2)); //return the result
 }
 
 /* 
@@ -143,7 +149,7 @@ JNIEXPORT jlong JNICALL JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenS
 			  }
 			  env ->ReleaseByteArrayElements(exponentBytes, exponent_bytes, 0);
 			  env ->ReleaseLongArrayElements(points, pointsArr, 0);
-			  delete(exponentsArr);
+			  delete[] exponentsArr;
 			  return 0;
 
 		  }
@@ -152,16 +158,18 @@ JNIEXPORT jlong JNICALL JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenS
 	  }
 
 	  //Call the function in the Dlog group that computes the simultaneous multiply.
+	  SCAPI_PROBE1(dlog_simultaneous_multiply_start, size);
 	  EC_POINT *result = ((DlogEC*)dlog)->simultaneousMultiply((const EC_POINT**) pointsArr, (const BIGNUM **) exponentsArr, size);
+	  SCAPI_PROBE1(dlog_simultaneous_multiply_done, size);
 	  
 	  //release the memory
 	  for(i=0; i<size; i++){
 		   BN_free(exponentsArr[i]);
 	  }
-	  delete(exponentsArr);
+	  delete[] exponentsArr;
 	  env ->ReleaseLongArrayElements(points, pointsArr, 0);
 	  
-	  return (long) result;
+	  return (long) ((DlogEC*)dlog)->track(result);
 }
 
 /* 
@@ -194,11 +202,13 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapte
 	  env ->ReleaseByteArrayElements(exponentBytes, (jbyte*) exponent_bytes, 0);
 
 	  //Call the function in the Dlog group that computes the exponentiate with the pre computes values.
+	  SCAPI_PROBE1(dlog_exponentiate_start, BN_num_bits(exponent));
 	  EC_POINT *result = ((DlogEC*)dlog)->exponentiateWithPreComputedValues(exponent);
+	  SCAPI_PROBE1(dlog_exponentiate_done, BN_num_bits(exponent));
 	  
 	  BN_free(exponent);
 	  
-	  return (long) result; //return the result
+	  return (long) ((DlogEC*)dlog)->track(result); //return the result
 }
 
 /* 
@@ -207,9 +217,105 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapte
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_deleteDlog
   (JNIEnv *, jobject, jlong dlog){
+	  scapi_native::trackRelease((DlogEC*)dlog);
 	  delete((DlogEC*)dlog);
 }
 
+/* 
+ * function normalizeMany		: Converts the given points to affine coordinates, using a single field inversion for all 
+ *								  of them, and returns their coordinates.
+ * param dlog					: Pointer to the dlog group.
+ * param points					: The points to normalize.
+ * return						: An array that holds the x and y coordinates of each point, one after the other. 
+ *								  The coordinates of an infinity point are null. Returns null if the normalization failed.
+ */
+JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_normalizeMany
+  (JNIEnv *env, jobject, jlong dlog, jlongArray points){
+	  DlogEC* dlogEC = (DlogEC*) dlog;
+	  int size = env->GetArrayLength(points);
+	  jlong* pointsArr = env->GetLongArrayElements(points, 0);
+
+	  //Infinity points have no affine form, so only the finite points are passed to OpenSSL.
+	  EC_POINT** finitePoints = new EC_POINT*[size];
+	  int numFinite = 0;
+	  for (int i = 0; i < size; i++){
+		  if (!EC_POINT_is_at_infinity(dlogEC->getCurve(), (EC_POINT*) pointsArr[i])){
+			  finitePoints[numFinite++] = (EC_POINT*) pointsArr[i];
+		  }
+	  }
+
+	  //Bring all the points to Z = 1 together. This costs one inversion instead of an inversion for each point. 
+	  //The points still represent the same group elements, so this is invisible to the java side.
+	  BOOL normalized = (numFinite == 0) || dlogEC->makeAffine(finitePoints, numFinite);
+	  delete[] finitePoints;
+	  if (!normalized){
+		  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+		  return NULL;
+	  }
+
+	  BIGNUM *x, *y;
+	  if(NULL == (x = BN_new())){
+		  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+		  return NULL;
+	  }
+	  if(NULL == (y = BN_new())){
+		  BN_free(x);
+		  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+		  return NULL;
+	  }
+
+	  jobjectArray result = env->NewObjectArray(2 * size, env->FindClass("[B"), NULL);
+	  unsigned char* buffer = new unsigned char[EC_GROUP_get_degree(dlogEC->getCurve()) / 8 + 1];
+	  for (int i = 0; i < size && result != NULL; i++){
+		  EC_POINT* point = (EC_POINT*) pointsArr[i];
+		  if (EC_POINT_is_at_infinity(dlogEC->getCurve(), point)){
+			  continue;
+		  }
+
+		  //The point is already affine, so getting its coordinates does not need another inversion.
+		  if (0 == dlogEC->getAffineCoordinates(point, x, y)){
+			  env->DeleteLocalRef(result);
+			  result = NULL;
+			  break;
+		  }
+
+		  int xSize = BN_bn2bin(x, buffer);
+		  jbyteArray xBytes = env->NewByteArray(xSize);
+		  env->SetByteArrayRegion(xBytes, 0, xSize, (jbyte*) buffer);
+		  env->SetObjectArrayElement(result, 2 * i, xBytes);
+		  env->DeleteLocalRef(xBytes);
+
+		  int ySize = BN_bn2bin(y, buffer);
+		  jbyteArray yBytes = env->NewByteArray(ySize);
+		  env->SetByteArrayRegion(yBytes, 0, ySize, (jbyte*) buffer);
+		  env->SetObjectArrayElement(result, 2 * i + 1, yBytes);
+		  env->DeleteLocalRef(yBytes);
+	  }
+
+	  //Release the allocated memory.
+	  delete[] buffer;
+	  BN_free(x);
+	  BN_free(y);
+	  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+
+	  return result;
+}
+
+/* 
+ * function deletePoints		: Deletes the given points.
+ * param points					: Pointers to the points.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_deletePoints
+  (JNIEnv *env, jobject, jlongArray points){
+	  int size = env->GetArrayLength(points);
+	  jlong* pointsArr = env->GetLongArrayElements(points, 0);
+	  for (int i = 0; i < size; i++){
+		  scapi_native::trackRelease((EC_POINT*) pointsArr[i]);
+		  EC_POINT_free((EC_POINT*) pointsArr[i]);
+	  }
+	  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+}
+
 /* 
  * function DlogEC				: Constructor that sets the curve and ctx.
  * param curveP					: Pointer to the curve.
@@ -219,12 +325,21 @@ DlogEC::DlogEC(EC_GROUP* curveP, BN_CTX* ctx){
 
 	this->curveP = curveP;
 	this->ctx = ctx;
+	this->beta = NULL;
+	this->prime = NULL;
+	this->koblitz = NULL;
+
+	//A point holds three coordinates of the field size.
+	pointSize = 3 * ((EC_GROUP_get_degree(curveP) + 7) / 8);
 }
 
 /* 
  * function ~DlogEC		: destructor
  */
 DlogEC::~DlogEC(){
+	BN_free(beta);
+	BN_free(prime);
+	delete koblitz;
 	BN_CTX_free(ctx);
 	EC_GROUP_free(curveP);
 }
@@ -398,3 +513,216 @@ EC_POINT* DlogEC::exponentiateWithPreComputedValues(BIGNUM* exponent){
 	return result;
 
 }
+
+/* 
+ * function makeAffine		: Converts the given points to affine coordinates using a simultaneous inversion.
+ * param points				: The points to convert. None of them may be the infinity point.
+ * param size				: The number of points.
+ * return					: True if the conversion succeeded; False, otherwise.
+ */
+BOOL DlogEC::makeAffine(EC_POINT** points, int size){
+	return EC_POINTs_make_affine(curveP, size, points, ctx);
+}
+
+/* 
+ * function getAffineCoordinates	: Gets the affine coordinates of the given point, according to the field of the curve.
+ * param point						: The point to get the coordinates of.
+ * param x							: Will hold the x coordinate.
+ * param y							: Will hold the y coordinate.
+ * return							: True if the coordinates were set; False, otherwise.
+ */
+BOOL DlogEC::getAffineCoordinates(const EC_POINT* point, BIGNUM* x, BIGNUM* y){
+	if (EC_METHOD_get_field_type(EC_GROUP_method_of(curveP)) == NID_X9_62_prime_field){
+		return EC_POINT_get_affine_coordinates_GFp(curveP, point, x, y, ctx);
+	}
+	return EC_POINT_get_affine_coordinates_GF2m(curveP, point, x, y, ctx);
+}
+
+/* 
+ * function setEndomorphism		: Sets the GLV endomorphism (x, y) -> (beta*x, y) of a curve over Fp.
+ *								  The dlog takes the ownership of beta.
+ * param beta					: Cube root of unity mod p.
+ * return						: True if the endomorphism was set; False, otherwise.
+ */
+BOOL DlogEC::setEndomorphism(BIGNUM* beta){
+	BIGNUM* prime;
+	if(NULL == (prime = BN_new())) return 0;
+	if(0 == EC_GROUP_get_curve_GFp(curveP, prime, NULL, NULL, ctx)){
+		BN_free(prime);
+		return 0;
+	}
+
+	BN_free(this->beta);
+	BN_free(this->prime);
+	this->beta = beta;
+	this->prime = prime;
+	return 1;
+}
+
+/* 
+ * function simultaneousMultiplyGlv	: Computes the product of several exponentiations using the GLV endomorphism.
+ *									  Each exponent k was split to k1 + k2*lambda, so k*P = k1*P + k2*phi(P) and all the 
+ *									  half length multiplications are done together, sharing the doublings.
+ * param pointsArr					: Bases array. None of the bases may be the infinity point.
+ * param exponentsArr				: The absolute values of k1 and k2 of each base, one after the other.
+ * param negative					: For each value in exponentsArr, whether it is negative.
+ * param size						: The number of bases.
+ * return							: The result's point, or 0 if the endomorphism was not set.
+ */
+EC_POINT* DlogEC::simultaneousMultiplyGlv(const EC_POINT** pointsArr, const BIGNUM** exponentsArr, const jboolean* negative, int size){
+	if (beta == NULL) return 0;
+
+	BIGNUM *x, *y;
+	if(NULL == (x = BN_new())) return 0;
+	if(NULL == (y = BN_new())){
+		BN_free(x);
+		return 0;
+	}
+
+	//Prepare P and phi(P) of each base, negated where the respective part of the exponent is negative.
+	EC_POINT** splitPoints = new EC_POINT*[2 * size]();
+	BOOL ok = 1;
+	for (int i = 0; ok && i < size; i++){
+		ok = (NULL != (splitPoints[2 * i] = EC_POINT_dup(pointsArr[i], curveP))) &&
+			 (NULL != (splitPoints[2 * i + 1] = EC_POINT_new(curveP))) &&
+			 getAffineCoordinates(pointsArr[i], x, y) &&
+			 BN_mod_mul(x, x, beta, prime, ctx) &&
+			 EC_POINT_set_affine_coordinates_GFp(curveP, splitPoints[2 * i + 1], x, y, ctx);
+
+		for (int j = 2 * i; ok && j < 2 * i + 2; j++){
+			if (negative[j]){
+				ok = EC_POINT_invert(curveP, splitPoints[j], ctx);
+			}
+		}
+	}
+
+	//Computes the simultaneous multiply of the 2*size half length exponents.
+	EC_POINT *result = NULL;
+	if (ok && (NULL != (result = EC_POINT_new(curveP)))){
+		if(0 == (EC_POINTs_mul(curveP, result, NULL, 2 * size, (const EC_POINT**) splitPoints, exponentsArr, ctx))){
+			EC_POINT_free(result);
+			result = NULL;
+		}
+	}
+
+	//Release the allocated memory.
+	for (int i = 0; i < 2 * size; i++){
+		EC_POINT_free(splitPoints[i]);
+	}
+	delete[] splitPoints;
+	BN_free(x);
+	BN_free(y);
+
+	return result;
+}
+
+/* 
+ * function setKoblitz		: Sets the tau-adic arithmetic of the curve, which is used by exponentiateTnaf.
+ *							  The dlog takes the ownership of the given object.
+ * param koblitz			: The Koblitz curve that matches this curve.
+ * return					: 1.
+ */
+BOOL DlogEC::setKoblitz(scapi_native::KoblitzCurve* koblitz){
+	delete this->koblitz;
+	this->koblitz = koblitz;
+	return 1;
+}
+
+/* 
+ * function toKoblitzElement	: Converts a field element from BIGNUM to the little endian words of the Koblitz arithmetic.
+ */
+BOOL DlogEC::toKoblitzElement(const BIGNUM* value, scapi_native::KoblitzElement element){
+	int words = koblitz->getWords();
+	unsigned char bytes[8 * scapi_native::KOBLITZ_MAX_WORDS];
+	int size = BN_num_bytes(value);
+	if (size > 8 * words) return 0;
+	memset(bytes, 0, sizeof(bytes));
+	BN_bn2bin(value, bytes + 8 * words - size);
+
+	memset(element, 0, sizeof(scapi_native::KoblitzElement));
+	for (int i = 0; i < 8 * words; i++){
+		element[i / 8] |= ((uint64_t) bytes[8 * words - 1 - i]) << (8 * (i % 8));
+	}
+	return 1;
+}
+
+/* 
+ * function fromKoblitzElement	: Converts a field element from the words of the Koblitz arithmetic to BIGNUM.
+ */
+BOOL DlogEC::fromKoblitzElement(const scapi_native::KoblitzElement element, BIGNUM* value){
+	int words = koblitz->getWords();
+	unsigned char bytes[8 * scapi_native::KOBLITZ_MAX_WORDS];
+	for (int i = 0; i < 8 * words; i++){
+		bytes[8 * words - 1 - i] = (unsigned char) (element[i / 8] >> (8 * (i % 8)));
+	}
+	return (NULL != BN_bin2bn(bytes, 8 * words, value));
+}
+
+/* 
+ * function exponentiateTnaf	: Computes the exponentiation of a point on a Koblitz curve, given the width-w tau-adic NAF 
+ *								  of the exponent. The expansion is evaluated with the Frobenius map instead of doublings.
+ * param base					: The point to exponentiate.
+ * param digits					: The digits of the expansion, least significant first. Every non zero digit is odd.
+ * param numDigits				: The number of digits.
+ * return						: The result's point, or 0 if the Koblitz arithmetic was not set or the digits are invalid.
+ */
+EC_POINT* DlogEC::exponentiateTnaf(const EC_POINT* base, const signed char* digits, int numDigits){
+	if (koblitz == NULL) return 0;
+
+	//Make sure that every digit has a precomputed point.
+	int numAlphas = koblitz->getNumAlphas();
+	for (int i = 0; i < numDigits; i++){
+		int u = (digits[i] < 0) ? -digits[i] : digits[i];
+		if ((u != 0) && ((u % 2 == 0) || (u / 2 >= numAlphas))) return 0;
+	}
+
+	EC_POINT* result;
+	if(NULL == (result = EC_POINT_new(curveP))) return 0;
+	if (EC_POINT_is_at_infinity(curveP, base)){
+		EC_POINT_set_to_infinity(curveP, result);
+		return result;
+	}
+
+	BIGNUM *x, *y;
+	if(NULL == (x = BN_new())){
+		EC_POINT_free(result);
+		return 0;
+	}
+	if(NULL == (y = BN_new())){
+		BN_free(x);
+		EC_POINT_free(result);
+		return 0;
+	}
+
+	scapi_native::KoblitzAffinePoint p, q;
+	p.infinity = false;
+	BOOL ok = EC_POINT_get_affine_coordinates_GF2m(curveP, base, x, y, ctx) &&
+			  toKoblitzElement(x, p.x) && toKoblitzElement(y, p.y);
+	if (ok){
+		koblitz->multiply(p, digits, numDigits, q);
+		if (q.infinity){
+			ok = EC_POINT_set_to_infinity(curveP, result);
+		} else {
+			ok = fromKoblitzElement(q.x, x) && fromKoblitzElement(q.y, y) &&
+				 EC_POINT_set_affine_coordinates_GF2m(curveP, result, x, y, ctx);
+		}
+	}
+
+	//Release the allocated memory.
+	BN_free(x);
+	BN_free(y);
+	if (!ok){
+		EC_POINT_free(result);
+		return 0;
+	}
+	return result;
+}
+
+/* 
+ * function track			: Records the given point in the native allocation registry.
+ * param point				: The point that is returned to java.
+ * return					: The given point.
+ */
+EC_POINT* DlogEC::track(EC_POINT* point){
+	return scapi_native::trackAllocation(point, "EC_POINT", pointSize);
+}
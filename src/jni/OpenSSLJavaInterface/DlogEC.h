@@ -26,6 +26,8 @@
 /* DO NOT EDIT THIS FILE - it is machine generated */
 #include <jni.h>
 #include <openssl/ec.h>
+#include "../Common/NativeAllocationRegistry.h"
+#include "../Common/KoblitzTnaf.h"
 /* Header for class edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogECAbs */
 
 #ifndef _Included_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
@@ -105,6 +107,22 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapte
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_deleteDlog
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    normalizeMany
+ * Signature: (J[J)[[B
+ */
+JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_normalizeMany
+  (JNIEnv *, jobject, jlong, jlongArray);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    deletePoints
+ * Signature: ([J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_deletePoints
+  (JNIEnv *, jobject, jlongArray);
+
 #ifdef __cplusplus
 }
 
@@ -113,6 +131,13 @@ private:
 
 	EC_GROUP* curveP;
 	BN_CTX* ctx;
+	int pointSize;	//The approximate size of a point in bytes, used in the native allocation accounting.
+	BIGNUM* beta;	//The cube root of unity mod p of the GLV endomorphism (x, y) -> (beta*x, y), or NULL if it is not used.
+	BIGNUM* prime;	//The field modulus, set together with beta.
+	scapi_native::KoblitzCurve* koblitz;	//The tau-adic arithmetic of a Koblitz curve, or NULL if it is not used.
+
+	BOOL toKoblitzElement(const BIGNUM* value, scapi_native::KoblitzElement element);
+	BOOL fromKoblitzElement(const scapi_native::KoblitzElement element, BIGNUM* value);
 public:
 
 	DlogEC(EC_GROUP* curveP, BN_CTX* ctx);
@@ -129,6 +154,13 @@ public:
 	EC_POINT* simultaneousMultiply(const EC_POINT** pointsArr, const BIGNUM** exponentsArr, int size);
 	BOOL validate();
 	EC_POINT* exponentiateWithPreComputedValues(BIGNUM* exponent);
+	BOOL makeAffine(EC_POINT** points, int size);
+	BOOL getAffineCoordinates(const EC_POINT* point, BIGNUM* x, BIGNUM* y);
+	BOOL setEndomorphism(BIGNUM* beta);
+	EC_POINT* simultaneousMultiplyGlv(const EC_POINT** pointsArr, const BIGNUM** exponentsArr, const jboolean* negative, int size);
+	BOOL setKoblitz(scapi_native::KoblitzCurve* koblitz);
+	EC_POINT* exponentiateTnaf(const EC_POINT* base, const signed char* digits, int numDigits);
+	EC_POINT* track(EC_POINT* point);
 };
 
 
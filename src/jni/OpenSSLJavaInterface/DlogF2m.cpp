@@ -97,7 +97,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogEC
 	  
 	  //Create Dlog group with the curve and ctx.
 	  DlogEC* dlog = new DlogEC(curve, ctx);
-	  return (long) dlog;
+	  return (long) scapi_native::trackAllocation(dlog, "DlogEC");
 }
 
 /* 
@@ -142,3 +142,85 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF
 	  return 1;
 }
 
+
+/* 
+ * function initKoblitz		: Sets the tau-adic arithmetic of a Koblitz curve, to be used by exponentiateTnaf.
+ *							  The arithmetic is set only if the curve is K-163, K-233 or K-283 with the standard polynomial
+ *							  and the processor has a carry-less multiplication. Otherwise the generic exponentiation is faster.
+ *							  The arithmetic that was set before is removed in any case.
+ * param dlog				: Pointer to the native Dlog object.
+ * param m					: The degree of the field.
+ * param a					: The parameter a of the curve equation, 0 or 1. The parameter b should be 1.
+ * param alphaDigits		: The width-2 tau-adic NAF of each alpha_u, u = 1, 3, ..., 2^(w-1)-1.
+ * param portable			: True to use the portable carry-less multiplication, also when the processor has one (for testing).
+ * return					: True if the arithmetic was set; False, otherwise.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_initKoblitz
+  (JNIEnv *env, jobject, jlong dlog, jint m, jint a, jobjectArray alphaDigits, jboolean portable){
+
+	  DlogEC* dlogEC = (DlogEC*) dlog;
+	  dlogEC->setKoblitz(NULL);
+	  scapi_native::KoblitzCurve* koblitz = new scapi_native::KoblitzCurve(m, a, !portable);
+	  if (!koblitz->isSupported() || (!portable && !koblitz->usesPclmul())){
+		  delete koblitz;
+		  return 0;
+	  }
+
+	  //Check that the curve is y^2 + xy = x^3 + ax^2 + 1 over the field of the Koblitz arithmetic.
+	  int exponents[6];
+	  koblitz->getPolynomial(exponents);
+	  BIGNUM *p, *curveP, *curveA, *curveB, *expected;
+	  p = BN_new();
+	  curveP = BN_new();
+	  curveA = BN_new();
+	  curveB = BN_new();
+	  expected = BN_new();
+	  BOOL ok = (NULL != p) && (NULL != curveP) && (NULL != curveA) && (NULL != curveB) && (NULL != expected) &&
+				BN_GF2m_arr2poly(exponents, p) &&
+				EC_GROUP_get_curve_GF2m(dlogEC->getCurve(), curveP, curveA, curveB, dlogEC->getCTX()) &&
+				BN_set_word(expected, a) &&
+				(0 == BN_cmp(p, curveP)) && (0 == BN_cmp(curveA, expected)) && BN_is_one(curveB);
+	  BN_free(p);
+	  BN_free(curveP);
+	  BN_free(curveA);
+	  BN_free(curveB);
+	  BN_free(expected);
+	  if (!ok){
+		  delete koblitz;
+		  return 0;
+	  }
+
+	  //Copy the digits of the alphas.
+	  int numAlphas = env->GetArrayLength(alphaDigits);
+	  vector<vector<signed char> > digits(numAlphas);
+	  for (int i = 0; i < numAlphas; i++){
+		  jbyteArray alpha = (jbyteArray) env->GetObjectArrayElement(alphaDigits, i);
+		  int size = env->GetArrayLength(alpha);
+		  digits[i].resize(size);
+		  if (size > 0){
+			  env->GetByteArrayRegion(alpha, 0, size, (jbyte*) &digits[i][0]);
+		  }
+		  env->DeleteLocalRef(alpha);
+	  }
+	  koblitz->setAlphaDigits(digits);
+
+	  return dlogEC->setKoblitz(koblitz);
+}
+
+/* 
+ * function exponentiateTnaf	: Computes the exponentiation of a point, given the width-w tau-adic NAF of the exponent.
+ * param dlog					: Pointer to the native Dlog object.
+ * param base					: Pointer to the point to exponentiate.
+ * param digits					: The digits of the expansion, least significant first.
+ * return						: Pointer to the result point, or 0 if the computation failed.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_exponentiateTnaf
+  (JNIEnv *env, jobject, jlong dlog, jlong base, jbyteArray digits){
+
+	  int numDigits = env->GetArrayLength(digits);
+	  jbyte* digitsBytes = env->GetByteArrayElements(digits, 0);
+	  EC_POINT* result = ((DlogEC*) dlog)->exponentiateTnaf((EC_POINT*) base, (signed char*) digitsBytes, numDigits);
+	  env->ReleaseByteArrayElements(digits, digitsBytes, JNI_ABORT);
+
+	  return (long) ((DlogEC*) dlog)->track(result);
+}
@@ -48,6 +48,22 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogEC
 JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_initCurve
   (JNIEnv *, jobject, jlong, jlong, jbyteArray, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m
+ * Method:    initKoblitz
+ * Signature: (JII[[BZ)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_initKoblitz
+  (JNIEnv *, jobject, jlong, jint, jint, jobjectArray, jboolean);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m
+ * Method:    exponentiateTnaf
+ * Signature: (JJ[B)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_exponentiateTnaf
+  (JNIEnv *, jobject, jlong, jlong, jbyteArray);
+
 #ifdef __cplusplus
 }
 #endif
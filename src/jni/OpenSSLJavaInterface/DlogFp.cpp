@@ -26,7 +26,9 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "DlogFp.h"
+#include "OpenSSLJavaInterface.h"
 #include "DlogEC.h"
+#include "../Common/ScapiProbes.h"
 #include <openssl/ec.h>
 #include <openssl/rand.h>
 #include <cstring>	// For memcpy
@@ -97,7 +99,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogEC
 	  
 	  //Create Dlog group with the curve and ctx.
 	  DlogEC* dlog = new DlogEC(curve, ctx);
-	  return (long) dlog;
+	  return (long) scapi_native::trackAllocation(dlog, "DlogEC");
 }
 
 /* 
@@ -186,6 +188,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogEC
 		BN_free(p);
 		BN_free(x);
 		BN_free(y);
+		return 0;
 	}
 
 	BN_free(a);
@@ -205,19 +208,21 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogEC
 		BN_free(p);
 		BN_free(x);
 		BN_free(y);
-		delete(randomArray);
-		delete(newString);
+		delete[] randomArray;
+		delete[] newString;
 		return 0;
 	}
 
 	int counter = 0;
 	bool success = 0;
+	initOpenSSL();
 	do{
 			RAND_bytes((unsigned char*) randomArray, l-k-2);
 			memcpy(newString, randomArray, l-k-2);
 			
-			//Convert the result to a BigInteger (bIString)
-			if(NULL == (x = BN_bin2bn((unsigned char*)newString, l - k - 1 + len, NULL))) break;
+			//Convert the result to a BigInteger (bIString).
+			//x is reused in each iteration, so the previous value does not leak.
+			if(NULL == BN_bin2bn((unsigned char*)newString, l - k - 1 + len, x)) break;
 
 			int numBytes = BN_num_bytes(x);
 			//If the nmber is negative, make it positive.
@@ -236,8 +241,8 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogEC
 	BN_free(x);
 	BN_free(y);
 	BN_free(p);
-	delete(randomArray);
-	delete(newString);
+	delete[] randomArray;
+	delete[] newString;
 
 	//If a point could not be created, return 0;
 	if (!success){
@@ -246,6 +251,84 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogEC
 	}
 
 	//Return the created point.
-	return (long) point;
+	return (long) ((DlogEC*) dlog)->track(point);
+}
+
+
+/* 
+ * function initEndomorphism	: Sets the GLV endomorphism (x, y) -> (beta*x, y) of the curve. 
+ *								  Should be called only after checking that it acts on the group as multiplication by lambda.
+ * param dlog					: Pointer to the native Dlog object.
+ * param betaBytes				: Bytes of beta, a cube root of unity mod p.
+ * return						: True if the endomorphism was set; False, otherwise.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_initEndomorphism
+  (JNIEnv *env, jobject, jlong dlog, jbyteArray betaBytes){
+	  //Convert beta into BIGNUM object.
+	  BIGNUM *beta;
+	  jbyte* beta_bytes  = (jbyte*) env->GetByteArrayElements(betaBytes, 0);
+	  if(NULL == (beta = BN_bin2bn((unsigned char*)beta_bytes, env->GetArrayLength(betaBytes), NULL))){
+		  env ->ReleaseByteArrayElements(betaBytes, beta_bytes, 0);
+		  return 0;
+	  }
+	  env ->ReleaseByteArrayElements(betaBytes, beta_bytes, 0);
+
+	  //The dlog takes the ownership of beta.
+	  if (0 == ((DlogEC*) dlog)->setEndomorphism(beta)){
+		  BN_free(beta);
+		  return 0;
+	  }
+	  return 1;
 }
 
+/* 
+ * function simultaneousMultiplyGlv	: Computes the product of several exponentiations, using the GLV endomorphism.
+ * param dlog						: Pointer to the native Dlog object.
+ * param points						: Array of points. None of them may be the infinity point.
+ * param exponents					: The absolute values of the two halves of each exponent, two for each point.
+ * param negative					: For each value in exponents, whether it is negative.
+ * return							: Pointer to the result's point.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_simultaneousMultiplyGlv
+  (JNIEnv *env, jobject, jlong dlog, jlongArray points, jobjectArray exponents, jbooleanArray negative){
+	  int size = env->GetArrayLength(points); //Number of points.
+	  int numExponents = 2 * size;
+	  BIGNUM ** exponentsArr =  new BIGNUM*[numExponents](); //Create an array to hold the exponents.
+	  
+	  //Convert each exponent bytes to a BIGNUM object.
+	  for(int i=0; i<numExponents; i++){
+		  jbyteArray exponentBytes = (jbyteArray) env->GetObjectArrayElement(exponents, i);
+		  jbyte* exponent_bytes  = (jbyte*) env->GetByteArrayElements(exponentBytes, 0);
+		  exponentsArr[i] = BN_bin2bn((unsigned char*)exponent_bytes, env->GetArrayLength(exponentBytes), NULL);
+		  env ->ReleaseByteArrayElements(exponentBytes, exponent_bytes, JNI_ABORT);
+		  env->DeleteLocalRef(exponentBytes);
+		  if(NULL == exponentsArr[i]){
+			  for(int j=0; j<i; j++){
+				   BN_free(exponentsArr[j]);
+			  }
+			  delete[] exponentsArr;
+			  return 0;
+		  }
+	  }
+
+	  jlong* pointsArr  = env->GetLongArrayElements(points, 0);
+	  jboolean* negativeArr = env->GetBooleanArrayElements(negative, 0);
+
+	  //Call the function in the Dlog group that computes the simultaneous multiply.
+	  SCAPI_PROBE1(dlog_simultaneous_multiply_start, size);
+	  EC_POINT *result = ((DlogEC*)dlog)->simultaneousMultiplyGlv((const EC_POINT**) pointsArr, (const BIGNUM **) exponentsArr, negativeArr, size);
+	  SCAPI_PROBE1(dlog_simultaneous_multiply_done, size);
+
+	  //Release the memory.
+	  for(int i=0; i<numExponents; i++){
+		   BN_free(exponentsArr[i]);
+	  }
+	  delete[] exponentsArr;
+	  env ->ReleaseBooleanArrayElements(negative, negativeArr, JNI_ABORT);
+	  env ->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+
+	  if (result == 0){
+		  return 0;
+	  }
+	  return (long) ((DlogEC*)dlog)->track(result);
+}
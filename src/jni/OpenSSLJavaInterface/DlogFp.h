@@ -56,6 +56,22 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_encodeByteArrayToPoint
   (JNIEnv *, jobject, jlong, jbyteArray, jint);
 
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
+ * Method:    initEndomorphism
+ * Signature: (J[B)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_initEndomorphism
+  (JNIEnv *, jobject, jlong, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
+ * Method:    simultaneousMultiplyGlv
+ * Signature: (J[J[[B[Z)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_simultaneousMultiplyGlv
+  (JNIEnv *, jobject, jlong, jlongArray, jobjectArray, jbooleanArray);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "DlogZp.h"
+#include "OpenSSLJavaInterface.h"
 #include <openssl/dh.h>
 #include <openssl/rand.h>
 #include <iostream>
@@ -71,7 +72,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  //Create a native Dlog object with dh and ctx.
 	  DlogZp* dlog = new DlogZp(dh,  ctx);
 
-	  return (long) dlog;
+	  return (long) scapi_native::trackAllocation(dlog, "DlogZp");
 }
 
 /* 
@@ -91,12 +92,8 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 		  return 0;
 	  }
 
-	  //Seed the random geneartor.
-#ifdef _WIN32
-	  RAND_screen(); // only defined for windows, reseeds from screen contents
-#else
-	  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
-#endif
+	  //Make sure that the random generator is seeded.
+	  initOpenSSL();
 	  
 	  //Sample a random safe prime with the requested number of bits.
 	  dh->p = BN_new();
@@ -131,7 +128,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  //Create a native Dlog object with dh and ctx.
 	  DlogZp* dlog = new DlogZp(dh,  ctx);
 	  
-	  return (long) dlog;
+	  return (long) scapi_native::trackAllocation(dlog, "DlogZp");
 }
 
 /* 
@@ -205,7 +202,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  //Invert the given element and put the result in result.
 	  BN_mod_inverse(result, (BIGNUM*) element, dh->p, ((DlogZp*) dlog) ->getCTX());
 
-	  return (long) result;
+	  return (long) scapi_native::trackAllocation(result, "BIGNUM", BN_num_bytes(result));
 }
 
 /* 
@@ -234,6 +231,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  //Raise the given element and put the result in result.
 	  if(0 == (BN_mod_exp(result, (BIGNUM *) base, expBN, dh->p, ((DlogZp*) dlog) -> getCTX()))){
 		  BN_free(expBN);
+		  BN_free(result);
 		  return 0;
 	  }
 
@@ -241,7 +239,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  BN_free(expBN);
 	  
 
-	  return (long) result;
+	  return (long) scapi_native::trackAllocation(result, "BIGNUM", BN_num_bytes(result));
 }
 
 /* 
@@ -258,10 +256,13 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  //Prepare a result element.
 	  BIGNUM* result = BN_new();
 	  //Multiply the elements.
-	  if(0 == (BN_mod_mul(result, (BIGNUM*) element1, (BIGNUM*) element2, dh->p, ((DlogZp*) dlog) -> getCTX()))) return 0;
+	  if(0 == (BN_mod_mul(result, (BIGNUM*) element1, (BIGNUM*) element2, dh->p, ((DlogZp*) dlog) -> getCTX()))){
+		  BN_free(result);
+		  return 0;
+	  }
 	  
 
-	  return (long) result;
+	  return (long) scapi_native::trackAllocation(result, "BIGNUM", BN_num_bytes(result));
 }
 
 /* 
@@ -270,6 +271,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_deleteDlogZp
   (JNIEnv *, jobject, jlong dlog){
+	  scapi_native::trackRelease((DlogZp*) dlog);
 	  delete (DlogZp*) dlog;
 }
 
@@ -26,6 +26,7 @@
 /* DO NOT EDIT THIS FILE - it is machine generated */
 #include <jni.h>
 #include <openssl/dh.h>
+#include "../Common/NativeAllocationRegistry.h"
 /* Header for class edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime */
 
 #ifndef _Included_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
@@ -74,6 +74,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPointOpe
 	  if(1 != EC_POINT_set_affine_coordinates_GF2m(curve, point, x, y, ((DlogEC*) dlog)->getCTX())){
 		  BN_free(x);
 		  BN_free(y);
+		  EC_POINT_free(point);
 		  return 0;
 	  }
 
@@ -83,7 +84,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPointOpe
 	 
 	  
 
-	  return (long) point;
+	  return (long) ((DlogEC*) dlog)->track(point);
 }
 
 /* 
@@ -195,5 +196,6 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPoint
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPointOpenSSL_deletePoint
    (JNIEnv *, jobject, jlong point){
+	  scapi_native::trackRelease((EC_POINT*) point);
 	  EC_POINT_free((EC_POINT*) point);
 }
@@ -75,13 +75,14 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointOpen
 	  if(1 != EC_POINT_set_affine_coordinates_GFp(curve, point, x, y, ((DlogEC*) dlog)->getCTX())){
 		  BN_free(x);
 		  BN_free(y);
+		  EC_POINT_free(point);
 		  return 0;
 	  }
 	  //Release the allocated memory.
 	  BN_free(x);
 	  BN_free(y);
 
-	  return (long) point;
+	  return (long) ((DlogEC*) dlog)->track(point);
 }
 
 /* 
@@ -194,5 +195,6 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointO
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointOpenSSL_deletePoint
   (JNIEnv *, jobject, jlong point){
+	  scapi_native::trackRelease((EC_POINT*) point);
 	  EC_POINT_free((EC_POINT*) point);
 }
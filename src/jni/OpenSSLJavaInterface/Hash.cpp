@@ -26,6 +26,7 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "Hash.h"
+#include "OpenSSLJavaInterface.h"
 #include <openssl/evp.h>
 #include <iostream>
 
@@ -42,7 +43,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_c
 	  EVP_MD_CTX* mdctx;
 	  const EVP_MD *md;
 
-	  OpenSSL_add_all_digests();
+	  initOpenSSL();
  
 	  //Get the string from java.
 	  const char* name = env->GetStringUTFChars(hashName, NULL);
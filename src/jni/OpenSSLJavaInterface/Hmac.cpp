@@ -26,8 +26,10 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "Hmac.h"
+#include "OpenSSLJavaInterface.h"
 #include <openssl/hmac.h>
 #include <iostream>
+#include <string.h>
 
 using namespace std;
 
@@ -40,7 +42,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_cr
   (JNIEnv *env, jobject, jstring hashName){
 	  HMAC_CTX *ctx = new  HMAC_CTX;
 
-	  OpenSSL_add_all_digests();
+	  initOpenSSL();
 	  
 	  //get the hash name from java.
 	  const char* name = env->GetStringUTFChars(hashName, NULL);
@@ -154,3 +156,143 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_del
   (JNIEnv *, jobject, jlong hmac){
 	  HMAC_CTX_cleanup((HMAC_CTX*)hmac);
 }
+
+/*
+ * Computes the hmac of the given input. The hmac is initialized with its key before the computation, so the result does not 
+ * depend on previous updates.
+ */
+static void hmacBlock(HMAC_CTX* ctx, const unsigned char* in, int inLen, unsigned char* out){
+	HMAC_Init_ex(ctx, NULL, 0, NULL, NULL);
+	HMAC_Update(ctx, in, inLen);
+	HMAC_Final(ctx, out, NULL);
+}
+
+/*
+ * Computes IteratedPrfVarying on the input that is in the first inLen bytes of buf: Y_i = HMAC(x, outLen, i) for i = 1..m, 
+ * where outLen and i are written as single bytes, as in the java implementation. buf should have room for 2 more bytes 
+ * after the input and block should have room for one hmac output.
+ */
+static void iteratedPrf(HMAC_CTX* ctx, int prfLen, unsigned char* buf, int inLen, unsigned char* block, unsigned char* out, int outLen){
+	buf[inLen] = (unsigned char) outLen;
+	int rounds = (outLen + prfLen - 1) / prfLen;
+
+	for (int i = 1; i <= rounds; i++){
+		buf[inLen + 1] = (unsigned char) i;
+		int done = (i - 1) * prfLen;
+		if (outLen - done >= prfLen){
+			hmacBlock(ctx, buf, inLen + 2, out + done);
+		} else {
+			//The last round is copied partially.
+			hmacBlock(ctx, buf, inLen + 2, block);
+			memcpy(out + done, block, outLen - done);
+		}
+	}
+}
+
+/* 
+ * function computeIteratedBlocks	: Computes IteratedPrfVarying with this hmac as the underlying prf on numBlocks inputs of 
+ *									  inLen bytes each, and puts outLen bytes of output of each input in the output array.
+ *									  All the rounds of all the inputs are computed in this call.
+ * param hmac						: Pointer to the native Hmac object.
+ * param in							: The inputs, one after the other.
+ * param inOffset					: The offset of the first input.
+ * param inLen						: The length of each input.
+ * param out						: The output array.
+ * param outOffset					: The offset in the output array to put the first output from.
+ * param outLen						: The length of each output.
+ * param numBlocks					: The number of inputs.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_computeIteratedBlocks
+  (JNIEnv *env, jobject, jlong hmac, jbyteArray in, jint inOffset, jint inLen, jbyteArray out, jint outOffset, jint outLen, jint numBlocks){
+	  HMAC_CTX* ctx = (HMAC_CTX *)hmac;
+	  int prfLen = EVP_MD_size(ctx->md);
+	  unsigned char* buf = new unsigned char[inLen + 2];
+	  unsigned char* block = new unsigned char[prfLen];
+
+	  //No jni calls are made while the arrays are held, so the critical versions can be used.
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+
+	  for (int b = 0; b < numBlocks; b++){
+		  memcpy(buf, input + inOffset + b * inLen, inLen);
+		  iteratedPrf(ctx, prfLen, buf, inLen, block, output + outOffset + b * outLen, outLen);
+	  }
+
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
+
+	  delete [] buf;
+	  delete [] block;
+}
+
+/* 
+ * function computeLubyRackoffBlocks	: Computes (or inverts) LubyRackoffPrpFromPrfVarying, with IteratedPrfVarying over this hmac 
+ *										  as the round function, on numBlocks blocks of len bytes each.
+ *										  All the 4 rounds of all the blocks are computed in this call.
+ * param hmac							: Pointer to the native Hmac object.
+ * param in								: The blocks, one after the other.
+ * param inOffset						: The offset of the first block.
+ * param out							: The output array.
+ * param outOffset						: The offset in the output array to put the first result from.
+ * param len							: The length of each block. Should be even.
+ * param numBlocks						: The number of blocks.
+ * param invert							: true to invert the permutation, false to compute it.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_computeLubyRackoffBlocks
+  (JNIEnv *env, jobject, jlong hmac, jbyteArray in, jint inOffset, jbyteArray out, jint outOffset, jint len, jint numBlocks, jboolean invert){
+	  HMAC_CTX* ctx = (HMAC_CTX *)hmac;
+	  int prfLen = EVP_MD_size(ctx->md);
+	  int sideSize = len / 2;
+
+	  unsigned char* left = new unsigned char[sideSize];
+	  unsigned char* right = new unsigned char[sideSize];
+	  unsigned char* f = new unsigned char[sideSize];
+	  //The input of the round function is (side, round index) and the iterated prf appends 2 more bytes.
+	  unsigned char* buf = new unsigned char[sideSize + 3];
+	  unsigned char* block = new unsigned char[prfLen];
+
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+
+	  for (int b = 0; b < numBlocks; b++){
+		  memcpy(left, input + inOffset + b * len, sideSize);
+		  memcpy(right, input + inOffset + b * len + sideSize, sideSize);
+
+		  for (int r = 1; r <= 4; r++){
+			  int round = invert ? 5 - r : r;
+			  if (!invert){
+				  //Li = Ri-1, Ri = Li-1 ^ PRF_VARY_INOUT(k,(Ri-1,i),L)
+				  memcpy(buf, right, sideSize);
+				  buf[sideSize] = (unsigned char) round;
+				  iteratedPrf(ctx, prfLen, buf, sideSize + 1, block, f, sideSize);
+				  for (int j = 0; j < sideSize; j++){
+					  f[j] ^= left[j];
+				  }
+				  memcpy(left, right, sideSize);
+				  memcpy(right, f, sideSize);
+			  } else {
+				  //Ri-1 = Li, Li-1 = Ri ^ PRF_VARY_INOUT(k,(Li,i),L)
+				  memcpy(buf, left, sideSize);
+				  buf[sideSize] = (unsigned char) round;
+				  iteratedPrf(ctx, prfLen, buf, sideSize + 1, block, f, sideSize);
+				  for (int j = 0; j < sideSize; j++){
+					  f[j] ^= right[j];
+				  }
+				  memcpy(right, left, sideSize);
+				  memcpy(left, f, sideSize);
+			  }
+		  }
+
+		  memcpy(output + outOffset + b * len, left, sideSize);
+		  memcpy(output + outOffset + b * len + sideSize, right, sideSize);
+	  }
+
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
+
+	  delete [] left;
+	  delete [] right;
+	  delete [] f;
+	  delete [] buf;
+	  delete [] block;
+}
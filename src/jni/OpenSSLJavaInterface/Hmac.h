@@ -82,6 +82,22 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_upd
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_deleteNative
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
+ * Method:    computeIteratedBlocks
+ * Signature: (J[BII[BIII)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_computeIteratedBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jbyteArray, jint, jint, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
+ * Method:    computeLubyRackoffBlocks
+ * Signature: (J[BI[BIIIZ)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_computeLubyRackoffBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jbyteArray, jint, jint, jint, jboolean);
+
 #ifdef __cplusplus
 }
 #endif
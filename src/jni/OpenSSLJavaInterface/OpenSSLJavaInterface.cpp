@@ -23,9 +23,302 @@
 * 
 */
 
-// OpenSSLJavaInterface.cpp : Defines the exported functions for the DLL application.
+// OpenSSLJavaInterface.cpp : Defines the library level functions of the DLL application: the one time initialization of
+// OpenSSL and the registration of the native methods.
 //
 
 #include "StdAfx.h"
+#include <jni.h>
+#include <mutex>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include "OpenSSLJavaInterface.h"
+#include "../Common/NativeRegistration.h"
+#include "AES.h"
+#include "DSA.h"
+#include "DlogEC.h"
+#include "DlogF2m.h"
+#include "DlogFp.h"
+#include "DlogZp.h"
+#include "F2mPoint.h"
+#include "FpPoint.h"
+#include "Hash.h"
+#include "Hmac.h"
+#include "PrpAbs.h"
+#include "RC4.h"
+#include "RSAOaep.h"
+#include "RSAPermutation.h"
+#include "RSAPss.h"
+#include "ShakeRO.h"
+#include "SymEncryption.h"
+#include "TlsChannel.h"
+#include "TripleDES.h"
+#include "ZpElement.h"
+#include "ZqVectorOps.h"
 
+static const JNINativeMethod nativeTlsChannelMethods[] = {
+	SCAPI_NATIVE_METHOD("connect", "(JLjava/lang/String;ILjava/lang/String;I)J", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_connect),
+	SCAPI_NATIVE_METHOD("send", "(J[B)Z", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_send),
+	SCAPI_NATIVE_METHOD("receive", "(JI)[B", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_receive),
+	SCAPI_NATIVE_METHOD("isKernelSend", "(J)Z", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_isKernelSend),
+	SCAPI_NATIVE_METHOD("isKernelReceive", "(J)Z", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_isKernelReceive),
+	SCAPI_NATIVE_METHOD("closeConnections", "(JJ)V", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_closeConnections),
+	SCAPI_NATIVE_METHOD("deleteConnections", "(JJ)V", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_deleteConnections)
+};
 
+static const JNINativeMethod nativeTlsSocketCommunicationSetupMethods[] = {
+	SCAPI_NATIVE_METHOD("createContext", "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Z)J", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup_createContext),
+	SCAPI_NATIVE_METHOD("deleteContext", "(J)V", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup_deleteContext)
+};
+
+static const JNINativeMethod nativeTlsSocketListenerThreadMethods[] = {
+	SCAPI_NATIVE_METHOD("initReceiveSocket", "(Ljava/lang/String;I)J", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_initReceiveSocket),
+	SCAPI_NATIVE_METHOD("accept", "(JJLjava/lang/String;I)J", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_accept),
+	SCAPI_NATIVE_METHOD("close", "(J)V", Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_close)
+};
+
+static const JNINativeMethod openSSLDSAMethods[] = {
+	SCAPI_NATIVE_METHOD("createDSA", "([B[B[B)J", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_createDSA),
+	SCAPI_NATIVE_METHOD("setKeys", "(J[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_setKeys),
+	SCAPI_NATIVE_METHOD("setPublicKey", "(J[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_setPublicKey),
+	SCAPI_NATIVE_METHOD("sign", "(J[BII)[B", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_sign),
+	SCAPI_NATIVE_METHOD("verify", "(J[B[BII)Z", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_verify),
+	SCAPI_NATIVE_METHOD("generateKey", "(J)[[B", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_generateKey),
+	SCAPI_NATIVE_METHOD("deleteDSA", "(J)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLDSA_deleteDSA)
+};
+
+static const JNINativeMethod openSSLRSAPssMethods[] = {
+	SCAPI_NATIVE_METHOD("createRSASignature", "()J", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLRSAPss_createRSASignature),
+	SCAPI_NATIVE_METHOD("initRSAVerifier", "(J[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLRSAPss_initRSAVerifier),
+	SCAPI_NATIVE_METHOD("initRSACrtSigner", "(J[B[B[B[B[B[B[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLRSAPss_initRSACrtSigner),
+	SCAPI_NATIVE_METHOD("initRSASigner", "(J[B[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLRSAPss_initRSASigner),
+	SCAPI_NATIVE_METHOD("doSign", "(J[BII)[B", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLRSAPss_doSign),
+	SCAPI_NATIVE_METHOD("doVerify", "(J[B[BII)Z", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLRSAPss_doVerify),
+	SCAPI_NATIVE_METHOD("deleteRSA", "(J)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_digitalSignature_OpenSSLRSAPss_deleteRSA)
+};
+
+static const JNINativeMethod openSSLRSAOaepMethods[] = {
+	SCAPI_NATIVE_METHOD("createEncryption", "()J", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_OpenSSLRSAOaep_createEncryption),
+	SCAPI_NATIVE_METHOD("initRSAEncryptor", "(J[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_OpenSSLRSAOaep_initRSAEncryptor),
+	SCAPI_NATIVE_METHOD("initRSADecryptor", "(J[B[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_OpenSSLRSAOaep_initRSADecryptor),
+	SCAPI_NATIVE_METHOD("initRSACrtDecryptor", "(J[B[B[B[B[B[B[B[B)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_OpenSSLRSAOaep_initRSACrtDecryptor),
+	SCAPI_NATIVE_METHOD("doEncrypt", "(J[B)[B", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_OpenSSLRSAOaep_doEncrypt),
+	SCAPI_NATIVE_METHOD("doDecrypt", "(J[B)[B", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_OpenSSLRSAOaep_doDecrypt),
+	SCAPI_NATIVE_METHOD("getPlaintextLength", "(J)I", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_OpenSSLRSAOaep_getPlaintextLength),
+	SCAPI_NATIVE_METHOD("deleteRSA", "(J)V", Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryption_OpenSSLRSAOaep_deleteRSA)
+};
+
+static const JNINativeMethod openSSLCBCEncRandomIVMethods[] = {
+	SCAPI_NATIVE_METHOD("setKey", "(JJLjava/lang/String;[B)V", Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLCBCEncRandomIV_setKey)
+};
+
+static const JNINativeMethod openSSLCTREncRandomIVMethods[] = {
+	SCAPI_NATIVE_METHOD("setKey", "(JJLjava/lang/String;[B)V", Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLCTREncRandomIV_setKey)
+};
+
+static const JNINativeMethod openSSLEncWithIVAbsMethods[] = {
+	SCAPI_NATIVE_METHOD("createEncryption", "()J", Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_createEncryption),
+	SCAPI_NATIVE_METHOD("createDecryption", "()J", Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_createDecryption),
+	SCAPI_NATIVE_METHOD("getIVSize", "(J)I", Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_getIVSize),
+	SCAPI_NATIVE_METHOD("encrypt", "(J[B[B)[B", Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_encrypt),
+	SCAPI_NATIVE_METHOD("decrypt", "(J[B[B)[B", Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decrypt),
+	SCAPI_NATIVE_METHOD("deleteNative", "(JJ)V", Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_deleteNative)
+};
+
+static const JNINativeMethod eCF2mPointOpenSSLMethods[] = {
+	SCAPI_NATIVE_METHOD("createPoint", "(J[B[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPointOpenSSL_createPoint),
+	SCAPI_NATIVE_METHOD("getX", "(JJ)[B", Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPointOpenSSL_getX),
+	SCAPI_NATIVE_METHOD("getY", "(JJ)[B", Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPointOpenSSL_getY),
+	SCAPI_NATIVE_METHOD("checkInfinity", "(JJ)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPointOpenSSL_checkInfinity),
+	SCAPI_NATIVE_METHOD("deletePoint", "(J)V", Java_edu_biu_scapi_primitives_dlog_openSSL_ECF2mPointOpenSSL_deletePoint)
+};
+
+static const JNINativeMethod eCFpPointOpenSSLMethods[] = {
+	SCAPI_NATIVE_METHOD("createPoint", "(J[B[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointOpenSSL_createPoint),
+	SCAPI_NATIVE_METHOD("getX", "(JJ)[B", Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointOpenSSL_getX),
+	SCAPI_NATIVE_METHOD("getY", "(JJ)[B", Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointOpenSSL_getY),
+	SCAPI_NATIVE_METHOD("checkInfinity", "(JJ)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointOpenSSL_checkInfinity),
+	SCAPI_NATIVE_METHOD("deletePoint", "(J)V", Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointOpenSSL_deletePoint)
+};
+
+static const JNINativeMethod openSSLAdapterDlogECMethods[] = {
+	SCAPI_NATIVE_METHOD("createInfinityPoint", "(J)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_createInfinityPoint),
+	SCAPI_NATIVE_METHOD("inversePoint", "(JJ)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_inversePoint),
+	SCAPI_NATIVE_METHOD("exponentiate", "(JJ[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_exponentiate),
+	SCAPI_NATIVE_METHOD("multiply", "(JJJ)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_multiply),
+	SCAPI_NATIVE_METHOD("checkCurveMembership", "(JJ)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_checkCurveMembership),
+	SCAPI_NATIVE_METHOD("simultaneousMultiply", "(J[J[[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_simultaneousMultiply),
+	SCAPI_NATIVE_METHOD("validate", "(J)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_validate),
+	SCAPI_NATIVE_METHOD("exponentiateWithPreComputedValues", "(J[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_exponentiateWithPreComputedValues),
+	SCAPI_NATIVE_METHOD("deleteDlog", "(J)V", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_deleteDlog),
+	SCAPI_NATIVE_METHOD("normalizeMany", "(J[J)[[B", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_normalizeMany),
+	SCAPI_NATIVE_METHOD("deletePoints", "([J)V", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_deletePoints)
+};
+
+static const JNINativeMethod openSSLDlogECF2mMethods[] = {
+	SCAPI_NATIVE_METHOD("createCurve", "([B[B[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_createCurve),
+	SCAPI_NATIVE_METHOD("initCurve", "(JJ[B[B)I", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_initCurve),
+	SCAPI_NATIVE_METHOD("initKoblitz", "(JII[[BZ)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_initKoblitz),
+	SCAPI_NATIVE_METHOD("exponentiateTnaf", "(JJ[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF2m_exponentiateTnaf)
+};
+
+static const JNINativeMethod openSSLDlogECFpMethods[] = {
+	SCAPI_NATIVE_METHOD("createCurve", "([B[B[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_createCurve),
+	SCAPI_NATIVE_METHOD("initCurve", "(JJ[B)I", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_initCurve),
+	SCAPI_NATIVE_METHOD("encodeByteArrayToPoint", "(J[BI)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_encodeByteArrayToPoint),
+	SCAPI_NATIVE_METHOD("initEndomorphism", "(J[B)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_initEndomorphism),
+	SCAPI_NATIVE_METHOD("simultaneousMultiplyGlv", "(J[J[[B[Z)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_simultaneousMultiplyGlv)
+};
+
+static const JNINativeMethod openSSLDlogZpSafePrimeMethods[] = {
+	SCAPI_NATIVE_METHOD("createDlogZp", "([B[B[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_createDlogZp),
+	SCAPI_NATIVE_METHOD("createRandomDlogZp", "(I)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_createRandomDlogZp),
+	SCAPI_NATIVE_METHOD("getGenerator", "(J)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_getGenerator),
+	SCAPI_NATIVE_METHOD("getP", "(J)[B", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_getP),
+	SCAPI_NATIVE_METHOD("getQ", "(J)[B", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_getQ),
+	SCAPI_NATIVE_METHOD("inverseElement", "(JJ)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_inverseElement),
+	SCAPI_NATIVE_METHOD("exponentiateElement", "(JJ[B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_exponentiateElement),
+	SCAPI_NATIVE_METHOD("multiplyElements", "(JJJ)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_multiplyElements),
+	SCAPI_NATIVE_METHOD("deleteDlogZp", "(J)V", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_deleteDlogZp),
+	SCAPI_NATIVE_METHOD("validateZpGroup", "(J)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_validateZpGroup),
+	SCAPI_NATIVE_METHOD("validateZpGenerator", "(J)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_validateZpGenerator),
+	SCAPI_NATIVE_METHOD("validateZpElement", "(JJ)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_validateZpElement)
+};
+
+static const JNINativeMethod openSSLZpSafePrimeElementMethods[] = {
+	SCAPI_NATIVE_METHOD("createElement", "([B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZpSafePrimeElement_createElement),
+	SCAPI_NATIVE_METHOD("deleteElement", "(J)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZpSafePrimeElement_deleteElement),
+	SCAPI_NATIVE_METHOD("getElement", "(J)[B", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZpSafePrimeElement_getElement)
+};
+
+static const JNINativeMethod openSSLHashMethods[] = {
+	SCAPI_NATIVE_METHOD("createHash", "(Ljava/lang/String;)J", Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_createHash),
+	SCAPI_NATIVE_METHOD("algName", "(J)Ljava/lang/String;", Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_algName),
+	SCAPI_NATIVE_METHOD("updateHash", "(J[BJ)V", Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_updateHash),
+	SCAPI_NATIVE_METHOD("finalHash", "(J[B)V", Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_finalHash),
+	SCAPI_NATIVE_METHOD("getDigestSize", "(J)I", Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_getDigestSize),
+	SCAPI_NATIVE_METHOD("deleteHash", "(J)V", Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_deleteHash)
+};
+
+static const JNINativeMethod openSSLZqVectorOpsMethods[] = {
+	SCAPI_NATIVE_METHOD("createContext", "([B)J", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_createContext),
+	SCAPI_NATIVE_METHOD("add", "(J[B[B[BI)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_add),
+	SCAPI_NATIVE_METHOD("subtract", "(J[B[B[BI)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_subtract),
+	SCAPI_NATIVE_METHOD("multiply", "(J[B[B[BI)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_multiply),
+	SCAPI_NATIVE_METHOD("multiplyAdd", "(J[B[B[B[BI)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_multiplyAdd),
+	SCAPI_NATIVE_METHOD("invertMany", "(J[B[BI)Z", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_invertMany),
+	SCAPI_NATIVE_METHOD("deleteContext", "(J)V", Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_deleteContext)
+};
+
+static const JNINativeMethod openSSLShakeROMethods[] = {
+	SCAPI_NATIVE_METHOD("createShake", "(Ljava/lang/String;)J", Java_edu_biu_scapi_primitives_randomOracle_openSSL_OpenSSLShakeRO_createShake),
+	SCAPI_NATIVE_METHOD("computeShake", "(J[BII[BII)V", Java_edu_biu_scapi_primitives_randomOracle_openSSL_OpenSSLShakeRO_computeShake),
+	SCAPI_NATIVE_METHOD("computeShakeMany", "(J[BII[BII)V", Java_edu_biu_scapi_primitives_randomOracle_openSSL_OpenSSLShakeRO_computeShakeMany),
+	SCAPI_NATIVE_METHOD("deleteShake", "(J)V", Java_edu_biu_scapi_primitives_randomOracle_openSSL_OpenSSLShakeRO_deleteShake)
+};
+
+static const JNINativeMethod openSSLAESMethods[] = {
+	SCAPI_NATIVE_METHOD("createAESCompute", "()J", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_createAESCompute),
+	SCAPI_NATIVE_METHOD("createAESInvert", "()J", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_createAESInvert),
+	SCAPI_NATIVE_METHOD("setKey", "(JJ[B)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_setKey),
+	SCAPI_NATIVE_METHOD("computeCounterBlocks", "(J[B[BII)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_computeCounterBlocks),
+	SCAPI_NATIVE_METHOD("computeCbcChains", "(J[B[BIII[BI)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLAES_computeCbcChains)
+};
+
+static const JNINativeMethod openSSLHMACMethods[] = {
+	SCAPI_NATIVE_METHOD("createHMAC", "(Ljava/lang/String;)J", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_createHMAC),
+	SCAPI_NATIVE_METHOD("setKey", "(J[B)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_setKey),
+	SCAPI_NATIVE_METHOD("getNativeBlockSize", "(J)I", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_getNativeBlockSize),
+	SCAPI_NATIVE_METHOD("getName", "(J)Ljava/lang/String;", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_getName),
+	SCAPI_NATIVE_METHOD("updateNative", "(J[BII)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_updateNative),
+	SCAPI_NATIVE_METHOD("updateFinal", "(J[BI)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_updateFinal),
+	SCAPI_NATIVE_METHOD("deleteNative", "(J)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_deleteNative),
+	SCAPI_NATIVE_METHOD("computeIteratedBlocks", "(J[BII[BIII)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_computeIteratedBlocks),
+	SCAPI_NATIVE_METHOD("computeLubyRackoffBlocks", "(J[BI[BIIIZ)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_computeLubyRackoffBlocks)
+};
+
+static const JNINativeMethod openSSLPRPMethods[] = {
+	SCAPI_NATIVE_METHOD("computeBlock", "(J[B[BII)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_computeBlock),
+	SCAPI_NATIVE_METHOD("invertBlock", "(J[B[BII)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_invertBlock),
+	SCAPI_NATIVE_METHOD("doOptimizedCompute", "(J[B[BI)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_doOptimizedCompute),
+	SCAPI_NATIVE_METHOD("doOptimizedInvert", "(J[B[BI)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_doOptimizedInvert),
+	SCAPI_NATIVE_METHOD("deleteNative", "(JJ)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_deleteNative)
+};
+
+static const JNINativeMethod openSSLTripleDESMethods[] = {
+	SCAPI_NATIVE_METHOD("createTripleDESCompute", "()J", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLTripleDES_createTripleDESCompute),
+	SCAPI_NATIVE_METHOD("createTripleDESInvert", "()J", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLTripleDES_createTripleDESInvert),
+	SCAPI_NATIVE_METHOD("setKey", "(JJ[B)V", Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLTripleDES_setKey)
+};
+
+static const JNINativeMethod openSSLRC4Methods[] = {
+	SCAPI_NATIVE_METHOD("createRC4", "()J", Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLRC4_createRC4),
+	SCAPI_NATIVE_METHOD("initRC4", "(J[B)V", Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLRC4_initRC4),
+	SCAPI_NATIVE_METHOD("generateBytes", "(JI[BI)V", Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLRC4_generateBytes),
+	SCAPI_NATIVE_METHOD("deleteNative", "(J)V", Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLRC4_deleteNative)
+};
+
+static const JNINativeMethod openSSLRSAPermutationMethods[] = {
+	SCAPI_NATIVE_METHOD("initRSAPublicPrivate", "([B[B[B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_initRSAPublicPrivate),
+	SCAPI_NATIVE_METHOD("initRSAPublicPrivateCrt", "([B[B[B[B[B[B[B[B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_initRSAPublicPrivateCrt),
+	SCAPI_NATIVE_METHOD("initRSAPublic", "([B[B)J", Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_initRSAPublic),
+	SCAPI_NATIVE_METHOD("computeRSA", "(J[B)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_computeRSA),
+	SCAPI_NATIVE_METHOD("invertRSA", "(J[B)[B", Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_invertRSA),
+	SCAPI_NATIVE_METHOD("deleteRSA", "(J)V", Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_deleteRSA)
+};
+
+static const scapi_native::NativeClassMethods nativeClasses[] = {
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/comm/twoPartyComm/NativeTlsChannel", nativeTlsChannelMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/comm/twoPartyComm/NativeTlsSocketCommunicationSetup", nativeTlsSocketCommunicationSetupMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/comm/twoPartyComm/NativeTlsSocketListenerThread", nativeTlsSocketListenerThreadMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/midLayer/asymmetricCrypto/digitalSignature/OpenSSLDSA", openSSLDSAMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/midLayer/asymmetricCrypto/digitalSignature/OpenSSLRSAPss", openSSLRSAPssMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/midLayer/asymmetricCrypto/encryption/OpenSSLRSAOaep", openSSLRSAOaepMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/midLayer/symmetricCrypto/encryption/OpenSSLCBCEncRandomIV", openSSLCBCEncRandomIVMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/midLayer/symmetricCrypto/encryption/OpenSSLCTREncRandomIV", openSSLCTREncRandomIVMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/midLayer/symmetricCrypto/encryption/OpenSSLEncWithIVAbs", openSSLEncWithIVAbsMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/openSSL/ECF2mPointOpenSSL", eCF2mPointOpenSSLMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/openSSL/ECFpPointOpenSSL", eCFpPointOpenSSLMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/openSSL/OpenSSLAdapterDlogEC", openSSLAdapterDlogECMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/openSSL/OpenSSLDlogECF2m", openSSLDlogECF2mMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/openSSL/OpenSSLDlogECFp", openSSLDlogECFpMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/openSSL/OpenSSLDlogZpSafePrime", openSSLDlogZpSafePrimeMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/openSSL/OpenSSLZpSafePrimeElement", openSSLZpSafePrimeElementMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/dlog/openSSL/OpenSSLZqVectorOps", openSSLZqVectorOpsMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/hash/openSSL/OpenSSLHash", openSSLHashMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/prf/openSSL/OpenSSLAES", openSSLAESMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/prf/openSSL/OpenSSLHMAC", openSSLHMACMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/prf/openSSL/OpenSSLPRP", openSSLPRPMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/prf/openSSL/OpenSSLTripleDES", openSSLTripleDESMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/prg/openSSL/OpenSSLRC4", openSSLRC4Methods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/randomOracle/openSSL/OpenSSLShakeRO", openSSLShakeROMethods),
+	SCAPI_NATIVE_CLASS("edu/biu/scapi/primitives/trapdoorPermutation/openSSL/OpenSSLRSAPermutation", openSSLRSAPermutationMethods)
+};
+
+static std::once_flag openSSLInitialized;
+
+/*
+ * function initOpenSSL	: Loads the error strings and the digests of OpenSSL and seeds its random generator.
+ *						  The initialization is done once, by the first call to this function.
+ */
+void initOpenSSL(){
+	std::call_once(openSSLInitialized, [](){
+		ERR_load_crypto_strings();
+		OpenSSL_add_all_digests();
+
+		//Seed the random geneartor.
+#ifdef _WIN32
+		RAND_screen(); // only defined for windows, reseeds from screen contents
+#else
+		RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
+#endif
+	});
+}
+
+/*
+ * function JNI_OnLoad	: Registers the native methods of the library when it is loaded by the jvm.
+ */
+extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*){
+	return scapi_native::registerNativeClasses(vm, nativeClasses, sizeof(nativeClasses) / sizeof(nativeClasses[0]));
+}
@@ -26,6 +26,7 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "RSAOaep.h"
+#include "OpenSSLJavaInterface.h"
 #include <openssl/rsa.h>
 #include <openssl/rand.h>
 #include <iostream>
@@ -152,12 +153,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryp
 	  //Convert the given data into c++ notation.
 	  jbyte* plaintext  = (jbyte*) env->GetByteArrayElements(plaintextBytes, 0);
 	  
-	  //Seed the random geneartor.
-#ifdef _WIN32
-	  RAND_screen(); // only defined for windows, reseeds from screen contents
-#else
-	  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
-#endif
+	  //Make sure that the random generator is seeded.
+	  initOpenSSL();
 
 	  //Allocate a new byte array to hold the output.
 	  int size = RSA_size((RSA *) rsa);
@@ -26,6 +26,7 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "RSAPermutation.h"
+#include "OpenSSLJavaInterface.h"
 #include <openssl/rsa.h>
 #include <openssl/rand.h>
 #include <iostream>
@@ -162,14 +163,9 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_o
   (JNIEnv *env, jobject, jlong rsa, jbyteArray element) {
 	  //Convert the given data into c++ notation.
 	  jbyte* el  = (jbyte*) env->GetByteArrayElements(element, 0);
-	  ERR_load_crypto_strings();
-
-	  //Seed the random geneartor.
-#ifdef _WIN32
-	  RAND_screen(); // only defined for windows, reseeds from screen contents
-#else
-	  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
-#endif
+
+	  //Make sure that the random generator is seeded.
+	  initOpenSSL();
 
 	  //Allocate a new byte array to hold the output.
 	  int size = RSA_size((RSA *) rsa);
@@ -0,0 +1,142 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "ShakeRO.h"
+#include "OpenSSLJavaInterface.h"
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+#include <string.h>
+
+//SHAKE and EVP_DigestFinalXOF were added in OpenSSL 1.1.1. With older versions createShake returns 0.
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+#define SCAPI_HAS_SHAKE
+#endif
+
+/* 
+ * function createShake		: Creates a native SHAKE context.
+ * param name				: SHAKE128 or SHAKE256.
+ * return					: Pointer to the created context, or 0 if the given name is not supported.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_randomOracle_openSSL_OpenSSLShakeRO_createShake
+  (JNIEnv *env, jobject, jstring name){
+
+#ifdef SCAPI_HAS_SHAKE
+	  initOpenSSL();
+
+	  const char* shakeName = env->GetStringUTFChars(name, NULL);
+	  const EVP_MD *md = NULL;
+	  if (strcmp(shakeName, "SHAKE128") == 0) {
+		  md = EVP_shake128();
+	  } else if (strcmp(shakeName, "SHAKE256") == 0) {
+		  md = EVP_shake256();
+	  }
+	  env->ReleaseStringUTFChars(name, shakeName);
+	  if (md == NULL) {
+		  return 0;
+	  }
+
+	  EVP_MD_CTX* mdctx = EVP_MD_CTX_create();
+	  if (0 == EVP_DigestInit_ex(mdctx, md, NULL)) {
+		  EVP_MD_CTX_destroy(mdctx);
+		  return 0;
+	  }
+	  return (long) mdctx;
+#else
+	  return 0;
+#endif
+}
+
+#ifdef SCAPI_HAS_SHAKE
+/*
+ * Computes SHAKE on the given input and writes outLen bytes to out. The context is initialized again for the next input.
+ * A NULL digest initializes the context with the digest it already has (EVP_MD_CTX_md is deprecated in OpenSSL 3).
+ */
+static void shake(EVP_MD_CTX* mdctx, const unsigned char* in, int inLen, unsigned char* out, int outLen){
+	EVP_DigestInit_ex(mdctx, NULL, NULL);
+	EVP_DigestUpdate(mdctx, in, inLen);
+	EVP_DigestFinalXOF(mdctx, out, outLen);
+}
+#endif
+
+/* 
+ * function computeShake	: Computes SHAKE on the given input and puts outLen bytes of output in the given array.
+ * param shakePtr			: Pointer to the native context.
+ * param input				: The input array.
+ * param inOffset			: The offset of the input in the array.
+ * param inLen				: The length of the input.
+ * param output				: The array to put the output in.
+ * param outOffset			: The offset in the output array to put the result from.
+ * param outLen				: The number of output bytes.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_randomOracle_openSSL_OpenSSLShakeRO_computeShake
+  (JNIEnv *env, jobject, jlong shakePtr, jbyteArray input, jint inOffset, jint inLen, jbyteArray output, jint outOffset, jint outLen){
+
+#ifdef SCAPI_HAS_SHAKE
+	  unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(input, 0);
+	  unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(output, 0);
+
+	  shake((EVP_MD_CTX*) shakePtr, in + inOffset, inLen, out + outOffset, outLen);
+
+	  env->ReleasePrimitiveArrayCritical(output, out, 0);
+	  env->ReleasePrimitiveArrayCritical(input, in, JNI_ABORT);
+#endif
+}
+
+/* 
+ * function computeShakeMany	: Computes SHAKE on each of the given inputs, all of the same length, and puts outLen bytes 
+ *								  of output for each input in the given array, one after the other.
+ * param shakePtr				: Pointer to the native context.
+ * param inputs					: The inputs, one after the other.
+ * param inLen					: The length of each input.
+ * param numInputs				: The number of inputs.
+ * param output					: The array to put the outputs in.
+ * param outOffset				: The offset in the output array to put the first output from.
+ * param outLen					: The number of output bytes of each input.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_randomOracle_openSSL_OpenSSLShakeRO_computeShakeMany
+  (JNIEnv *env, jobject, jlong shakePtr, jbyteArray inputs, jint inLen, jint numInputs, jbyteArray output, jint outOffset, jint outLen){
+
+#ifdef SCAPI_HAS_SHAKE
+	  unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(inputs, 0);
+	  unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(output, 0);
+
+	  for (int i = 0; i < numInputs; i++) {
+		  shake((EVP_MD_CTX*) shakePtr, in + i * inLen, inLen, out + outOffset + i * outLen, outLen);
+	  }
+
+	  env->ReleasePrimitiveArrayCritical(output, out, 0);
+	  env->ReleasePrimitiveArrayCritical(inputs, in, JNI_ABORT);
+#endif
+}
+
+/* 
+ * function deleteShake	: Deletes the native context.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_randomOracle_openSSL_OpenSSLShakeRO_deleteShake
+  (JNIEnv *, jobject, jlong shakePtr){
+	  EVP_MD_CTX_destroy((EVP_MD_CTX *)shakePtr);
+}
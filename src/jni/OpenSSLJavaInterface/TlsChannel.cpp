@@ -0,0 +1,530 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "TlsChannel.h"
+#include "OpenSSLJavaInterface.h"
+#include "../Common/NativeAllocationRegistry.h"
+#include <openssl/err.h>
+#include <openssl/x509v3.h>
+#include <stdio.h>
+#include <string.h>
+#include <mutex>
+
+#ifdef _WIN32
+#pragma comment(lib, "ws2_32.lib")
+#define closeSocket closesocket
+#define shutdownSocket(s) ::shutdown(s, SD_BOTH)
+#define pollSockets WSAPoll
+#define INVALID_TLS_SOCKET INVALID_SOCKET
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#define closeSocket ::close
+#define shutdownSocket(s) ::shutdown(s, SHUT_RDWR)
+#define pollSockets ::poll
+#define INVALID_TLS_SOCKET (-1)
+#endif
+
+//The record layer can be offloaded to the kernel when OpenSSL was built with kTLS (OpenSSL 3.0 and above on linux).
+//The offload is only used when the java side asks for it. This path has not been run against a kernel with kTLS 
+//support yet, only the user space path was tested.
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define SCAPI_KTLS
+#endif
+
+//A received message is copied to java in chunks of this size, a few tls records each.
+#define TLS_RECEIVE_CHUNK 65536
+
+using namespace std;
+
+static once_flag tlsInitialized;
+
+/*
+ * Initializes the ssl part of OpenSSL (and the socket library on windows) on the first call.
+ */
+static void initTls(){
+	initOpenSSL();
+	call_once(tlsInitialized, [](){
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+		SSL_library_init();
+		SSL_load_error_strings();
+#else
+		OPENSSL_init_ssl(0, NULL);
+#endif
+#ifdef _WIN32
+		WSADATA wsaData;
+		WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+	});
+}
+
+/*
+ * Creates a tcp socket with Nagle's algorithm disabled. If address is not NULL, the socket is connected to it, 
+ * otherwise it is bound to the given port and listens on it. Returns INVALID_TLS_SOCKET on failure.
+ */
+static TlsSocket openSocket(const char* address, const char* listenAddress, int port){
+	char portString[16];
+	sprintf(portString, "%d", port);
+
+	struct addrinfo hints, *addresses;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	if (address == NULL){
+		hints.ai_flags = AI_PASSIVE;
+	}
+	if (getaddrinfo((address != NULL) ? address : listenAddress, portString, &hints, &addresses) != 0){
+		return INVALID_TLS_SOCKET;
+	}
+
+	TlsSocket s = INVALID_TLS_SOCKET;
+	for (struct addrinfo* ai = addresses; ai != NULL && s == INVALID_TLS_SOCKET; ai = ai->ai_next){
+		s = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (s == INVALID_TLS_SOCKET) continue;
+
+		int on = 1;
+		bool opened;
+		if (address != NULL){
+			opened = ::connect(s, ai->ai_addr, (int) ai->ai_addrlen) == 0;
+		} else{
+			setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*) &on, sizeof(on));
+			opened = ::bind(s, ai->ai_addr, (int) ai->ai_addrlen) == 0 && ::listen(s, SOMAXCONN) == 0;
+		}
+		if (!opened){
+			closeSocket(s);
+			s = INVALID_TLS_SOCKET;
+			continue;
+		}
+		setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*) &on, sizeof(on));
+	}
+	freeaddrinfo(addresses);
+	return s;
+}
+
+/*
+ * Sets the timeout of each blocking read and write on the socket, in milliseconds. Zero means no timeout.
+ */
+static void setSocketTimeout(TlsSocket s, int millis){
+#ifdef _WIN32
+	DWORD timeout = millis;
+#else
+	struct timeval timeout;
+	timeout.tv_sec = millis / 1000;
+	timeout.tv_usec = (millis % 1000) * 1000;
+#endif
+	setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, (const char*) &timeout, sizeof(timeout));
+	setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, (const char*) &timeout, sizeof(timeout));
+}
+
+/*
+ * Sets the name that the certificate of the other party should be issued to, in addition to being signed by a trusted 
+ * authority. A name that is an ip address is checked against the ip addresses of the certificate, any other name 
+ * against its dns names (or its common name if it has none).
+ */
+static bool setPeerName(SSL* ssl, const char* peerName){
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+	X509_VERIFY_PARAM* param = SSL_get0_param(ssl);
+	if (X509_VERIFY_PARAM_set1_ip_asc(param, peerName) == 1){
+		return true;
+	}
+	ERR_clear_error();
+	X509_VERIFY_PARAM_set_hostflags(param, X509_CHECK_FLAG_NO_PARTIAL_WILDCARDS);
+	return X509_VERIFY_PARAM_set1_host(param, peerName, 0) == 1;
+#else
+	//The name can't be checked, so no connection is made.
+	return false;
+#endif
+}
+
+/*
+ * Runs the handshake over the given connected socket, as the client or as the server. The certificate of the other 
+ * party should be issued to peerName. Each read and write of the handshake waits at most timeoutMillis.
+ * Returns the connection, or NULL if the handshake failed, in which case the socket is closed.
+ */
+static TlsConnection* handshake(SSL_CTX* ctx, TlsSocket s, bool client, const char* peerName, int timeoutMillis){
+	SSL* ssl = SSL_new(ctx);
+	if (ssl == NULL){
+		closeSocket(s);
+		return NULL;
+	}
+	//A party that connects and then sends nothing would otherwise block the handshake forever.
+	setSocketTimeout(s, timeoutMillis);
+	if (!setPeerName(ssl, peerName) || SSL_set_fd(ssl, (int) s) != 1 || (client ? SSL_connect(ssl) : SSL_accept(ssl)) != 1){
+		ERR_clear_error();
+		SSL_free(ssl);
+		closeSocket(s);
+		return NULL;
+	}
+	//The messages are waited for as long as it takes, a blocked receive is woken up by close.
+	setSocketTimeout(s, 0);
+	return scapi_native::trackAllocation(new TlsConnection(ssl, s), "TlsConnection");
+}
+
+TlsConnection::TlsConnection(SSL* ssl, TlsSocket socket) : chunk(TLS_RECEIVE_CHUNK){
+	this->ssl = ssl;
+	this->socket = socket;
+	users = 0;
+	closed = false;
+#ifdef SCAPI_KTLS
+	//OpenSSL installs the keys in the kernel at the end of the handshake if it can, for each direction separately.
+	kernelSend = BIO_get_ktls_send(SSL_get_wbio(ssl)) == 1;
+	kernelReceive = BIO_get_ktls_recv(SSL_get_rbio(ssl)) == 1;
+#else
+	kernelSend = false;
+	kernelReceive = false;
+#endif
+}
+
+TlsConnection::~TlsConnection(){
+	close();
+}
+
+/*
+ * Marks the calling thread as using the connection, so that close waits for it. Returns false if the connection was closed.
+ */
+bool TlsConnection::acquire(){
+	lock_guard<mutex> guard(lock);
+	if (closed) return false;
+	users++;
+	return true;
+}
+
+void TlsConnection::release(){
+	lock_guard<mutex> guard(lock);
+	if (--users == 0){
+		released.notify_all();
+	}
+}
+
+bool TlsConnection::isKernelSend(){
+	return kernelSend;
+}
+
+bool TlsConnection::isKernelReceive(){
+	return kernelReceive;
+}
+
+/*
+ * Encrypts and writes all the given bytes using OpenSSL.
+ */
+bool TlsConnection::writeFully(const char* data, size_t size){
+	while (size > 0){
+		int chunk = (size > 0x40000000) ? 0x40000000 : (int) size;
+		int written = SSL_write(ssl, data, chunk);
+		if (written <= 0){
+			ERR_clear_error();
+			return false;
+		}
+		data += written;
+		size -= written;
+	}
+	return true;
+}
+
+/*
+ * Reads and decrypts exactly the given number of bytes. OpenSSL reads through the kernel when the receive direction 
+ * is offloaded, since the kernel also delivers records that are not application data (e.g. alerts) that it should handle.
+ */
+bool TlsConnection::readFully(char* data, size_t size){
+	while (size > 0){
+		int chunk = (size > 0x40000000) ? 0x40000000 : (int) size;
+		int read = SSL_read(ssl, data, chunk);
+		if (read <= 0){
+			ERR_clear_error();
+			return false;
+		}
+		data += read;
+		size -= read;
+	}
+	return true;
+}
+
+/*
+ * Returns a buffer for a message of the given size, framed as [int size][size bytes], the same framing as NativeChannel.
+ * The caller copies the message after the size and sends the frame with sendFrame.
+ */
+char* TlsConnection::prepareFrame(int size){
+	frame.resize(sizeof(int) + size);
+	memcpy(frame.data(), &size, sizeof(int));
+	return frame.data() + sizeof(int);
+}
+
+/*
+ * Sends the frame that was filled after prepareFrame. The size and the message are in one buffer, so that they are 
+ * written in the same record. When the kernel encrypts the records the frame is written to the socket directly, 
+ * otherwise it is encrypted by OpenSSL.
+ */
+bool TlsConnection::sendFrame(){
+#if defined(SCAPI_KTLS) && !defined(_WIN32)
+	if (kernelSend){
+		const char* data = frame.data();
+		size_t size = frame.size();
+		while (size > 0){
+			ssize_t written = ::send(socket, data, size, 0);
+			if (written < 0){
+				if (errno == EINTR) continue;
+				return false;
+			}
+			data += written;
+			size -= written;
+		}
+		return true;
+	}
+#endif
+
+	return writeFully(frame.data(), frame.size());
+}
+
+bool TlsConnection::receiveSize(int* size){
+	return readFully((char*) size, sizeof(int)) && *size >= 0;
+}
+
+/*
+ * Reads the next part of the message, of at most TLS_RECEIVE_CHUNK bytes, and returns it. Returns NULL on failure.
+ */
+char* TlsConnection::receiveChunk(int size){
+	return readFully(chunk.data(), size) ? chunk.data() : NULL;
+}
+
+/*
+ * Closes the connection. If another thread is sending or receiving, the socket is shut down first so that its call 
+ * fails, and the session is freed after that thread leaves. Otherwise close_notify is sent to the other party first.
+ */
+void TlsConnection::close(){
+	unique_lock<mutex> guard(lock);
+	if (closed) return;
+	closed = true;
+
+	if (users > 0){
+		shutdownSocket(socket);
+		released.wait(guard, [this](){ return users == 0; });
+	} else{
+		SSL_shutdown(ssl);
+	}
+	ERR_clear_error();
+	SSL_free(ssl);
+	closeSocket(socket);
+	ssl = NULL;
+}
+
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup_createContext
+  (JNIEnv *env, jobject, jstring certFile, jstring keyFile, jstring caFile, jboolean kernelTls){
+	  initTls();
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+	  SSL_CTX* ctx = SSL_CTX_new(TLS_method());
+#else
+	  SSL_CTX* ctx = SSL_CTX_new(TLSv1_2_method());
+#endif
+	  if (ctx == NULL) return 0;
+
+	  //Load the certificate and key of this party and the certificates of the authorities that the other party is checked with.
+	  const char* cert = env->GetStringUTFChars(certFile, 0);
+	  const char* key = env->GetStringUTFChars(keyFile, 0);
+	  const char* ca = env->GetStringUTFChars(caFile, 0);
+	  bool loaded = SSL_CTX_use_certificate_chain_file(ctx, cert) == 1 &&
+		  SSL_CTX_use_PrivateKey_file(ctx, key, SSL_FILETYPE_PEM) == 1 &&
+		  SSL_CTX_check_private_key(ctx) == 1 &&
+		  SSL_CTX_load_verify_locations(ctx, ca, NULL) == 1;
+	  env->ReleaseStringUTFChars(certFile, cert);
+	  env->ReleaseStringUTFChars(keyFile, key);
+	  env->ReleaseStringUTFChars(caFile, ca);
+	  if (!loaded){
+		  ERR_clear_error();
+		  SSL_CTX_free(ctx);
+		  return 0;
+	  }
+
+	  //Both parties are authenticated, the same as in the ssl socket channels.
+	  SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, NULL);
+	  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+	  //Use TLS 1.3 only. The kernel encrypts AES-GCM records, so these suites come before ChaCha20-Poly1305.
+	  //Sessions are never resumed, so no tickets are sent after the handshake.
+	  if (SSL_CTX_set_min_proto_version(ctx, TLS1_3_VERSION) != 1 ||
+		  SSL_CTX_set_ciphersuites(ctx, "TLS_AES_128_GCM_SHA256:TLS_AES_256_GCM_SHA384:TLS_CHACHA20_POLY1305_SHA256") != 1 ||
+		  SSL_CTX_set_num_tickets(ctx, 0) != 1){
+		  ERR_clear_error();
+		  SSL_CTX_free(ctx);
+		  return 0;
+	  }
+#endif
+
+#ifdef SCAPI_KTLS
+	  if (kernelTls){
+		  SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+	  }
+#endif
+
+	  return (long) ctx;
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup_deleteContext
+  (JNIEnv *, jobject, jlong ctx){
+	  //Each open connection holds a reference to the context, so it is freed after the last one is closed.
+	  SSL_CTX_free((SSL_CTX*) ctx);
+}
+
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_connect
+  (JNIEnv *env, jobject, jlong ctx, jstring ip, jint port, jstring peerName, jint timeoutMillis){
+	  const char* address = env->GetStringUTFChars(ip, 0);
+	  TlsSocket s = openSocket(address, NULL, port);
+	  env->ReleaseStringUTFChars(ip, address);
+
+	  if (s == INVALID_TLS_SOCKET) return 0;
+
+	  const char* name = env->GetStringUTFChars(peerName, 0);
+	  TlsConnection* connection = handshake((SSL_CTX*) ctx, s, true, name, timeoutMillis);
+	  env->ReleaseStringUTFChars(peerName, name);
+	  return (long) connection;
+}
+
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_send
+  (JNIEnv *env, jobject, jlong connection, jbyteArray data){
+	  TlsConnection* tls = (TlsConnection*) connection;
+	  if (!tls->acquire()) return false;
+
+	  //The message is copied once, from the java array straight into the frame that is sent.
+	  int size = env->GetArrayLength(data);
+	  env->GetByteArrayRegion(data, 0, size, (jbyte*) tls->prepareFrame(size));
+	  bool sent = tls->sendFrame();
+
+	  tls->release();
+	  return sent;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_receive
+  (JNIEnv *env, jobject, jlong connection, jint maxSize){
+	  TlsConnection* tls = (TlsConnection*) connection;
+	  if (!tls->acquire()) return NULL;
+
+	  //The size is checked before anything is allocated, since it is sent by the other party.
+	  int size;
+	  jbyteArray received = NULL;
+	  if (tls->receiveSize(&size) && size <= maxSize){
+		  received = env->NewByteArray(size);
+	  }
+
+	  //The message is read in chunks that are copied directly into the java array.
+	  for (int offset = 0; received != NULL && offset < size; ){
+		  int length = (size - offset > TLS_RECEIVE_CHUNK) ? TLS_RECEIVE_CHUNK : size - offset;
+		  char* chunk = tls->receiveChunk(length);
+		  if (chunk == NULL){
+			  env->DeleteLocalRef(received);
+			  received = NULL;
+			  break;
+		  }
+		  env->SetByteArrayRegion(received, offset, length, (jbyte*) chunk);
+		  offset += length;
+	  }
+
+	  tls->release();
+	  return received;
+}
+
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_isKernelSend
+  (JNIEnv *, jobject, jlong connection){
+	  return ((TlsConnection*) connection)->isKernelSend();
+}
+
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_isKernelReceive
+  (JNIEnv *, jobject, jlong connection){
+	  return ((TlsConnection*) connection)->isKernelReceive();
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_closeConnections
+  (JNIEnv *, jobject, jlong sendConnection, jlong receiveConnection){
+	  //A thread that is blocked in send or receive is woken up. The connections stay allocated until deleteConnections, 
+	  //so a call that starts after this one just fails.
+	  TlsConnection* connections[2] = { (TlsConnection*) sendConnection, (TlsConnection*) receiveConnection };
+	  for (int i = 0; i < 2; i++){
+		  if (connections[i] != NULL){
+			  connections[i]->close();
+		  }
+	  }
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_deleteConnections
+  (JNIEnv *, jobject, jlong sendConnection, jlong receiveConnection){
+	  TlsConnection* connections[2] = { (TlsConnection*) sendConnection, (TlsConnection*) receiveConnection };
+	  for (int i = 0; i < 2; i++){
+		  if (connections[i] != NULL){
+			  scapi_native::trackRelease(connections[i]);
+			  delete connections[i];
+		  }
+	  }
+}
+
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_initReceiveSocket
+  (JNIEnv *env, jobject, jstring ip, jint port){
+	  initTls();
+
+	  const char* address = env->GetStringUTFChars(ip, 0);
+	  TlsSocket s = openSocket(NULL, address, port);
+	  env->ReleaseStringUTFChars(ip, address);
+
+	  if (s == INVALID_TLS_SOCKET) return 0;
+
+	  return (long) new TlsSocket(s);
+}
+
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_accept
+  (JNIEnv *env, jobject, jlong ctx, jlong serverSocket, jstring peerName, jint timeoutMillis){
+	  //Wait a limited time for a connection, so that the listening thread can check whether it was stopped.
+	  struct pollfd listening;
+	  listening.fd = *(TlsSocket*) serverSocket;
+	  listening.events = POLLIN;
+	  listening.revents = 0;
+	  if (pollSockets(&listening, 1, timeoutMillis) != 1) return 0;
+
+	  TlsSocket s = ::accept(*(TlsSocket*) serverSocket, NULL, NULL);
+	  if (s == INVALID_TLS_SOCKET) return 0;
+
+	  int on = 1;
+	  setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*) &on, sizeof(on));
+
+	  //A connection whose handshake fails or times out (e.g. the certificate of the other party is not trusted or is 
+	  //issued to another name) is dropped.
+	  const char* name = env->GetStringUTFChars(peerName, 0);
+	  TlsConnection* connection = handshake((SSL_CTX*) ctx, s, false, name, timeoutMillis);
+	  env->ReleaseStringUTFChars(peerName, name);
+	  return (long) connection;
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_close
+  (JNIEnv *, jobject, jlong serverSocket){
+	  closeSocket(*(TlsSocket*) serverSocket);
+	  delete (TlsSocket*) serverSocket;
+}
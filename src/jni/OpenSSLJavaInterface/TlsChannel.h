@@ -0,0 +1,190 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for classes edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup, 
+ * edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel and edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread */
+
+#ifndef _Included_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+#define _Included_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup
+ * Method:    createContext
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Z)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup_createContext
+  (JNIEnv *, jobject, jstring, jstring, jstring, jboolean);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup
+ * Method:    deleteContext
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketCommunicationSetup_deleteContext
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+ * Method:    connect
+ * Signature: (JLjava/lang/String;ILjava/lang/String;I)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_connect
+  (JNIEnv *, jobject, jlong, jstring, jint, jstring, jint);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+ * Method:    send
+ * Signature: (J[B)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_send
+  (JNIEnv *, jobject, jlong, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+ * Method:    receive
+ * Signature: (JI)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_receive
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+ * Method:    isKernelSend
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_isKernelSend
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+ * Method:    isKernelReceive
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_isKernelReceive
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+ * Method:    closeConnections
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_closeConnections
+  (JNIEnv *, jobject, jlong, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel
+ * Method:    deleteConnections
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsChannel_deleteConnections
+  (JNIEnv *, jobject, jlong, jlong);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread
+ * Method:    initReceiveSocket
+ * Signature: (Ljava/lang/String;I)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_initReceiveSocket
+  (JNIEnv *, jobject, jstring, jint);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread
+ * Method:    accept
+ * Signature: (JJLjava/lang/String;I)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_accept
+  (JNIEnv *, jobject, jlong, jlong, jstring, jint);
+
+/*
+ * Class:     edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread
+ * Method:    close
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_comm_twoPartyComm_NativeTlsSocketListenerThread_close
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET TlsSocket;
+#else
+typedef int TlsSocket;
+#endif
+
+#include <openssl/ssl.h>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+/*
+ * One direction of a native tls channel: a connected tcp socket and the tls session that runs over it.
+ * When it was enabled, OpenSSL hands the session keys of the record layer to the kernel (kTLS) after the handshake if the 
+ * kernel and the negotiated cipher support it. Each direction is offloaded on its own, so isKernelSend and isKernelReceive 
+ * tell which ones actually are. Without offload, the records are encrypted and decrypted by OpenSSL in user space.
+ *
+ * The messages are sent and received between acquire and release. close may be called by another thread while a message 
+ * is being sent or received: it wakes up the blocked call by shutting down the socket and frees the session only after 
+ * the call has left. The object itself should be deleted only when no thread can call it anymore.
+ */
+class TlsConnection {
+private:
+	SSL* ssl;
+	TlsSocket socket;
+	bool kernelSend;				//The kernel encrypts the records written to the socket.
+	bool kernelReceive;				//The kernel decrypts the records read from the socket.
+	std::vector<char> frame;		//Holds the size and the message that are sent.
+	std::vector<char> chunk;		//Holds each chunk of a received message before it is copied to java.
+	std::mutex lock;
+	std::condition_variable released;
+	int users;						//The number of threads between acquire and release.
+	bool closed;
+
+	bool writeFully(const char* data, size_t size);
+	bool readFully(char* data, size_t size);
+
+public:
+	TlsConnection(SSL* ssl, TlsSocket socket);
+	~TlsConnection();
+
+	bool acquire();
+	void release();
+	char* prepareFrame(int size);
+	bool sendFrame();
+	bool receiveSize(int* size);
+	char* receiveChunk(int size);
+	bool isKernelSend();
+	bool isKernelReceive();
+	void close();
+};
+
+#endif
+#endif
@@ -27,6 +27,7 @@
 #include <jni.h>
 #include "ZpElement.h"
 #include <openssl/bn.h>
+#include "../Common/NativeAllocationRegistry.h"
 #include <iostream>
 
 using namespace std;
@@ -51,7 +52,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZpSafe
 	  //Release the allocated memory.
 	  env ->ReleaseByteArrayElements(element, el, 0);
 
-	  return (long) elBN;
+	  return (long) scapi_native::trackAllocation(elBN, "BIGNUM", BN_num_bytes(elBN));
 }
 
 /* 
@@ -60,6 +61,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZpSafe
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZpSafePrimeElement_deleteElement
   (JNIEnv *, jobject, jlong zpElement){
+	  scapi_native::trackRelease((BIGNUM*)zpElement);
 	  BN_free((BIGNUM*)zpElement);
 }
 
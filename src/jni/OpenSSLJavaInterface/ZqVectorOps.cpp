@@ -0,0 +1,364 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "ZqVectorOps.h"
+#include "../Common/NativeAllocationRegistry.h"
+#include <openssl/bn.h>
+#include <string.h>
+#include <vector>
+
+using namespace std;
+using scapi_native::ZqMontgomery;
+using scapi_native::ZQ_MAX_WORDS;
+
+/*
+ * Converts a non negative number of at most the given number of words to little endian words.
+ */
+static void bnToWords(const BIGNUM* value, uint64_t* words, int numWords){
+	unsigned char bytes[8 * ZQ_MAX_WORDS];
+	int size = BN_num_bytes(value);
+	memset(bytes, 0, sizeof(bytes));
+	BN_bn2bin(value, bytes + 8 * numWords - size);
+	for (int i = 0; i < numWords; i++){
+		uint64_t word = 0;
+		for (int j = 0; j < 8; j++){
+			word = (word << 8) | bytes[8 * (numWords - 1 - i) + j];
+		}
+		words[i] = word;
+	}
+}
+
+ZqVectorContext::ZqVectorContext(ZqMontgomery* arithmetic, BIGNUM* q, BN_CTX* ctx, int elementSize){
+	this->arithmetic = arithmetic;
+	this->q = q;
+	this->ctx = ctx;
+	this->elementSize = elementSize;
+}
+
+ZqVectorContext::~ZqVectorContext(){
+	delete arithmetic;
+	BN_free(q);
+	BN_CTX_free(ctx);
+}
+
+const ZqMontgomery& ZqVectorContext::getArithmetic(){
+	return *arithmetic;
+}
+
+int ZqVectorContext::getElementSize(){
+	return elementSize;
+}
+
+/* 
+ * function load			: Converts elements from big endian byte arrays of elementSize bytes to words.
+ * param bytes				: The elements, one after the other.
+ * param num				: The number of elements.
+ * param elements			: The words of the elements, getWords() for each element.
+ * return					: 1 if all the elements are smaller than q; 0, otherwise.
+ */
+BOOL ZqVectorContext::load(const unsigned char* bytes, int num, uint64_t* elements){
+	int words = arithmetic->getWords();
+	BOOL reduced = 1;
+	for (int i = 0; i < num; i++){
+		const unsigned char* element = bytes + i * elementSize;
+		uint64_t* result = elements + i * words;
+		memset(result, 0, words * sizeof(uint64_t));
+		for (int j = 0; j < elementSize; j++){
+			int position = elementSize - 1 - j;	//The index of the byte from the least significant one.
+			result[position / 8] |= ((uint64_t) element[j]) << (8 * (position % 8));
+		}
+		reduced &= arithmetic->isReduced(result);
+	}
+	return reduced;
+}
+
+/* 
+ * function store			: Converts elements from words to big endian byte arrays of elementSize bytes.
+ */
+void ZqVectorContext::store(const uint64_t* elements, int num, unsigned char* bytes){
+	int words = arithmetic->getWords();
+	for (int i = 0; i < num; i++){
+		const uint64_t* element = elements + i * words;
+		unsigned char* result = bytes + i * elementSize;
+		for (int j = 0; j < elementSize; j++){
+			int position = elementSize - 1 - j;
+			result[j] = (unsigned char) (element[position / 8] >> (8 * (position % 8)));
+		}
+	}
+}
+
+/* 
+ * function invertMany		: Computes the inverses of all the given elements with a single modular inversion 
+ *							  (Montgomery's trick): the inverse of the product of all the elements is computed, and each 
+ *							  inverse is then the product of it with the other elements.
+ * param elements			: The elements to invert.
+ * param num				: The number of elements.
+ * param result				: The inverses. May be elements.
+ * return					: 1 if all the elements are invertible; 0, otherwise.
+ */
+BOOL ZqVectorContext::invertMany(const uint64_t* elements, int num, uint64_t* result){
+	if (num == 0) return 1;
+	int words = arithmetic->getWords();
+	vector<uint64_t> montgomery(num * words), prefix(num * words);
+	uint64_t product[ZQ_MAX_WORDS], one[ZQ_MAX_WORDS];
+	memset(one, 0, sizeof(one));
+	one[0] = 1;
+
+	//prefix[i] is the product of the elements before element i, all in the Montgomery representation.
+	arithmetic->toMontgomery(product, one);
+	for (int i = 0; i < num; i++){
+		arithmetic->toMontgomery(&montgomery[i * words], elements + i * words);
+		memcpy(&prefix[i * words], product, words * sizeof(uint64_t));
+		arithmetic->mulMontgomery(product, product, &montgomery[i * words]);
+	}
+
+	//Invert the product of all the elements.
+	unsigned char bytes[8 * ZQ_MAX_WORDS];
+	arithmetic->fromMontgomery(product, product);
+	store(product, 1, bytes);
+	BIGNUM* inverse;
+	if (NULL == (inverse = BN_bin2bn(bytes, elementSize, NULL))) return 0;
+	if (NULL == BN_mod_inverse(inverse, inverse, q, ctx)){
+		BN_free(inverse);
+		return 0;
+	}
+	bnToWords(inverse, product, words);
+	BN_free(inverse);
+	arithmetic->toMontgomery(product, product);
+
+	//Going backwards, product is the inverse of the product of the elements up to element i.
+	for (int i = num - 1; i >= 0; i--){
+		uint64_t* inverseI = result + i * words;
+		arithmetic->mulMontgomery(inverseI, product, &prefix[i * words]);
+		arithmetic->fromMontgomery(inverseI, inverseI);
+		arithmetic->mulMontgomery(product, product, &montgomery[i * words]);
+	}
+	return 1;
+}
+
+/* 
+ * function createContext	: Creates the arithmetic modulo q.
+ * param qBytes				: The modulus, big endian. Should be odd and of at most 576 bits.
+ * return					: Pointer to the created context, or 0 if the modulus is not supported.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_createContext
+  (JNIEnv *env, jobject, jbyteArray qBytes){
+
+	  BIGNUM *q, *rSquare;
+	  BN_CTX* ctx;
+	  jbyte* q_bytes  = env->GetByteArrayElements(qBytes, 0);
+	  q = BN_bin2bn((unsigned char*) q_bytes, env->GetArrayLength(qBytes), NULL);
+	  env->ReleaseByteArrayElements(qBytes, q_bytes, JNI_ABORT);
+	  if (NULL == q) return 0;
+
+	  int bits = BN_num_bits(q);
+	  if (!BN_is_odd(q) || BN_is_one(q) || bits > 64 * ZQ_MAX_WORDS){
+		  BN_free(q);
+		  return 0;
+	  }
+	  int words = (bits + 63) / 64;
+
+	  //R^2 mod q, where R = 2^(64*words).
+	  if (NULL == (ctx = BN_CTX_new())){
+		  BN_free(q);
+		  return 0;
+	  }
+	  if (NULL == (rSquare = BN_new())){
+		  BN_CTX_free(ctx);
+		  BN_free(q);
+		  return 0;
+	  }
+	  if (0 == BN_set_bit(rSquare, 128 * words) || 0 == BN_mod(rSquare, rSquare, q, ctx)){
+		  BN_free(rSquare);
+		  BN_CTX_free(ctx);
+		  BN_free(q);
+		  return 0;
+	  }
+
+	  uint64_t qWords[ZQ_MAX_WORDS], rWords[ZQ_MAX_WORDS];
+	  bnToWords(q, qWords, words);
+	  bnToWords(rSquare, rWords, words);
+	  BN_free(rSquare);
+
+	  ZqVectorContext* context = new ZqVectorContext(new ZqMontgomery(qWords, rWords, words), q, ctx, (bits + 7) / 8);
+	  return (long) scapi_native::trackAllocation(context, "ZqVectorContext");
+}
+
+enum ZqOperation { ZQ_ADD, ZQ_SUBTRACT, ZQ_MULTIPLY, ZQ_MULTIPLY_ADD };
+
+/*
+ * Loads num elements of the given java array, or a single element that is used for all the indices if the array holds 
+ * one element. Returns the distance between the elements, which is 0 in the second case, or -1 if the array is invalid.
+ */
+static int loadOperand(JNIEnv *env, ZqVectorContext* context, jbyteArray array, int num, vector<unsigned char>& bytes, vector<uint64_t>& elements){
+	int size = context->getElementSize();
+	int words = context->getArithmetic().getWords();
+	int length = env->GetArrayLength(array);
+	int count;
+	if (length == num * size){
+		count = num;
+	} else if (length == size){
+		count = 1;
+	} else{
+		return -1;
+	}
+
+	bytes.resize(count * size);
+	elements.resize(count * words);
+	if (count > 0){
+		env->GetByteArrayRegion(array, 0, count * size, (jbyte*) &bytes[0]);
+	}
+	if (!context->load(bytes.data(), count, elements.data())){
+		return -1;
+	}
+	return (count == 1 && num != 1) ? 0 : words;
+}
+
+/*
+ * Computes the given operation on each index of the vectors and puts the results in the result array.
+ */
+static jboolean operate(JNIEnv *env, jlong contextPtr, ZqOperation operation, jbyteArray a, jbyteArray b, jbyteArray c, jbyteArray result, int num){
+	ZqVectorContext* context = (ZqVectorContext*) contextPtr;
+	const ZqMontgomery& arithmetic = context->getArithmetic();
+	int words = arithmetic.getWords();
+	int size = context->getElementSize();
+	if (num < 0 || env->GetArrayLength(a) != num * size || env->GetArrayLength(result) < num * size) return 0;
+
+	vector<unsigned char> bytes;
+	vector<uint64_t> aElements, bElements, cElements;
+	int aStride = loadOperand(env, context, a, num, bytes, aElements);
+	int bStride = loadOperand(env, context, b, num, bytes, bElements);
+	int cStride = 0;
+	if (operation == ZQ_MULTIPLY_ADD){
+		cStride = loadOperand(env, context, c, num, bytes, cElements);
+	}
+	if (aStride < 0 || bStride < 0 || cStride < 0) return 0;
+
+	vector<uint64_t> results(num * words);
+	for (int i = 0; i < num; i++){
+		uint64_t* r = &results[i * words];
+		const uint64_t* x = &aElements[i * aStride];
+		const uint64_t* y = &bElements[i * bStride];
+		switch (operation){
+		case ZQ_ADD:
+			arithmetic.add(r, x, y);
+			break;
+		case ZQ_SUBTRACT:
+			arithmetic.sub(r, x, y);
+			break;
+		case ZQ_MULTIPLY:
+			arithmetic.mul(r, x, y);
+			break;
+		case ZQ_MULTIPLY_ADD:
+			arithmetic.mulAdd(r, x, y, &cElements[i * cStride]);
+			break;
+		}
+	}
+
+	bytes.resize(num * size);
+	context->store(results.data(), num, bytes.data());
+	if (num > 0){
+		env->SetByteArrayRegion(result, 0, num * size, (jbyte*) &bytes[0]);
+	}
+	return 1;
+}
+
+/* 
+ * function add				: Computes a[i] + b[i] mod q for each index i.
+ * param context			: Pointer to the native context.
+ * param a					: The first vector, num elements of elementSize bytes each, big endian.
+ * param b					: The second vector, num elements or a single element that is used for every index.
+ * param result				: The array to put the results in. May be a or b.
+ * param num				: The number of elements.
+ * return					: True if the vectors are valid and all the elements are smaller than q; False, otherwise.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_add
+  (JNIEnv *env, jobject, jlong context, jbyteArray a, jbyteArray b, jbyteArray result, jint num){
+	  return operate(env, context, ZQ_ADD, a, b, NULL, result, num);
+}
+
+/* 
+ * function subtract		: Computes a[i] - b[i] mod q for each index i. The parameters are as in add.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_subtract
+  (JNIEnv *env, jobject, jlong context, jbyteArray a, jbyteArray b, jbyteArray result, jint num){
+	  return operate(env, context, ZQ_SUBTRACT, a, b, NULL, result, num);
+}
+
+/* 
+ * function multiply		: Computes a[i] * b[i] mod q for each index i. The parameters are as in add.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_multiply
+  (JNIEnv *env, jobject, jlong context, jbyteArray a, jbyteArray b, jbyteArray result, jint num){
+	  return operate(env, context, ZQ_MULTIPLY, a, b, NULL, result, num);
+}
+
+/* 
+ * function multiplyAdd		: Computes a[i] * b[i] + c[i] mod q for each index i. b and c may each be a single element.
+ *							  The other parameters are as in add.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_multiplyAdd
+  (JNIEnv *env, jobject, jlong context, jbyteArray a, jbyteArray b, jbyteArray c, jbyteArray result, jint num){
+	  return operate(env, context, ZQ_MULTIPLY_ADD, a, b, c, result, num);
+}
+
+/* 
+ * function invertMany		: Computes the inverse modulo q of each element of a, with a single modular inversion.
+ * param context			: Pointer to the native context.
+ * param a					: The elements to invert.
+ * param result				: The array to put the inverses in. May be a.
+ * param num				: The number of elements.
+ * return					: True if all the elements are invertible; False, otherwise.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_invertMany
+  (JNIEnv *env, jobject, jlong contextPtr, jbyteArray a, jbyteArray result, jint num){
+
+	  ZqVectorContext* context = (ZqVectorContext*) contextPtr;
+	  int size = context->getElementSize();
+	  if (num < 0 || env->GetArrayLength(a) != num * size || env->GetArrayLength(result) < num * size) return 0;
+
+	  vector<unsigned char> bytes;
+	  vector<uint64_t> elements;
+	  if (loadOperand(env, context, a, num, bytes, elements) < 0) return 0;
+	  if (!context->invertMany(elements.data(), num, elements.data())) return 0;
+
+	  bytes.resize(num * size);
+	  context->store(elements.data(), num, bytes.data());
+	  if (num > 0){
+		  env->SetByteArrayRegion(result, 0, num * size, (jbyte*) &bytes[0]);
+	  }
+	  return 1;
+}
+
+/* 
+ * function deleteContext	: Deletes the native context.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_deleteContext
+  (JNIEnv *, jobject, jlong context){
+	  scapi_native::trackRelease((ZqVectorContext*) context);
+	  delete (ZqVectorContext*) context;
+}
@@ -0,0 +1,121 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps */
+
+#ifndef _Included_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+#define _Included_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+ * Method:    createContext
+ * Signature: ([B)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_createContext
+  (JNIEnv *, jobject, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+ * Method:    add
+ * Signature: (J[B[B[BI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_add
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+ * Method:    subtract
+ * Signature: (J[B[B[BI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_subtract
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+ * Method:    multiply
+ * Signature: (J[B[B[BI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_multiply
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+ * Method:    multiplyAdd
+ * Signature: (J[B[B[B[BI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_multiplyAdd
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+ * Method:    invertMany
+ * Signature: (J[B[BI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_invertMany
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps
+ * Method:    deleteContext
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLZqVectorOps_deleteContext
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+
+#include <openssl/bn.h>
+#include <vector>
+#include "../Common/ZqMontgomery.h"
+
+/*
+ * The arithmetic modulo q together with the conversion of elements from and to the fixed size big endian byte arrays
+ * that java uses.
+ */
+class ZqVectorContext {
+private:
+	scapi_native::ZqMontgomery* arithmetic;
+	BIGNUM* q;
+	BN_CTX* ctx;
+	int elementSize;	//The number of bytes of an element in the java arrays.
+
+public:
+	ZqVectorContext(scapi_native::ZqMontgomery* arithmetic, BIGNUM* q, BN_CTX* ctx, int elementSize);
+	~ZqVectorContext();
+
+	const scapi_native::ZqMontgomery& getArithmetic();
+	int getElementSize();
+	BOOL load(const unsigned char* bytes, int num, uint64_t* elements);
+	void store(const uint64_t* elements, int num, unsigned char* bytes);
+	BOOL invertMany(const uint64_t* elements, int num, uint64_t* result);
+};
+
+#endif
+#endif
@@ -3,6 +3,10 @@
 #include "OTSemiHonestExtensionReceiver.h"
 #include "OTSemiHonestExtensionSender.h"
 #include "jni.h"
+#include "../Common/NativeAllocationRegistry.h"
+#include "../Common/ScapiProbes.h"
+
+DEFINE_NATIVE_ALLOCATION_STATS(OtExtension)
 
 
 
@@ -212,7 +216,9 @@ BOOL PrecomputeNaorPinkasSender()
 	
 	U.Create(NUM_EXECS_NAOR_PINKAS*log_nVals, m_aSeed, cnt);
 	
+	SCAPI_PROBE1(base_ot_start, NUM_EXECS_NAOR_PINKAS);
 	bot->Receiver(nSndVals, NUM_EXECS_NAOR_PINKAS, U, m_vSockets[0], pBuf);
+	SCAPI_PROBE1(base_ot_done, NUM_EXECS_NAOR_PINKAS);
 	
 	//Key expansion
 	BYTE* pBufIdx = pBuf;
@@ -235,7 +241,9 @@ BOOL PrecomputeNaorPinkasReceiver()
 	
 	//=================================================	
 	// N-P sender: send: C0 (=g^r), C1, C2, C3 
+	SCAPI_PROBE1(base_ot_start, NUM_EXECS_NAOR_PINKAS);
 	bot->Sender(nSndVals, NUM_EXECS_NAOR_PINKAS, m_vSockets[0], pBuf);
+	SCAPI_PROBE1(base_ot_done, NUM_EXECS_NAOR_PINKAS);
 	
 	//Key expansion
 	BYTE* pBufIdx = pBuf;
@@ -264,7 +272,9 @@ BOOL ObliviouslySend(OTExtensionSender* sender, CBitVector& X1, CBitVector& X2,
 	gettimeofday(&ot_begin, NULL);
 #endif
 	// Execute OT sender routine 	
+	SCAPI_PROBE2(ot_send_start, numOTs, bitlength);
 	success = sender->send(numOTs, bitlength, X1, X2, delta, version, m_nNumOTThreads, m_fMaskFct);
+	SCAPI_PROBE2(ot_send_done, numOTs, bitlength);
 	
 #ifdef OTTiming
 	gettimeofday(&ot_end, NULL);
@@ -282,7 +292,9 @@ BOOL ObliviouslyReceive(OTExtensionReceiver* receiver, CBitVector& choices, CBit
 	gettimeofday(&ot_begin, NULL);
 #endif
 	// Execute OT receiver routine 	
+	SCAPI_PROBE2(ot_receive_start, numOTs, bitlength);
 	success = receiver->receive(numOTs, bitlength, choices, ret, version, m_nNumOTThreads, m_fMaskFct);
+	SCAPI_PROBE2(ot_receive_done, numOTs, bitlength);
 	
 #ifdef OTTiming
 	gettimeofday(&ot_end, NULL);
@@ -325,7 +337,12 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_ot
 	}
 	  //get the string from java
 	const char* adrr = env->GetStringUTFChars( ipAddress, NULL );
-	return (jlong) InitOTReceiver(adrr, port, numOfthreads);
+	OTExtensionReceiver* receiver = InitOTReceiver(adrr, port, numOfthreads);
+
+	//the address is only used while connecting.
+	env->ReleaseStringUTFChars(ipAddress, adrr);
+
+	return (jlong) scapi_native::trackAllocation(receiver, "OTExtensionReceiver");
 
 }
 
@@ -424,7 +441,12 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_ot
 	}
 	  //get the string from java
 	const char* adrr = env->GetStringUTFChars( ipAddress, NULL );
-	return (jlong) InitOTSender(adrr, port, numOfThreads);
+	OTExtensionSender* sender = InitOTSender(adrr, port, numOfThreads);
+
+	//the address is only used while connecting.
+	env->ReleaseStringUTFChars(ipAddress, adrr);
+
+	return (jlong) scapi_native::trackAllocation(sender, "OTExtensionSender");
 
 }
 
@@ -538,10 +560,12 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otE
 
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionSender_deleteSender
   (JNIEnv *, jobject, jlong sender){
+	  scapi_native::trackRelease((OTExtensionSender*) sender);
 	  delete (OTExtensionSender*) sender;
 }
 
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_ot_otBatch_otExtension_OTSemiHonestExtensionReceiver_deleteReceiver
   (JNIEnv *, jobject, jlong receiver){
+	  scapi_native::trackRelease((OTExtensionReceiver*) receiver);
 	  delete (OTExtensionReceiver*) receiver;
 }
@@ -0,0 +1,70 @@
+// AesNiCipher.h : AES-128 encryption with the AES-NI instructions, used by the native garbling engines of this library.
+
+#ifndef AES_NI_CIPHER_H
+#define AES_NI_CIPHER_H
+
+#include <wmmintrin.h>
+#include <emmintrin.h>
+
+static inline __m128i expandKeyStep(__m128i key, __m128i generated) {
+	generated = _mm_shuffle_epi32(generated, 0xff);
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	return _mm_xor_si128(key, generated);
+}
+
+#define EXPAND_KEY(i, rcon) roundKeys[i] = expandKeyStep(roundKeys[i - 1], _mm_aeskeygenassist_si128(roundKeys[i - 1], rcon))
+
+/*
+ * AES-128 with a key that is set once. The key schedule is computed in the constructor.
+ */
+class AesNiCipher {
+private:
+	__m128i roundKeys[11];
+
+public:
+	explicit AesNiCipher(__m128i key) {
+		roundKeys[0] = key;
+		EXPAND_KEY(1, 0x01);
+		EXPAND_KEY(2, 0x02);
+		EXPAND_KEY(3, 0x04);
+		EXPAND_KEY(4, 0x08);
+		EXPAND_KEY(5, 0x10);
+		EXPAND_KEY(6, 0x20);
+		EXPAND_KEY(7, 0x40);
+		EXPAND_KEY(8, 0x80);
+		EXPAND_KEY(9, 0x1b);
+		EXPAND_KEY(10, 0x36);
+	}
+
+	__m128i encrypt(__m128i block) const {
+		block = _mm_xor_si128(block, roundKeys[0]);
+		for (int i = 1; i < 10; i++) {
+			block = _mm_aesenc_si128(block, roundKeys[i]);
+		}
+		return _mm_aesenclast_si128(block, roundKeys[10]);
+	}
+
+	/*
+	 * Encrypts N independent blocks in place. The rounds of the blocks are interleaved so the aes unit is kept busy.
+	 */
+	template<int N>
+	void encryptBlocks(__m128i* blocks) const {
+		for (int j = 0; j < N; j++) {
+			blocks[j] = _mm_xor_si128(blocks[j], roundKeys[0]);
+		}
+		for (int i = 1; i < 10; i++) {
+			for (int j = 0; j < N; j++) {
+				blocks[j] = _mm_aesenc_si128(blocks[j], roundKeys[i]);
+			}
+		}
+		for (int j = 0; j < N; j++) {
+			blocks[j] = _mm_aesenclast_si128(blocks[j], roundKeys[10]);
+		}
+	}
+};
+
+#undef EXPAND_KEY
+
+#endif
@@ -0,0 +1,209 @@
+// FixedKeyGarbledGates.cpp : The native engine of the java garbled circuits (edu.biu.scapi.circuits.garbledCircuit) that use
+// AESFixedKeyMultiKeyEncryption.
+//
+// The garbled tables and the computed keys are identical to the ones created by StandardGarbledGate and
+// StandardRowReductionGarbledGate, so circuits garbled by the native engine can be computed in java and vice versa.
+// The keys themselves are still sampled in java (by the circuit utilities, from the encryption scheme or the prg), so the
+// garbling with a seed results in the same circuit as before.
+
+#ifdef _WIN32
+	#include "StdAfx.h"
+#else
+	#include <string.h>
+#endif
+#include "FixedKeyGarbledGates.h"
+#include "AesNiCipher.h"
+#include "../Common/ScapiProbes.h"
+#include <stdint.h>
+
+#define GATE_DESC_SIZE edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_GATE_DESC_SIZE
+#define FREE_XOR_GATE edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_FREE_XOR_GATE
+#define ROW_REDUCTION_GATE edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_ROW_REDUCTION_GATE
+
+//The offsets of the fields in the description of a gate (see NativeGarbledGates.java).
+#define DESC_KIND 0
+#define DESC_GATE_NUMBER 1
+#define DESC_NUM_INPUTS 2
+#define DESC_INPUTS 3
+#define DESC_OUTPUT 6
+#define DESC_TRUTH_TABLE 7
+
+#define BLOCK_SIZE 16
+#define MAX_INPUTS 3
+
+//The fixed key of AESFixedKeyMultiKeyEncryption.
+static const unsigned char FIXED_KEY[BLOCK_SIZE] = { 0xf3, 0x1d, 0xec, 0x62, 0xa0, 0xcd, 0xaa, 0xae, 0x09, 0x31, 0xe6, 0x5c, 0xea, 0x32, 0x9c, 0x24 };
+
+//AES-128 with the fixed key. The key schedule is computed once, when the library is loaded.
+static const AesNiCipher fixedKeyAES(_mm_loadu_si128((const __m128i*) FIXED_KEY));
+
+/*
+ * The keys of the free xor circuits are multiplied (or divided) by two before they are used, the same as the java code does:
+ * each 8 bytes of the key are read as a big endian signed long and shifted by one bit.
+ */
+static inline uint64_t readBigEndian(const unsigned char* bytes) {
+	uint64_t value = 0;
+	for (int i = 0; i < 8; i++) {
+		value = (value << 8) | bytes[i];
+	}
+	return value;
+}
+
+static inline void writeBigEndian(uint64_t value, unsigned char* bytes) {
+	for (int i = 7; i >= 0; i--) {
+		bytes[i] = (unsigned char) value;
+		value >>= 8;
+	}
+}
+
+static inline void shiftKey(const unsigned char* key, unsigned char* shifted, bool left) {
+	for (int i = 0; i < BLOCK_SIZE; i += 8) {
+		int64_t value = (int64_t) readBigEndian(key + i);
+		writeBigEndian(left ? ((uint64_t) value << 1) : (uint64_t) (value >> 1), shifted + i);
+	}
+}
+
+static inline void writeInt(int value, unsigned char* bytes) {
+	bytes[0] = (unsigned char) (value >> 24);
+	bytes[1] = (unsigned char) (value >> 16);
+	bytes[2] = (unsigned char) (value >> 8);
+	bytes[3] = (unsigned char) value;
+}
+
+/*
+ * Computes a row of a garbled table, the same as AESFixedKeyMultiKeyEncryption.encrypt (and decrypt):
+ * K = keys[0] ^ ... ^ keys[n-1] ^ tweak, row = AES(K) ^ K ^ text.
+ */
+static inline void processRow(const unsigned char* const* keys, int numKeys, const unsigned char* tweak, const unsigned char* text,
+		unsigned char* row, bool freeXor) {
+	unsigned char shifted[BLOCK_SIZE];
+	__m128i k = _mm_loadu_si128((const __m128i*) tweak);
+	for (int i = 0; i < numKeys; i++) {
+		if (freeXor) {
+			//The first key is multiplied by two and the others are divided by two.
+			shiftKey(keys[i], shifted, i == 0);
+			k = _mm_xor_si128(k, _mm_loadu_si128((const __m128i*) shifted));
+		} else {
+			k = _mm_xor_si128(k, _mm_loadu_si128((const __m128i*) keys[i]));
+		}
+	}
+	__m128i result = _mm_xor_si128(fixedKeyAES.encrypt(k), k);
+	result = _mm_xor_si128(result, _mm_loadu_si128((const __m128i*) text));
+	_mm_storeu_si128((__m128i*) row, result);
+}
+
+static inline int signalBit(const unsigned char* key) {
+	return key[BLOCK_SIZE - 1] & 1;
+}
+
+/* function garbleTables : Creates the garbled tables of all the standard and row reduction gates of the circuit, using both keys of each wire.
+ * param gatesDesc	: The description of the gates, GATE_DESC_SIZE ints for each gate.
+ * param wireKeys	: Both keys of each wire; the keys of wire w are at w*32 (the 0-key) and w*32 + 16 (the 1-key).
+ * param tables		: The garbled tables of the circuit, indexed by the gate number. The table of each garbled gate is already allocated.
+ * param freeXor	: Whether the encryption scheme is used in free xor mode.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_garbleTables
+  (JNIEnv *env, jclass, jintArray gatesDesc, jbyteArray wireKeys, jobjectArray tables, jboolean freeXor) {
+
+	jsize numGates = env->GetArrayLength(gatesDesc) / GATE_DESC_SIZE;
+	jint* gates = env->GetIntArrayElements(gatesDesc, NULL);
+	unsigned char* keys = (unsigned char*) env->GetByteArrayElements(wireKeys, NULL);
+
+	unsigned char table[(1 << MAX_INPUTS) * BLOCK_SIZE];
+	const unsigned char* keysToEncryptOn[MAX_INPUTS];
+	unsigned char tweak[BLOCK_SIZE];
+
+	SCAPI_PROBE2(garble_start, numGates, 0);
+	for (jsize g = 0; g < numGates; g++) {
+		const jint* gate = gates + g * GATE_DESC_SIZE;
+		if (gate[DESC_KIND] == FREE_XOR_GATE) {
+			continue;
+		}
+		int numInputs = gate[DESC_NUM_INPUTS];
+		int numRows = 1 << numInputs;
+		//In the row reduction technique the last row of the permuted table is not saved.
+		int numSavedRows = (gate[DESC_KIND] == ROW_REDUCTION_GATE) ? numRows - 1 : numRows;
+		const unsigned char* outputKeys = keys + gate[DESC_OUTPUT] * 2 * BLOCK_SIZE;
+
+		for (int row = 0; row < numRows; row++) {
+			memset(tweak, 0, BLOCK_SIZE);
+			writeInt(gate[DESC_GATE_NUMBER], tweak);
+			int permutedPosition = 0;
+
+			//Go over the inputs of the row from left to right, as StandardGarbledGate does.
+			for (int i = 0; i < numInputs; i++) {
+				int input = (row >> (numInputs - 1 - i)) & 1;
+				const unsigned char* inputKeys = keys + gate[DESC_INPUTS + i] * 2 * BLOCK_SIZE;
+				int permutedBit = input ^ signalBit(inputKeys);
+				permutedPosition |= permutedBit << (numInputs - 1 - i);
+				keysToEncryptOn[i] = inputKeys + input * BLOCK_SIZE;
+				writeInt(permutedBit, tweak + 4 * (i + 1));
+			}
+
+			if (permutedPosition < numSavedRows) {
+				int value = (gate[DESC_TRUTH_TABLE] >> row) & 1;
+				processRow(keysToEncryptOn, numInputs, tweak, outputKeys + value * BLOCK_SIZE, table + permutedPosition * BLOCK_SIZE, freeXor == JNI_TRUE);
+			}
+		}
+
+		jbyteArray gateTable = (jbyteArray) env->GetObjectArrayElement(tables, gate[DESC_GATE_NUMBER]);
+		env->SetByteArrayRegion(gateTable, 0, numSavedRows * BLOCK_SIZE, (jbyte*) table);
+		env->DeleteLocalRef(gateTable);
+	}
+	SCAPI_PROBE2(garble_done, numGates, 0);
+
+	env->ReleaseByteArrayElements(wireKeys, (jbyte*) keys, JNI_ABORT);
+	env->ReleaseIntArrayElements(gatesDesc, gates, JNI_ABORT);
+}
+
+/* function computeGates : Computes the free xor and standard gates of the circuit.
+ * param gatesDesc		: The description of the gates, GATE_DESC_SIZE ints for each gate.
+ * param wireValues		: The computed key of each wire, at w*16. The keys of the input wires should be set, the other keys are filled by this function.
+ * param tables			: The garbled tables of the circuit, indexed by the gate number.
+ * param freeXor		: Whether the encryption scheme is used in free xor mode.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_computeGates
+  (JNIEnv *env, jclass, jintArray gatesDesc, jbyteArray wireValues, jobjectArray tables, jboolean freeXor) {
+
+	jsize numGates = env->GetArrayLength(gatesDesc) / GATE_DESC_SIZE;
+	jint* gates = env->GetIntArrayElements(gatesDesc, NULL);
+	unsigned char* values = (unsigned char*) env->GetByteArrayElements(wireValues, NULL);
+
+	const unsigned char* keysToDecryptOn[MAX_INPUTS];
+	unsigned char tweak[BLOCK_SIZE];
+	unsigned char row[BLOCK_SIZE];
+
+	SCAPI_PROBE2(compute_start, numGates, 0);
+	for (jsize g = 0; g < numGates; g++) {
+		const jint* gate = gates + g * GATE_DESC_SIZE;
+		unsigned char* output = values + gate[DESC_OUTPUT] * BLOCK_SIZE;
+
+		if (gate[DESC_KIND] == FREE_XOR_GATE) {
+			__m128i first = _mm_loadu_si128((const __m128i*) (values + gate[DESC_INPUTS] * BLOCK_SIZE));
+			__m128i second = _mm_loadu_si128((const __m128i*) (values + gate[DESC_INPUTS + 1] * BLOCK_SIZE));
+			_mm_storeu_si128((__m128i*) output, _mm_xor_si128(first, second));
+			continue;
+		}
+
+		int numInputs = gate[DESC_NUM_INPUTS];
+		memset(tweak, 0, BLOCK_SIZE);
+		writeInt(gate[DESC_GATE_NUMBER], tweak);
+		int garbledTableIndex = 0;
+		for (int i = 0; i < numInputs; i++) {
+			keysToDecryptOn[i] = values + gate[DESC_INPUTS + i] * BLOCK_SIZE;
+			int bit = signalBit(keysToDecryptOn[i]);
+			garbledTableIndex |= bit << (numInputs - 1 - i);
+			writeInt(bit, tweak + 4 * (i + 1));
+		}
+
+		jbyteArray gateTable = (jbyteArray) env->GetObjectArrayElement(tables, gate[DESC_GATE_NUMBER]);
+		env->GetByteArrayRegion(gateTable, garbledTableIndex * BLOCK_SIZE, BLOCK_SIZE, (jbyte*) row);
+		env->DeleteLocalRef(gateTable);
+
+		processRow(keysToDecryptOn, numInputs, tweak, row, output, freeXor == JNI_TRUE);
+	}
+	SCAPI_PROBE2(compute_done, numGates, 0);
+
+	env->ReleaseByteArrayElements(wireValues, (jbyte*) values, 0);
+	env->ReleaseIntArrayElements(gatesDesc, gates, JNI_ABORT);
+}
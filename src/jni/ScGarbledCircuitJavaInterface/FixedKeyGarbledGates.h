@@ -0,0 +1,37 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates */
+
+#ifndef _Included_edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates
+#define _Included_edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_GATE_DESC_SIZE
+#define edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_GATE_DESC_SIZE 8L
+#undef edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_FREE_XOR_GATE
+#define edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_FREE_XOR_GATE 0L
+#undef edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_STANDARD_GATE
+#define edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_STANDARD_GATE 1L
+#undef edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_ROW_REDUCTION_GATE
+#define edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_ROW_REDUCTION_GATE 2L
+/*
+ * Class:     edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates
+ * Method:    garbleTables
+ * Signature: ([I[B[[BZ)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_garbleTables
+  (JNIEnv *, jclass, jintArray, jbyteArray, jobjectArray, jboolean);
+
+/*
+ * Class:     edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates
+ * Method:    computeGates
+ * Signature: ([I[B[[BZ)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_garbledCircuit_NativeGarbledGates_computeGates
+  (JNIEnv *, jclass, jintArray, jbyteArray, jobjectArray, jboolean);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,133 @@
+// GarbledLabels.cpp : Conversions between the input/output bits of a circuit and the garbled labels of its wires
+// (see edu.biu.scapi.circuits.fastGarbledCircuit.GarbledLabelsUtil).
+//
+// The labels of the wires are kept as in FastCircuitCreationValues: two 16 bytes labels for each wire, the label of 0 followed
+// by the label of 1. The packed bits are little endian, i.e. bit i is bit (i % 8) of byte (i / 8).
+
+#ifdef _WIN32
+	#include "StdAfx.h"
+#else
+	#include <string.h>
+#endif
+#include "GarbledLabels.h"
+#include <emmintrin.h>
+
+#define BLOCK_SIZE 16
+
+/*
+ * function packBits : Packs an array that holds one bit in each byte into an array that holds eight bits in each byte.
+ * Sixteen bits are packed at a time by moving the bit of each byte to its sign bit and taking the mask of the signs.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil_nativePackBits
+  (JNIEnv *env, jclass, jbyteArray bits){
+
+	int numBits = env->GetArrayLength(bits);
+	int numBytes = (numBits + 7) / 8;
+	jbyteArray packed = env->NewByteArray(numBytes);
+
+	unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(bits, 0);
+	unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(packed, 0);
+
+	int i = 0;
+	for (; i + 16 <= numBits; i += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*) (in + i));
+		int mask = _mm_movemask_epi8(_mm_slli_epi16(chunk, 7));
+		out[i / 8] = (unsigned char) mask;
+		out[i / 8 + 1] = (unsigned char) (mask >> 8);
+	}
+	//Pack the rest of the bits one by one.
+	if (i < numBits) {
+		memset(out + i / 8, 0, numBytes - i / 8);
+		for (; i < numBits; i++) {
+			out[i / 8] |= (in[i] & 1) << (i % 8);
+		}
+	}
+
+	env->ReleasePrimitiveArrayCritical(packed, out, 0);
+	env->ReleasePrimitiveArrayCritical(bits, in, JNI_ABORT);
+
+	return packed;
+}
+
+/*
+ * function unpackBits : Unpacks the given number of bits into an array that holds one bit in each byte.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil_nativeUnpackBits
+  (JNIEnv *env, jclass, jbyteArray packed, jint numBits){
+
+	jbyteArray bits = env->NewByteArray(numBits);
+
+	unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(packed, 0);
+	unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(bits, 0);
+
+	for (int i = 0; i < numBits; i++) {
+		out[i] = (in[i / 8] >> (i % 8)) & 1;
+	}
+
+	env->ReleasePrimitiveArrayCritical(bits, out, 0);
+	env->ReleasePrimitiveArrayCritical(packed, in, JNI_ABORT);
+
+	return bits;
+}
+
+/*
+ * function selectLabels : Returns the label of each wire that matches its bit in the given packed bits.
+ * The selection is done without branches, by blending the two labels of the wire with a mask that is all zeros or all ones.
+ * param allLabels	: Two labels for each wire.
+ * param firstWire	: The index (in allLabels) of the wire of the first bit.
+ * param packedBits	: The packed bits of the wires.
+ * param numBits	: The number of bits (and wires).
+ * return			: numBits labels, one after the other.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil_nativeSelectLabels
+  (JNIEnv *env, jclass, jbyteArray allLabels, jint firstWire, jbyteArray packedBits, jint numBits){
+
+	jbyteArray selected = env->NewByteArray(numBits * BLOCK_SIZE);
+
+	unsigned char* labels = (unsigned char*) env->GetPrimitiveArrayCritical(allLabels, 0);
+	unsigned char* bits = (unsigned char*) env->GetPrimitiveArrayCritical(packedBits, 0);
+	unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(selected, 0);
+
+	const __m128i* pairs = (const __m128i*) (labels + 2 * firstWire * BLOCK_SIZE);
+	for (int i = 0; i < numBits; i++) {
+		__m128i zero = _mm_loadu_si128(pairs + 2 * i);
+		__m128i one = _mm_loadu_si128(pairs + 2 * i + 1);
+		__m128i mask = _mm_set1_epi8(-(char) ((bits[i / 8] >> (i % 8)) & 1));
+		//zero ^ ((zero ^ one) & mask) is one if the mask is set and zero otherwise.
+		__m128i label = _mm_xor_si128(zero, _mm_and_si128(_mm_xor_si128(zero, one), mask));
+		_mm_storeu_si128((__m128i*) (out + i * BLOCK_SIZE), label);
+	}
+
+	env->ReleasePrimitiveArrayCritical(selected, out, 0);
+	env->ReleasePrimitiveArrayCritical(packedBits, bits, JNI_ABORT);
+	env->ReleasePrimitiveArrayCritical(allLabels, labels, JNI_ABORT);
+
+	return selected;
+}
+
+/*
+ * function bitsFromLabels : Translates output labels to their bits, using the translation table of the circuit.
+ * The bit of each label is its signal bit (the lsb of its first byte) xored with the signal bit of the label of 0 that
+ * the translation table holds, as done by the translate of the native circuit.
+ * return : One bit for each output label, in a byte.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil_nativeBitsFromLabels
+  (JNIEnv *env, jclass, jbyteArray outputLabels, jbyteArray translationTable){
+
+	int numOutputs = env->GetArrayLength(translationTable);
+	jbyteArray bits = env->NewByteArray(numOutputs);
+
+	unsigned char* labels = (unsigned char*) env->GetPrimitiveArrayCritical(outputLabels, 0);
+	unsigned char* table = (unsigned char*) env->GetPrimitiveArrayCritical(translationTable, 0);
+	unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(bits, 0);
+
+	for (int i = 0; i < numOutputs; i++) {
+		out[i] = (labels[i * BLOCK_SIZE] ^ table[i]) & 1;
+	}
+
+	env->ReleasePrimitiveArrayCritical(bits, out, 0);
+	env->ReleasePrimitiveArrayCritical(translationTable, table, JNI_ABORT);
+	env->ReleasePrimitiveArrayCritical(outputLabels, labels, JNI_ABORT);
+
+	return bits;
+}
@@ -0,0 +1,45 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil */
+
+#ifndef _Included_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil
+#define _Included_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil
+ * Method:    nativePackBits
+ * Signature: ([B)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil_nativePackBits
+  (JNIEnv *, jclass, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil
+ * Method:    nativeUnpackBits
+ * Signature: ([BI)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil_nativeUnpackBits
+  (JNIEnv *, jclass, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil
+ * Method:    nativeSelectLabels
+ * Signature: ([BI[BI)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil_nativeSelectLabels
+  (JNIEnv *, jclass, jbyteArray, jint, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil
+ * Method:    nativeBitsFromLabels
+ * Signature: ([B[B)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_GarbledLabelsUtil_nativeBitsFromLabels
+  (JNIEnv *, jclass, jbyteArray, jbyteArray);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -13,10 +13,98 @@
 #include "StandardGarbledBooleanCircuit.h"
 #include "FreeXorGarbledBooleanCircuit.h"
 #include "HalfGatesGarbledBooleanCircuit.h"
+#include "ThreeHalvesGarbledBooleanCircuit.h"
+#include "../Common/NativeAllocationRegistry.h"
+#include "../Common/ScapiProbes.h"
+#include "../Common/HugePageAllocator.h"
 #include <iostream>
 
 using namespace std;
 
+DEFINE_NATIVE_ALLOCATION_STATS(ScGarbledCircuit)
+
+//The type of the three halves circuit (FREE_XOR_THREE_HALVES in ScNativeGarbledBooleanCircuit.CircuitType).
+#define THREE_HALVES_TYPE 4
+
+/*
+ * The three halves circuit is implemented in this library and is not a GarbledBooleanCircuit, so its pointer is returned to java with
+ * the lowest bit set (the pointers of both classes are aligned). The functions that are called from java are templates over the class
+ * of the circuit and DISPATCH_CIRCUIT calls the function of the right class.
+ */
+#define THREE_HALVES_TAG 1
+
+#define DISPATCH_CIRCUIT(gbcPtr, function, ...) \
+	if ((gbcPtr) & THREE_HALVES_TAG) \
+		return function((ThreeHalvesGarbledBooleanCircuit *)((gbcPtr) & ~(jlong)THREE_HALVES_TAG), __VA_ARGS__); \
+	return function((GarbledBooleanCircuit *)(gbcPtr), __VA_ARGS__)
+
+/* function getGarbledTablesSize : Returns the size in bytes of the garbled tables of the given circuit.
+ */
+static int getGarbledTablesSize(GarbledBooleanCircuit * garbledCircuit){
+
+	int mult = 4;//for a regular circuit we have 4 blocks for each gate
+
+	if(garbledCircuit->getIsRowReduction()==true){
+
+		mult = 3;//in row reduction we only have 3 rows
+	}
+	else if (garbledCircuit->getIsTwoRows() == true){
+		mult = 2; //half gates only use 2 rows for AND gates
+	}
+
+	if (garbledCircuit->getIsNonXorOutputsRequired()){
+		return ((garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult + 2 * garbledCircuit->getNumberOfOutputs()) * 16;
+	}
+	else{
+		return (garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult * 16;
+	}
+}
+
+/* function getGarbledTablesSize : Returns the size in bytes of the garbled tables of the three halves circuit: 1.5 blocks and 5 bits for
+ * each AND gate.
+ */
+static int getGarbledTablesSize(ThreeHalvesGarbledBooleanCircuit * garbledCircuit){
+
+	return garbledCircuit->getGarbledTablesSize();
+}
+
+/* function computeCircuit : Computes the circuit. The half gates circuit has its own compute.
+ */
+static void computeCircuit(GarbledBooleanCircuit * garbledCircuit, block * inputs, block * outputs){
+
+	if (garbledCircuit->getIsTwoRows() == true){
+		((HalfGatesGarbledBooleanCircuit *)garbledCircuit)->compute(inputs, outputs);
+	}
+	else{
+		//call the native function compute of the garbled circuit
+		garbledCircuit->compute(inputs, outputs);
+	}
+}
+
+static void computeCircuit(ThreeHalvesGarbledBooleanCircuit * garbledCircuit, block * inputs, block * outputs){
+
+	garbledCircuit->compute(inputs, outputs);
+}
+
+/* function computeSets : Computes the circuit on numSets sets of input keys. The gates of the ScGarbledCircuit library are computed
+ * inside the library, so its circuits compute the sets one after the other.
+ */
+static void computeSets(GarbledBooleanCircuit * garbledCircuit, block * inputs, block * outputs, int numSets){
+
+	int numInputs = garbledCircuit->getNumberOfInputs();
+	int numOutputs = garbledCircuit->getNumberOfOutputs();
+	for (int i = 0; i < numSets; i++){
+		computeCircuit(garbledCircuit, inputs + i * numInputs, outputs + i * numOutputs);
+	}
+}
+
+/* The three halves circuit computes each gate on a few sets at a time.
+ */
+static void computeSets(ThreeHalvesGarbledBooleanCircuit * garbledCircuit, block * inputs, block * outputs, int numSets){
+
+	garbledCircuit->computeMany(inputs, outputs, numSets);
+}
+
 
 /* function createGarbledcircuit : This function creates a new circuit and returns a pointer to the created circuit. 
  * return			   : A pointer to the created circuit.
@@ -25,29 +113,39 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeG
 (JNIEnv *env, jobject, jstring fileName, jint type, jboolean isNonXorOutputsRequired){
 
 	const char* str = env->GetStringUTFChars(fileName, NULL);
-	char *strFileName = (char*)str;
 
 	GarbledBooleanCircuit *garbledCircuit = NULL;
+	ThreeHalvesGarbledBooleanCircuit *threeHalvesCircuit = NULL;
 
-	switch (type) {
-	case 0:  
-		garbledCircuit = new HalfGatesGarbledBooleanCircuit(str, isNonXorOutputsRequired);
-		break;
+	//the circuit constructors read the circuit file and may throw. In this case the file name should still be released.
+	try {
+		switch (type) {
+		case 0:  
+			garbledCircuit = new HalfGatesGarbledBooleanCircuit(str, isNonXorOutputsRequired);
+			break;
 
-	case 1:
-		garbledCircuit = new RowReductionGarbledBooleanCircuit(str, isNonXorOutputsRequired);
-		break;
-
-	case 2:
-		garbledCircuit = new FreeXorGarbledBooleanCircuit(str, isNonXorOutputsRequired);
-		break;
-
-	case 3:
-		garbledCircuit = new StandardGarbledBooleanCircuit(str);
-		break;
-	default: 
-		;
-		break;
+		case 1:
+			garbledCircuit = new RowReductionGarbledBooleanCircuit(str, isNonXorOutputsRequired);
+			break;
+
+		case 2:
+			garbledCircuit = new FreeXorGarbledBooleanCircuit(str, isNonXorOutputsRequired);
+			break;
+
+		case 3:
+			garbledCircuit = new StandardGarbledBooleanCircuit(str);
+			break;
+
+		case THREE_HALVES_TYPE:
+			threeHalvesCircuit = new ThreeHalvesGarbledBooleanCircuit(str, isNonXorOutputsRequired);
+			break;
+		default: 
+			;
+			break;
+		}
+	} catch (...) {
+		env->ReleaseStringUTFChars(fileName, str);
+		return 0;
 	}
 	/*
 
@@ -74,6 +172,18 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeG
 	//release memory 
 	env->ReleaseStringUTFChars(fileName, str);
 
+	if (threeHalvesCircuit != NULL){
+		scapi_native::trackAllocation(threeHalvesCircuit, "ThreeHalvesGarbledBooleanCircuit", sizeof(*threeHalvesCircuit) + getGarbledTablesSize(threeHalvesCircuit));
+		return (jlong)threeHalvesCircuit | THREE_HALVES_TAG;
+	}
+
+	//an unknown type does not create a circuit.
+	if (garbledCircuit == NULL){
+		return 0;
+	}
+
+	scapi_native::trackAllocation(garbledCircuit, "GarbledBooleanCircuit", sizeof(*garbledCircuit) + getGarbledTablesSize(garbledCircuit));
+
 	//return the pointer of the circuit. This will be saved in the java enviroment. Every access to the circuit, this pointer will
 	//be sent from java.
 	return (jlong)garbledCircuit;
@@ -83,11 +193,8 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeG
 /* function getOutputIndicesArray : This function returns the output indices array held in the circuit. 
  * return			: The output indices array
  */
-JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getOutputIndicesArray
-  (JNIEnv * env, jobject, jlong gbcPtr){
-
-	 //get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
+template<class Circuit>
+static jintArray getOutputIndicesArray(Circuit * garbledCircuit, JNIEnv * env){
 
 	//get the size of the output wire numbers
 	int size= garbledCircuit->getNumberOfOutputs();
@@ -102,15 +209,18 @@ JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNat
 
 
 }
+
+JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getOutputIndicesArray
+  (JNIEnv * env, jobject, jlong gbcPtr){
+
+	DISPATCH_CIRCUIT(gbcPtr, getOutputIndicesArray, env);
+}
 /* function getOutputIndicesArray : This function returns the input indices array held in the circuit. These indices are for all the parties
  *									One after the other.
  * return			: The input indices array
  */
-JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getInputIndicesArray
-  (JNIEnv *env, jobject, jlong gbcPtr){
-
-	 //get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
+template<class Circuit>
+static jintArray getInputIndicesArray(Circuit * garbledCircuit, JNIEnv *env){
 
 	//get the size of the output wire numbers
 	int size= garbledCircuit->getNumberOfInputs();
@@ -125,13 +235,16 @@ JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNat
 
 }
 
-/* function getOutputIndicesArray : This function returns the an array that holds for each party the number of inputs it has in the circuit.
- */
-JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getNumOfInputsForEachParty
+JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getInputIndicesArray
   (JNIEnv *env, jobject, jlong gbcPtr){
 
-	  //get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
+	DISPATCH_CIRCUIT(gbcPtr, getInputIndicesArray, env);
+}
+
+/* function getOutputIndicesArray : This function returns the an array that holds for each party the number of inputs it has in the circuit.
+ */
+template<class Circuit>
+static jintArray getNumOfInputsForEachParty(Circuit * garbledCircuit, JNIEnv *env){
 
 	//get the size of the output wire numbers
 	int size= garbledCircuit->getNumberOfParties();
@@ -145,13 +258,16 @@ JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNat
 	return result;
 }
 
-/* function getTranslationTable : This function returns the translation table array of the circuit.
- */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getTranslationTable
+JNIEXPORT jintArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getNumOfInputsForEachParty
   (JNIEnv *env, jobject, jlong gbcPtr){
 
-	  //get the garbled circuit
-	  GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
+	DISPATCH_CIRCUIT(gbcPtr, getNumOfInputsForEachParty, env);
+}
+
+/* function getTranslationTable : This function returns the translation table array of the circuit.
+ */
+template<class Circuit>
+static jbyteArray getTranslationTable(Circuit * garbledCircuit, JNIEnv *env){
 
 	  //get the size of the output 
 	  int size= (garbledCircuit->getNumberOfOutputs());
@@ -165,13 +281,16 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	  return result;
 }
 
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getTranslationTable
+  (JNIEnv *env, jobject, jlong gbcPtr){
+
+	DISPATCH_CIRCUIT(gbcPtr, getTranslationTable, env);
+}
+
 /* function setTranslationTable : This function sets the translation table from java to the c++ garbled circuit.
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_setTranslationTable
-  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray translationTable){
-
-	  //get the garbled circuit
-	  GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
+template<class Circuit>
+static void setTranslationTable(Circuit * garbledCircuit, JNIEnv *env, jbyteArray translationTable){
 
 	  //get the translation table as an array of jbyte
 	  jbyte *carr = env->GetByteArrayElements(translationTable, 0);
@@ -184,70 +303,36 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGa
 
 }
 
+JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_setTranslationTable
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray translationTable){
 
+	DISPATCH_CIRCUIT(gbcPtr, setTranslationTable, env, translationTable);
+}
 
-/* function setTranslationTable : This function sets the garbled table from java to the c++ garbled circuit.
- */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_setGarbleTables
-  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray garbledTables){
-
-	  //get the garbled circuit
-	  GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
-
-	  int mult = 4;//for a regular circuit we have 4 blocks for each gate
 
-	  if(garbledCircuit->getIsRowReduction()==true){
 
-		  mult = 3;//in row reduction we only have 3 rows
-	  }
-	  else if (garbledCircuit->getIsTwoRows() == true){
-		  mult = 2; //half gates only use 2 rows for AND gates
-	  }
+/* function setTranslationTable : This function sets the garbled table from java to the c++ garbled circuit.
+ */
+template<class Circuit>
+static void setGarbleTables(Circuit * garbledCircuit, JNIEnv *env, jbyteArray garbledTables){
 
-	   //get the garbled table as an array of jbyte
-	  jbyte *carr = env->GetByteArrayElements(garbledTables, 0);
+	  //copy the garbled table directly to the native circuit, without pinning or copying the whole java array first
+	  env->GetByteArrayRegion(garbledTables, 0, getGarbledTablesSize(garbledCircuit), (jbyte*)garbledCircuit->getGarbledTables());
+}
 
-	  if (garbledCircuit->getIsNonXorOutputsRequired()){
-		  //copy the garbled table to the native circuit
-		  memcpy(garbledCircuit->getGarbledTables(), carr, ((garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult + 2 * garbledCircuit ->getNumberOfOutputs())* 16);
-	  }
-	  else{
-		  //copy the garbled table to the native circuit
-		  memcpy(garbledCircuit->getGarbledTables(), carr, (garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult * 16);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_setGarbleTables
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray garbledTables){
 
-	  }
-	   
-	  //free the memory of jbyte array
-	  env->ReleaseByteArrayElements(garbledTables,carr,JNI_ABORT);
+	DISPATCH_CIRCUIT(gbcPtr, setGarbleTables, env, garbledTables);
 }
 
 /* function getGarbleTables : This function returns the garbled table array of the circuit.
  */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getGarbleTables
-  (JNIEnv *env, jobject, jlong gbcPtr){
-
-	 //get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
-
-	int mult = 4;//for a regular circuit we have 4 blocks for each gate
-
-	if(garbledCircuit->getIsRowReduction()==true){
-
-		mult = 3;//in row reduction we only have 3 rows
-	}
-	else if (garbledCircuit->getIsTwoRows() == true){
-		mult = 2; //half gates only use 2 rows for AND gates
-	}
+template<class Circuit>
+static jbyteArray getGarbleTables(Circuit * garbledCircuit, JNIEnv *env){
 
 	//get the size of the garbled table
-	int size;
-	if (garbledCircuit->getIsNonXorOutputsRequired()){
-		size = (((garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult + 2 * garbledCircuit->getNumberOfOutputs()) * 16);
-	}
-	else{
-		size = ((garbledCircuit->getNumberOfGates() - garbledCircuit->getNumOfXorGates()) *mult * 16);
-	}
-	
+	int size = getGarbledTablesSize(garbledCircuit);
 
 	 //create a jbyteArray with the size of the garbled table
 	jbyteArray result = env->NewByteArray(size);
@@ -258,12 +343,18 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	return result;
 
 }
+
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getGarbleTables
+  (JNIEnv *env, jobject, jlong gbcPtr){
+
+	DISPATCH_CIRCUIT(gbcPtr, getGarbleTables, env);
+}
 /* function garble : This function calls the garble of the native code garbled circuit that garbles the circuit.
  * It creates aligned memory for the inputs and outputs, and memory for the translation table so the native garble can work properly and eventually copies back
  * the results to the input empty arrays
  */
-JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_garble
-  (JNIEnv *env, jobject obj, jbyteArray allInputWireValues, jbyteArray allOutputWireValues, jbyteArray translationTable, jbyteArray seed, jlong gbcPtr){
+template<class Circuit>
+static jlong garble(Circuit * garbledCircuit, JNIEnv *env, jbyteArray allInputWireValues, jbyteArray allOutputWireValues, jbyteArray translationTable, jbyteArray seed){
 
 	jbyte *jseed = env->GetByteArrayElements(seed, 0);
 	 
@@ -271,24 +362,24 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeG
 	block seedBlock = _mm_set_epi8(jseed[15],jseed[14],jseed[13],jseed[12],jseed[11],jseed[10],jseed[9],jseed[8],jseed[7],jseed[6],jseed[5],jseed[4],jseed[3],jseed[2],jseed[1],jseed[0]);
 
 
-	//get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit *)gbcPtr;
 	jbyte *carr = env->GetByteArrayElements(translationTable, 0);
 
 
 	//allocate memory for the input keys and the output keys and translation that will be filled by the native garble call
-	block *inputs = (block *) _aligned_malloc(sizeof(block) *2 * garbledCircuit->getNumberOfInputs(), 16); 
-	block *outputs = (block *) _aligned_malloc(sizeof(block) * 2 *garbledCircuit->getNumberOfOutputs(), 16); 
+	block *inputs = (block *) scapi_native::alignedAlloc(sizeof(block) *2 * garbledCircuit->getNumberOfInputs(), 16); 
+	block *outputs = (block *) scapi_native::alignedAlloc(sizeof(block) * 2 *garbledCircuit->getNumberOfOutputs(), 16); 
 	
+	SCAPI_PROBE2(garble_start, garbledCircuit->getNumberOfGates(), garbledCircuit->getNumberOfInputs());
 	garbledCircuit->garble(inputs, outputs, (unsigned char*)carr, seedBlock);
+	SCAPI_PROBE2(garble_done, garbledCircuit->getNumberOfGates(), garbledCircuit->getNumberOfInputs());
 	
 	//set all the information from the garble call back the empty arguments of this function
 	env->SetByteArrayRegion(allInputWireValues, 0,sizeof(jbyte) *2 * garbledCircuit->getNumberOfInputs()*SIZE_OF_BLOCK ,  (jbyte*)inputs);
 	env->SetByteArrayRegion(allOutputWireValues, 0,sizeof(jbyte) *2 * garbledCircuit->getNumberOfOutputs()*SIZE_OF_BLOCK ,  (jbyte*)outputs);
 	
 	//remove the memory that we have allocated in this function.
-	_aligned_free(inputs);
-	_aligned_free(outputs);
+	scapi_native::alignedFree(inputs);
+	scapi_native::alignedFree(outputs);
 	//delete [] scTranslationTable;
 
 	//release memory
@@ -301,22 +392,25 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeG
 
 }
 
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_garble
+  (JNIEnv *env, jobject obj, jbyteArray allInputWireValues, jbyteArray allOutputWireValues, jbyteArray translationTable, jbyteArray seed, jlong gbcPtr){
+
+	DISPATCH_CIRCUIT(gbcPtr, garble, env, allInputWireValues, allOutputWireValues, translationTable, seed);
+}
+
 /* function compute : This function calls the compute of the native code garbled circuit that computes the circuit.
  * It creates aligned memory for the inputs so the native compute can work properly and eventually get back the output
  */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_compute
-(JNIEnv *env, jobject, jlong gbcPtr, jbyteArray singleInputs){
-
-	//get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit = (GarbledBooleanCircuit *)gbcPtr;
+template<class Circuit>
+static jbyteArray compute(Circuit * garbledCircuit, JNIEnv *env, jbyteArray singleInputs){
 
 	//get the single inputs as an array of jbyte
 	jbyte *carr = env->GetByteArrayElements(singleInputs, 0);
 
 
 	//allocate memory for the input keys and the output keys that will be filled
-	block *inputs = (block *)_aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfInputs(), 16);
-	block *outputs = (block *)_aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16);
+	block *inputs = (block *)scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfInputs(), 16);
+	block *outputs = (block *)scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16);
 
 	//create a jbyteArray with the size of the outputs
 	jbyteArray outputKeys = env->NewByteArray(garbledCircuit->getNumberOfOutputs() * 16);
@@ -327,13 +421,9 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	//copy the bothInputKeys to the the aligned inputs
 	memcpy(inputs, carr, garbledCircuit->getNumberOfInputs() * 16);
 
-	if (garbledCircuit->getIsTwoRows() == true){
-		((HalfGatesGarbledBooleanCircuit *)garbledCircuit)->compute(inputs, outputs);
-	}
-	else{
-		//call the native function compute of the garbled circuit
-		garbledCircuit->compute(inputs, outputs);
-	}
+	SCAPI_PROBE2(compute_start, garbledCircuit->getNumberOfGates(), garbledCircuit->getNumberOfInputs());
+	computeCircuit(garbledCircuit, inputs, outputs);
+	SCAPI_PROBE2(compute_done, garbledCircuit->getNumberOfGates(), garbledCircuit->getNumberOfInputs());
 
 	//copy the results from the native compute back the new array outputKeys.
 	env->SetByteArrayRegion(outputKeys, 0, sizeof(jbyte) * garbledCircuit->getNumberOfOutputs() * 16, (jbyte*)outputs);
@@ -343,8 +433,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	env->ReleaseByteArrayElements(singleInputs,carr,JNI_ABORT);
 
 	//free dynamicallly allocated memory
-	_aligned_free(outputs);
-	_aligned_free(inputs);
+	scapi_native::alignedFree(outputs);
+	scapi_native::alignedFree(inputs);
 
 	 return outputKeys;
 
@@ -352,17 +442,74 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 
 }
 
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_compute
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray singleInputs){
+
+	DISPATCH_CIRCUIT(gbcPtr, compute, env, singleInputs);
+}
+
+/* function computeMany : Computes the circuit on each of the given sets of input keys, using the same garbled tables.
+ * The sets are copied once to aligned memory, so the jni crossing, the pinning and the allocations are paid once for all the sets.
+ * The three halves circuit interleaves the sets gate by gate; the other circuits compute them one after the other.
+ * param inputKeySets	: The input keys of all the sets, one set after the other.
+ * param numSets		: The number of sets.
+ * return				: The output keys of all the sets, one set after the other.
+ */
+template<class Circuit>
+static jbyteArray computeMany(Circuit * garbledCircuit, JNIEnv *env, jbyteArray inputKeySets, jint numSets){
+
+	int numInputs = garbledCircuit->getNumberOfInputs();
+	int numOutputs = garbledCircuit->getNumberOfOutputs();
+
+	//allocate memory for the input keys of all sets and the output keys that will be filled
+	block *inputs = (block *)scapi_native::alignedAlloc(sizeof(block) * numInputs * numSets, 16);
+	block *outputs = (block *)scapi_native::alignedAlloc(sizeof(block) * numOutputs * numSets, 16);
+
+	//copy the input keys directly to the aligned memory
+	env->GetByteArrayRegion(inputKeySets, 0, numInputs * numSets * 16, (jbyte*)inputs);
+
+	SCAPI_PROBE2(compute_many_start, garbledCircuit->getNumberOfGates(), numSets);
+	computeSets(garbledCircuit, inputs, outputs, numSets);
+	SCAPI_PROBE2(compute_many_done, garbledCircuit->getNumberOfGates(), numSets);
+
+	//copy the results of all sets to the returned array.
+	jbyteArray outputKeys = env->NewByteArray(numOutputs * numSets * 16);
+	env->SetByteArrayRegion(outputKeys, 0, numOutputs * numSets * 16, (jbyte*)outputs);
+
+	scapi_native::alignedFree(outputs);
+	scapi_native::alignedFree(inputs);
+
+	return outputKeys;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_computeMany
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray inputKeySets, jint numSets){
+
+	DISPATCH_CIRCUIT(gbcPtr, computeMany, env, inputKeySets, numSets);
+}
+
+/* function getNumberOfGates : Returns the number of gates of the circuit.
+ */
+template<class Circuit>
+static jint getNumberOfGates(Circuit * garbledCircuit, JNIEnv *){
+
+	return garbledCircuit->getNumberOfGates();
+}
+
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getNumberOfGates
+  (JNIEnv *env, jobject, jlong gbcPtr){
+
+	DISPATCH_CIRCUIT(gbcPtr, getNumberOfGates, env);
+}
+
 /* function verify : This function calls the verify of the native code verify circuit that verifies the circuit.
  * It creates aligned memory for the inputs so the native verify can work properly and eventually get a true or false result
  */
-JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verify
-  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray bothInputKeys){
-
-	  //get the garbled circuit
-	  GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit *)gbcPtr;
+template<class Circuit>
+static jboolean verify(Circuit * garbledCircuit, JNIEnv *env, jbyteArray bothInputKeys){
 
 	  //allocate memory for the input keys and the output keys that will be filled
-	  block *inputs = (block *) _aligned_malloc(sizeof(block) *2 * garbledCircuit->getNumberOfInputs(), 16); 
+	  block *inputs = (block *) scapi_native::alignedAlloc(sizeof(block) *2 * garbledCircuit->getNumberOfInputs(), 16); 
 	 
 	  //get the bothInputKeys as an array of jbyte
 	  jbyte *carr = env->GetByteArrayElements(bothInputKeys, 0);
@@ -371,33 +518,38 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 	  memcpy( inputs, carr, garbledCircuit->getNumberOfInputs() *2 *16 );
 
 	  //get the result of verify from the native circuit
+	  SCAPI_PROBE1(verify_start, garbledCircuit->getNumberOfGates());
 	  bool isVerified = garbledCircuit->verify(inputs);
+	  SCAPI_PROBE1(verify_done, garbledCircuit->getNumberOfGates());
 
 	  //release the memory
 	  env->ReleaseByteArrayElements(bothInputKeys,carr,JNI_ABORT);
 
 	  //free and inputs array
-	  _aligned_free(inputs);
+	  scapi_native::alignedFree(inputs);
 
 	  //now, after memory has been free return the value of the native verify call.
 	  return isVerified;
 
 }
 
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verify
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray bothInputKeys){
+
+	DISPATCH_CIRCUIT(gbcPtr, verify, env, bothInputKeys);
+}
+
 /* function verify : This function calls the internalVerify of the native code internalVerifyof the circuit that internally verifies the circuit.
  * It creates aligned memory for the inputs so the native internalVerify can work properly and eventually get a true or false result
  */
-JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_internalVerify
-  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray bothInputKeys, jbyteArray emptyBothWireOutputKeys){
-
-	  //get the garbled circuit
-	  GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit *)gbcPtr;
+template<class Circuit>
+static jboolean internalVerify(Circuit * garbledCircuit, JNIEnv *env, jbyteArray bothInputKeys, jbyteArray emptyBothWireOutputKeys){
 
 	  //cout<< "in garble\n";
 
 	  //allocate memory for the input keys and the output keys that will be filled
-	  block *inputs = (block *) _aligned_malloc(sizeof(block) *2 * garbledCircuit->getNumberOfInputs(), 16); 
-	  block *outputs = (block *) _aligned_malloc(sizeof(block) * 2 *garbledCircuit->getNumberOfOutputs(), 16); 
+	  block *inputs = (block *) scapi_native::alignedAlloc(sizeof(block) *2 * garbledCircuit->getNumberOfInputs(), 16); 
+	  block *outputs = (block *) scapi_native::alignedAlloc(sizeof(block) * 2 *garbledCircuit->getNumberOfOutputs(), 16); 
 
 	  jbyte *carr = env->GetByteArrayElements(bothInputKeys, 0);
 
@@ -413,32 +565,33 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 
 	  //release memory
 	  env->ReleaseByteArrayElements(bothInputKeys,carr,JNI_ABORT);
-	  _aligned_free(inputs);
-	  _aligned_free(outputs);
+	  scapi_native::alignedFree(inputs);
+	  scapi_native::alignedFree(outputs);
 	  
 	  //now, after memory has been free return the value of the native internal verify call.
 	  return isVerified;
 
 }
 
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_internalVerify
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray bothInputKeys, jbyteArray emptyBothWireOutputKeys){
+
+	DISPATCH_CIRCUIT(gbcPtr, internalVerify, env, bothInputKeys, emptyBothWireOutputKeys);
+}
+
 
 /* function verifyTranslationTable : This function calls the verifyTranslationTable of the native code.
  * It creates aligned memory for the both outputs so the native verifyTranslationTable can work properly and eventually get a true or false result
  */
-JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verifyTranslationTable
-	(JNIEnv *env, jobject, jlong gbcPtr, jbyteArray bothOutputKeys){
-
+template<class Circuit>
+static jboolean verifyTranslationTable(Circuit * garbledCircuit, JNIEnv *env, jbyteArray bothOutputKeys){
 
 	bool result = false;
 
-
-	//get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
-
 	jbyte *carr = env->GetByteArrayElements(bothOutputKeys, 0);
 	
 	//allocate memory for the output keys of both keys
-	block *bothOutputResults = (block *) _aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs()*2, 16); 
+	block *bothOutputResults = (block *) scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs()*2, 16); 
 
 	//copy the bothInputKeys to the the aligned inputs
 	memcpy( bothOutputResults, carr, garbledCircuit->getNumberOfOutputs() *2 *16 );
@@ -448,6 +601,7 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 
 	//release the memory
 	env->ReleaseByteArrayElements(bothOutputKeys,carr,JNI_ABORT);
+	scapi_native::alignedFree(bothOutputResults);
 
 	//now, after memory has been free return the value of the native verifyTranslationTable call.
 	return result;
@@ -456,16 +610,20 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 
 }
 
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verifyTranslationTable
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray bothOutputKeys){
+
+	DISPATCH_CIRCUIT(gbcPtr, verifyTranslationTable, env, bothOutputKeys);
+}
+
 /* function translate : This function calls the verifyTranslationTable of the native code.
  * It creates aligned memory for the both outputs so the native verifyTranslationTable can work properly and eventually get a true or false result
  */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_translate
-	(JNIEnv *env, jobject, jlong gbcPtr, jbyteArray outputKeys){
+template<class Circuit>
+static jbyteArray translate(Circuit * garbledCircuit, JNIEnv *env, jbyteArray outputKeys){
 
 	
 	
-	//get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
 
 	unsigned char* answer = new unsigned char[garbledCircuit->getNumberOfOutputs()];
 
@@ -474,7 +632,7 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	jbyte *carr = env->GetByteArrayElements(outputKeys, 0);
 	
 	//allocate memory for the input keys and the output keys that will be filled
-	block *outputResults = (block *) _aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16); 
+	block *outputResults = (block *) scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16); 
 
 	//copy the outputKeys to the the aligned outputs
 	memcpy( outputResults, carr, garbledCircuit->getNumberOfOutputs()  *16 );
@@ -487,6 +645,7 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 
 	//relase memory
 	env->ReleaseByteArrayElements(outputKeys,carr,JNI_ABORT);
+	scapi_native::alignedFree(outputResults);
 
 	delete[] answer;
 
@@ -494,29 +653,31 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	return answerJbytesArray;
 
 }
+
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_translate
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray outputKeys){
+
+	DISPATCH_CIRCUIT(gbcPtr, translate, env, outputKeys);
+}
 /* function verifyTranslate : This function calls the verifyTranslate of the native code.
  * It creates aligned memory for the single outputs as well as both outputs so the function can check that each element in the 
  * single array is either one key or the other. Only after this check we call the regual translate of the native circuit.
  */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verifyTranslate
-	(JNIEnv *env, jobject, jlong gbcPtr, jbyteArray outputKeys , jbyteArray bothOutputKeys){
-
+template<class Circuit>
+static jbyteArray verifyTranslate(Circuit * garbledCircuit, JNIEnv *env, jbyteArray outputKeys, jbyteArray bothOutputKeys){
 
 	jbyteArray answerJbytesArray;
 	
 	bool flagSuccess = true;
 
-	//get the garbled circuit
-	GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
-
 	unsigned char* answer = new unsigned char[garbledCircuit->getNumberOfOutputs()];
 
 	jbyte *carrSingle = env->GetByteArrayElements(outputKeys, 0);
 	jbyte *carrBoth = env->GetByteArrayElements(bothOutputKeys, 0);
 
 	//allocate memory for the input keys and the output keys that will be filled
-	block *singleOutputResultsBlocks = (block *) _aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16); 
-	block *bothOutputKeysBlocks = (block *) _aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs()*2, 16); 
+	block *singleOutputResultsBlocks = (block *) scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16); 
+	block *bothOutputKeysBlocks = (block *) scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs()*2, 16); 
 
 
 	//copy the outputKeys to the the aligned singleOutputResultsBlocks
@@ -550,6 +711,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	//release memory
 	env->ReleaseByteArrayElements(outputKeys,carrSingle,JNI_ABORT);
 	env->ReleaseByteArrayElements(bothOutputKeys,carrBoth,JNI_ABORT);
+	scapi_native::alignedFree(singleOutputResultsBlocks);
+	scapi_native::alignedFree(bothOutputKeysBlocks);
 	
 	//return true if each key is one of both possible keys and translate return true, false, otherwise.
 	delete[] answer;
@@ -557,13 +720,22 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 
 }
 
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_verifyTranslate
+  (JNIEnv *env, jobject, jlong gbcPtr, jbyteArray outputKeys , jbyteArray bothOutputKeys){
 
-JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_deleteCircuit
-  (JNIEnv *, jobject, jlong gbcPtr ){
+	DISPATCH_CIRCUIT(gbcPtr, verifyTranslate, env, outputKeys, bothOutputKeys);
+}
 
-	  GarbledBooleanCircuit * garbledCircuit= (GarbledBooleanCircuit*) gbcPtr;
 
+template<class Circuit>
+static void deleteCircuit(Circuit * garbledCircuit, JNIEnv *){
+
+	  scapi_native::trackRelease(garbledCircuit);
 	  delete garbledCircuit;
+}
 
+JNIEXPORT void JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_deleteCircuit
+  (JNIEnv *env, jobject, jlong gbcPtr ){
 
+	DISPATCH_CIRCUIT(gbcPtr, deleteCircuit, env);
 }
\ No newline at end of file
@@ -89,6 +89,22 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeG
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_compute
 (JNIEnv *, jobject, jlong, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit
+ * Method:    computeMany
+ * Signature: (J[BI)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_computeMany
+  (JNIEnv *, jobject, jlong, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit
+ * Method:    getNumberOfGates
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit_getNumberOfGates
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeGarbledBooleanCircuit
  * Method:    verify
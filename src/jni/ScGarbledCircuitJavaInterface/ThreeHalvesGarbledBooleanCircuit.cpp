@@ -0,0 +1,587 @@
+// ThreeHalvesGarbledBooleanCircuit.cpp : The garbling and the computation of the three halves AND gates.
+//
+// The evaluator of an AND gate holds the keys A and B with the colors (signal bits) a and b and computes the two halves of
+// the output key as
+//		C_L = H(A) ^ H(A^B) ^ V_L[ab] * G ^ R_L[ab,r] * (A_L, A_R, B_L, B_R)
+//		C_R = H(B) ^ H(A^B) ^ V_R[ab] * G ^ R_R[ab,r] * (A_L, A_R, B_L, B_R)
+// where H outputs a half key, G = (G0, G1, G2) are the half ciphertexts of the gate and R is a 0/1 matrix that is chosen by the
+// two control bits r of the row. The control bits are encrypted the same way, by the extra bit of each hash and the 5 control
+// bits of the gate. The garbler chooses the control bits of the four rows by two secret random bits of the gate, so every row
+// sees uniform control bits whatever the permutation bits of the input wires are.
+
+#ifdef _WIN32
+	#include "StdAfx.h"
+#else
+	#include <string.h>
+#endif
+#include "ThreeHalvesGarbledBooleanCircuit.h"
+#include "AesNiCipher.h"
+#include "../Common/HugePageAllocator.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+#define HALF_CIPHERTEXTS_SIZE 24
+#define NUM_CONTROL_BITS 5
+
+//The domains of the hash tweaks.
+#define GATE_TWEAK 0
+#define OUTPUT_TWEAK 1
+#define DICE_TWEAK 2
+
+//The fixed key of the hash (the first digits of pi).
+static const AesNiCipher threeHalvesAES(_mm_set_epi32(0x03707344, 0x13198a2e, 0x85a308d3, 0x243f6a88));
+
+/*
+ * R[color][r] : The matrix of the evaluator, chosen by the colors (2a+b) of the row and its control bits.
+ * Bits 0-3 select (A_L, A_R, B_L, B_R) for the left half of the output key and bits 4-7 select them for the right half.
+ */
+static const unsigned char R_MATRICES[4][4] = {
+	{ 0x00, 0xd6, 0xbd, 0x6b },
+	{ 0x20, 0xf6, 0x9d, 0x4b },
+	{ 0x04, 0xd2, 0xb9, 0x6f },
+	{ 0x24, 0xf2, 0x99, 0x4f }
+};
+
+/*
+ * CONTROL_BITS[i][j][s] : The control bits of the four rows (two bits for each color, color 0 in the low bits) that the garbler
+ * uses when the colors of the 0-keys are i and j and the secret random bits of the gate are s.
+ */
+static const unsigned char CONTROL_BITS[2][2][4] = {
+	{ { 0x00, 0x55, 0xff, 0xaa }, { 0x72, 0x27, 0x8d, 0xd8 } },
+	{ { 0x93, 0xc6, 0x6c, 0x39 }, { 0xe1, 0xb4, 0x1e, 0x4b } }
+};
+
+//For each color, the half ciphertexts (G0, G1, G2) that are added to the left and right halves of the output key.
+static const unsigned char CIPHERTEXTS_LEFT[4] = { 0, 4, 5, 1 };
+static const unsigned char CIPHERTEXTS_RIGHT[4] = { 0, 6, 4, 2 };
+
+//For each color, the encrypted control bits (z0, ..., z4) that give the first and second control bit of the row.
+static const unsigned char CONTROL_LEFT[4] = { 0x01, 0x11, 0x15, 0x05 };
+static const unsigned char CONTROL_RIGHT[4] = { 0x02, 0x1a, 0x12, 0x0a };
+
+static inline int getSignalBit(__m128i key) {
+	return _mm_cvtsi128_si32(key) & 1;
+}
+
+static inline uint64_t lowHalf(__m128i key) {
+	return (uint64_t) _mm_cvtsi128_si64(key);
+}
+
+static inline uint64_t highHalf(__m128i key) {
+	return (uint64_t) _mm_cvtsi128_si64(_mm_unpackhi_epi64(key, key));
+}
+
+static inline uint64_t select(int bit, uint64_t value) {
+	return (0 - (uint64_t) (bit & 1)) & value;
+}
+
+static inline int parity(unsigned int bits) {
+	bits ^= bits >> 4;
+	bits ^= bits >> 2;
+	bits ^= bits >> 1;
+	return bits & 1;
+}
+
+/*
+ * Multiplies one row of a matrix of R_MATRICES by the halves of the input keys.
+ */
+static inline uint64_t multiplyRow(int row, const uint64_t* halves) {
+	return select(row, halves[0]) ^ select(row >> 1, halves[1]) ^ select(row >> 2, halves[2]) ^ select(row >> 3, halves[3]);
+}
+
+static inline __m128i tweak(int64_t domain, int64_t counter) {
+	return _mm_set_epi64x(domain, counter);
+}
+
+/*
+ * The tweakable circular correlation robust hash H(x, t) = AES(s(x) ^ t) ^ s(x), where s(x_L, x_R) = (x_L ^ x_R, x_L) is a linear
+ * orthomorphism. Hashes N keys at once.
+ * The low half of each result is the half key that is used for the output keys and the lowest bit of the high half is the bit
+ * that encrypts the control bits.
+ */
+template<int N>
+static inline void hashKeys(const __m128i* keys, const __m128i* tweaks, __m128i* results) {
+	const __m128i lowMask = _mm_set_epi64x(0, -1);
+	__m128i sigma[N];
+	for (int i = 0; i < N; i++) {
+		sigma[i] = _mm_xor_si128(_mm_shuffle_epi32(keys[i], 0x4e), _mm_and_si128(keys[i], lowMask));
+		results[i] = _mm_xor_si128(sigma[i], tweaks[i]);
+	}
+	threeHalvesAES.encryptBlocks<N>(results);
+	for (int i = 0; i < N; i++) {
+		results[i] = _mm_xor_si128(results[i], sigma[i]);
+	}
+}
+
+static inline int extraBit(__m128i hash) {
+	return (int) (highHalf(hash) & 1);
+}
+
+/*
+ * The non xor output keys are the hash of the keys with the signal bit of the original keys, so the translation table does not change.
+ */
+static inline __m128i hashOutputKey(__m128i key, int outputIndex) {
+	const __m128i one = _mm_set_epi64x(0, 1);
+	__m128i t = tweak(OUTPUT_TWEAK, outputIndex);
+	__m128i hash;
+	hashKeys<1>(&key, &t, &hash);
+	return _mm_or_si128(_mm_andnot_si128(one, hash), _mm_and_si128(one, key));
+}
+
+/*
+ * Garbles a single AND gate.
+ * a0, b0	: The 0-keys of the input wires.
+ * dice		: The two secret random bits of the gate.
+ * ciphertexts	: Filled with the three half ciphertexts.
+ * controlBits	: Set to the five control bits of the gate.
+ * return	: The 0-key of the output wire.
+ */
+static inline __m128i garbleAndGate(__m128i a0, __m128i b0, __m128i delta, int dice, int andIndex, uint64_t* ciphertexts,
+		unsigned int* controlBits) {
+
+	uint64_t deltaHalves[2] = { lowHalf(delta), highHalf(delta) };
+	int i = getSignalBit(a0);
+	int j = getSignalBit(b0);
+
+	//the keys of the input wires ordered by their colors, and the xor of A and B for the two possible xors of the colors.
+	__m128i keys[6], tweaks[6], hashes[6];
+	keys[i] = a0;
+	keys[1 - i] = _mm_xor_si128(a0, delta);
+	keys[2 + j] = b0;
+	keys[3 - j] = _mm_xor_si128(b0, delta);
+	keys[4] = _mm_xor_si128(keys[0], keys[2]);
+	keys[5] = _mm_xor_si128(keys[4], delta);
+	__m128i t0 = tweak(GATE_TWEAK, 3 * (int64_t) andIndex);
+	__m128i t1 = tweak(GATE_TWEAK, 3 * (int64_t) andIndex + 1);
+	__m128i t2 = tweak(GATE_TWEAK, 3 * (int64_t) andIndex + 2);
+	tweaks[0] = tweaks[1] = t0;
+	tweaks[2] = tweaks[3] = t1;
+	tweaks[4] = tweaks[5] = t2;
+	hashKeys<6>(keys, tweaks, hashes);
+
+	//compute for each row what the evaluator gets before the ciphertexts are added (E), and the control bits before the encrypted
+	//control bits are added (P). The ciphertexts are then chosen so that every row gets the right output key.
+	int rowsControlBits = CONTROL_BITS[i][j][dice];
+	uint64_t left[4], right[4];
+	unsigned int plainControl[4];
+	for (int color = 0; color < 4; color++) {
+		int a = color >> 1, b = color & 1;
+		__m128i hashA = hashes[a], hashB = hashes[2 + b], hashX = hashes[4 + (a ^ b)];
+		uint64_t halves[4] = { lowHalf(keys[a]), highHalf(keys[a]), lowHalf(keys[2 + b]), highHalf(keys[2 + b]) };
+		int r = (rowsControlBits >> (2 * color)) & 3;
+		int matrix = R_MATRICES[color][r];
+		int andResult = (a ^ i) & (b ^ j);
+
+		left[color] = lowHalf(hashA) ^ lowHalf(hashX) ^ multiplyRow(matrix, halves) ^ select(andResult, deltaHalves[0]);
+		right[color] = lowHalf(hashB) ^ lowHalf(hashX) ^ multiplyRow(matrix >> 4, halves) ^ select(andResult, deltaHalves[1]);
+		plainControl[color] = r ^ (extraBit(hashA) ^ extraBit(hashX)) ^ ((extraBit(hashB) ^ extraBit(hashX)) << 1);
+	}
+
+	ciphertexts[0] = left[3] ^ left[0];
+	ciphertexts[1] = right[3] ^ right[0];
+	ciphertexts[2] = left[1] ^ left[0];
+	*controlBits = plainControl[0] | ((plainControl[3] ^ plainControl[0]) << 2) | (((plainControl[1] ^ plainControl[0]) & 1) << 4);
+
+	return _mm_set_epi64x((int64_t) right[0], (int64_t) left[0]);
+}
+
+/*
+ * Computes an AND gate given one key of each input wire and the hashes H(A), H(B) and H(A^B).
+ */
+static inline __m128i decryptAndGate(__m128i a, __m128i b, const __m128i* hashes, const uint64_t* ciphertexts, unsigned int controlBits) {
+
+	int color = (getSignalBit(a) << 1) | getSignalBit(b);
+
+	int r = (parity(controlBits & CONTROL_LEFT[color]) ^ extraBit(hashes[0]) ^ extraBit(hashes[2])) |
+		((parity(controlBits & CONTROL_RIGHT[color]) ^ extraBit(hashes[1]) ^ extraBit(hashes[2])) << 1);
+	int matrix = R_MATRICES[color][r];
+	uint64_t halves[4] = { lowHalf(a), highHalf(a), lowHalf(b), highHalf(b) };
+
+	int leftCiphertexts = CIPHERTEXTS_LEFT[color], rightCiphertexts = CIPHERTEXTS_RIGHT[color];
+	uint64_t left = lowHalf(hashes[0]) ^ lowHalf(hashes[2]) ^ multiplyRow(matrix, halves) ^ select(leftCiphertexts, ciphertexts[0]) ^
+		select(leftCiphertexts >> 1, ciphertexts[1]) ^ select(leftCiphertexts >> 2, ciphertexts[2]);
+	uint64_t right = lowHalf(hashes[1]) ^ lowHalf(hashes[2]) ^ multiplyRow(matrix >> 4, halves) ^ select(rightCiphertexts, ciphertexts[0]) ^
+		select(rightCiphertexts >> 1, ciphertexts[1]) ^ select(rightCiphertexts >> 2, ciphertexts[2]);
+
+	return _mm_set_epi64x((int64_t) right, (int64_t) left);
+}
+
+/*
+ * Computes the same AND gate on N sets of keys, given one key of each input wire in each set. The 3N hashes of all the sets are
+ * computed together, so the aes rounds of the sets are interleaved.
+ */
+template<int N>
+static inline void computeAndGates(const __m128i* a, const __m128i* b, int andIndex, const uint64_t* ciphertexts, unsigned int controlBits,
+		__m128i* outputs) {
+
+	__m128i keys[3 * N], tweaks[3 * N], hashes[3 * N];
+	for (int k = 0; k < N; k++) {
+		keys[3 * k] = a[k];
+		keys[3 * k + 1] = b[k];
+		keys[3 * k + 2] = _mm_xor_si128(a[k], b[k]);
+		for (int j = 0; j < 3; j++) {
+			tweaks[3 * k + j] = tweak(GATE_TWEAK, 3 * (int64_t) andIndex + j);
+		}
+	}
+	hashKeys<3 * N>(keys, tweaks, hashes);
+
+	for (int k = 0; k < N; k++) {
+		outputs[k] = decryptAndGate(a[k], b[k], hashes + 3 * k, ciphertexts, controlBits);
+	}
+}
+
+static inline unsigned int readControlBits(const unsigned char* bits, int andIndex) {
+	int position = andIndex * NUM_CONTROL_BITS;
+	unsigned int twoBytes = bits[position / 8] | (bits[position / 8 + 1] << 8);
+	return (twoBytes >> (position % 8)) & ((1 << NUM_CONTROL_BITS) - 1);
+}
+
+static inline void writeControlBits(unsigned char* bits, int andIndex, unsigned int value) {
+	int position = andIndex * NUM_CONTROL_BITS;
+	unsigned int twoBytes = value << (position % 8);
+	bits[position / 8] |= (unsigned char) twoBytes;
+	bits[position / 8 + 1] |= (unsigned char) (twoBytes >> 8);
+}
+
+ThreeHalvesGarbledBooleanCircuit::ThreeHalvesGarbledBooleanCircuit(const char* fileName, bool isNonXorOutputsRequired)
+	: numberOfWires(0), numOfAndGates(0), isNonXorOutputsRequired(isNonXorOutputsRequired), garbledTables(NULL), wireKeys(NULL) {
+
+	readCircuitFromFile(fileName);
+
+	garbledTablesSize = numOfAndGates * HALF_CIPHERTEXTS_SIZE + (numOfAndGates * NUM_CONTROL_BITS + 7) / 8;
+	translationTable.resize(outputIndices.size());
+
+	//the control bits are read two bytes at a time, so one more byte is allocated after the tables.
+	garbledTables = (unsigned char*) scapi_native::alignedAlloc(garbledTablesSize + 1, 16);
+	memset(garbledTables, 0, garbledTablesSize + 1);
+	wireKeys = (__m128i*) scapi_native::alignedAlloc(sizeof(__m128i) * numberOfWires, 16);
+}
+
+ThreeHalvesGarbledBooleanCircuit::~ThreeHalvesGarbledBooleanCircuit() {
+	scapi_native::alignedFree(garbledTables);
+	scapi_native::alignedFree(wireKeys);
+}
+
+/*
+ * Reads a circuit file in the format of the ScGarbledCircuit library:
+ * number of gates, number of parties, for each party its number, its number of inputs and the input wires, the number of outputs
+ * and the output wires, and then each gate as: fan in, fan out, the input wires, the output wire and the truth table.
+ */
+void ThreeHalvesGarbledBooleanCircuit::readCircuitFromFile(const char* fileName) {
+	ifstream file(fileName);
+	if (!file.is_open()) {
+		throw runtime_error("cannot open the circuit file");
+	}
+
+	int numberOfGates, numberOfParties;
+	file >> numberOfGates >> numberOfParties;
+	if (!file || numberOfGates < 0 || numberOfParties <= 0) {
+		throw runtime_error("invalid circuit file");
+	}
+
+	vector<vector<int> > partiesInputs(numberOfParties);
+	numOfInputsForEachParty.resize(numberOfParties);
+	for (int i = 0; i < numberOfParties; i++) {
+		int partyNumber, numOfInputs;
+		file >> partyNumber >> numOfInputs;
+		if (!file || partyNumber < 1 || partyNumber > numberOfParties || numOfInputs < 0) {
+			throw runtime_error("invalid circuit file");
+		}
+		numOfInputsForEachParty[partyNumber - 1] = numOfInputs;
+		partiesInputs[partyNumber - 1].resize(numOfInputs);
+		for (int j = 0; j < numOfInputs; j++) {
+			file >> partiesInputs[partyNumber - 1][j];
+		}
+	}
+	//the inputs of all the parties, one party after the other.
+	for (int i = 0; i < numberOfParties; i++) {
+		inputIndices.insert(inputIndices.end(), partiesInputs[i].begin(), partiesInputs[i].end());
+	}
+
+	int numberOfOutputs;
+	file >> numberOfOutputs;
+	if (!file || numberOfOutputs < 0) {
+		throw runtime_error("invalid circuit file");
+	}
+	outputIndices.resize(numberOfOutputs);
+	for (int i = 0; i < numberOfOutputs; i++) {
+		file >> outputIndices[i];
+	}
+
+	gates.resize(numberOfGates);
+	for (int g = 0; g < numberOfGates; g++) {
+		Gate& gate = gates[g];
+		int fanIn, fanOut;
+		string truthTable;
+		file >> fanIn >> fanOut;
+		if (fanIn == 1) {
+			file >> gate.input0 >> gate.output >> truthTable;
+			gate.input1 = gate.input0;
+		} else if (fanIn == 2) {
+			file >> gate.input0 >> gate.input1 >> gate.output >> truthTable;
+		} else {
+			throw runtime_error("only gates with one or two inputs are supported");
+		}
+		if (!file || fanOut != 1 || (int) truthTable.size() != (1 << fanIn)) {
+			throw runtime_error("invalid circuit file");
+		}
+
+		//the truth table holds the output for the inputs 00, 01, 10, 11 (or 0, 1 for a single input).
+		int values[4] = { 0, 0, 0, 0 };
+		int weight = 0;
+		for (int k = 0; k < (int) truthTable.size(); k++) {
+			values[k] = truthTable[k] == '1';
+			weight += values[k];
+		}
+
+		gate.p = gate.q = gate.r = 0;
+		if (fanIn == 1) {
+			gate.isAnd = false;
+			gate.c0 = values[0];
+			gate.ca = values[0] ^ values[1];
+			gate.cb = 0;
+		} else if (weight % 2 == 0) {
+			gate.isAnd = false;
+			gate.c0 = values[0];
+			gate.ca = values[0] ^ values[2];
+			gate.cb = values[0] ^ values[1];
+		} else {
+			//a single input (u,v) gives a different output than the other three, so the gate is ((a ^ p) & (b ^ q)) ^ r.
+			int majority = weight == 1 ? 0 : 1;
+			int k = 0;
+			while (values[k] == majority) {
+				k++;
+			}
+			gate.isAnd = true;
+			gate.p = 1 ^ (k >> 1);
+			gate.q = 1 ^ (k & 1);
+			gate.r = majority;
+			numOfAndGates++;
+		}
+
+		numberOfWires = max(numberOfWires, max(gate.output, max(gate.input0, gate.input1)) + 1);
+	}
+	for (size_t i = 0; i < inputIndices.size(); i++) {
+		numberOfWires = max(numberOfWires, inputIndices[i] + 1);
+	}
+	for (size_t i = 0; i < outputIndices.size(); i++) {
+		numberOfWires = max(numberOfWires, outputIndices[i] + 1);
+	}
+}
+
+bool ThreeHalvesGarbledBooleanCircuit::garbleGates(const __m128i* bothInputKeys, unsigned char* tables, __m128i* bothOutputKeys) {
+	int numberOfInputs = getNumberOfInputs();
+	if (numberOfInputs == 0) {
+		return false;
+	}
+
+	//all the input keys should have the same delta, with a signal bit of 1.
+	__m128i delta = _mm_xor_si128(bothInputKeys[0], bothInputKeys[1]);
+	if (getSignalBit(delta) != 1) {
+		return false;
+	}
+	for (int i = 0; i < numberOfInputs; i++) {
+		if (!equalBlocks(_mm_xor_si128(bothInputKeys[2 * i], bothInputKeys[2 * i + 1]), delta)) {
+			return false;
+		}
+		wireKeys[inputIndices[i]] = bothInputKeys[2 * i];
+	}
+
+	//the secret random bits of the gates are derived from the delta, so the circuit can be garbled again from the input keys.
+	//Each hash gives the bits of 64 gates.
+	unsigned char* controlBits = tables + numOfAndGates * HALF_CIPHERTEXTS_SIZE;
+	memset(controlBits, 0, garbledTablesSize + 1 - numOfAndGates * HALF_CIPHERTEXTS_SIZE);
+	uint64_t dice[2] = { 0, 0 };
+
+	const __m128i zero = _mm_setzero_si128();
+	int andIndex = 0;
+	for (size_t g = 0; g < gates.size(); g++) {
+		const Gate& gate = gates[g];
+		__m128i a0 = wireKeys[gate.input0];
+		__m128i b0 = wireKeys[gate.input1];
+
+		if (!gate.isAnd) {
+			wireKeys[gate.output] = _mm_xor_si128(_mm_xor_si128(gate.ca ? a0 : zero, gate.cb ? b0 : zero), gate.c0 ? delta : zero);
+			continue;
+		}
+
+		if (andIndex % 64 == 0) {
+			__m128i t = tweak(DICE_TWEAK, andIndex / 64), hash;
+			hashKeys<1>(&delta, &t, &hash);
+			dice[0] = lowHalf(hash);
+			dice[1] = highHalf(hash);
+		}
+		int bit = 2 * (andIndex % 64);
+		int gateDice = (int) (dice[bit / 64] >> (bit % 64)) & 3;
+
+		uint64_t ciphertexts[3];
+		unsigned int gateControlBits;
+		__m128i c0 = garbleAndGate(gate.p ? _mm_xor_si128(a0, delta) : a0, gate.q ? _mm_xor_si128(b0, delta) : b0, delta, gateDice,
+			andIndex, ciphertexts, &gateControlBits);
+		memcpy(tables + andIndex * HALF_CIPHERTEXTS_SIZE, ciphertexts, HALF_CIPHERTEXTS_SIZE);
+		writeControlBits(controlBits, andIndex, gateControlBits);
+
+		wireKeys[gate.output] = gate.r ? _mm_xor_si128(c0, delta) : c0;
+		andIndex++;
+	}
+
+	for (int i = 0; i < getNumberOfOutputs(); i++) {
+		__m128i key0 = wireKeys[outputIndices[i]];
+		__m128i key1 = _mm_xor_si128(key0, delta);
+		if (isNonXorOutputsRequired) {
+			key0 = hashOutputKey(key0, i);
+			key1 = hashOutputKey(key1, i);
+		}
+		bothOutputKeys[2 * i] = key0;
+		bothOutputKeys[2 * i + 1] = key1;
+	}
+	return true;
+}
+
+void ThreeHalvesGarbledBooleanCircuit::garble(__m128i* emptyBothInputKeys, __m128i* emptyBothOutputKeys,
+		unsigned char* emptyTranslationTable, __m128i seed) {
+
+	//the delta and the input keys are the aes encryptions of a counter, using the seed as the key.
+	AesNiCipher prg(seed);
+	__m128i delta = _mm_or_si128(prg.encrypt(_mm_setzero_si128()), _mm_set_epi64x(0, 1));
+	for (int i = 0; i < getNumberOfInputs(); i++) {
+		emptyBothInputKeys[2 * i] = prg.encrypt(_mm_set_epi64x(0, i + 1));
+		emptyBothInputKeys[2 * i + 1] = _mm_xor_si128(emptyBothInputKeys[2 * i], delta);
+	}
+
+	garbleGates(emptyBothInputKeys, garbledTables, emptyBothOutputKeys);
+
+	for (int i = 0; i < getNumberOfOutputs(); i++) {
+		translationTable[i] = (unsigned char) getSignalBit(emptyBothOutputKeys[2 * i]);
+	}
+	memcpy(emptyTranslationTable, &translationTable[0], getNumberOfOutputs());
+}
+
+void ThreeHalvesGarbledBooleanCircuit::compute(__m128i* singleWiresInputKeys, __m128i* outputs) {
+	for (int i = 0; i < getNumberOfInputs(); i++) {
+		wireKeys[inputIndices[i]] = singleWiresInputKeys[i];
+	}
+
+	const unsigned char* controlBits = garbledTables + numOfAndGates * HALF_CIPHERTEXTS_SIZE;
+	const __m128i zero = _mm_setzero_si128();
+	int andIndex = 0;
+	for (size_t g = 0; g < gates.size(); g++) {
+		const Gate& gate = gates[g];
+		__m128i a = wireKeys[gate.input0];
+		__m128i b = wireKeys[gate.input1];
+
+		if (!gate.isAnd) {
+			wireKeys[gate.output] = _mm_xor_si128(gate.ca ? a : zero, gate.cb ? b : zero);
+			continue;
+		}
+
+		uint64_t ciphertexts[3];
+		memcpy(ciphertexts, garbledTables + andIndex * HALF_CIPHERTEXTS_SIZE, HALF_CIPHERTEXTS_SIZE);
+		computeAndGates<1>(&a, &b, andIndex, ciphertexts, readControlBits(controlBits, andIndex), &wireKeys[gate.output]);
+		andIndex++;
+	}
+
+	for (int i = 0; i < getNumberOfOutputs(); i++) {
+		outputs[i] = isNonXorOutputsRequired ? hashOutputKey(wireKeys[outputIndices[i]], i) : wireKeys[outputIndices[i]];
+	}
+}
+
+template<int N>
+void ThreeHalvesGarbledBooleanCircuit::computeSets(const __m128i* inputKeySets, __m128i* outputSets, __m128i* keys) {
+	int numInputs = getNumberOfInputs();
+	int numOutputs = getNumberOfOutputs();
+	for (int k = 0; k < N; k++) {
+		for (int i = 0; i < numInputs; i++) {
+			keys[inputIndices[i] * N + k] = inputKeySets[k * numInputs + i];
+		}
+	}
+
+	const unsigned char* controlBits = garbledTables + numOfAndGates * HALF_CIPHERTEXTS_SIZE;
+	const __m128i zero = _mm_setzero_si128();
+	int andIndex = 0;
+	for (size_t g = 0; g < gates.size(); g++) {
+		const Gate& gate = gates[g];
+		const __m128i* a = keys + gate.input0 * N;
+		const __m128i* b = keys + gate.input1 * N;
+		__m128i* c = keys + gate.output * N;
+
+		if (!gate.isAnd) {
+			for (int k = 0; k < N; k++) {
+				c[k] = _mm_xor_si128(gate.ca ? a[k] : zero, gate.cb ? b[k] : zero);
+			}
+			continue;
+		}
+
+		uint64_t ciphertexts[3];
+		memcpy(ciphertexts, garbledTables + andIndex * HALF_CIPHERTEXTS_SIZE, HALF_CIPHERTEXTS_SIZE);
+		computeAndGates<N>(a, b, andIndex, ciphertexts, readControlBits(controlBits, andIndex), c);
+		andIndex++;
+	}
+
+	for (int k = 0; k < N; k++) {
+		for (int i = 0; i < numOutputs; i++) {
+			__m128i key = keys[outputIndices[i] * N + k];
+			outputSets[k * numOutputs + i] = isNonXorOutputsRequired ? hashOutputKey(key, i) : key;
+		}
+	}
+}
+
+void ThreeHalvesGarbledBooleanCircuit::computeMany(const __m128i* inputKeySets, __m128i* outputSets, int numSets) {
+	int numInputs = getNumberOfInputs();
+	int numOutputs = getNumberOfOutputs();
+
+	//the keys of the sets that are computed together are next to each other, COMPUTE_MANY_WIDTH keys for each wire.
+	__m128i* keys = (__m128i*) scapi_native::alignedAlloc(sizeof(__m128i) * numberOfWires * COMPUTE_MANY_WIDTH, 16);
+	int set = 0;
+	for (; set + COMPUTE_MANY_WIDTH <= numSets; set += COMPUTE_MANY_WIDTH) {
+		computeSets<COMPUTE_MANY_WIDTH>(inputKeySets + set * numInputs, outputSets + set * numOutputs, keys);
+	}
+	//the remaining sets are computed one by one.
+	for (; set < numSets; set++) {
+		computeSets<1>(inputKeySets + set * numInputs, outputSets + set * numOutputs, keys);
+	}
+	scapi_native::alignedFree(keys);
+}
+
+bool ThreeHalvesGarbledBooleanCircuit::internalVerify(__m128i* bothInputKeys, __m128i* emptyBothWireOutputKeys) {
+	unsigned char* tables = (unsigned char*) scapi_native::alignedAlloc(garbledTablesSize + 1, 16);
+
+	bool isVerified = garbleGates(bothInputKeys, tables, emptyBothWireOutputKeys) &&
+		memcmp(tables, garbledTables, garbledTablesSize) == 0;
+
+	scapi_native::alignedFree(tables);
+	return isVerified;
+}
+
+bool ThreeHalvesGarbledBooleanCircuit::verify(__m128i* bothInputKeys) {
+	__m128i* outputs = (__m128i*) scapi_native::alignedAlloc(sizeof(__m128i) * 2 * getNumberOfOutputs(), 16);
+
+	bool isVerified = internalVerify(bothInputKeys, outputs) && verifyTranslationTable(outputs);
+
+	scapi_native::alignedFree(outputs);
+	return isVerified;
+}
+
+bool ThreeHalvesGarbledBooleanCircuit::verifyTranslationTable(__m128i* bothOutputKeys) {
+	for (int i = 0; i < getNumberOfOutputs(); i++) {
+		if ((getSignalBit(bothOutputKeys[2 * i]) ^ translationTable[i]) != 0 ||
+			(getSignalBit(bothOutputKeys[2 * i + 1]) ^ translationTable[i]) != 1) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void ThreeHalvesGarbledBooleanCircuit::translate(__m128i* outputKeys, unsigned char* answer) {
+	for (int i = 0; i < getNumberOfOutputs(); i++) {
+		answer[i] = (unsigned char) (getSignalBit(outputKeys[i]) ^ translationTable[i]);
+	}
+}
+
+bool ThreeHalvesGarbledBooleanCircuit::equalBlocks(__m128i a, __m128i b) {
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xffff;
+}
@@ -0,0 +1,128 @@
+// ThreeHalvesGarbledBooleanCircuit.h : A free xor garbled circuit whose AND gates are garbled with the "three halves" scheme of
+// Rosulek and Roy (Three Halves Make a Whole? Beating the Half-Gates Lower Bound for Garbled Circuits, CRYPTO 2021).
+//
+// The circuit has the same interface as the circuits of the ScGarbledCircuit library, so the jni functions of
+// ScNativeGarbledBooleanCircuit work with it the same way. It reads the same circuit files.
+
+#ifndef THREE_HALVES_GARBLED_BOOLEAN_CIRCUIT_H
+#define THREE_HALVES_GARBLED_BOOLEAN_CIRCUIT_H
+
+#include <emmintrin.h>
+#include <stdint.h>
+#include <vector>
+
+//The number of input sets that computeMany computes together (12 blocks go through the aes unit for each AND gate).
+#define COMPUTE_MANY_WIDTH 4
+
+/*
+ * Each wire label is split to two halves of 64 bits, L (the low half, that holds the signal bit) and R.
+ * An AND gate is garbled to three half ciphertexts and 5 control bits, 1.5 blocks + 5 bits instead of the 2 blocks of half gates.
+ * The evaluator makes three hash calls for each AND gate (H(A), H(B) and H(A^B)) and the garbler six.
+ * XOR, XNOR and NOT gates are free.
+ *
+ * The layout of the garbled tables is:
+ *	- The three half ciphertexts of each AND gate, 24 bytes for each gate, in the order of the AND gates in the circuit.
+ *	- The control bits of all the AND gates, 5 bits for each gate, packed one after the other (bit k of the table is bit k%8
+ *	  of byte k/8).
+ */
+class ThreeHalvesGarbledBooleanCircuit {
+public:
+	/*
+	 * Reads the circuit from the given file. Throws an exception if the file cannot be read.
+	 * isNonXorOutputsRequired : If true, the output keys are hashed so that they are not a xor of each other with the delta.
+	 */
+	ThreeHalvesGarbledBooleanCircuit(const char* fileName, bool isNonXorOutputsRequired);
+	~ThreeHalvesGarbledBooleanCircuit();
+
+	/*
+	 * Creates the keys of the input wires from the seed and garbles the circuit.
+	 * emptyBothInputKeys	: Filled with both keys of each input wire, the 0-key followed by the 1-key.
+	 * emptyBothOutputKeys	: Filled with both keys of each output wire.
+	 * emptyTranslationTable	: Filled with the signal bit of the 0-key of each output wire.
+	 */
+	void garble(__m128i* emptyBothInputKeys, __m128i* emptyBothOutputKeys, unsigned char* emptyTranslationTable, __m128i seed);
+
+	/*
+	 * Computes the circuit using the garbled tables and a single key for each input wire.
+	 */
+	void compute(__m128i* singleWiresInputKeys, __m128i* outputs);
+
+	/*
+	 * Computes the circuit on numSets sets of input keys using the same garbled tables. Each gate is computed on COMPUTE_MANY_WIDTH
+	 * sets at a time, so the hashes of the sets go through the aes unit together.
+	 * inputKeySets	: A single key for each input wire in each set, one set after the other.
+	 * outputSets	: Filled with the output keys of each set, one set after the other.
+	 */
+	void computeMany(const __m128i* inputKeySets, __m128i* outputSets, int numSets);
+
+	/*
+	 * Garbles the circuit again using both keys of the input wires and checks that the result is the garbled tables of this
+	 * circuit and that the translation table matches the output keys.
+	 */
+	bool verify(__m128i* bothInputKeys);
+
+	/*
+	 * Same as verify, but does not check the translation table. Fills emptyBothWireOutputKeys with both keys of the output wires.
+	 */
+	bool internalVerify(__m128i* bothInputKeys, __m128i* emptyBothWireOutputKeys);
+
+	bool verifyTranslationTable(__m128i* bothOutputKeys);
+	void translate(__m128i* outputKeys, unsigned char* answer);
+	bool equalBlocks(__m128i a, __m128i b);
+
+	int getGarbledTablesSize() const { return garbledTablesSize; }
+	unsigned char* getGarbledTables() { return garbledTables; }
+	unsigned char* getTranslationTable() { return &translationTable[0]; }
+
+	int getNumberOfGates() const { return (int) gates.size(); }
+	int getNumOfAndGates() const { return numOfAndGates; }
+	int getNumberOfInputs() const { return (int) inputIndices.size(); }
+	int getNumberOfOutputs() const { return (int) outputIndices.size(); }
+	int getNumberOfParties() const { return (int) numOfInputsForEachParty.size(); }
+	int* getInputIndices() { return &inputIndices[0]; }
+	int* getOutputIndices() { return &outputIndices[0]; }
+	int* getNumOfInputsForEachParty() { return &numOfInputsForEachParty[0]; }
+
+private:
+	/*
+	 * Every gate is either linear, output = c0 ^ (ca & a) ^ (cb & b), or an AND of the negated inputs,
+	 * output = ((a ^ p) & (b ^ q)) ^ r. The negations are done by the garbler only, so all the AND gates are computed the same.
+	 */
+	struct Gate {
+		int input0;
+		int input1;
+		int output;
+		bool isAnd;
+		unsigned char c0, ca, cb;	//the coefficients of a linear gate.
+		unsigned char p, q, r;		//the negations of an AND gate.
+	};
+
+	std::vector<Gate> gates;
+	std::vector<int> inputIndices;
+	std::vector<int> outputIndices;
+	std::vector<int> numOfInputsForEachParty;
+	std::vector<unsigned char> translationTable;
+	int numberOfWires;
+	int numOfAndGates;
+	bool isNonXorOutputsRequired;
+
+	unsigned char* garbledTables;
+	int garbledTablesSize;
+	__m128i* wireKeys;	//the 0-key of each wire while garbling, the computed key of each wire while computing.
+
+	void readCircuitFromFile(const char* fileName);
+
+	/*
+	 * Computes N sets of input keys. keys holds N keys for each wire, the keys of a wire being next to each other.
+	 */
+	template<int N>
+	void computeSets(const __m128i* inputKeySets, __m128i* outputSets, __m128i* keys);
+
+	/*
+	 * Garbles all the gates given both keys of the input wires. Writes the garbled tables to the given tables and both keys of
+	 * the output wires to bothOutputKeys. Returns false if the input keys are not free xor keys of the same delta.
+	 */
+	bool garbleGates(const __m128i* bothInputKeys, unsigned char* tables, __m128i* bothOutputKeys);
+};
+
+#endif
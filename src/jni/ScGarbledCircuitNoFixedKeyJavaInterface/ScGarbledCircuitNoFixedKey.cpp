@@ -14,6 +14,7 @@
 #include "GarbledBooleanCircuit.h"
 #include "FastGarblingFourToTwoNoAssumptions.h"
 #include "FastGarblingFreeXorHalfGatesFixedKeyAssumptions.h"
+#include "../Common/HugePageAllocator.h"
 
 using namespace std;
 
@@ -229,8 +230,8 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeG
 
 
 	//allocate memory for the input keys and the output keys and translation that will be filled by the native garble call
-	block *inputs = (block *)_aligned_malloc(sizeof(block) * 2 * garbledCircuit->getNumberOfInputs(), 16);
-	block *outputs = (block *)_aligned_malloc(sizeof(block) * 2 * garbledCircuit->getNumberOfOutputs(), 16);
+	block *inputs = (block *)scapi_native::alignedAlloc(sizeof(block) * 2 * garbledCircuit->getNumberOfInputs(), 16);
+	block *outputs = (block *)scapi_native::alignedAlloc(sizeof(block) * 2 * garbledCircuit->getNumberOfOutputs(), 16);
 
 	garbledCircuit->garble(inputs, outputs, (unsigned char*)carr, seedBlock);
 
@@ -239,8 +240,8 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNativeG
 	env->SetByteArrayRegion(allOutputWireValues, 0, sizeof(jbyte) * 2 * garbledCircuit->getNumberOfOutputs()*SIZE_OF_BLOCK, (jbyte*)outputs);
 
 	//remove the memory that we have allocated in this function.
-	_aligned_free(inputs);
-	_aligned_free(outputs);
+	scapi_native::alignedFree(inputs);
+	scapi_native::alignedFree(outputs);
 	//delete [] scTranslationTable;
 
 	//release memory
@@ -264,8 +265,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 
 
 	//allocate memory for the input keys and the output keys that will be filled
-	block *inputs = (block *)_aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfInputs(), 16);
-	block *outputs = (block *)_aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16);
+	block *inputs = (block *)scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfInputs(), 16);
+	block *outputs = (block *)scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16);
 
 	//create a jbyteArray with the size of the outputs
 	jbyteArray outputKeys = env->NewByteArray(garbledCircuit->getNumberOfOutputs() * 16);
@@ -287,8 +288,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	env->ReleaseByteArrayElements(singleInputs, carr, JNI_ABORT);
 
 	//free dynamicallly allocated memory
-	_aligned_free(outputs);
-	_aligned_free(inputs);
+	scapi_native::alignedFree(outputs);
+	scapi_native::alignedFree(inputs);
 
 	return outputKeys;
 
@@ -306,7 +307,7 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 	GarbledBooleanCircuit * garbledCircuit = (GarbledBooleanCircuit *)gbcPtr;
 
 	//allocate memory for the input keys and the output keys that will be filled
-	block *inputs = (block *)_aligned_malloc(sizeof(block) * 2 * garbledCircuit->getNumberOfInputs(), 16);
+	block *inputs = (block *)scapi_native::alignedAlloc(sizeof(block) * 2 * garbledCircuit->getNumberOfInputs(), 16);
 
 	//get the bothInputKeys as an array of jbyte
 	jbyte *carr = env->GetByteArrayElements(bothInputKeys, 0);
@@ -321,7 +322,7 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 	env->ReleaseByteArrayElements(bothInputKeys, carr, JNI_ABORT);
 
 	//free and inputs array
-	_aligned_free(inputs);
+	scapi_native::alignedFree(inputs);
 
 	//now, after memory has been free return the value of the native verify call.
 	return isVerified;
@@ -340,8 +341,8 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 	//cout<< "in garble\n";
 
 	//allocate memory for the input keys and the output keys that will be filled
-	block *inputs = (block *)_aligned_malloc(sizeof(block) * 2 * garbledCircuit->getNumberOfInputs(), 16);
-	block *outputs = (block *)_aligned_malloc(sizeof(block) * 2 * garbledCircuit->getNumberOfOutputs(), 16);
+	block *inputs = (block *)scapi_native::alignedAlloc(sizeof(block) * 2 * garbledCircuit->getNumberOfInputs(), 16);
+	block *outputs = (block *)scapi_native::alignedAlloc(sizeof(block) * 2 * garbledCircuit->getNumberOfOutputs(), 16);
 
 	jbyte *carr = env->GetByteArrayElements(bothInputKeys, 0);
 
@@ -357,8 +358,8 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 
 	//release memory
 	env->ReleaseByteArrayElements(bothInputKeys, carr, JNI_ABORT);
-	_aligned_free(inputs);
-	_aligned_free(outputs);
+	scapi_native::alignedFree(inputs);
+	scapi_native::alignedFree(outputs);
 
 	//now, after memory has been free return the value of the native internal verify call.
 	return isVerified;
@@ -382,7 +383,7 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 	jbyte *carr = env->GetByteArrayElements(bothOutputKeys, 0);
 
 	//allocate memory for the output keys of both keys
-	block *bothOutputResults = (block *)_aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs() * 2, 16);
+	block *bothOutputResults = (block *)scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs() * 2, 16);
 
 	//copy the bothInputKeys to the the aligned inputs
 	memcpy(bothOutputResults, carr, garbledCircuit->getNumberOfOutputs() * 2 * 16);
@@ -392,6 +393,7 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNati
 
 	//release the memory
 	env->ReleaseByteArrayElements(bothOutputKeys, carr, JNI_ABORT);
+	scapi_native::alignedFree(bothOutputResults);
 
 	//now, after memory has been free return the value of the native verifyTranslationTable call.
 	return result;
@@ -418,7 +420,7 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	jbyte *carr = env->GetByteArrayElements(outputKeys, 0);
 
 	//allocate memory for the input keys and the output keys that will be filled
-	block *outputResults = (block *)_aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16);
+	block *outputResults = (block *)scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16);
 
 	//copy the outputKeys to the the aligned outputs
 	memcpy(outputResults, carr, garbledCircuit->getNumberOfOutputs() * 16);
@@ -431,6 +433,7 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 
 	//relase memory
 	env->ReleaseByteArrayElements(outputKeys, carr, JNI_ABORT);
+	scapi_native::alignedFree(outputResults);
 
 	delete[] answer;
 
@@ -459,8 +462,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	jbyte *carrBoth = env->GetByteArrayElements(bothOutputKeys, 0);
 
 	//allocate memory for the input keys and the output keys that will be filled
-	block *singleOutputResultsBlocks = (block *)_aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16);
-	block *bothOutputKeysBlocks = (block *)_aligned_malloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs() * 2, 16);
+	block *singleOutputResultsBlocks = (block *)scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs(), 16);
+	block *bothOutputKeysBlocks = (block *)scapi_native::alignedAlloc(sizeof(block)  * garbledCircuit->getNumberOfOutputs() * 2, 16);
 
 
 	//copy the outputKeys to the the aligned singleOutputResultsBlocks
@@ -494,6 +497,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_circuits_fastGarbledCircuit_ScNa
 	//release memory
 	env->ReleaseByteArrayElements(outputKeys, carrSingle, JNI_ABORT);
 	env->ReleaseByteArrayElements(bothOutputKeys, carrBoth, JNI_ABORT);
+	scapi_native::alignedFree(singleOutputResultsBlocks);
+	scapi_native::alignedFree(bothOutputKeysBlocks);
 
 	//return true if each key is one of both possible keys and translate return true, false, otherwise.
 	delete[] answer;